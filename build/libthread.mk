@@ -8,6 +8,7 @@ THREAD_SOURCES = \
 	$(THREAD_SRC_DIR)/RecursivelySuspensibleThread.cpp \
 	$(THREAD_SRC_DIR)/WorkerThread.cpp \
 	$(THREAD_SRC_DIR)/StandbyThread.cpp \
+	$(THREAD_SRC_DIR)/ThreadPool.cpp \
 	$(THREAD_SRC_DIR)/Debug.cpp
 
 # this is needed to compile Notify.cpp, which depends on the screen
@@ -209,6 +209,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/RadarRenderer.cpp \
 	\
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
@@ -250,13 +251,19 @@ XCSOAR_SOURCES := \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Logger/NMEALogger.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
+	$(SRC)/Logger/SensorRecorder.cpp \
 	$(SRC)/Logger/ExternalLogger.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
 	$(SRC)/Logger/GlueFlightLogger.cpp \
 	$(SRC)/Replay/Replay.cpp \
+	$(SRC)/Replay/Checkpoints.cpp \
+	$(SRC)/Replay/SeekFeeder.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/Replay/IgcReplay.cpp \
 	$(SRC)/Replay/NmeaReplay.cpp \
+	$(SRC)/Replay/SensorRecord.cpp \
+	$(SRC)/Replay/SensorReplay.cpp \
 	$(SRC)/Replay/DemoReplay.cpp \
 	$(SRC)/Replay/DemoReplayGlue.cpp \
 	$(SRC)/Replay/TaskAutoPilot.cpp \
@@ -398,6 +405,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Audio/VarioSettings.cpp \
 	$(SRC)/MergeThread.cpp \
 	$(SRC)/CalculationThread.cpp \
+	$(SRC)/LatencyTrace.cpp \
 	$(SRC)/DisplayMode.cpp \
 	\
 	$(SRC)/Markers/Markers.cpp \
@@ -515,6 +523,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/ApplyVegaSwitches.cpp \
 	$(SRC)/MainWindow.cpp \
 	$(SRC)/Startup.cpp \
+	$(SRC)/StartupLoader.cpp \
 	$(SRC)/Components.cpp \
 	$(SRC)/BackendComponents.cpp \
 	$(SRC)/DataComponents.cpp \
@@ -14,6 +14,7 @@ LIBMAPWINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowGlideRange.cpp \
 	$(SRC)/Projection/MapWindowProjection.cpp \
 	$(SRC)/MapWindow/MapWindowRender.cpp \
+	$(SRC)/MapWindow/MapLayerStatistics.cpp \
 	$(SRC)/MapWindow/MapWindowSymbols.cpp \
 	$(SRC)/MapWindow/MapWindowContest.cpp \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
@@ -23,10 +23,12 @@ PYTHON_SOURCES = \
 	$(PYTHON_SRC)/Flight/FlightTimes.cpp \
 	$(PYTHON_SRC)/Flight/DouglasPeuckerMod.cpp \
 	$(PYTHON_SRC)/Flight/AnalyseFlight.cpp \
+	$(PYTHON_SRC)/Flight/BatchAnalyse.cpp \
         $(PYTHON_SRC)/Tools/GoogleEncode.cpp \
 	$(PYTHON_SRC)/PythonConverters.cpp \
 	$(PYTHON_SRC)/PythonGlue.cpp \
 	$(PYTHON_SRC)/Flight.cpp \
+	$(PYTHON_SRC)/FlightColumns.cpp \
 	$(PYTHON_SRC)/Airspaces.cpp \
 	$(PYTHON_SRC)/Util.cpp \
 	$(ENGINE_SRC_DIR)/Task/TaskBehaviour.cpp \
@@ -48,10 +50,11 @@ PYTHON_SOURCES = \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceSorter.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceAircraftPerformance.cpp \
-	$(SRC)/NMEA/Aircraft.cpp
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/TransponderCode.cpp
 PYTHON_LDADD = $(DEBUG_REPLAY_LDADD)
 PYTHON_LDLIBS = $(shell python3-config --ldflags)
-PYTHON_DEPENDS = CONTEST WAYPOINT UTIL ZZIP GEO MATH TIME
+PYTHON_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST WAYPOINT UTIL ZZIP GEO MATH TIME
 PYTHON_CPPFLAGS = $(shell python3-config --includes) \
 	-I$(TEST_SRC_DIR) -Wno-write-strings
 PYTHON_NO_LIB_PREFIX = y
@@ -239,6 +239,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/memory/RawBitmap.cpp \
 	$(CANVAS_SRC_DIR)/memory/VirtualCanvas.cpp \
 	$(CANVAS_SRC_DIR)/memory/SubCanvas.cpp \
+	$(CANVAS_SRC_DIR)/memory/TiledRenderer.cpp \
 	$(CANVAS_SRC_DIR)/memory/Canvas.cpp
 MEMORY_CANVAS_CPPFLAGS = -DUSE_MEMORY_CANVAS
 endif
@@ -267,6 +268,11 @@ ifeq ($(LIBPNG),y)
 SCREEN_DEPENDS += IO
 endif
 
+ifeq ($(USE_MEMORY_CANVAS),y)
+# TiledRenderer.cpp uses class ThreadPool
+SCREEN_DEPENDS += THREAD
+endif
+
 $(eval $(call link-library,screen,SCREEN))
 
 ifeq ($(USE_FB)$(VFB),yy)
@@ -87,9 +87,12 @@ TEST_NAMES = \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
-	TestLogger TestGRecord TestClimbAvCalc \
+	TestLogger TestAsyncOutputStream TestSensorRecord \
+	TestVarioChannel TestAudioAlgorithms \
+	TestThreadPool \
+	TestGRecord TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
-	TestFlarmNet \
+	TestFlarmNet TestTrafficList \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
@@ -100,6 +103,7 @@ TEST_NAMES = \
 	TestTeamCode \
 	TestZeroFinder \
 	TestAirspaceParser \
+	TestAirspaceCache \
 	TestMETARParser \
 	TestIGCParser \
 	TestStrings TestUTF8 \
@@ -114,7 +118,11 @@ TEST_NAMES = \
 	TestLXNToIGC \
 	TestLeastSquares \
 	TestHexString \
-	TestThermalBand
+	TestThermalBand \
+	TestSnapshotBuffer \
+	TestFlatTrace \
+	TestTraceStore \
+	TestReplaySeek
 
 ifeq ($(TARGET_IS_ANDROID),n)
 # These programs are broken on Android because they require Java code
@@ -157,6 +165,29 @@ $(TEST_SRC_DIR)/tap.c \
 $(TEST_SRC_DIR)/TestThermalBand.cpp
 $(eval $(call link-program,TestThermalBand,TEST_THERMALBAND))
 
+TEST_SNAPSHOT_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSnapshotBuffer.cpp
+TEST_SNAPSHOT_BUFFER_DEPENDS = THREAD
+$(eval $(call link-program,TestSnapshotBuffer,TEST_SNAPSHOT_BUFFER))
+
+TEST_FLAT_TRACE_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/FlatTrace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlatTrace.cpp
+TEST_FLAT_TRACE_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestFlatTrace,TEST_FLAT_TRACE))
+
+TEST_TRACE_STORE_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTraceStore.cpp
+TEST_TRACE_STORE_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTraceStore,TEST_TRACE_STORE))
+
 TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestOverwritingRingBuffer.cpp
@@ -165,9 +196,10 @@ $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFE
 
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCBulkParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestIGCParser.cpp
-TEST_IGC_PARSER_DEPENDS = MATH UTIL
+TEST_IGC_PARSER_DEPENDS = IO MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
 TEST_METAR_PARSER_SOURCES = \
@@ -191,6 +223,19 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE UNITS ZZIP GEO MATH UTIL UNITS
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceCache.cpp
+TEST_AIRSPACE_CACHE_LDADD = $(FAKE_LIBS)
+TEST_AIRSPACE_CACHE_DEPENDS = IO OS AIRSPACE UNITS GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceCache,TEST_AIRSPACE_CACHE))
+
 TEST_DATE_TIME_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestDateTime.cpp
@@ -408,6 +453,15 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = GEO MATH UTIL FMT
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -620,6 +674,7 @@ $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
@@ -630,9 +685,46 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL UNITS
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL UNITS
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
+TEST_ASYNC_OUTPUT_STREAM_SOURCES = \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAsyncOutputStream.cpp
+TEST_ASYNC_OUTPUT_STREAM_DEPENDS = THREAD UTIL
+$(eval $(call link-program,TestAsyncOutputStream,TEST_ASYNC_OUTPUT_STREAM))
+
+TEST_SENSOR_RECORD_SOURCES = \
+	$(SRC)/Replay/SensorRecord.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSensorRecord.cpp
+TEST_SENSOR_RECORD_DEPENDS = LIBNMEA FLARM GEO MATH IO UTIL TIME UNITS
+$(eval $(call link-program,TestSensorRecord,TEST_SENSOR_RECORD))
+
+TEST_VARIO_CHANNEL_SOURCES = \
+	$(SRC)/Audio/VarioChannel.cpp \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestVarioChannel.cpp
+TEST_VARIO_CHANNEL_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestVarioChannel,TEST_VARIO_CHANNEL))
+
+TEST_THREAD_POOL_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThreadPool.cpp
+TEST_THREAD_POOL_DEPENDS = THREAD UTIL
+$(eval $(call link-program,TestThreadPool,TEST_THREAD_POOL))
+
+TEST_AUDIO_ALGORITHMS_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAudioAlgorithms.cpp
+TEST_AUDIO_ALGORITHMS_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestAudioAlgorithms,TEST_AUDIO_ALGORITHMS))
+
 TEST_GRECORD_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/util/MD5.cpp \
@@ -714,6 +806,14 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkIGCParser \
+	BenchmarkFlarmTraffic \
+	BenchmarkBlackboardMerge \
+	BenchmarkTrace \
+	BenchmarkTaskDijkstra \
+	BenchmarkAirspaceCache \
+	BenchmarkReplay \
+	BenchmarkPCM \
 	DumpTextInflate \
 	DumpHexColor \
 	RunXMLParser \
@@ -754,7 +854,7 @@ DEBUG_PROGRAM_NAMES += \
 	RunFlightLogger RunFlyingComputer \
 	RunCirclingWind RunWindEKF RunWindComputer \
 	RunExternalWind \
-	RunTask \
+	RunTask ScoreTask \
 	LoadImage ViewImage \
 	RunCanvas RunMapWindow \
 	RunListControl \
@@ -779,7 +879,8 @@ DEBUG_PROGRAM_NAMES += \
 	RunVegaSettings \
 	RunFlarmUtils \
 	RunLX1600Utils \
-	IGC2NMEA
+	IGC2NMEA \
+	NMEA2SensorRecord
 endif
 
 ifeq ($(TARGET),UNIX)
@@ -814,6 +915,10 @@ ifeq ($(LUA),y)
 DEBUG_PROGRAM_NAMES += RunLua
 endif
 
+ifeq ($(USE_MEMORY_CANVAS),y)
+DEBUG_PROGRAM_NAMES += BenchmarkTiledRenderer
+endif
+
 DEBUG_PROGRAMS = $(call name-to-bin,$(DEBUG_PROGRAM_NAMES))
 
 ifeq ($(LUA),y)
@@ -862,6 +967,8 @@ DEBUG_REPLAY_SOURCES = \
 	$(TEST_SRC_DIR)/FakeGeoid.cpp \
 	$(TEST_SRC_DIR)/DebugReplayIGC.cpp \
 	$(TEST_SRC_DIR)/DebugReplayNMEA.cpp \
+	$(SRC)/Replay/SensorRecord.cpp \
+	$(TEST_SRC_DIR)/DebugReplaySensor.cpp \
 	$(TEST_SRC_DIR)/DebugReplay.cpp
 DEBUG_REPLAY_DEPENDS = DRIVER ASYNC LIBNET IO OS THREAD TIME
 
@@ -879,6 +986,162 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_IGC_PARSER_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCBulkParser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIGCParser.cpp
+BENCHMARK_IGC_PARSER_DEPENDS = IO MATH UTIL
+$(eval $(call link-program,BenchmarkIGCParser,BENCHMARK_IGC_PARSER))
+
+BENCHMARK_TRACE_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/FlatTrace.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTrace.cpp
+BENCHMARK_TRACE_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,BenchmarkTrace,BENCHMARK_TRACE))
+
+BENCHMARK_TASK_DIJKSTRA_SOURCES = \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstra.cpp \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstraMin.cpp \
+	$(ENGINE_SRC_DIR)/Task/PathSolvers/TaskDijkstraMax.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskDijkstra.cpp
+BENCHMARK_TASK_DIJKSTRA_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,BenchmarkTaskDijkstra,BENCHMARK_TASK_DIJKSTRA))
+
+BENCHMARK_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaceCache.cpp
+BENCHMARK_AIRSPACE_CACHE_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_CACHE_DEPENDS = IO OS AIRSPACE UNITS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspaceCache,BENCHMARK_AIRSPACE_CACHE))
+
+BENCHMARK_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReplay.cpp
+BENCHMARK_REPLAY_DEPENDS = $(DEBUG_REPLAY_DEPENDS) \
+	LIBCOMPUTER LIBNMEA CONTEST ROUTE TERRAIN GLIDE WAYPOINT AIRSPACE \
+	OPERATION ZZIP UTIL GEO MATH
+$(eval $(call link-program,BenchmarkReplay,BENCHMARK_REPLAY))
+
+TEST_REPLAY_SEEK_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Replay/IgcReplay.cpp \
+	$(SRC)/Replay/Checkpoints.cpp \
+	$(SRC)/Replay/SeekFeeder.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestReplaySeek.cpp
+TEST_REPLAY_SEEK_DEPENDS = $(DEBUG_REPLAY_DEPENDS) \
+	LIBCOMPUTER LIBNMEA CONTEST ROUTE TERRAIN GLIDE WAYPOINT AIRSPACE \
+	OPERATION ZZIP UTIL GEO MATH
+$(eval $(call link-program,TestReplaySeek,TEST_REPLAY_SEEK))
+
+BENCHMARK_PCM_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioChannel.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkPCM.cpp
+BENCHMARK_PCM_DEPENDS = MATH UTIL
+$(eval $(call link-program,BenchmarkPCM,BENCHMARK_PCM))
+
+BENCHMARK_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
+	$(SRC)/Device/Driver/FLARM/CRC16.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FLARMEmulator.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFlarmTraffic.cpp
+BENCHMARK_FLARM_TRAFFIC_DEPENDS = PORT OPERATION LIBNMEA GEO MATH IO OS THREAD TIME UTIL UNITS
+$(eval $(call link-program,BenchmarkFlarmTraffic,BENCHMARK_FLARM_TRAFFIC))
+
+BENCHMARK_BLACKBOARD_MERGE_SOURCES = \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
+	$(SRC)/Device/Driver/FLARM/CRC16.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FLARMEmulator.cpp \
+	$(TEST_SRC_DIR)/BenchmarkBlackboardMerge.cpp
+BENCHMARK_BLACKBOARD_MERGE_DEPENDS = PORT OPERATION LIBNMEA GEO MATH IO OS THREAD TIME UTIL UNITS
+$(eval $(call link-program,BenchmarkBlackboardMerge,BENCHMARK_BLACKBOARD_MERGE))
+
+BENCHMARK_TILED_RENDERER_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkTiledRenderer.cpp
+BENCHMARK_TILED_RENDERER_DEPENDS = SCREEN EVENT ASYNC THREAD OS IO MATH UTIL
+$(eval $(call link-program,BenchmarkTiledRenderer,BENCHMARK_TILED_RENDERER))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1417,6 +1680,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
@@ -1514,6 +1778,21 @@ RUN_TASK_SOURCES = \
 RUN_TASK_DEPENDS = $(DEBUG_REPLAY_DEPENDS) TASKFILE WAYPOINTFILE GLIDE GEO MATH UTIL IO TIME
 $(eval $(call link-program,RunTask,RUN_TASK))
 
+SCORE_TASK_SOURCES = \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(SRC)/Formatter/NMEAFormatter.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/TaskScoring.cpp \
+	$(TEST_SRC_DIR)/ScoreTask.cpp
+SCORE_TASK_DEPENDS = $(DEBUG_REPLAY_DEPENDS) TASKFILE WAYPOINTFILE GLIDE GEO MATH UTIL IO TIME
+$(eval $(call link-program,ScoreTask,SCORE_TASK))
+
 RUN_TRACE_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -2128,6 +2407,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
@@ -2387,6 +2667,13 @@ IGC2NMEA_DEPENDS = $(DEBUG_REPLAY_DEPENDS) GEO MATH UTIL TIME
 
 $(eval $(call link-program,IGC2NMEA,IGC2NMEA))
 
+NMEA2SENSOR_RECORD_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/NMEA2SensorRecord.cpp
+NMEA2SENSOR_RECORD_DEPENDS = $(DEBUG_REPLAY_DEPENDS) GEO MATH UTIL TIME
+$(eval $(call link-program,NMEA2SensorRecord,NMEA2SENSOR_RECORD))
+
 debug: $(DEBUG_PROGRAMS)
 
 TEST_REPLAY_RETROSPECTIVE_SOURCES = \
@@ -11,15 +11,165 @@
 #include "Flight/Flight.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "Flight/IGCFixEnhanced.hpp"
+#include "Flight/BatchAnalyse.hpp"
 #include "Tools/GoogleEncode.hpp"
 
 #include <cstdio>
+#include <string>
 #include <vector>
 #include <cinttypes>
 #include <limits>
 
 using namespace std::chrono;
 
+/**
+ * Collect the fixes between #begin and #end.  This does not use the
+ * Python API and may be called without holding the GIL.
+ */
+static bool
+ReadPath(Flight &flight,
+         std::chrono::system_clock::time_point begin,
+         std::chrono::system_clock::time_point end,
+         std::vector<IGCFixEnhanced> &fixes)
+{
+  DebugReplay *replay = flight.Replay();
+
+  if (replay == nullptr)
+    return false;
+
+  while (replay->Next()) {
+    if (replay->Level() == -1) continue;
+
+    const MoreData &basic = replay->Basic();
+    const auto date_time_utc = basic.date_time_utc.ToTimePoint();
+
+    if (date_time_utc < begin)
+      continue;
+    else if (date_time_utc > end)
+      break;
+
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    IGCFixEnhanced fix;
+    fix.Clear();
+    fix.Apply(basic, replay->Calculated());
+    fix.level = replay->Level();
+
+    fixes.push_back(fix);
+  }
+
+  delete replay;
+
+  return true;
+}
+
+static PyObject *
+WriteTimes(const std::vector<FlightTimeResult> &results)
+{
+  PyObject *py_times = PyList_New(0);
+
+  for (auto times : results) {
+    PyObject *py_power_states = PyList_New(0);
+
+    for (auto power_state : times.power_states) {
+      PyObject *py_power_state = Py_BuildValue("{s:N,s:N,s:O}",
+        "time", Python::BrokenDateTimeToPy(power_state.time),
+        "location", Python::WriteLonLat(power_state.location),
+        "powered", power_state.state == PowerState::ON ? Py_True : Py_False);
+
+      if (PyList_Append(py_power_states, py_power_state) != 0)
+        return nullptr;
+
+      Py_DECREF(py_power_state);
+    }
+
+    PyObject *py_single_flight = Py_BuildValue("{s:N,s:N,s:N}",
+      "takeoff", Python::WriteEvent(times.takeoff_time, times.takeoff_location),
+      "landing", Python::WriteEvent(times.landing_time, times.landing_location),
+      "power_states", py_power_states);
+
+    if (times.release_time.IsPlausible()) {
+      PyObject *py_release = Python::WriteEvent(times.release_time, times.release_location);
+      PyDict_SetItemString(py_single_flight, "release", py_release);
+      Py_DECREF(py_release);
+    }
+
+    if (PyList_Append(py_times, py_single_flight) != 0)
+      return nullptr;
+
+    Py_DECREF(py_single_flight);
+  }
+
+  return py_times;
+}
+
+static PyObject *
+WriteAnalysis(const ContestStatistics &olc_plus,
+              const ContestStatistics &dmst,
+              const PhaseList &phase_list,
+              const PhaseTotals &phase_totals,
+              const WindList &wind_list,
+              AtmosphericPressure qnh, Validity qnh_available)
+{
+  /* write olc_plus statistics */
+  PyObject *py_olc_plus = Py_BuildValue("{s:N,s:N,s:N}",
+    "classic", Python::WriteContest(olc_plus.result[0], olc_plus.solution[0]),
+    "triangle", Python::WriteContest(olc_plus.result[1], olc_plus.solution[1]),
+    "plus", Python::WriteContest(olc_plus.result[2], olc_plus.solution[2]));
+
+  /* write dmst statistics */
+  PyObject *py_dmst = Py_BuildValue("{s:N}",
+    "quadrilateral", Python::WriteContest(dmst.result[0], dmst.solution[0]));
+
+  /* write contests */
+  PyObject *py_contests = Py_BuildValue("{s:N,s:N}",
+    "olc_plus", py_olc_plus,
+    "dmst", py_dmst);
+
+  /* write fligh phases */
+  PyObject *py_phases = PyList_New(0);
+
+  for (Phase phase : phase_list) {
+    PyObject *py_phase = Python::WritePhase(phase);
+    if (PyList_Append(py_phases, py_phase) != 0)
+      return nullptr;
+
+    Py_DECREF(py_phase);
+  }
+
+  /* write wind list*/
+  PyObject *py_wind_list = PyList_New(0);
+
+  for (WindListItem wind_item: wind_list) {
+    PyObject *py_wind = Python::WriteWindItem(wind_item);
+    if (PyList_Append(py_wind_list, py_wind) != 0)
+      return nullptr;
+
+    Py_DECREF(py_wind);
+  }
+
+  /* write QNH */
+  PyObject *py_qnh;
+
+  if (qnh_available) {
+    py_qnh = PyFloat_FromDouble(qnh.GetHectoPascal());
+  } else {
+    py_qnh = Py_None;
+    Py_INCREF(Py_None);
+  }
+
+  PyObject *py_result = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
+    "contests", py_contests,
+    "phases", py_phases,
+    "performance", Python::WritePerformanceStats(phase_totals),
+    "wind", py_wind_list,
+    "qnh", py_qnh);
+
+  return py_result;
+}
+
 PyObject* xcsoar_Flight_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
   /* constructor */
   static char *kwlist[] = {"file", "keep", nullptr};
@@ -122,48 +272,30 @@ PyObject* xcsoar_Flight_path(Pyxcsoar_Flight *self, PyObject *args) {
   if (py_end != nullptr && PyDateTime_Check(py_end))
     end = Python::PyToBrokenDateTime(py_end).ToTimePoint();
 
-  // prepare output
-  PyObject *py_fixes = PyList_New(0);
+  std::vector<IGCFixEnhanced> fixes;
+  bool success;
 
-  DebugReplay *replay = self->flight->Replay();
+  Py_BEGIN_ALLOW_THREADS
+  success = ReadPath(*self->flight, begin, end, fixes);
+  Py_END_ALLOW_THREADS
 
-  if (replay == nullptr) {
+  if (!success) {
     PyErr_SetString(PyExc_IOError, "Can't start replay - file not found.");
     return nullptr;
   }
 
-  while (replay->Next()) {
-    if (replay->Level() == -1) continue;
-
-    const MoreData &basic = replay->Basic();
-    const auto date_time_utc = basic.date_time_utc.ToTimePoint();
-
-    if (date_time_utc < begin)
-      continue;
-    else if (date_time_utc > end)
-      break;
-
-    if (!basic.time_available || !basic.location_available ||
-        !basic.NavAltitudeAvailable())
-      continue;
-
-    IGCFixEnhanced fix;
-    fix.Clear();
-    fix.Apply(basic, replay->Calculated());
-    fix.level = replay->Level();
+  // prepare output
+  PyObject *py_fixes = PyList_New(0);
 
+  for (const auto &fix : fixes) {
     PyObject *py_fix = Python::IGCFixEnhancedToPyTuple(fix);
 
-    if (PyList_Append(py_fixes, py_fix) != 0) {
-      delete replay;
+    if (PyList_Append(py_fixes, py_fix) != 0)
       return nullptr;
-    }
 
     Py_DECREF(py_fix);
   }
 
-  delete replay;
-
   return py_fixes;
 }
 
@@ -174,41 +306,7 @@ PyObject* xcsoar_Flight_times(Pyxcsoar_Flight *self) {
   self->flight->Times(results);
   Py_END_ALLOW_THREADS
 
-  PyObject *py_times = PyList_New(0);
-
-  for (auto times : results) {
-    PyObject *py_power_states = PyList_New(0);
-
-    for (auto power_state : times.power_states) {
-      PyObject *py_power_state = Py_BuildValue("{s:N,s:N,s:O}",
-        "time", Python::BrokenDateTimeToPy(power_state.time),
-        "location", Python::WriteLonLat(power_state.location),
-        "powered", power_state.state == PowerState::ON ? Py_True : Py_False);
-
-      if (PyList_Append(py_power_states, py_power_state) != 0)
-        return nullptr;
-
-      Py_DECREF(py_power_state);
-    }
-
-    PyObject *py_single_flight = Py_BuildValue("{s:N,s:N,s:N}",
-      "takeoff", Python::WriteEvent(times.takeoff_time, times.takeoff_location),
-      "landing", Python::WriteEvent(times.landing_time, times.landing_location),
-      "power_states", py_power_states);
-
-    if (times.release_time.IsPlausible()) {
-      PyObject *py_release = Python::WriteEvent(times.release_time, times.release_location);
-      PyDict_SetItemString(py_single_flight, "release", py_release);
-      Py_DECREF(py_release);
-    }
-
-    if (PyList_Append(py_times, py_single_flight) != 0)
-      return nullptr;
-
-    Py_DECREF(py_single_flight);
-  }
-
-  return py_times;
+  return WriteTimes(results);
 }
 
 PyObject* xcsoar_Flight_reduce(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs) {
@@ -320,61 +418,8 @@ PyObject* xcsoar_Flight_analyse(Pyxcsoar_Flight *self, PyObject *args, PyObject
   if (!success)
     Py_RETURN_NONE;
 
-  /* write olc_plus statistics */
-  PyObject *py_olc_plus = Py_BuildValue("{s:N,s:N,s:N}",
-    "classic", Python::WriteContest(olc_plus.result[0], olc_plus.solution[0]),
-    "triangle", Python::WriteContest(olc_plus.result[1], olc_plus.solution[1]),
-    "plus", Python::WriteContest(olc_plus.result[2], olc_plus.solution[2]));
-
-  /* write dmst statistics */
-  PyObject *py_dmst = Py_BuildValue("{s:N}",
-    "quadrilateral", Python::WriteContest(dmst.result[0], dmst.solution[0]));
-
-  /* write contests */
-  PyObject *py_contests = Py_BuildValue("{s:N,s:N}",
-    "olc_plus", py_olc_plus,
-    "dmst", py_dmst);
-
-  /* write fligh phases */
-  PyObject *py_phases = PyList_New(0);
-
-  for (Phase phase : phase_list) {
-    PyObject *py_phase = Python::WritePhase(phase);
-    if (PyList_Append(py_phases, py_phase) != 0)
-      return nullptr;
-
-    Py_DECREF(py_phase);
-  }
-
-  /* write wind list*/
-  PyObject *py_wind_list = PyList_New(0);
-
-  for (WindListItem wind_item: wind_list) {
-    PyObject *py_wind = Python::WriteWindItem(wind_item);
-    if (PyList_Append(py_wind_list, py_wind) != 0)
-      return nullptr;
-
-    Py_DECREF(py_wind);
-  }
-
-  /* write QNH */
-  PyObject *py_qnh;
-
-  if (self->flight->qnh_available) {
-    py_qnh = PyFloat_FromDouble(self->flight->qnh.GetHectoPascal());
-  } else {
-    py_qnh = Py_None;
-    Py_INCREF(Py_None);
-  }
-
-  PyObject *py_result = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
-    "contests", py_contests,
-    "phases", py_phases,
-    "performance", Python::WritePerformanceStats(phase_totals),
-    "wind", py_wind_list,
-    "qnh", py_qnh);
-
-  return py_result;
+  return WriteAnalysis(olc_plus, dmst, phase_list, phase_totals, wind_list,
+                       self->flight->qnh, self->flight->qnh_available);
 }
 
 PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args) {
@@ -400,45 +445,53 @@ PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args) {
                encoded_altitude,
                encoded_enl;
 
+  /* the encoding does not involve the Python API, so let other
+     threads run meanwhile */
+  bool success;
+
+  Py_BEGIN_ALLOW_THREADS
   DebugReplay *replay = self->flight->Replay();
+  success = replay != nullptr;
 
-  if (replay == nullptr) {
-    PyErr_SetString(PyExc_IOError, "Can't start replay - file not found.");
-    return nullptr;
-  }
+  if (success) {
+    while (replay->Next()) {
+      if (replay->Level() == -1) continue;
 
-  while (replay->Next()) {
-    if (replay->Level() == -1) continue;
+      const MoreData &basic = replay->Basic();
+      const auto date_time_utc = basic.date_time_utc.ToTimePoint();
 
-    const MoreData &basic = replay->Basic();
-    const auto date_time_utc = basic.date_time_utc.ToTimePoint();
+      if (date_time_utc < begin)
+        continue;
+      else if (date_time_utc > end)
+        break;
 
-    if (date_time_utc < begin)
-      continue;
-    else if (date_time_utc > end)
-      break;
+      if (!basic.time_available || !basic.location_available ||
+          !basic.NavAltitudeAvailable())
+        continue;
 
-    if (!basic.time_available || !basic.location_available ||
-        !basic.NavAltitudeAvailable())
-      continue;
+      IGCFixEnhanced fix;
+      fix.Clear();
+      fix.Apply(basic, replay->Calculated());
 
-    IGCFixEnhanced fix;
-    fix.Clear();
-    fix.Apply(basic, replay->Calculated());
+      encoded_locations.addDouble(fix.location.latitude.Degrees());
+      encoded_locations.addDouble(fix.location.longitude.Degrees());
 
-    encoded_locations.addDouble(fix.location.latitude.Degrees());
-    encoded_locations.addDouble(fix.location.longitude.Degrees());
+      encoded_levels.addUnsignedNumber(replay->Level());
+      encoded_times.addSignedNumber(duration_cast<duration<int>>(basic.time.ToDuration()).count());
+      encoded_altitude.addSignedNumber(self->flight->qnh.PressureAltitudeToQNHAltitude(fix.pressure_altitude));
 
-    encoded_levels.addUnsignedNumber(replay->Level());
-    encoded_times.addSignedNumber(duration_cast<duration<int>>(basic.time.ToDuration()).count());
-    encoded_altitude.addSignedNumber(self->flight->qnh.PressureAltitudeToQNHAltitude(fix.pressure_altitude));
+      if (fix.enl >= 0)
+          encoded_enl.addSignedNumber(fix.enl);
+    }
 
-    if (fix.enl >= 0)
-        encoded_enl.addSignedNumber(fix.enl);
+    delete replay;
   }
+  Py_END_ALLOW_THREADS
 
-  delete replay;
-
+  if (!success) {
+    PyErr_SetString(PyExc_IOError, "Can't start replay - file not found.");
+    return nullptr;
+  }
 
   PyObject *py_result = Py_BuildValue("{s:s,s:s,s:s,s:s,s:s}",
     "locations", encoded_locations.asString()->c_str(),
@@ -450,6 +503,84 @@ PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args) {
   return py_result;
 }
 
+PyObject* xcsoar_analyse_flights([[maybe_unused]] PyObject *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"files", "threads",
+                           "full", "triangle", "sprint",
+                           "max_iterations", "max_tree_size", nullptr};
+  PyObject *py_files;
+  unsigned threads = 0;
+  BatchAnalyseSettings settings;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|IIIIII", kwlist,
+                                   &py_files, &threads,
+                                   &settings.full, &settings.triangle,
+                                   &settings.sprint,
+                                   &settings.max_iterations,
+                                   &settings.max_tree_size)) {
+    return nullptr;
+  }
+
+  PyObject *py_files_fast = PySequence_Fast(py_files, "Expected a list of file names.");
+  if (py_files_fast == nullptr)
+    return nullptr;
+
+  const Py_ssize_t num_files = PySequence_Fast_GET_SIZE(py_files_fast);
+
+  std::vector<std::string> files;
+  files.reserve(num_files);
+
+  for (Py_ssize_t i = 0; i < num_files; ++i) {
+    PyObject *py_file = PySequence_Fast_GET_ITEM(py_files_fast, i);
+
+    const char *file = PyUnicode_Check(py_file)
+      ? PyUnicode_AsUTF8(py_file)
+      : nullptr;
+    if (file == nullptr) {
+      if (!PyErr_Occurred())
+        PyErr_SetString(PyExc_TypeError, "Expected a list of file names.");
+      Py_DECREF(py_files_fast);
+      return nullptr;
+    }
+
+    files.emplace_back(file);
+  }
+
+  Py_DECREF(py_files_fast);
+
+  std::vector<BatchAnalyseResult> results;
+
+  Py_BEGIN_ALLOW_THREADS
+  results = BatchAnalyse(files, settings, threads);
+  Py_END_ALLOW_THREADS
+
+  PyObject *py_results = PyList_New(0);
+
+  for (const auto &result : results) {
+    PyObject *py_result;
+
+    if (result.success) {
+      py_result = Py_BuildValue("{s:N,s:N}",
+        "times", WriteTimes(result.times),
+        "analysis", WriteAnalysis(result.olc_plus, result.dmst,
+                                  result.phase_list, result.phase_totals,
+                                  result.wind_list,
+                                  result.qnh, result.qnh_available));
+      if (py_result == nullptr)
+        return nullptr;
+    } else {
+      py_result = Py_None;
+      Py_INCREF(Py_None);
+    }
+
+    if (PyList_Append(py_results, py_result) != 0)
+      return nullptr;
+
+    Py_DECREF(py_result);
+  }
+
+  return py_results;
+}
+
 PyMethodDef xcsoar_Flight_methods[] = {
   {"setQNH", (PyCFunction)xcsoar_Flight_setQNH, METH_VARARGS, "Set QNH for the flight (in hPa)."},
   {"path", (PyCFunction)xcsoar_Flight_path, METH_VARARGS, "Get flight as list."},
@@ -457,6 +588,8 @@ PyMethodDef xcsoar_Flight_methods[] = {
   {"reduce", (PyCFunction)xcsoar_Flight_reduce, METH_VARARGS | METH_KEYWORDS, "Reduce flight."},
   {"analyse", (PyCFunction)xcsoar_Flight_analyse, METH_VARARGS | METH_KEYWORDS, "Analyse flight."},
   {"encode", (PyCFunction)xcsoar_Flight_encode, METH_VARARGS, "Return encoded flight."},
+  {"columns", (PyCFunction)xcsoar_Flight_columns, METH_NOARGS, "Get the fixes as dict of column buffers."},
+  {"from_columns", (PyCFunction)(void(*)(void))xcsoar_Flight_from_columns, METH_VARARGS | METH_KEYWORDS | METH_CLASS, "Create a flight from column buffers."},
   {nullptr, nullptr, 0, nullptr}
 };
 
@@ -512,6 +645,9 @@ bool Flight_init(PyObject* m) {
   if (PyType_Ready(&xcsoar_Flight_Type) < 0)
       return false;
 
+  if (!FlightColumns_init())
+      return false;
+
   PyDateTime_IMPORT;
 
   Py_INCREF(&xcsoar_Flight_Type);
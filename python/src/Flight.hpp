@@ -24,5 +24,11 @@ PyObject* xcsoar_Flight_times(Pyxcsoar_Flight *self);
 PyObject* xcsoar_Flight_reduce(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs);
 PyObject* xcsoar_Flight_analyse(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs);
 PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args);
+PyObject* xcsoar_Flight_columns(Pyxcsoar_Flight *self);
+PyObject* xcsoar_Flight_from_columns(PyTypeObject *type, PyObject *args, PyObject *kwargs);
 
+/* xcsoar module functions */
+PyObject* xcsoar_analyse_flights(PyObject *self, PyObject *args, PyObject *kwargs);
+
+bool FlightColumns_init();
 bool Flight_init(PyObject* m);
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "BatchAnalyse.hpp"
+#include "Flight.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <algorithm>
+
+static void
+Analyse(const char *path, const BatchAnalyseSettings &settings,
+        BatchAnalyseResult &result) noexcept
+try {
+  Flight flight(path, false);
+
+  if (flight.Times(result.times) == 0)
+    return;
+
+  const BrokenDateTime takeoff = result.times.front().takeoff_time;
+  const BrokenDateTime landing = result.times.back().landing_time;
+
+  /* no scoring window: score everything between takeoff and
+     landing */
+  const BrokenDateTime scoring_start = BrokenDateTime::Invalid();
+  const BrokenDateTime scoring_end = BrokenDateTime::Invalid();
+
+  result.success = flight.Analyse(takeoff, scoring_start, scoring_end, landing,
+                                  result.olc_plus, result.dmst,
+                                  result.phase_list, result.phase_totals,
+                                  result.wind_list,
+                                  settings.full, settings.triangle,
+                                  settings.sprint,
+                                  settings.max_iterations,
+                                  settings.max_tree_size);
+
+  result.qnh = flight.qnh;
+  result.qnh_available = flight.qnh_available;
+} catch (...) {
+  /* the file could not be read */
+  result.success = false;
+}
+
+std::vector<BatchAnalyseResult>
+BatchAnalyse(std::span<const std::string> files,
+             const BatchAnalyseSettings &settings,
+             unsigned concurrency) noexcept
+{
+  std::vector<BatchAnalyseResult> results(files.size());
+  if (files.empty())
+    return results;
+
+  if (concurrency == 0)
+    concurrency = ThreadPool::GetDefaultConcurrency();
+
+  try {
+    ThreadPool pool(std::min<std::size_t>(concurrency, files.size()));
+
+    pool.ParallelFor(files.size(), [&](std::size_t i){
+      Analyse(files[i].c_str(), settings, results[i]);
+    });
+  } catch (...) {
+    /* failed to launch threads: fall back to sequential analysis */
+    for (std::size_t i = 0; i < files.size(); ++i)
+      Analyse(files[i].c_str(), settings, results[i]);
+  }
+
+  return results;
+}
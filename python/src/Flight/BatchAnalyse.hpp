@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "FlightTimes.hpp"
+#include "AnalyseFlight.hpp"
+#include "Engine/Contest/ContestStatistics.hpp"
+#include "Atmosphere/Pressure.hpp"
+#include "NMEA/Validity.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+
+struct BatchAnalyseSettings {
+  unsigned full = 512, triangle = 1024, sprint = 96;
+  unsigned max_iterations = 20e6, max_tree_size = 5e6;
+};
+
+/**
+ * The analysis of one flight file; this combines the results of
+ * Flight::Times() and Flight::Analyse().
+ */
+struct BatchAnalyseResult {
+  /**
+   * False if the file could not be read or contains no flight; all
+   * other attributes are undefined then.
+   */
+  bool success = false;
+
+  std::vector<FlightTimeResult> times;
+
+  ContestStatistics olc_plus, dmst;
+
+  PhaseList phase_list;
+  PhaseTotals phase_totals;
+
+  WindList wind_list;
+
+  AtmosphericPressure qnh;
+  Validity qnh_available;
+};
+
+/**
+ * Analyse many IGC files concurrently.  For each file, the flight
+ * times are detected, and the range from the first takeoff to the
+ * last landing is analysed.
+ *
+ * This function does not use the Python API and may be called
+ * without holding the GIL.
+ *
+ * @param concurrency the number of threads; 0 means one per CPU
+ * @return one result per file, in the same order
+ */
+std::vector<BatchAnalyseResult>
+BatchAnalyse(std::span<const std::string> files,
+             const BatchAnalyseSettings &settings,
+             unsigned concurrency) noexcept;
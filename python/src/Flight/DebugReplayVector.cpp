@@ -12,9 +12,10 @@ DebugReplayVector::Next()
 {
   last_basic = computed_basic;
 
-  if (position != fixes.size()) {
-    CopyFromFix(fixes[position]);
-    Compute(fixes[position].elevation);
+  if (position != fixes->size()) {
+    const IGCFixEnhanced &fix = (*fixes)[position];
+    CopyFromFix(fix);
+    Compute(fix.elevation);
     ++position;
     return true;
   }
@@ -6,15 +6,21 @@
 #include "DebugReplay.hpp"
 #include "IGCFixEnhanced.hpp"
 #include <cassert>
+#include <memory>
+#include <vector>
 
 
+/**
+ * Replay fixes from a vector.  The vector is not copied; this object
+ * keeps a reference to it, and its owner must not modify it.
+ */
 class DebugReplayVector : public DebugReplay {
-  const std::vector<IGCFixEnhanced> fixes;
+  const std::shared_ptr<const std::vector<IGCFixEnhanced>> fixes;
   unsigned long position;
 
 private:
-  DebugReplayVector(const std::vector<IGCFixEnhanced> &_fixes)
-    : fixes(_fixes), position(0) {
+  DebugReplayVector(std::shared_ptr<const std::vector<IGCFixEnhanced>> &&_fixes)
+    : fixes(std::move(_fixes)), position(0) {
   }
 
   ~DebugReplayVector() {
@@ -24,7 +30,7 @@ public:
   virtual bool Next();
 
   long Size() const {
-    return fixes.size();
+    return fixes->size();
   }
 
   long Tell() const {
@@ -33,11 +39,11 @@ public:
 
   int Level() const {
     assert(position > 0);
-    return fixes[position - 1].level;
+    return (*fixes)[position - 1].level;
   }
 
-  static DebugReplay* Create(const std::vector<IGCFixEnhanced> &fixes) {
-    return new DebugReplayVector(fixes);
+  static DebugReplay* Create(std::shared_ptr<const std::vector<IGCFixEnhanced>> fixes) {
+    return new DebugReplayVector(std::move(fixes));
   }
 
 protected:
@@ -10,7 +10,7 @@
 #include <vector>
 
 Flight::Flight(const char* _flight_file, bool _keep_flight)
-  : fixes(nullptr), keep_flight(_keep_flight), flight_file(_flight_file) {
+  : keep_flight(_keep_flight), flight_file(_flight_file) {
   if (keep_flight)
     ReadFlight();
 
@@ -19,7 +19,7 @@ Flight::Flight(const char* _flight_file, bool _keep_flight)
 }
 
 void Flight::ReadFlight() {
-  fixes = new std::vector<IGCFixEnhanced>;
+  fixes = std::make_shared<std::vector<IGCFixEnhanced>>();
 
   DebugReplay *replay = DebugReplayIGC::Create(Path(flight_file));
 
@@ -43,11 +43,10 @@ void Flight::Reduce(const BrokenDateTime start, const BrokenDateTime end,
                     const unsigned num_levels, const unsigned zoom_factor,
                     const double threshold, const bool force_endpoints,
                     const unsigned max_delta_time, const unsigned max_points) {
-  // we need the whole flight, so read it now...
-  if (!keep_flight) {
-    ReadFlight();
-    keep_flight = true;
-  }
+  // we need the whole flight, so read it now...  The levels are
+  // calculated in a copy, because a replay or a column export may be
+  // using the current vector without holding the GIL
+  auto reduced = std::make_shared<std::vector<IGCFixEnhanced>>(*GetFixes());
 
   DouglasPeuckerMod dp(num_levels, zoom_factor, threshold,
     force_endpoints, max_delta_time, max_points);
@@ -55,7 +54,7 @@ void Flight::Reduce(const BrokenDateTime start, const BrokenDateTime end,
   unsigned start_index = 0,
            end_index = 0;
 
-  for (auto fix : *fixes) {
+  for (auto fix : *reduced) {
     const BrokenDateTime date_time{fix.date, fix.time};
 
     if (date_time < start)
@@ -67,14 +66,12 @@ void Flight::Reduce(const BrokenDateTime start, const BrokenDateTime end,
       break;
   }
 
-  end_index = std::min(end_index, unsigned(fixes->size()));
+  end_index = std::min(end_index, unsigned(reduced->size()));
   start_index = std::min(start_index, end_index);
 
-  dp.Encode(*fixes, start_index, end_index);
-}
+  dp.Encode(*reduced, start_index, end_index);
 
-Flight::~Flight() {
-  if (keep_flight)
-    delete fixes;
+  const std::lock_guard lock{mutex};
+  fixes = std::move(reduced);
 }
 
@@ -12,13 +12,29 @@
 #include "Atmosphere/Pressure.hpp"
 #include "Computer/Settings.hpp"
 
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 class DebugReplay;
 
 class Flight {
 private:
-  std::vector<IGCFixEnhanced> *fixes;
+  /**
+   * Protects #fixes and #keep_flight; Python threads may call
+   * methods of the same flight concurrently while they have
+   * released the GIL.
+   */
+  mutable std::mutex mutex;
+
+  /**
+   * The fixes if #keep_flight is set.  Replays and column exports
+   * keep a reference to the vector while they use it without holding
+   * #mutex; AppendFix() never modifies such a shared vector, but
+   * copies it first.
+   */
+  std::shared_ptr<std::vector<IGCFixEnhanced>> fixes;
   bool keep_flight;
   const char *flight_file;
 
@@ -31,16 +47,21 @@ public:
    * Create a empty flight object, used to create a flight from in-memory data
    */
   Flight()
-    : keep_flight(true), flight_file(nullptr) {
-    fixes = new std::vector<IGCFixEnhanced>;
+    : fixes(std::make_shared<std::vector<IGCFixEnhanced>>()),
+      keep_flight(true), flight_file(nullptr) {
     qnh = AtmosphericPressure::Standard();
     qnh_available.Clear();
   };
 
   /**
-   * Destructor
+   * Create a flight object from in-memory fixes
    */
-  ~Flight();
+  explicit Flight(std::vector<IGCFixEnhanced> &&_fixes)
+    : fixes(std::make_shared<std::vector<IGCFixEnhanced>>(std::move(_fixes))),
+      keep_flight(true), flight_file(nullptr) {
+    qnh = AtmosphericPressure::Standard();
+    qnh_available.Clear();
+  };
 
   /**
    * Create a flight object with file source
@@ -55,7 +76,7 @@ public:
   DebugReplay *Replay() {
     DebugReplay *replay;
 
-    if (keep_flight) replay = DebugReplayVector::Create(*fixes);
+    if (auto pinned = PinFixes()) replay = DebugReplayVector::Create(std::move(pinned));
     else replay = DebugReplayIGC::Create(Path(flight_file));
 
     if (qnh_available)
@@ -125,11 +146,29 @@ public:
    * Append a fix to this flight (only valid for in-memory flights)
    */
   void AppendFix(const IGCFixEnhanced &fix) {
+    const std::lock_guard lock{mutex};
     if (fixes == nullptr) return;
 
+    /* copy on write: the old vector may be in use by a replay or a
+       column export */
+    if (fixes.use_count() > 1)
+      fixes = std::make_shared<std::vector<IGCFixEnhanced>>(*fixes);
+
     fixes->push_back(fix);
   };
 
+  /**
+   * Return the fixes of this flight.  This reads the flight into
+   * memory (and sets the keep_flight flag) if that has not been done
+   * yet.  The returned vector is never modified, not even by a later
+   * AppendFix() call, so it can be used without holding the GIL.
+   */
+  std::shared_ptr<const std::vector<IGCFixEnhanced>> GetFixes() {
+    const std::lock_guard lock{mutex};
+    Load();
+    return fixes;
+  };
+
   /**
    * Set the QNH for this flight
    */
@@ -139,6 +178,26 @@ public:
   };
 
 private:
+  /**
+   * Return the in-memory fixes, or nullptr if the flight shall be
+   * replayed from the file.
+   */
+  std::shared_ptr<const std::vector<IGCFixEnhanced>> PinFixes() const {
+    const std::lock_guard lock{mutex};
+    return keep_flight ? fixes : nullptr;
+  };
+
+  /**
+   * Read the flight into memory unless that has been done already.
+   * Caller must lock the mutex.
+   */
+  void Load() {
+    if (!keep_flight) {
+      ReadFlight();
+      keep_flight = true;
+    }
+  };
+
   /* Read the flight into memory */
   void ReadFlight();
 };
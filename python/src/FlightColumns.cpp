@@ -0,0 +1,637 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Columnar access to the fixes of a xcsoar.Flight.
+ *
+ * Flight.columns() exports each attribute of the in-memory fixes as a
+ * one-dimensional buffer (PEP 3118), which can be wrapped by
+ * memoryview or numpy.asarray() without creating one Python object
+ * per fix.  Most columns point directly into the fix vector (with a
+ * stride of sizeof(IGCFixEnhanced)) and keep a reference to it, so
+ * later changes to the flight (e.g. Flight.reduce()) do not affect
+ * them; only those which need a unit conversion are computed into a
+ * private contiguous array.
+ *
+ * Flight.from_columns() is the reverse: it builds an in-memory flight
+ * from a set of equally sized buffers.
+ */
+
+#include <Python.h>
+
+#include "Flight.hpp"
+#include "Flight/Flight.hpp"
+#include "Flight/IGCFixEnhanced.hpp"
+#include "time/BrokenDateTime.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using FixVector = std::vector<IGCFixEnhanced>;
+
+/**
+ * A read-only one-dimensional buffer exporter.  It either refers to
+ * a (never modified) fix vector (#fixes), or to its own #storage.
+ */
+struct Pyxcsoar_FixColumn {
+  PyObject_HEAD
+
+  /**
+   * A reference to the fix vector #buf points into; nullptr if
+   * #storage is used.
+   */
+  std::shared_ptr<const FixVector> *fixes;
+
+  std::vector<std::byte> *storage;
+
+  const char *buf;
+  const char *format;
+  Py_ssize_t itemsize;
+  Py_ssize_t length;
+  Py_ssize_t stride;
+};
+
+static void
+xcsoar_FixColumn_dealloc(Pyxcsoar_FixColumn *self)
+{
+  delete self->fixes;
+  delete self->storage;
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+xcsoar_FixColumn_getbuffer(Pyxcsoar_FixColumn *self, Py_buffer *view,
+                           int flags)
+{
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "Fix columns are read-only.");
+    return -1;
+  }
+
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES &&
+      self->stride != self->itemsize) {
+    PyErr_SetString(PyExc_BufferError, "Fix column is not contiguous.");
+    return -1;
+  }
+
+  Py_INCREF(self);
+  view->obj = (PyObject *)self;
+  view->buf = const_cast<char *>(self->buf);
+  view->len = self->length * self->itemsize;
+  view->readonly = 1;
+  view->itemsize = self->itemsize;
+  view->format = (flags & PyBUF_FORMAT)
+    ? const_cast<char *>(self->format)
+    : nullptr;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? &self->length : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) ? &self->stride : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static PyBufferProcs xcsoar_FixColumn_as_buffer = {
+  (getbufferproc)xcsoar_FixColumn_getbuffer,
+  nullptr,
+};
+
+static PyTypeObject xcsoar_FixColumn_Type = {
+  PyVarObject_HEAD_INIT(&PyType_Type, 0)
+  "xcsoar.FixColumn",
+  sizeof(Pyxcsoar_FixColumn),
+  0,
+  (destructor)xcsoar_FixColumn_dealloc,
+};
+
+template<typename T>
+static constexpr const char *
+BufferFormat() noexcept
+{
+  if constexpr (std::is_same_v<T, double>)
+    return "d";
+  else if constexpr (std::is_same_v<T, int64_t>)
+    return "q";
+  else if constexpr (std::is_same_v<T, int>)
+    return "i";
+  else if constexpr (std::is_same_v<T, int16_t>)
+    return "h";
+  else {
+    static_assert(std::is_same_v<T, bool>);
+    return "?";
+  }
+}
+
+/**
+ * Wrap a #Pyxcsoar_FixColumn in a memoryview.
+ */
+static PyObject *
+NewColumn(std::shared_ptr<const FixVector> *fixes,
+          std::vector<std::byte> *storage,
+          const void *buf, const char *format, std::size_t itemsize,
+          std::size_t length, std::size_t stride)
+{
+  auto *column = PyObject_New(Pyxcsoar_FixColumn, &xcsoar_FixColumn_Type);
+  if (column == nullptr) {
+    delete fixes;
+    delete storage;
+    return nullptr;
+  }
+
+  column->fixes = fixes;
+  column->storage = storage;
+  column->buf = (const char *)buf;
+  column->format = format;
+  column->itemsize = itemsize;
+  column->length = length;
+  column->stride = stride;
+
+  PyObject *py_view = PyMemoryView_FromObject((PyObject *)column);
+  Py_DECREF(column);
+  return py_view;
+}
+
+/**
+ * Export one attribute of all fixes without copying.
+ *
+ * @param f a function returning a pointer to the attribute within
+ * the given fix
+ */
+template<typename T, typename F>
+static PyObject *
+NewStridedColumn(const std::shared_ptr<const FixVector> &fixes, F &&f)
+{
+  const T *first = fixes->empty() ? nullptr : f(fixes->front());
+  return NewColumn(new std::shared_ptr<const FixVector>(fixes), nullptr,
+                   first, BufferFormat<T>(), sizeof(T),
+                   fixes->size(), sizeof(IGCFixEnhanced));
+}
+
+template<typename T>
+static PyObject *
+NewComputedColumn(std::unique_ptr<std::vector<std::byte>> &&storage)
+{
+  const std::size_t length = storage->size() / sizeof(T);
+  const void *buf = storage->data();
+  return NewColumn(nullptr, storage.release(), buf, BufferFormat<T>(),
+                   sizeof(T), length, sizeof(T));
+}
+
+template<typename T, typename F>
+static std::unique_ptr<std::vector<std::byte>>
+Compute(const std::vector<IGCFixEnhanced> &fixes, F &&f) noexcept
+{
+  auto storage = std::make_unique<std::vector<std::byte>>(fixes.size() *
+                                                          sizeof(T));
+  T *p = reinterpret_cast<T *>(storage->data());
+  for (const auto &fix : fixes)
+    *p++ = f(fix);
+  return storage;
+}
+
+static bool
+AddColumn(PyObject *py_columns, const char *name, PyObject *py_column)
+{
+  if (py_column == nullptr)
+    return false;
+
+  const bool success = PyDict_SetItemString(py_columns, name, py_column) == 0;
+  Py_DECREF(py_column);
+  return success;
+}
+
+/* TimeStamp is exported as plain double */
+static_assert(sizeof(TimeStamp) == sizeof(double));
+
+PyObject* xcsoar_Flight_columns(Pyxcsoar_Flight *self) {
+  std::shared_ptr<const FixVector> fixes;
+  std::unique_ptr<std::vector<std::byte>> time, latitude, longitude;
+
+  Py_BEGIN_ALLOW_THREADS
+  fixes = self->flight->GetFixes();
+
+  time = Compute<int64_t>(*fixes, [](const IGCFixEnhanced &fix){
+    const auto t = BrokenDateTime(fix.date, fix.time).ToTimePoint();
+    return (int64_t)std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+  });
+
+  latitude = Compute<double>(*fixes, [](const IGCFixEnhanced &fix){
+    return fix.location.latitude.Degrees();
+  });
+
+  longitude = Compute<double>(*fixes, [](const IGCFixEnhanced &fix){
+    return fix.location.longitude.Degrees();
+  });
+  Py_END_ALLOW_THREADS
+
+  PyObject *py_columns = PyDict_New();
+  if (py_columns == nullptr)
+    return nullptr;
+
+  if (!AddColumn(py_columns, "time",
+                 NewComputedColumn<int64_t>(std::move(time))) ||
+      !AddColumn(py_columns, "clock",
+                 NewStridedColumn<double>(fixes, [](const IGCFixEnhanced &fix){
+                   return reinterpret_cast<const double *>(&fix.clock);
+                 })) ||
+      !AddColumn(py_columns, "latitude",
+                 NewComputedColumn<double>(std::move(latitude))) ||
+      !AddColumn(py_columns, "longitude",
+                 NewComputedColumn<double>(std::move(longitude))) ||
+      !AddColumn(py_columns, "gps_valid",
+                 NewStridedColumn<bool>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.gps_valid;
+                 })) ||
+      !AddColumn(py_columns, "gps_altitude",
+                 NewStridedColumn<int>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.gps_altitude;
+                 })) ||
+      !AddColumn(py_columns, "pressure_altitude",
+                 NewStridedColumn<int>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.pressure_altitude;
+                 })) ||
+      !AddColumn(py_columns, "enl",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.enl;
+                 })) ||
+      !AddColumn(py_columns, "trt",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.trt;
+                 })) ||
+      !AddColumn(py_columns, "gsp",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.gsp;
+                 })) ||
+      !AddColumn(py_columns, "tas",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.tas;
+                 })) ||
+      !AddColumn(py_columns, "ias",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.ias;
+                 })) ||
+      !AddColumn(py_columns, "siu",
+                 NewStridedColumn<int16_t>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.siu;
+                 })) ||
+      !AddColumn(py_columns, "elevation",
+                 NewStridedColumn<int>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.elevation;
+                 })) ||
+      !AddColumn(py_columns, "level",
+                 NewStridedColumn<int>(fixes, [](const IGCFixEnhanced &fix){
+                   return &fix.level;
+                 }))) {
+    Py_DECREF(py_columns);
+    return nullptr;
+  }
+
+  return py_columns;
+}
+
+/**
+ * An input column of Flight.from_columns().
+ */
+struct InputColumn {
+  const char *name;
+  Py_buffer view;
+  char format = 0;
+
+  bool IsDefined() const noexcept {
+    return format != 0;
+  }
+
+  /**
+   * Read element #i as double.  Call only if IsDefined().
+   */
+  double operator[](Py_ssize_t i) const noexcept {
+    const char *p = (const char *)view.buf + i * view.strides[0];
+
+    switch (format) {
+#define READ(c, T) case c: { T value; memcpy(&value, p, sizeof(value)); return value; }
+      READ('d', double)
+      READ('f', float)
+      READ('b', signed char)
+      READ('B', unsigned char)
+      READ('h', short)
+      READ('H', unsigned short)
+      READ('i', int)
+      READ('I', unsigned)
+      READ('l', long)
+      READ('L', unsigned long)
+      READ('q', long long)
+      READ('Q', unsigned long long)
+      READ('?', bool)
+#undef READ
+    }
+
+    return NAN;
+  }
+};
+
+/**
+ * Parse a (native byte order) struct format string consisting of one
+ * numeric item.
+ *
+ * @return the type code or 0 if the format is not supported
+ */
+static char
+ParseFormat(const char *format) noexcept
+{
+  if (format == nullptr)
+    return 'B';
+
+  if (*format == '@' || *format == '=' ||
+      (*format == '<' && std::endian::native == std::endian::little) ||
+      (*format == '>' && std::endian::native == std::endian::big))
+    ++format;
+
+  if (format[0] == 0 || format[1] != 0 ||
+      strchr("dfbBhHiIlLqQ?", format[0]) == nullptr)
+    return 0;
+
+  return format[0];
+}
+
+/**
+ * Obtain a buffer from the given object and check that it is a
+ * one-dimensional numeric array with #length elements (or set
+ * #length if it is negative).
+ */
+static bool
+GetInputColumn(PyObject *py_column, InputColumn &column, Py_ssize_t &length)
+{
+  if (PyObject_GetBuffer(py_column, &column.view, PyBUF_RECORDS_RO) != 0)
+    return false;
+
+  column.format = ParseFormat(column.view.format);
+  if (column.format == 0 || column.view.ndim != 1) {
+    PyBuffer_Release(&column.view);
+    column.format = 0;
+    PyErr_Format(PyExc_TypeError,
+                 "Column '%s' is not a one-dimensional numeric array.",
+                 column.name);
+    return false;
+  }
+
+  if (length < 0)
+    length = column.view.shape[0];
+  else if (column.view.shape[0] != length) {
+    PyBuffer_Release(&column.view);
+    column.format = 0;
+    PyErr_Format(PyExc_ValueError,
+                 "Column '%s' has a different length.", column.name);
+    return false;
+  }
+
+  return true;
+}
+
+enum {
+  COLUMN_TIME,
+  COLUMN_CLOCK,
+  COLUMN_LATITUDE,
+  COLUMN_LONGITUDE,
+  COLUMN_GPS_VALID,
+  COLUMN_GPS_ALTITUDE,
+  COLUMN_PRESSURE_ALTITUDE,
+  COLUMN_ENL,
+  COLUMN_TRT,
+  COLUMN_GSP,
+  COLUMN_TAS,
+  COLUMN_IAS,
+  COLUMN_SIU,
+  COLUMN_ELEVATION,
+  COLUMN_LEVEL,
+  NUM_COLUMNS,
+};
+
+static constexpr const char *column_names[NUM_COLUMNS] = {
+  "time",
+  "clock",
+  "latitude",
+  "longitude",
+  "gps_valid",
+  "gps_altitude",
+  "pressure_altitude",
+  "enl",
+  "trt",
+  "gsp",
+  "tas",
+  "ias",
+  "siu",
+  "elevation",
+  "level",
+};
+
+/**
+ * Is this value neither NaN nor infinite?  XCSoar is built with
+ * -ffast-math, which allows the compiler to assume that there are no
+ * such values, and to optimise std::isnan() and comparisons
+ * accordingly; but values from Python may be anything, so this
+ * checks the bits.
+ */
+static constexpr bool
+IsFiniteInput(double value) noexcept
+{
+  constexpr uint64_t exponent_mask = 0x7ff0000000000000;
+  return (std::bit_cast<uint64_t>(value) & exponent_mask) != exponent_mask;
+}
+
+static int16_t
+ReadExtension(const InputColumn &column, Py_ssize_t i) noexcept
+{
+  if (!column.IsDefined())
+    return -1;
+
+  const double value = column[i];
+  return IsFiniteInput(value) ? (int16_t)value : -1;
+}
+
+/**
+ * Is this a Unix time which can be converted to int64_t and
+ * #BrokenDateTime (1970 to 9999)?
+ */
+static constexpr bool
+IsValidUnixTime(double t) noexcept
+{
+  return IsFiniteInput(t) && t >= 0 && t < 253402300800.;
+}
+
+/**
+ * Convert the columns to fixes.  This does not use the Python API
+ * and may be called without holding the GIL.
+ *
+ * @param error receives the name of the invalid attribute
+ * @return the index of the first invalid fix, or -1 on success
+ */
+static Py_ssize_t
+ReadColumns(const InputColumn *columns, Py_ssize_t length,
+            std::vector<IGCFixEnhanced> &fixes, const char *&error) noexcept
+{
+  fixes.reserve(length);
+
+  for (Py_ssize_t i = 0; i < length; ++i) {
+    IGCFixEnhanced fix;
+    fix.Clear();
+
+    const double time = columns[COLUMN_TIME][i];
+    if (!IsValidUnixTime(time)) {
+      error = "time";
+      return i;
+    }
+
+    const BrokenDateTime date_time =
+      BrokenDateTime::FromUnixTimeUTC((int64_t)time);
+    fix.date = date_time;
+    fix.time = date_time;
+    fix.clock = columns[COLUMN_CLOCK].IsDefined()
+      ? TimeStamp{FloatDuration{columns[COLUMN_CLOCK][i]}}
+      : TimeStamp{date_time.DurationSinceMidnight()};
+
+    const double longitude = columns[COLUMN_LONGITUDE][i];
+    const double latitude = columns[COLUMN_LATITUDE][i];
+    fix.location = GeoPoint(Angle::Degrees(longitude),
+                            Angle::Degrees(latitude));
+    if (!IsFiniteInput(longitude) || !IsFiniteInput(latitude) ||
+        !fix.location.Check()) {
+      error = "location";
+      return i;
+    }
+
+    const double gps_altitude = columns[COLUMN_GPS_ALTITUDE].IsDefined()
+      ? columns[COLUMN_GPS_ALTITUDE][i]
+      : NAN;
+    fix.gps_valid = columns[COLUMN_GPS_VALID].IsDefined()
+      ? columns[COLUMN_GPS_VALID][i] != 0
+      : IsFiniteInput(gps_altitude);
+    fix.gps_altitude = IsFiniteInput(gps_altitude) ? (int)gps_altitude : 0;
+
+    const double pressure_altitude =
+      columns[COLUMN_PRESSURE_ALTITUDE].IsDefined()
+      ? columns[COLUMN_PRESSURE_ALTITUDE][i]
+      : NAN;
+    /* fall back to GPS altitude - this is the same behaviour as in
+       IGCFix::Apply() */
+    fix.pressure_altitude = IsFiniteInput(pressure_altitude)
+      ? (int)pressure_altitude
+      : fix.gps_altitude;
+
+    fix.enl = ReadExtension(columns[COLUMN_ENL], i);
+    fix.trt = ReadExtension(columns[COLUMN_TRT], i);
+    fix.gsp = ReadExtension(columns[COLUMN_GSP], i);
+    fix.tas = ReadExtension(columns[COLUMN_TAS], i);
+    fix.ias = ReadExtension(columns[COLUMN_IAS], i);
+    fix.siu = ReadExtension(columns[COLUMN_SIU], i);
+
+    if (columns[COLUMN_ELEVATION].IsDefined() &&
+        IsFiniteInput(columns[COLUMN_ELEVATION][i]))
+      fix.elevation = (int)columns[COLUMN_ELEVATION][i];
+
+    if (columns[COLUMN_LEVEL].IsDefined())
+      fix.level = (int)columns[COLUMN_LEVEL][i];
+
+    fixes.push_back(fix);
+  }
+
+  return -1;
+}
+
+static void
+ReleaseColumns(InputColumn *columns) noexcept
+{
+  for (unsigned i = 0; i < NUM_COLUMNS; ++i)
+    if (columns[i].IsDefined())
+      PyBuffer_Release(&columns[i].view);
+}
+
+PyObject* xcsoar_Flight_from_columns(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+  if (PyTuple_Size(args) != 0 || kwargs == nullptr) {
+    PyErr_SetString(PyExc_TypeError, "Expected columns as keyword arguments.");
+    return nullptr;
+  }
+
+  InputColumn columns[NUM_COLUMNS];
+  for (unsigned i = 0; i < NUM_COLUMNS; ++i)
+    columns[i].name = column_names[i];
+
+  Py_ssize_t length = -1;
+
+  PyObject *py_key, *py_value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(kwargs, &pos, &py_key, &py_value)) {
+    const char *key = PyUnicode_AsUTF8(py_key);
+    if (key == nullptr) {
+      ReleaseColumns(columns);
+      return nullptr;
+    }
+
+    unsigned i = 0;
+    while (i < NUM_COLUMNS && strcmp(key, column_names[i]) != 0)
+      ++i;
+
+    if (i == NUM_COLUMNS) {
+      ReleaseColumns(columns);
+      PyErr_Format(PyExc_TypeError, "Unknown column '%s'.", key);
+      return nullptr;
+    }
+
+    if (!GetInputColumn(py_value, columns[i], length)) {
+      ReleaseColumns(columns);
+      return nullptr;
+    }
+  }
+
+  if (!columns[COLUMN_TIME].IsDefined() ||
+      !columns[COLUMN_LATITUDE].IsDefined() ||
+      !columns[COLUMN_LONGITUDE].IsDefined()) {
+    ReleaseColumns(columns);
+    PyErr_SetString(PyExc_TypeError,
+                    "Columns 'time', 'latitude' and 'longitude' are required.");
+    return nullptr;
+  }
+
+  if (!columns[COLUMN_GPS_ALTITUDE].IsDefined() &&
+      !columns[COLUMN_PRESSURE_ALTITUDE].IsDefined()) {
+    ReleaseColumns(columns);
+    PyErr_SetString(PyExc_ValueError, "Need at least gps or pressure altitude");
+    return nullptr;
+  }
+
+  std::vector<IGCFixEnhanced> fixes;
+  Py_ssize_t invalid;
+  const char *error = nullptr;
+
+  Py_BEGIN_ALLOW_THREADS
+  invalid = ReadColumns(columns, length, fixes, error);
+  Py_END_ALLOW_THREADS
+
+  ReleaseColumns(columns);
+
+  if (invalid >= 0) {
+    PyErr_Format(PyExc_ValueError, "Invalid %s in row %zd.", error, invalid);
+    return nullptr;
+  }
+
+  auto *self = (Pyxcsoar_Flight *)type->tp_alloc(type, 0);
+  if (self == nullptr)
+    return nullptr;
+
+  self->filename = nullptr;
+  self->flight = new Flight(std::move(fixes));
+
+  return (PyObject *)self;
+}
+
+bool FlightColumns_init() {
+  xcsoar_FixColumn_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+  xcsoar_FixColumn_Type.tp_doc = "Read-only buffer of one xcsoar.Flight attribute";
+  xcsoar_FixColumn_Type.tp_as_buffer = &xcsoar_FixColumn_as_buffer;
+
+  return PyType_Ready(&xcsoar_FixColumn_Type) == 0;
+}
@@ -13,6 +13,7 @@
 
 PyMethodDef xcsoar_methods[] = {
   {"encode", (PyCFunction)xcsoar_encode, METH_VARARGS | METH_KEYWORDS, "Encode a list of numbers."},
+  {"analyse_flights", (PyCFunction)xcsoar_analyse_flights, METH_VARARGS | METH_KEYWORDS, "Analyse a list of IGC files in parallel."},
   {nullptr, nullptr, 0, nullptr}
 };
 
@@ -4,6 +4,7 @@ from __future__ import print_function
 
 import xcsoar
 import argparse
+from array import array
 from pprint import pprint
 
 # Parse command line parameters
@@ -97,3 +98,57 @@ for i, fix in enumerate(flight.path()):
   print(fix)
 
 del flight
+
+
+print()
+print("Analyse several flights in parallel")
+
+for result in xcsoar.analyse_flights([args.file_name, args.file_name]):
+  pprint(result['times'])
+  pprint(result['analysis']['contests'])
+
+
+print()
+print("Export the flight as columns and create a new flight from them")
+
+flight = xcsoar.Flight(args.file_name)
+columns = flight.columns()
+
+for name, column in columns.items():
+  print(name, column.format, column[:5].tolist())
+
+flight = xcsoar.Flight.from_columns(time=columns['time'],
+                                    latitude=columns['latitude'],
+                                    longitude=columns['longitude'],
+                                    gps_altitude=columns['gps_altitude'],
+                                    pressure_altitude=columns['pressure_altitude'])
+pprint(flight.times())
+
+del flight
+
+
+print()
+print("Reject an invalid time")
+
+try:
+  xcsoar.Flight.from_columns(time=array('d', [float('nan')]),
+                             latitude=columns['latitude'][:1],
+                             longitude=columns['longitude'][:1],
+                             pressure_altitude=columns['pressure_altitude'][:1])
+  print("not rejected")
+except ValueError as e:
+  print(e)
+
+
+print()
+print("Reject invalid locations")
+
+for latitude, longitude in [(100., 10.), (45., float('nan'))]:
+  try:
+    xcsoar.Flight.from_columns(time=columns['time'][:1],
+                               latitude=array('d', [latitude]),
+                               longitude=array('d', [longitude]),
+                               pressure_altitude=columns['pressure_altitude'][:1])
+    print("not rejected")
+  except ValueError as e:
+    print(e)
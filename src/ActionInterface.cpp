@@ -34,6 +34,8 @@ XCSoarInterface::ReceiveGPS() noexcept
     const std::lock_guard lock{device_blackboard.mutex};
 
     ReadBlackboardBasic(device_blackboard.Basic());
+    ReadTraffic(device_blackboard.Traffic(),
+                device_blackboard.GetTrafficVersion());
 
     const NMEAInfo &real = device_blackboard.RealState();
     Private::movement_detected = real.alive && real.gps.real &&
@@ -42,7 +44,7 @@ XCSoarInterface::ReceiveGPS() noexcept
 
   BroadcastGPSUpdate();
 
-  if (!Basic().flarm.traffic.IsEmpty())
+  if (!Traffic().IsEmpty())
     /* auto-load FlarmNet when traffic is seen */
     LoadFlarmDatabases();
 }
@@ -52,9 +54,11 @@ XCSoarInterface::ReceiveCalculated() noexcept
 {
   {
     auto &device_blackboard = *backend_components->device_blackboard;
-    const std::lock_guard lock{device_blackboard.mutex};
 
-    ReadBlackboardCalculated(device_blackboard.Calculated());
+    /* lock-free, doesn't need the mutex */
+    ReadBlackboardCalculated(device_blackboard.GetCalculatedSnapshot());
+
+    const std::lock_guard lock{device_blackboard.mutex};
     device_blackboard.ReadComputerSettings(GetComputerSettings());
   }
 
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "io/BufferedReader.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "util/SpanCast.hxx"
+#include "util/StringAPI.hxx"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <string.h>
+
+struct CacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  uint32_t n_sources;
+};
+
+/**
+ * Identifies one of the files the airspaces were parsed from.  It
+ * is followed by #path_length characters of the path name.
+ */
+struct SourceHeader {
+  uint32_t path_length;
+  uint64_t size;
+  int64_t mtime;
+};
+
+/**
+ * Precedes each airspace in the cache file.  It is followed by the
+ * name, the type and then the shape: for a polygon, #n_points
+ * #GeoPoint instances; for a circle, the center and the radius.
+ */
+struct AirspaceHeader {
+  AbstractAirspace::Shape shape;
+  AirspaceClass asclass;
+  AirspaceActivity days;
+  RadioFrequency radio_frequency;
+
+  uint32_t name_length;
+  uint32_t type_length;
+  uint32_t n_points;
+
+  AirspaceAltitude base, top;
+};
+
+static_assert(std::is_trivially_copyable_v<AirspaceHeader>);
+static_assert(std::is_trivially_copyable_v<GeoPoint>);
+
+/* sanity limits which protect against malformed files */
+static constexpr uint32_t MAX_SOURCES = 16;
+static constexpr uint32_t MAX_STRING_LENGTH = 4096;
+static constexpr uint32_t MAX_POINTS = 1024 * 1024;
+static constexpr uint32_t MAX_AIRSPACES = 1024 * 1024;
+
+[[gnu::pure]]
+static SourceHeader
+MakeSourceHeader(Path path) noexcept
+{
+  SourceHeader header;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&header, 0, sizeof(header));
+
+  if (path != nullptr) {
+    header.path_length = StringLength(path.c_str());
+    header.size = File::GetSize(path);
+    header.mtime = std::chrono::duration_cast<std::chrono::seconds>(
+      File::GetLastModification(path).time_since_epoch()).count();
+  }
+
+  return header;
+}
+
+static void
+WriteString(BufferedOutputStream &os, const TCHAR *s, std::size_t length)
+{
+  os.Write(std::as_bytes(std::span{s, length}));
+}
+
+static void
+ReadString(BufferedReader &r, tstring &dest, std::size_t length)
+{
+  if (length > MAX_STRING_LENGTH)
+    throw std::runtime_error("Malformed airspace cache string");
+
+  dest.resize(length);
+  r.ReadFull(std::as_writable_bytes(std::span{dest}));
+}
+
+void
+SaveAirspaceCache(BufferedOutputStream &os, std::span<const Path> sources,
+                  const Airspaces &airspaces)
+{
+  assert(sources.size() <= MAX_SOURCES);
+
+  CacheHeader header;
+  header.version = CacheHeader::VERSION;
+  header.n_sources = sources.size();
+  os.WriteT(header);
+
+  for (const Path path : sources) {
+    os.WriteT(MakeSourceHeader(path));
+    if (path != nullptr)
+      WriteString(os, path.c_str(), StringLength(path.c_str()));
+  }
+
+  const uint32_t n_airspaces = airspaces.GetSize();
+  os.WriteT(n_airspaces);
+
+  for (const auto &i : airspaces.QueryAll()) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+
+    AirspaceHeader as_header;
+    /* zero-fill all implicit padding bytes (to make valgrind happy) */
+    memset((void *)&as_header, 0, sizeof(as_header));
+
+    as_header.shape = airspace.GetShape();
+    as_header.asclass = airspace.GetClass();
+    as_header.days = airspace.GetDays();
+    as_header.radio_frequency = airspace.GetRadioFrequency();
+    as_header.name_length = StringLength(airspace.GetName());
+    as_header.type_length = StringLength(airspace.GetType());
+    as_header.n_points = airspace.GetShape() == AbstractAirspace::Shape::POLYGON
+      ? airspace.GetPoints().size()
+      : 0;
+    as_header.base = airspace.GetBase();
+    as_header.top = airspace.GetTop();
+
+    os.WriteT(as_header);
+    WriteString(os, airspace.GetName(), as_header.name_length);
+    WriteString(os, airspace.GetType(), as_header.type_length);
+
+    switch (airspace.GetShape()) {
+    case AbstractAirspace::Shape::CIRCLE: {
+      const auto &circle = (const AirspaceCircle &)airspace;
+      os.WriteT(circle.GetCenter());
+      os.WriteT(circle.GetRadius());
+      break;
+    }
+
+    case AbstractAirspace::Shape::POLYGON:
+      /* the polygon border contains arcs and circles which were
+         already approximated by the parser */
+      for (const auto &p : airspace.GetPoints())
+        os.WriteT(p.GetLocation());
+      break;
+    }
+  }
+}
+
+/**
+ * Check whether the cached source list matches the given one.
+ */
+static bool
+CheckSources(BufferedReader &r, std::span<const Path> sources)
+{
+  const auto header = r.ReadFullT<CacheHeader>();
+  if (header.version != CacheHeader::VERSION ||
+      header.n_sources != sources.size())
+    return false;
+
+  tstring cached_path;
+  for (const Path path : sources) {
+    const auto source = r.ReadFullT<SourceHeader>();
+    const auto expected = MakeSourceHeader(path);
+    if (source.path_length != expected.path_length ||
+        source.size != expected.size ||
+        source.mtime != expected.mtime)
+      return false;
+
+    ReadString(r, cached_path, source.path_length);
+    if (path != nullptr && !StringIsEqual(cached_path.c_str(), path.c_str()))
+      return false;
+  }
+
+  return true;
+}
+
+static AirspacePtr
+LoadAirspace(BufferedReader &r, std::vector<GeoPoint> &points)
+{
+  const auto header = r.ReadFullT<AirspaceHeader>();
+  if (header.asclass >= AIRSPACECLASSCOUNT)
+    throw std::runtime_error("Malformed airspace cache");
+
+  tstring name, type;
+  ReadString(r, name, header.name_length);
+  ReadString(r, type, header.type_length);
+
+  std::shared_ptr<AbstractAirspace> airspace;
+
+  switch (header.shape) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    const auto center = r.ReadFullT<GeoPoint>();
+    const auto radius = r.ReadFullT<double>();
+    airspace = std::make_shared<AirspaceCircle>(center, radius);
+    break;
+  }
+
+  case AbstractAirspace::Shape::POLYGON:
+    if (header.n_points < 3 || header.n_points > MAX_POINTS)
+      throw std::runtime_error("Malformed airspace cache polygon");
+
+    points.resize(header.n_points);
+    r.ReadFull(std::as_writable_bytes(std::span{points}));
+    airspace = std::make_shared<AirspacePolygon>(points);
+    break;
+
+  default:
+    throw std::runtime_error("Malformed airspace cache shape");
+  }
+
+  airspace->SetProperties(std::move(name), header.asclass, std::move(type),
+                          header.base, header.top);
+  airspace->SetRadioFrequency(header.radio_frequency);
+  airspace->SetDays(header.days);
+  return airspace;
+}
+
+bool
+LoadAirspaceCache(BufferedReader &r, std::span<const Path> sources,
+                  Airspaces &airspaces)
+{
+  if (!CheckSources(r, sources))
+    return false;
+
+  const auto n_airspaces = r.ReadFullT<uint32_t>();
+  if (n_airspaces > MAX_AIRSPACES)
+    throw std::runtime_error("Malformed airspace cache");
+
+  std::vector<GeoPoint> points;
+  for (uint32_t i = 0; i < n_airspaces; ++i)
+    airspaces.Add(LoadAirspace(r, points));
+
+  return true;
+}
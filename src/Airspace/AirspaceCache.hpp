@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <span>
+
+class Airspaces;
+class Path;
+class BufferedReader;
+class BufferedOutputStream;
+
+/**
+ * Write the parsed airspaces to a binary cache file, which can be
+ * loaded by LoadAirspaceCache() on the next start instead of parsing
+ * the text files again.
+ *
+ * Throws on error.
+ *
+ * @param sources the configured airspace files (may contain null
+ * paths); their names, sizes and modification times are recorded so
+ * the cache is discarded when one of them changes
+ */
+void
+SaveAirspaceCache(BufferedOutputStream &os, std::span<const Path> sources,
+                  const Airspaces &airspaces);
+
+/**
+ * Load airspaces from a file written by SaveAirspaceCache() and add
+ * them to the given #Airspaces object.  The caller is responsible
+ * for calling Airspaces::Optimise() afterwards.
+ *
+ * Throws on error (e.g. if the file is malformed); in that case,
+ * the #Airspaces object may contain a partial result.
+ *
+ * @return false if the cache is stale, i.e. it does not match the
+ * given source files
+ */
+bool
+LoadAirspaceCache(BufferedReader &r, std::span<const Path> sources,
+                  Airspaces &airspaces);
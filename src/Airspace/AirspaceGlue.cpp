@@ -3,6 +3,7 @@
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Profile/Keys.hpp"
@@ -12,7 +13,10 @@
 #include "lib/fmt/PathFormatter.hpp"
 #include "lib/fmt/RuntimeError.hxx"
 #include "system/Path.hpp"
+#include "io/FileCache.hpp"
 #include "io/FileReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
 #include "io/ProgressReader.hpp"
 #include "io/BufferedReader.hxx"
 #include "io/ZipArchive.hpp"
@@ -20,8 +24,12 @@
 #include "io/MapFile.hpp"
 #include "Profile/Profile.hpp"
 
+#include <array>
+
 #include <string.h>
 
+static const TCHAR *const airspace_cache_name = _T("airspace");
+
 static bool
 ParseAirspaceFile(Airspaces &airspaces, Path path,
                   OperationEnvironment &operation) noexcept
@@ -67,37 +75,138 @@ try {
   return false;
 }
 
+/**
+ * The files airspaces are loaded from: the primary and the
+ * additional airspace file and the map file (which may contain
+ * "airspace.txt").
+ */
+using AirspaceSources = std::array<AllocatedPath, 3>;
+
+[[gnu::pure]]
+static std::array<Path, 3>
+ToPaths(const AirspaceSources &sources) noexcept
+{
+  return {sources[0], sources[1], sources[2]};
+}
+
+/**
+ * Returns the first configured source file, which is used as the
+ * #FileCache key; the others are checked by LoadAirspaceCache().
+ */
+[[gnu::pure]]
+static Path
+GetCacheKey(const AirspaceSources &sources) noexcept
+{
+  for (const auto &i : sources)
+    if (i != nullptr)
+      return i;
+
+  return nullptr;
+}
+
+static bool
+LoadCache(FileCache &cache, const AirspaceSources &sources,
+          Airspaces &airspaces)
+{
+  const Path key = GetCacheKey(sources);
+  if (key == nullptr)
+    return false;
+
+  auto r = cache.Load(airspace_cache_name, key);
+  if (!r)
+    return false;
+
+  BufferedReader br(*r);
+  return LoadAirspaceCache(br, ToPaths(sources), airspaces);
+}
+
+static void
+SaveCache(FileCache &cache, const AirspaceSources &sources,
+          const Airspaces &airspaces)
+{
+  const Path key = GetCacheKey(sources);
+  if (key == nullptr)
+    return;
+
+  auto os = cache.Save(airspace_cache_name, key);
+  BufferedOutputStream bos(*os);
+  SaveAirspaceCache(bos, ToPaths(sources), airspaces);
+  bos.Flush();
+  os->Commit();
+}
+
 void
 ReadAirspace(Airspaces &airspaces,
              AtmosphericPressure press,
+             FileCache *cache,
              OperationEnvironment &operation)
 {
   LogString("ReadAirspace");
   operation.SetText(_("Loading Airspace File..."));
 
-  bool airspace_ok = false;
+  const AirspaceSources sources{
+    Profile::GetPath(ProfileKeys::AirspaceFile),
+    Profile::GetPath(ProfileKeys::AdditionalAirspaceFile),
+    Profile::GetPath(ProfileKeys::MapFile),
+  };
+
+  if (cache != nullptr) {
+    try {
+      if (LoadCache(*cache, sources, airspaces)) {
+        airspaces.Optimise();
+        airspaces.SetFlightLevels(press);
+        return;
+      }
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load airspace cache");
+    }
+
+    /* discard a partial result */
+    airspaces.Clear();
+  }
+
+  bool airspace_ok = false, airspace_failed = false;
 
   // Read the airspace filenames from the registry
-  if (const auto path = Profile::GetPath(ProfileKeys::AirspaceFile);
-      path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
+  if (const Path path = sources[0]; path != nullptr) {
+    const bool ok = ParseAirspaceFile(airspaces, path, operation);
+    airspace_ok |= ok;
+    airspace_failed |= !ok;
+  }
 
-  if (const auto path = Profile::GetPath(ProfileKeys::AdditionalAirspaceFile);
-      path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
+  if (const Path path = sources[1]; path != nullptr) {
+    const bool ok = ParseAirspaceFile(airspaces, path, operation);
+    airspace_ok |= ok;
+    airspace_failed |= !ok;
+  }
 
   try {
     if (auto archive = OpenMapFile();
-        archive && archive->Exists("airspace.txt"))
-      airspace_ok |= ParseAirspaceFile(airspaces, archive->get(),
-                                       "airspace.txt", operation);
+        archive && archive->Exists("airspace.txt")) {
+      const bool ok = ParseAirspaceFile(airspaces, archive->get(),
+                                        "airspace.txt", operation);
+      airspace_ok |= ok;
+      airspace_failed |= !ok;
+    }
   } catch (...) {
+    airspace_failed = true;
     LogError(std::current_exception(),
              "Failed to load airspaces from map file");
   }
 
   if (airspace_ok) {
     airspaces.Optimise();
+
+    /* don't cache an incomplete result; it would hide the error on
+       the next start */
+    if (cache != nullptr && !airspace_failed) {
+      try {
+        SaveCache(*cache, sources, airspaces);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save airspace cache");
+      }
+    }
+
     airspaces.SetFlightLevels(press);
   } else
     // there was a problem
@@ -3,13 +3,13 @@
 
 #pragma once
 
+#include "SIMD.hpp"
 #include "util/Compiler.h"
 #include "util/ByteOrder.hxx"
 
 #include <algorithm>
 #include <limits>
 #include <type_traits>
-#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -68,6 +68,39 @@ inline void MixPCM(int16_t *dest, size_t num_frames,
   }
 }
 
+#ifdef HAVE_AUDIO_SIMD
+
+/**
+ * The SIMD implementation of MixPCM() and ByteSwapAndMixPCM().  It
+ * handles only whole vectors and returns the number of frames which
+ * were mixed.
+ */
+template<bool byte_swap>
+inline size_t MixPCMSIMD(int16_t *dest, const int16_t *src,
+                         size_t num_frames, unsigned vol_percent) {
+  if (vol_percent > static_cast<unsigned>(std::numeric_limits<int16_t>::max()))
+    return 0;
+
+  const size_t n = num_frames - num_frames % AudioSIMD::N;
+  for (size_t i = 0; i < n; i += AudioSIMD::N) {
+    auto v = AudioSIMD::Load(src + i);
+
+    /* the byte-swapped samples are unsigned, just like in
+       ByteSwapAndMixPCM()'s scalar code */
+    if constexpr (byte_swap)
+      v = AudioSIMD::ScalePercentUnsigned(AudioSIMD::ByteSwap(v),
+                                          static_cast<int16_t>(vol_percent));
+    else
+      v = AudioSIMD::ScalePercent(v, static_cast<int16_t>(vol_percent));
+
+    AudioSIMD::Store(dest + i, AudioSIMD::Add(AudioSIMD::Load(dest + i), v));
+  }
+
+  return n;
+}
+
+#endif
+
 /**
  * Mix PCM data from a given data source to a destination buffer
  * (which already contains PCM data).
@@ -76,6 +109,15 @@ inline void MixPCM(int16_t *dest, size_t num_frames,
  */
 inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
                    unsigned vol_percent) {
+#ifdef HAVE_AUDIO_SIMD
+  if (0 != vol_percent) {
+    const size_t n = MixPCMSIMD<false>(dest, src, num_frames, vol_percent);
+    dest += n;
+    src += n;
+    num_frames -= n;
+  }
+#endif
+
   MixPCM(dest, num_frames, vol_percent, [&src](size_t i) { return src[i]; });
 }
 
@@ -91,6 +133,15 @@ inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
  */
 inline void ByteSwapAndMixPCM(int16_t *dest, const int16_t *src,
                               size_t num_frames, unsigned vol_percent) {
+#ifdef HAVE_AUDIO_SIMD
+  if (0 != vol_percent) {
+    const size_t n = MixPCMSIMD<true>(dest, src, num_frames, vol_percent);
+    dest += n;
+    src += n;
+    num_frames -= n;
+  }
+#endif
+
   MixPCM(dest, num_frames, vol_percent,
          [&src](size_t i) {
            return static_cast<int32_t>(GenericByteSwap16(src[i]));
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+/*
+ * SIMD building blocks for the PCM algorithms.  All of them produce
+ * exactly the same results as the scalar code they replace, which
+ * uses 32 bit integer intermediates and rounds towards zero.
+ *
+ * HAVE_AUDIO_SIMD is defined if an implementation is available for
+ * the target CPU; currently, this is only SSE2.  Other CPUs use the
+ * scalar code.
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define HAVE_AUDIO_SIMD
+#endif
+
+#ifdef HAVE_AUDIO_SIMD
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AudioSIMD {
+
+/**
+ * The number of 16 bit samples in one #Vector.
+ */
+static constexpr std::size_t N = 8;
+
+using Vector = __m128i;
+
+[[gnu::always_inline]]
+inline Vector
+Load(const int16_t *p) noexcept
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+[[gnu::always_inline]]
+inline void
+Store(int16_t *p, Vector v) noexcept
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+/**
+ * Add without saturation, i.e. wrap around like the implicit
+ * conversion to int16_t does.
+ */
+[[gnu::always_inline]]
+inline Vector
+Add(Vector a, Vector b) noexcept
+{
+  return _mm_add_epi16(a, b);
+}
+
+/**
+ * Multiply, keeping only the lower 16 bits of each product.
+ */
+[[gnu::always_inline]]
+inline Vector
+MultiplyLow(Vector v, int16_t factor) noexcept
+{
+  return _mm_mullo_epi16(v, _mm_set1_epi16(factor));
+}
+
+[[gnu::always_inline]]
+inline Vector
+ByteSwap(Vector v) noexcept
+{
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+/**
+ * Divide signed 32 bit integers by 100, rounding towards zero.  This
+ * is the "multiply by magic number" algorithm compilers use for
+ * scalar division; SSE2 has no signed 32 bit multiplication, so the
+ * signed high product is derived from the unsigned one.
+ */
+[[gnu::always_inline]]
+inline __m128i
+DivideBy100(__m128i x) noexcept
+{
+  const __m128i magic = _mm_set1_epi32(0x51EB851F);
+
+  /* the high 32 bits of the unsigned 64 bit products */
+  const __m128i even = _mm_mul_epu32(x, magic);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), magic);
+  __m128i high =
+    _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 3, 1)),
+                       _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 3, 1)));
+
+  /* convert to the signed high product; the magic number is
+     positive */
+  const __m128i sign = _mm_srai_epi32(x, 31);
+  high = _mm_sub_epi32(high, _mm_and_si128(sign, magic));
+
+  /* round towards zero */
+  return _mm_sub_epi32(_mm_srai_epi32(high, 5), sign);
+}
+
+/**
+ * Calculate Clip(v * percent / 100).
+ */
+[[gnu::always_inline]]
+inline Vector
+ScalePercent(Vector v, int16_t percent) noexcept
+{
+  const __m128i factor = _mm_set1_epi16(percent);
+  const __m128i low = _mm_mullo_epi16(v, factor);
+  const __m128i high = _mm_mulhi_epi16(v, factor);
+
+  return _mm_packs_epi32(DivideBy100(_mm_unpacklo_epi16(low, high)),
+                         DivideBy100(_mm_unpackhi_epi16(low, high)));
+}
+
+/**
+ * Same as ScalePercent(), but interpret the input as unsigned 16 bit
+ * integers.
+ */
+[[gnu::always_inline]]
+inline Vector
+ScalePercentUnsigned(Vector v, int16_t percent) noexcept
+{
+  const __m128i factor = _mm_set1_epi16(percent);
+  const __m128i low = _mm_mullo_epi16(v, factor);
+  const __m128i high = _mm_mulhi_epu16(v, factor);
+
+  return _mm_packs_epi32(DivideBy100(_mm_unpacklo_epi16(low, high)),
+                         DivideBy100(_mm_unpackhi_epi16(low, high)));
+}
+
+} // namespace AudioSIMD
+
+#endif
@@ -2,10 +2,33 @@
 // Copyright The XCSoar Project
 
 #include "ToneSynthesiser.hpp"
-#include "Math/FastTrig.hpp"
+#include "SIMD.hpp"
 
 #include <cassert>
 
+static_assert(ISINETABLE.size() == INT_ANGLE_RANGE);
+
+void
+ToneSynthesiser::UpdateTable() noexcept
+{
+  std::size_t i = 0;
+
+#ifdef HAVE_AUDIO_SIMD
+  /* bit-compatible with the loop below only as long as there is no
+     overflow, i.e. up to 100% volume */
+  if (volume <= 100) {
+    for (; i < table.size(); i += AudioSIMD::N) {
+      const auto v = AudioSIMD::MultiplyLow(AudioSIMD::Load(&ISINETABLE[i]),
+                                            32767 / 1024);
+      AudioSIMD::Store(&table[i], AudioSIMD::ScalePercent(v, volume));
+    }
+  }
+#endif
+
+  for (; i < table.size(); ++i)
+    table[i] = ISINETABLE[i] * (32767 / 1024) * (int)volume / 100;
+}
+
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
@@ -18,7 +41,7 @@ ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
   assert(angle < ISINETABLE.size());
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
+    *buffer = table[angle];
     angle = (angle + increment) & (ISINETABLE.size() - 1);
   }
 }
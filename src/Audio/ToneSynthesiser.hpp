@@ -4,6 +4,9 @@
 #pragma once
 
 #include "PCMSynthesiser.hpp"
+#include "Math/FastTrig.hpp"
+
+#include <array>
 
 /**
  * This class generates tones with a sine wave.
@@ -11,8 +14,15 @@
 class ToneSynthesiser : public PCMSynthesiser {
   unsigned volume = 100, angle = 0, increment = 0;
 
+  /**
+   * The sine wave, scaled to the current #volume.  This replaces the
+   * multiplication and division per sample with a table lookup.
+   */
+  std::array<int16_t, INT_ANGLE_RANGE> table;
+
 public:
   explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
+    UpdateTable();
   }
 
   unsigned GetSampleRate() const {
@@ -27,6 +37,7 @@ public:
    */
   void SetVolume(unsigned _volume) {
     volume = _volume;
+    UpdateTable();
   }
 
   void SetTone(unsigned tone_hz);
@@ -34,6 +45,9 @@ public:
   /* methods from class PCMSynthesiser */
   virtual void Synthesise(int16_t *buffer, size_t n);
 
+private:
+  void UpdateTable() noexcept;
+
 protected:
   const unsigned sample_rate;
 
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "VarioChannel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+/*
+ * Layout of the packed 64 bit word:
+ *
+ * - bits 0..15: the vario value [cm/s] as signed 16 bit integer;
+ *   INT16_MIN means "silence"
+ * - bits 16..23: the source number
+ * - bits 24..63: the receipt time [us] modulo 2^40 (about 12 days,
+ *   which is plenty for comparing time stamps which are close
+ *   together)
+ */
+
+static constexpr int16_t SILENCE = INT16_MIN;
+static constexpr unsigned TIME_SHIFT = 24;
+static constexpr unsigned TIME_BITS = 64 - TIME_SHIFT;
+static constexpr uint64_t TIME_MASK = (uint64_t(1) << TIME_BITS) - 1;
+
+static constexpr uint64_t
+ToMicroseconds(VarioChannel::Clock::time_point time) noexcept
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+static constexpr uint64_t
+Pack(unsigned source, int16_t ivario,
+     VarioChannel::Clock::time_point time) noexcept
+{
+  return (ToMicroseconds(time) & TIME_MASK) << TIME_SHIFT |
+    uint64_t(source & 0xff) << 16 |
+    uint16_t(ivario);
+}
+
+static constexpr int16_t
+UnpackVario(uint64_t packed) noexcept
+{
+  return int16_t(uint16_t(packed));
+}
+
+static constexpr unsigned
+UnpackSource(uint64_t packed) noexcept
+{
+  return (packed >> 16) & 0xff;
+}
+
+/**
+ * Calculate the difference between the time stamp of a packed word
+ * and the specified time [us].  The result is negative if the packed
+ * time stamp is newer.
+ */
+static constexpr int64_t
+GetAge(uint64_t packed, uint64_t now_us) noexcept
+{
+  const uint64_t delta = (now_us - (packed >> TIME_SHIFT)) & TIME_MASK;
+
+  /* sign-extend the 40 bit value */
+  return int64_t(delta << TIME_SHIFT) >> TIME_SHIFT;
+}
+
+void
+VarioChannel::PushRaw(unsigned source, int16_t ivario,
+                      Clock::time_point time) noexcept
+{
+  assert(source <= MERGED);
+
+  const uint64_t packed = Pack(source, ivario, time);
+  const uint64_t now_us = ToMicroseconds(time);
+  const int64_t hold_us =
+    std::chrono::duration_cast<std::chrono::microseconds>(HOLD_TIME).count();
+
+  uint64_t old = value.load(std::memory_order_relaxed);
+  do {
+    if (source > UnpackSource(old) && GetAge(old, now_us) < hold_us)
+      /* a more important source has submitted a value recently */
+      return;
+  } while (!value.compare_exchange_weak(old, packed,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+void
+VarioChannel::Push(unsigned source, double vario,
+                   Clock::time_point time) noexcept
+{
+  /* the same truncation as VarioSynthesiser used to apply; the
+     synthesiser clamps to a much smaller range anyway */
+  const int ivario = std::clamp((int)(vario * 100),
+                                SILENCE + 1, (int)INT16_MAX);
+  PushRaw(source, int16_t(ivario), time);
+}
+
+void
+VarioChannel::PushSilence(unsigned source, Clock::time_point time) noexcept
+{
+  PushRaw(source, SILENCE, time);
+}
+
+bool
+VarioChannel::Read(Sample &sample) noexcept
+{
+  const uint64_t packed = value.load(std::memory_order_acquire);
+  if (packed == last_read)
+    return false;
+
+  last_read = packed;
+
+  const int16_t ivario = UnpackVario(packed);
+  sample.silence = ivario == SILENCE;
+  sample.ivario = ivario;
+
+  /* reconstruct the full time stamp from the current time */
+  const auto now = Clock::now();
+  const int64_t age_us = GetAge(packed, ToMicroseconds(now));
+  sample.time = now - std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds{age_us});
+
+  return true;
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * A lock-free single-value channel which passes the most recent vario
+ * value from its producers (device drivers and the #MergeThread) to
+ * the audio thread.  Producers never wait for the audio thread, and
+ * the audio thread never waits for a producer.
+ *
+ * The value, its source and its receipt time are packed into one
+ * 64 bit word, so a reader always sees a consistent sample.
+ *
+ * Several producers may feed the channel.  Like
+ * NMEAInfo::Complement(), the source with the lowest number wins: a
+ * value from a source with a higher number is discarded while a fresh
+ * value from a more important source is present.
+ */
+class VarioChannel {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * The source number of values which were not submitted by a
+   * specific device, e.g. the merged vario value.  It has the lowest
+   * priority.
+   */
+  static constexpr unsigned MERGED = 0xff;
+
+  /**
+   * A value from a more important source blocks other sources for
+   * this duration.
+   */
+  static constexpr Clock::duration HOLD_TIME = std::chrono::seconds{2};
+
+  struct Sample {
+    /**
+     * The vario value [cm/s].  Only valid if #silence is false.
+     */
+    int ivario;
+
+    /**
+     * Shall the vario be silent because no value is known?
+     */
+    bool silence;
+
+    /**
+     * The time the value was received.
+     */
+    Clock::time_point time;
+  };
+
+private:
+  std::atomic<uint64_t> value{EMPTY};
+
+  /**
+   * The last value returned by Read().  This is only accessed by the
+   * (single) consumer.
+   */
+  uint64_t last_read = EMPTY;
+
+  /**
+   * The packed silence value with the lowest priority and the time
+   * stamp zero.
+   */
+  static constexpr uint64_t EMPTY = uint64_t(MERGED) << 16 | 0x8000;
+
+public:
+  /**
+   * Submit a new vario value.  This method is thread-safe and
+   * lock-free.
+   *
+   * @param source the source number (e.g. the device index) or
+   * #MERGED
+   * @param vario the vario value [m/s]
+   * @param time the time the value was received
+   */
+  void Push(unsigned source, double vario, Clock::time_point time) noexcept;
+
+  /**
+   * Declare that the given source does not know a vario value.
+   */
+  void PushSilence(unsigned source, Clock::time_point time) noexcept;
+
+  /**
+   * Obtain the most recent value, if it was not read already.  Must
+   * only be called by one thread.
+   *
+   * @return true if a new value was stored in #sample
+   */
+  bool Read(Sample &sample) noexcept;
+
+private:
+  void PushRaw(unsigned source, int16_t ivario,
+               Clock::time_point time) noexcept;
+};
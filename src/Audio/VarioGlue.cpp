@@ -6,6 +6,7 @@
 #include "PCMPlayerFactory.hpp"
 #include "VarioSynthesiser.hpp"
 #include "VarioSettings.hpp"
+#include "LatencyTrace.hpp"
 
 #ifdef ANDROID
 #include "SLES/Init.hpp"
@@ -22,6 +23,21 @@ static bool have_sles;
 static PCMPlayer *player;
 static VarioSynthesiser *synthesiser;
 
+/**
+ * Records the delay between the receipt of a vario value and its
+ * first audio buffer in #LatencyTrace.
+ */
+class VarioLatencyListener final : public VarioSynthesiser::Listener {
+public:
+  void OnVarioSynthesised(VarioChannel::Clock::time_point received,
+                          VarioChannel::Clock::time_point begin,
+                          VarioChannel::Clock::time_point end) noexcept override {
+    LatencyTrace::Record(LatencyTrace::Stage::AUDIO, begin, end, received);
+  }
+};
+
+static VarioLatencyListener latency_listener;
+
 bool
 AudioVarioGlue::HaveAudioVario()
 {
@@ -46,6 +62,7 @@ AudioVarioGlue::Initialise()
 
   player = PCMPlayerFactory::CreateInstance();
   synthesiser = new VarioSynthesiser(sample_rate);
+  synthesiser->SetListener(&latency_listener);
 }
 
 void
@@ -81,7 +98,15 @@ AudioVarioGlue::Configure(const VarioSoundSettings &settings)
 }
 
 void
-AudioVarioGlue::SetValue(double vario)
+AudioVarioGlue::SetValue(double vario,
+                         std::chrono::steady_clock::time_point received)
+{
+  SetDeviceValue(VarioChannel::MERGED, vario, received);
+}
+
+void
+AudioVarioGlue::SetDeviceValue(unsigned device, double vario,
+                               std::chrono::steady_clock::time_point received)
 {
 #ifdef ANDROID
   if (!have_sles)
@@ -91,11 +116,11 @@ AudioVarioGlue::SetValue(double vario)
   assert(player != nullptr);
   assert(synthesiser != nullptr);
 
-  synthesiser->SetVario(vario);
+  synthesiser->GetChannel().Push(device, vario, received);
 }
 
 void
-AudioVarioGlue::NoValue()
+AudioVarioGlue::NoValue(std::chrono::steady_clock::time_point received)
 {
 #ifdef ANDROID
   if (!have_sles)
@@ -105,5 +130,5 @@ AudioVarioGlue::NoValue()
   assert(player != nullptr);
   assert(synthesiser != nullptr);
 
-  synthesiser->SetSilence();
+  synthesiser->GetChannel().PushSilence(VarioChannel::MERGED, received);
 }
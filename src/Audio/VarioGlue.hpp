@@ -5,6 +5,8 @@
 
 #include "Features.hpp"
 
+#include <chrono>
+
 struct VarioSoundSettings;
 
 namespace AudioVarioGlue {
@@ -27,18 +29,37 @@ namespace AudioVarioGlue {
   void Configure(const VarioSoundSettings &settings);
 
   /**
-   * Update the vario value.
+   * Update the (merged) vario value.  It is ignored while a device
+   * submits its values with SetDeviceValue().
+   *
+   * This function is thread-safe and lock-free.
    *
    * @param vario the current vario value [m/s]
+   * @param received the time the newest data contributing to this
+   * value was received
+   */
+  void SetValue(double vario, std::chrono::steady_clock::time_point received);
+
+  /**
+   * Submit a vario value directly from a device driver, bypassing
+   * the #MergeThread.  Values from devices with a lower index take
+   * precedence.
+   *
+   * This function is thread-safe and lock-free.
+   *
+   * @param device the device index
+   * @param vario the vario value [m/s]
+   * @param received the time the value was received
    */
-  void SetValue(double vario);
+  void SetDeviceValue(unsigned device, double vario,
+                      std::chrono::steady_clock::time_point received);
 
   /**
    * Declare that no vario value is known (e.g. when connection to all
    * devices is lost).  Vario sound will be shut off until vario
    * reception is back.
    */
-  void NoValue();
+  void NoValue(std::chrono::steady_clock::time_point received);
 
   /**
    * Is the audio vario platform available on this platform?
@@ -50,8 +71,12 @@ namespace AudioVarioGlue {
   static inline void Initialise() {}
   static inline void Deinitialise() {}
   static inline void Configure([[maybe_unused]] const VarioSoundSettings &settings) {}
-  static inline void SetValue([[maybe_unused]] double vario) {}
-  static inline void NoValue() {}
+  static inline void SetValue([[maybe_unused]] double vario,
+                              [[maybe_unused]] std::chrono::steady_clock::time_point received) {}
+  static inline void SetDeviceValue([[maybe_unused]] unsigned device,
+                                    [[maybe_unused]] double vario,
+                                    [[maybe_unused]] std::chrono::steady_clock::time_point received) {}
+  static inline void NoValue([[maybe_unused]] std::chrono::steady_clock::time_point received) {}
   static inline bool HaveAudioVario() { return false; }
 #endif
 };
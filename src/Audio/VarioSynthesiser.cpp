@@ -22,11 +22,9 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 }
 
 void
-VarioSynthesiser::SetVario(double vario)
+VarioSynthesiser::UnsafeSetVario(int ivario, size_t n) noexcept
 {
-  const std::lock_guard lock{mutex};
-
-  const int ivario = std::clamp((int)(vario * 100), min_vario, max_vario);
+  ivario = std::clamp(ivario, min_vario, max_vario);
 
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
@@ -34,8 +32,16 @@ VarioSynthesiser::SetVario(double vario)
     return;
   }
 
-  /* update the ToneSynthesiser base class */
-  SetTone(VarioToFrequency(ivario));
+  const bool was_silent = audible_count == 0;
+
+  /* update the ToneSynthesiser base class; don't glide from a tone
+     which has not been audible */
+  if (was_silent) {
+    FinishGlide();
+    frequency = VarioToFrequency(ivario);
+    SetTone(frequency);
+  } else
+    StartGlide(VarioToFrequency(ivario), n);
 
   if (ivario > 0) {
     /* while climbing, the vario sound gets interrupted by silence
@@ -64,16 +70,11 @@ VarioSynthesiser::SetVario(double vario)
   }
 }
 
-void
-VarioSynthesiser::SetSilence()
-{
-  const std::lock_guard lock{mutex};
-  UnsafeSetSilence();
-}
-
 void
 VarioSynthesiser::UnsafeSetSilence()
 {
+  FinishGlide();
+
   audible_count = 0;
   silence_count = 1;
 
@@ -86,17 +87,90 @@ VarioSynthesiser::UnsafeSetSilence()
   silence_remaining = 0;
 }
 
+void
+VarioSynthesiser::StartGlide(unsigned new_frequency, size_t n) noexcept
+{
+  if (new_frequency == frequency || n == 0) {
+    FinishGlide();
+    frequency = new_frequency;
+    SetTone(frequency);
+    return;
+  }
+
+  glide_from = frequency;
+  glide_to = new_frequency;
+  glide_length = glide_remaining = std::min(n, size_t(sample_rate / 20));
+}
+
+void
+VarioSynthesiser::FinishGlide() noexcept
+{
+  if (glide_remaining == 0)
+    return;
+
+  glide_remaining = 0;
+  frequency = glide_to;
+  SetTone(frequency);
+}
+
+void
+VarioSynthesiser::SynthesiseTone(int16_t *buffer, size_t n) noexcept
+{
+  /* the number of samples per glide step */
+  static constexpr size_t GLIDE_STEP = 64;
+
+  while (glide_remaining > 0 && n > 0) {
+    /* calculate the frequency at the end of this step, so the glide
+       ends exactly at the target frequency */
+    const size_t o = std::min({n, glide_remaining, GLIDE_STEP});
+    glide_remaining -= o;
+
+    const size_t done = glide_length - glide_remaining;
+    frequency = (unsigned)((int)glide_from +
+                           ((int)glide_to - (int)glide_from) * (int)done
+                           / (int)glide_length);
+    SetTone(frequency);
+
+    ToneSynthesiser::Synthesise(buffer, o);
+    buffer += o;
+    n -= o;
+  }
+
+  if (n > 0)
+    ToneSynthesiser::Synthesise(buffer, n);
+}
 
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
+  const auto begin = VarioChannel::Clock::now();
+
   const std::lock_guard lock{mutex};
 
+  VarioChannel::Sample sample;
+  const bool updated = channel.Read(sample);
+  if (updated) {
+    if (sample.silence)
+      UnsafeSetSilence();
+    else
+      UnsafeSetVario(sample.ivario, n);
+  }
+
+  SynthesiseBuffer(buffer, n);
+
+  if (updated && listener != nullptr)
+    listener->OnVarioSynthesised(sample.time, begin,
+                                 VarioChannel::Clock::now());
+}
+
+inline void
+VarioSynthesiser::SynthesiseBuffer(int16_t *buffer, size_t n) noexcept
+{
   assert(audible_count > 0 || silence_count > 0);
 
   if (silence_count == 0) {
     /* magic value for "continuous tone" */
-    ToneSynthesiser::Synthesise(buffer, n);
+    SynthesiseTone(buffer, n);
     return;
   }
 
@@ -107,7 +181,7 @@ VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
       unsigned o = silence_count > 0
         ? std::min(n, audible_remaining)
         : n;
-      ToneSynthesiser::Synthesise(buffer, o);
+      SynthesiseTone(buffer, o);
       buffer += o;
       n -= o;
       audible_remaining -= o;
@@ -120,7 +194,9 @@ VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
           Restart();
       }
     } else if (silence_remaining > 0) {
-      /* generate a period of silence (climbing) */
+      /* generate a period of silence (climbing); the glide is not
+         audible now, so skip it */
+      FinishGlide();
 
       unsigned o = audible_count > 0
         ? std::min(n, silence_remaining)
@@ -4,15 +4,45 @@
 #pragma once
 
 #include "ToneSynthesiser.hpp"
+#include "VarioChannel.hpp"
 #include "thread/Mutex.hxx"
 
 /**
  * This class generates vario sound.
+ *
+ * The vario value is submitted through a #VarioChannel and is picked
+ * up at the beginning of each audio buffer; the tone frequency glides
+ * to the new value within that buffer.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
+public:
+  /**
+   * An instrumentation hook, invoked in the audio thread.
+   */
+  class Listener {
+  public:
+    /**
+     * An audio buffer containing a new vario value has been
+     * generated.
+     *
+     * @param received the time the vario value was received
+     * @param begin the time the synthesis of the buffer has begun
+     * @param end the time the synthesis of the buffer was finished
+     */
+    virtual void OnVarioSynthesised(VarioChannel::Clock::time_point received,
+                                    VarioChannel::Clock::time_point begin,
+                                    VarioChannel::Clock::time_point end) noexcept = 0;
+  };
+
+private:
+  VarioChannel channel;
+
+  Listener *listener = nullptr;
+
   /**
    * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * by the settings methods and by Synthesise(); the vario value is
+   * passed without locking through #channel.
    */
   Mutex mutex;
 
@@ -67,6 +97,25 @@ class VarioSynthesiser final : public ToneSynthesiser {
    */
   int min_dead, max_dead;
 
+  /**
+   * The current tone frequency; during a glide, this is the frequency
+   * of the most recent step.
+   */
+  unsigned frequency;
+
+  /**
+   * The frequencies at the beginning and the end of the current
+   * glide.
+   */
+  unsigned glide_from, glide_to;
+
+  /**
+   * The total number of samples of the current glide, and the number
+   * of samples remaining.  If #glide_remaining is zero, then there is
+   * no glide.
+   */
+  size_t glide_length, glide_remaining;
+
 public:
   explicit VarioSynthesiser(unsigned sample_rate)
     :ToneSynthesiser(sample_rate),
@@ -75,25 +124,49 @@ public:
      dead_band_enabled(false),
      min_frequency(200), zero_frequency(500), max_frequency(1500),
      min_period_ms(150), max_period_ms(600),
-     min_dead(-30), max_dead(10) {}
+     min_dead(-30), max_dead(10),
+     frequency(0), glide_from(0), glide_to(0),
+     glide_length(0), glide_remaining(0) {}
+
+  /**
+   * Returns the channel which feeds vario values to this object.
+   * Its methods may be called from any thread.
+   */
+  VarioChannel &GetChannel() noexcept {
+    return channel;
+  }
+
+  /**
+   * Install an instrumentation hook.  Must be called before the
+   * synthesiser is started.
+   */
+  void SetListener(Listener *_listener) noexcept {
+    listener = _listener;
+  }
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The new tone frequency and the new
+   * "silence" rate (for positive vario values) will be applied by
+   * the next Synthesise() call.
    *
    * @param vario the current vario value [m/s]
    */
-  void SetVario(double vario);
+  void SetVario(double vario) noexcept {
+    channel.Push(VarioChannel::MERGED, vario, VarioChannel::Clock::now());
+  }
 
   /**
    * Produce silence from now on.
    */
-  void SetSilence();
+  void SetSilence() noexcept {
+    channel.PushSilence(VarioChannel::MERGED, VarioChannel::Clock::now());
+  }
 
   /**
    * Enable/disable the dead band silence
    */
   void SetDeadBand(bool enabled) {
+    const std::lock_guard lock{mutex};
     dead_band_enabled = enabled;
   }
 
@@ -101,6 +174,7 @@ public:
    * Set the base frequencies for minimum, zero and maximum lift
    */
   void SetFrequencies(unsigned min, unsigned zero, unsigned max) {
+    const std::lock_guard lock{mutex};
     min_frequency = min;
     zero_frequency = zero;
     max_frequency = max;
@@ -110,6 +184,7 @@ public:
    * Set the time periods for minimum and maximum lift
    */
   void SetPeriods(unsigned min, unsigned max) {
+    const std::lock_guard lock{mutex};
     min_period_ms = min;
     max_period_ms = max;
   }
@@ -118,6 +193,7 @@ public:
    * Set the vario range of the "dead band" during which no sound is emitted
    */
   void SetDeadBandRange(double min, double max) {
+    const std::lock_guard lock{mutex};
     min_dead = (int)(min * 100);
     max_dead = (int)(max * 100);
   }
@@ -127,10 +203,42 @@ public:
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply a new vario value.  This calculates a new tone frequency
+   * and a new "silence" rate.
+   *
+   * @param ivario the current vario value [cm/s]
+   * @param n the size of the current buffer, i.e. the number of
+   * samples to glide to the new frequency
+   */
+  void UnsafeSetVario(int ivario, size_t n) noexcept;
+
+  /**
+   * Same as SetSilence(), but doesn't lock the mutex and applies
+   * the change immediately.
    */
   void UnsafeSetSilence();
 
+  /**
+   * Glide from the current frequency to the given one during the
+   * next #n audible samples.
+   */
+  void StartGlide(unsigned new_frequency, size_t n) noexcept;
+
+  /**
+   * Skip the rest of the current glide.
+   */
+  void FinishGlide() noexcept;
+
+  /**
+   * Generate audible tone, advancing the current glide.
+   */
+  void SynthesiseTone(int16_t *buffer, size_t n) noexcept;
+
+  /**
+   * Generate the buffer from the current parameters.
+   */
+  void SynthesiseBuffer(int16_t *buffer, size_t n) noexcept;
+
   /**
    * Convert a vario value to a tone frequency.
    *
@@ -8,6 +8,7 @@
 struct PolarSettings;
 class Logger;
 class NMEALogger;
+class SensorRecorder;
 class GlueFlightLogger;
 class MultipleDevices;
 class DeviceBlackboard;
@@ -26,6 +27,7 @@ class Replay;
 struct BackendComponents {
   std::unique_ptr<Logger> igc_logger;
   std::unique_ptr<NMEALogger> nmea_logger;
+  std::unique_ptr<SensorRecorder> sensor_recorder;
   std::unique_ptr<GlueFlightLogger> flight_logger;
 
   const std::unique_ptr<DeviceBlackboard> device_blackboard;
@@ -5,6 +5,7 @@
 
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
+#include "FLARM/List.hpp"
 
 /**
  * Base class for blackboards, providing read access to NMEA_INFO and DERIVED_INFO
@@ -15,7 +16,24 @@ protected:
   MoreData gps_info;
   DerivedInfo calculated_info;
 
+  /**
+   * The FLARM traffic.  It is kept separately from #gps_info because
+   * it is too large to be copied with each #NMEAInfo.
+   */
+  TrafficList traffic;
+
+  /**
+   * Incremented each time #traffic changes.  A reader which has
+   * copied #traffic already may skip the copy while this number is
+   * unchanged.
+   */
+  unsigned traffic_version = 0;
+
 public:
+  BaseBlackboard() noexcept {
+    traffic.Clear();
+  }
+
   // all blackboards can be read as const
   constexpr const MoreData &Basic() const noexcept {
     return gps_info;
@@ -24,4 +42,29 @@ public:
   constexpr const DerivedInfo& Calculated() const noexcept {
     return calculated_info;
   }
+
+  constexpr const TrafficList &Traffic() const noexcept {
+    return traffic;
+  }
+
+  constexpr unsigned GetTrafficVersion() const noexcept {
+    return traffic_version;
+  }
+
+protected:
+  /**
+   * Copy the traffic from another blackboard, unless this one has
+   * that version already.
+   *
+   * @param version the version number of @a src
+   * @return true if the traffic was copied
+   */
+  bool CopyTraffic(const TrafficList &src, unsigned version) noexcept {
+    if (version == traffic_version)
+      return false;
+
+    traffic.CopyFrom(src);
+    traffic_version = version;
+    return true;
+  }
 };
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "NMEA/Derived.hpp"
+#include "thread/SnapshotBuffer.hpp"
+
+/**
+ * Lock-free publication of #DerivedInfo from the CalculationThread.
+ * The readers are the UI thread, the DrawThread and the MergeThread;
+ * two more slots guarantee that the writer always finds a free one.
+ */
+using CalculatedSnapshot = SnapshotBuffer<DerivedInfo, 5>;
@@ -5,6 +5,7 @@
 #include "Protection.hpp"
 #include "Simulator.hpp"
 #include "RadioFrequency.hpp"
+#include "Logger/SensorRecorder.hpp"
 
 #include <algorithm>
 
@@ -26,6 +27,11 @@ DeviceBlackboard::DeviceBlackboard() noexcept
 
   real_data = simulator_data = replay_data = gps_info;
 
+  for (auto &i : per_device_traffic)
+    i.Clear();
+  merged_traffic.Clear();
+  replay_traffic.Clear();
+
   simulator.Init(simulator_data);
 
   real_clock.Reset();
@@ -45,6 +51,7 @@ DeviceBlackboard::SetStartupLocation(const GeoPoint &loc,
 {
   const std::lock_guard lock{mutex};
 
+  ReadCalculatedSnapshot();
   if (Calculated().flight.flying)
     return;
 
@@ -72,6 +79,7 @@ DeviceBlackboard::StopReplay() noexcept
   const std::lock_guard lock{mutex};
 
   replay_data.Reset();
+  replay_traffic.Clear();
 
   ScheduleMerge();
 }
@@ -161,13 +169,16 @@ DeviceBlackboard::ExpireWallClock() noexcept
     return;
 
   bool modified = false;
-  for (auto &basic : per_device_data) {
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    NMEAInfo &basic = per_device_data[i];
     if (!basic.alive)
       continue;
 
     basic.ExpireWallClock();
-    if (!basic.alive)
+    if (!basic.alive) {
+      per_device_traffic[i].Clear();
       modified = true;
+    }
   }
 
   if (modified)
@@ -186,21 +197,35 @@ DeviceBlackboard::Merge() noexcept
   NMEAInfo &basic = SetBasic();
 
   real_data.Reset();
-  for (auto &basic : per_device_data) {
+  merged_traffic.Clear();
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    NMEAInfo &basic = per_device_data[i];
     if (!basic.alive)
       continue;
 
     basic.UpdateClock();
     basic.Expire();
     real_data.Complement(basic);
+
+    TrafficList &device_traffic = per_device_traffic[i];
+    device_traffic.Expire(basic.clock);
+    merged_traffic.Complement(device_traffic);
   }
 
+  /* record before WrapClock modifies the time stamps, to replay
+     exactly what the devices delivered */
+  if (sensor_recorder != nullptr && real_data.alive)
+    sensor_recorder->Record(real_data);
+
   real_clock.Normalise(real_data);
 
   if (replay_data.alive) {
     replay_data.Expire();
     basic = replay_data;
 
+    replay_traffic.Expire(replay_data.clock);
+    merged_traffic.CopyFrom(replay_traffic);
+
     /* WrapClock operates on the replay_data copy to avoid feeding
        back BrokenDate modifications to the NMEA parser, as this would
        trigger its time warp checks */
@@ -209,7 +234,21 @@ DeviceBlackboard::Merge() noexcept
     simulator_data.UpdateClock();
     simulator_data.Expire();
     basic = simulator_data;
+    merged_traffic.Clear();
   } else {
     basic = real_data;
   }
+
+  real_data_merged.store(!replay_data.alive && !simulator_data.alive,
+                         std::memory_order_relaxed);
+}
+
+void
+DeviceBlackboard::PublishTraffic() noexcept
+{
+  if (traffic.IsSame(merged_traffic))
+    return;
+
+  traffic.CopyFrom(merged_traffic);
+  ++traffic_version;
 }
@@ -5,16 +5,19 @@
 
 #include "Blackboard/BaseBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
+#include "Blackboard/CalculatedSnapshot.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
 #include "time/WrapClock.hpp"
 
 #include <array>
+#include <atomic>
 
 class AtmosphericPressure;
 class OperationEnvironment;
 class RadioFrequency;
+class SensorRecorder;
 
 /**
  * Blackboard used by com devices: can write NMEA_INFO, reads DERIVED_INFO.
@@ -35,11 +38,23 @@ class DeviceBlackboard
    */
   std::array<NMEAInfo, NUMDEV> per_device_data;
 
+  /**
+   * Traffic from each physical device.  The NMEA parser of each
+   * device writes to it directly.
+   */
+  std::array<TrafficList, NUMDEV> per_device_traffic;
+
   /**
    * Merged data from the physical devices.
    */
   NMEAInfo real_data;
 
+  /**
+   * The traffic chosen by Merge().  FlarmComputer completes it, and
+   * PublishTraffic() copies it to #traffic if it has changed.
+   */
+  TrafficList merged_traffic;
+
   /**
    * Data from simulator.
    */
@@ -50,11 +65,41 @@ class DeviceBlackboard
    */
   NMEAInfo replay_data;
 
+  /**
+   * Traffic from replay.
+   */
+  TrafficList replay_traffic;
+
   /**
    * Clock management for #real_data and #replay_data.
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * The most recent #DerivedInfo published by the CalculationThread.
+   * Unlike #calculated_info, it can be read without locking #mutex.
+   */
+  CalculatedSnapshot calculated_snapshot;
+
+  /**
+   * The CalculatedSnapshot sequence number of #calculated_info.
+   * Protected by #mutex.
+   */
+  uint32_t calculated_sequence = 0;
+
+  /**
+   * If set, then Merge() passes #real_data to it.  Protected by
+   * #mutex.
+   */
+  SensorRecorder *sensor_recorder = nullptr;
+
+  /**
+   * Was #real_data the source of the merged data in the last Merge()
+   * call, i.e. neither replay nor simulator were active?  This can be
+   * read without locking #mutex.
+   */
+  std::atomic<bool> real_data_merged{true};
+
 public:
   Mutex mutex;
 
@@ -69,6 +114,48 @@ public:
    */
   void ReadBlackboard(const DerivedInfo &derived_info) noexcept {
     calculated_info = derived_info;
+    calculated_snapshot.Publish(derived_info);
+    calculated_sequence = calculated_snapshot.GetSequence();
+  }
+
+  /**
+   * Publish new calculated values without locking #mutex.  There must
+   * be only one thread calling this method or ReadBlackboard() at a
+   * time (normally the CalculationThread).
+   *
+   * The values become visible in GetCalculatedSnapshot() immediately
+   * and in Calculated() after the next ReadCalculatedSnapshot() call.
+   */
+  void PublishCalculated(const DerivedInfo &derived_info) noexcept {
+    calculated_snapshot.Publish(derived_info);
+  }
+
+  /**
+   * Access the most recent #DerivedInfo; this does not require
+   * locking #mutex.
+   */
+  const CalculatedSnapshot &GetCalculatedSnapshot() const noexcept {
+    return calculated_snapshot;
+  }
+
+  /**
+   * The #DerivedInfo as of the last ReadCalculatedSnapshot() call.
+   * The MergeThread calls it on each run, but in between, this lags
+   * behind GetCalculatedSnapshot(); callers which need the most
+   * recent values call ReadCalculatedSnapshot() first.  Caller must
+   * lock #mutex.
+   */
+  const DerivedInfo &Calculated() const noexcept {
+    return calculated_info;
+  }
+
+  /**
+   * Copy the most recent snapshot to #calculated_info unless it is
+   * already there.  Caller must lock #mutex.
+   */
+  void ReadCalculatedSnapshot() noexcept {
+    if (calculated_snapshot.GetSequence() != calculated_sequence)
+      calculated_sequence = calculated_snapshot.Read(calculated_info);
   }
 
   /**
@@ -84,6 +171,7 @@ public:
 protected:
   NMEAInfo &SetBasic() noexcept { return gps_info; }
   MoreData &SetMoreData() noexcept { return gps_info; }
+  TrafficList &SetMergedTraffic() noexcept { return merged_traffic; }
 
 public:
   const NMEAInfo &RealState(unsigned i) const noexcept {
@@ -94,6 +182,13 @@ public:
     return per_device_data[i];
   }
 
+  /**
+   * The traffic received by a device.  Caller must lock #mutex.
+   */
+  TrafficList &SetRealTraffic(unsigned i) noexcept {
+    return per_device_traffic[i];
+  }
+
   /**
    * Return a copy of a device's data after updating its clock via
    * NMEAInfo::UpdateClock().  The method takes care for locking and
@@ -118,8 +213,57 @@ public:
     ScheduleMerge();
   }
 
+  /**
+   * Record the merged data of the physical devices with the
+   * specified #SensorRecorder (or stop recording if nullptr is
+   * passed).  Caller must lock #mutex.
+   */
+  void SetSensorRecorder(SensorRecorder *_sensor_recorder) noexcept {
+    sensor_recorder = _sensor_recorder;
+  }
+
+  /**
+   * Is the data from the physical devices being used, i.e. neither
+   * replay nor simulator are active?  This method does not require
+   * locking #mutex.
+   */
+  bool IsRealDataMerged() const noexcept {
+    return real_data_merged.load(std::memory_order_relaxed);
+  }
+
   NMEAInfo &SetSimulatorState() noexcept { return simulator_data; }
   NMEAInfo &SetReplayState() noexcept { return replay_data; }
+  TrafficList &SetReplayTraffic() noexcept { return replay_traffic; }
+
+  /**
+   * Returns the #WrapClock which normalises #replay_data.  Caller
+   * must lock #mutex.
+   */
+  const WrapClock &GetReplayClock() const noexcept {
+    return replay_clock;
+  }
+
+  /**
+   * Replace the replay state after the replay has jumped to a
+   * different point in time, together with the merged and computed
+   * data, so the CalculationThread never sees data from before the
+   * jump.  The replayed traffic is cleared.  Caller must lock
+   * #mutex.
+   *
+   * @param data the new replay state
+   * @param clock the #WrapClock which has normalised @a data
+   * @param basic the result of Merge() and #BasicComputer for @a data
+   */
+  void SeekReplay(const NMEAInfo &data, const WrapClock &clock,
+                  const MoreData &basic) noexcept {
+    replay_data = data;
+    replay_traffic.Clear();
+    replay_clock = clock;
+    gps_info = basic;
+    merged_traffic.Clear();
+    traffic.Clear();
+    ++traffic_version;
+  }
 
 public:
   const NMEAInfo &RealState() const noexcept { return real_data; }
@@ -133,7 +277,8 @@ public:
    */
   [[gnu::pure]]
   bool IsFLARM(unsigned i) const noexcept {
-    return RealState(i).flarm.IsDetected();
+    return RealState(i).flarm.IsDetected() ||
+      !per_device_traffic[i].IsEmpty();
   }
 
   void SetStartupLocation(const GeoPoint &loc, double alt) noexcept;
@@ -162,8 +307,16 @@ public:
   void ScheduleMerge() noexcept;
 
   /**
-   * Copy real_data or simulator_data or replay_data to gps_info.
-   * Caller must lock the blackboard.
+   * Copy real_data or simulator_data or replay_data to gps_info, and
+   * the according traffic to #merged_traffic.  Caller must lock the
+   * blackboard.
    */
   void Merge() noexcept;
+
+  /**
+   * Copy #merged_traffic to #traffic and increment the version
+   * number, unless they are the same already.  Caller must lock the
+   * blackboard.
+   */
+  void PublishTraffic() noexcept;
 };
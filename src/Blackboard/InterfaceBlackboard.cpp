@@ -9,12 +9,25 @@ InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info) n
   calculated_info = derived_info;
 }
 
+void
+InterfaceBlackboard::ReadBlackboardCalculated(const CalculatedSnapshot &snapshot) noexcept
+{
+  snapshot.Read(calculated_info);
+}
+
 void
 InterfaceBlackboard::ReadBlackboardBasic(const MoreData &nmea_info) noexcept
 {
   gps_info = nmea_info;
 }
 
+void
+InterfaceBlackboard::ReadTraffic(const TrafficList &new_traffic,
+                                 unsigned version) noexcept
+{
+  CopyTraffic(new_traffic, version);
+}
+
 void
 InterfaceBlackboard::ReadComputerSettings(const ComputerSettings &settings) noexcept
 {
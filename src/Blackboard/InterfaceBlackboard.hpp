@@ -4,12 +4,16 @@
 #pragma once
 
 #include "LiveBlackboard.hpp"
+#include "CalculatedSnapshot.hpp"
 
 class InterfaceBlackboard : public LiveBlackboard
 {
 public:
   void ReadBlackboardBasic(const MoreData &nmea_info) noexcept;
+  void ReadTraffic(const TrafficList &new_traffic,
+                   unsigned version) noexcept;
   void ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept;
+  void ReadBlackboardCalculated(const CalculatedSnapshot &snapshot) noexcept;
 
   [[gnu::const]]
   SystemSettings &SetSystemSettings() noexcept {
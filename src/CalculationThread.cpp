@@ -6,6 +6,7 @@
 #include "Protection.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Hardware/CPU.hpp"
+#include "LatencyTrace.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -60,15 +61,20 @@ CalculationThread::Tick() noexcept
 #endif
 
   bool gps_updated;
+  LatencyTrace::Clock::time_point origin;
 
   // update and transfer master info to glide computer
   {
     const std::lock_guard lock{device_blackboard.mutex};
 
+    origin = LatencyTrace::GetOrigin(LatencyTrace::Stage::MERGE);
+
     gps_updated = device_blackboard.Basic().location_available.Modified(glide_computer.Basic().location_available);
 
     // Copy data from DeviceBlackboard to GlideComputerBlackboard
     glide_computer.ReadBlackboard(device_blackboard.Basic());
+    glide_computer.ReadTraffic(device_blackboard.Traffic(),
+                               device_blackboard.GetTrafficVersion());
   }
 
   bool force;
@@ -88,17 +94,19 @@ CalculationThread::Tick() noexcept
 
   bool do_idle = false;
 
-  if (gps_updated || force)
+  if (gps_updated || force) {
+    const LatencyTrace::ScopeStage trace{LatencyTrace::Stage::PROCESS_GPS,
+                                         origin};
+
     // perform idle call if time advanced and slow calculations need to be updated
     do_idle |= glide_computer.ProcessGPS(force);
+  }
 
-  // values changed, so copy them back now: ONLY CALCULATED INFO
+  // values changed, so publish them now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
-  // that one back (otherwise we may write over new data)
-  {
-    const std::lock_guard lock{device_blackboard.mutex};
-    device_blackboard.ReadBlackboard(glide_computer.Calculated());
-  }
+  // that one back (otherwise we may write over new data); this does
+  // not lock the DeviceBlackboard, so slow readers cannot delay us
+  device_blackboard.PublishCalculated(glide_computer.Calculated());
 
   // if (new GPS data)
   if (gps_updated || force)
@@ -107,6 +115,8 @@ CalculationThread::Tick() noexcept
 
   if (do_idle) {
     // do slow calculations last, to minimise latency
+    const LatencyTrace::ScopeStage trace{LatencyTrace::Stage::PROCESS_IDLE,
+                                         origin};
     glide_computer.ProcessIdle();
   }
 }
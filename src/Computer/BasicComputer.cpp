@@ -407,3 +407,9 @@ BasicComputer::Compute(MoreData &data,
   ComputeNettoVario(data, calculated);
   ComputeDynamics(data, calculated);
 }
+
+void
+BasicComputer::Resume(const MoreData &last_gps) noexcept
+{
+  ground_speed.Resume(last_gps);
+}
@@ -39,4 +39,10 @@ public:
    */
   void Compute(MoreData &data, const MoreData &last, const MoreData &last_gps,
                const DerivedInfo &calculated) noexcept;
+
+  /**
+   * Continue with the specified GPS fix as the previous one, e.g.
+   * after the calculation state has been restored from a checkpoint.
+   */
+  void Resume(const MoreData &last_gps) noexcept;
 };
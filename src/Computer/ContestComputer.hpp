@@ -5,6 +5,9 @@
 
 #include "Engine/Contest/ContestManager.hpp"
 
+#include <memory>
+#include <optional>
+
 struct ContestSettings;
 struct ContestStatistics;
 class Trace;
@@ -25,6 +28,25 @@ public:
     contest_manager.Reset();
   }
 
+  /**
+   * Copy the state of all solvers, including the searches in
+   * progress.
+   */
+  void SaveCheckpoint(std::optional<ContestManager> &checkpoint) const {
+    checkpoint.emplace(contest_manager);
+  }
+
+  /**
+   * Restore the state saved by SaveCheckpoint().  The traces must
+   * have been restored from the same checkpoint.
+   */
+  void RestoreCheckpoint(const ContestManager &checkpoint) {
+    /* the solvers refer to the traces they were constructed with,
+       which makes them copy-constructible, but not assignable */
+    std::destroy_at(&contest_manager);
+    std::construct_at(&contest_manager, checkpoint);
+  }
+
   /**
    * @see ContestDijkstra::SetPredicted()
    */
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "Events.hpp"
+#include "Blackboard/LiveBlackboard.hpp"
 #include "Input/InputQueue.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
@@ -54,9 +55,10 @@ GlideComputerEvents::OnCalculatedUpdate(const MoreData &basic,
       InputEvents::processGlideComputer(GCE_FLARM_NOTRAFFIC);
     last_traffic = flarm.status.rx;
 
-    if (flarm.traffic.new_traffic.Modified(last_new_traffic)) {
+    const TrafficList &traffic = blackboard.Traffic();
+    if (traffic.new_traffic.Modified(last_new_traffic)) {
       // new traffic has appeared
-      last_new_traffic = flarm.traffic.new_traffic;
+      last_new_traffic = traffic.new_traffic;
       InputEvents::processGlideComputer(GCE_FLARM_NEWTRAFFIC);
     }
   } else
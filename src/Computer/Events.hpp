@@ -6,6 +6,8 @@
 #include "Blackboard/BlackboardListener.hpp"
 #include "NMEA/Validity.hpp"
 
+class LiveBlackboard;
+
 /**
  * This class listens for #LiveBlackboard changes and emits glide
  * computer events.
@@ -13,6 +15,8 @@
  * @see InputEvents::processGlideComputer()
  */
 class GlideComputerEvents final : public NullBlackboardListener {
+  const LiveBlackboard &blackboard;
+
   bool enable_team, last_teammate_in_sector;
 
   bool last_flying;
@@ -23,7 +27,8 @@ class GlideComputerEvents final : public NullBlackboardListener {
   Validity last_new_traffic;
 
 public:
-  GlideComputerEvents():enable_team(false) {}
+  explicit GlideComputerEvents(const LiveBlackboard &_blackboard)
+    :blackboard(_blackboard), enable_team(false) {}
 
   void Reset();
 
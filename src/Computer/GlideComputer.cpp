@@ -9,8 +9,6 @@
 
 using namespace std::chrono;
 
-static PeriodClock last_team_code_update;
-
 GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              const Waypoints &_way_points,
                              Airspaces &_airspace_database,
@@ -18,7 +16,8 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              GlideComputerTaskEvents& events)
   :air_data_computer(_way_points),
    warning_computer(_settings.airspace.warnings, _airspace_database),
-   task_computer(task, _airspace_database, &warning_computer.GetManager()),
+   task_computer(task, _way_points, _airspace_database,
+                 &warning_computer.GetManager()),
    idle_condition_monitors(warning_computer.GetManager()),
    waypoints(_way_points),
    retrospective(_way_points),
@@ -26,7 +25,19 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
 {
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
-  idle_clock.Update();
+  idle_clock.wall.Update();
+}
+
+bool
+GlideComputer::CheckRateLimit(RateLimiter &clock,
+                              steady_clock::duration duration) noexcept
+{
+  if (!deterministic)
+    return clock.wall.CheckUpdate(duration);
+
+  const MoreData &basic = Basic();
+  return basic.time_available &&
+    clock.gps.CheckAdvance(basic.time, duration);
 }
 
 void
@@ -43,6 +54,35 @@ GlideComputer::ResetFlight(const bool full)
   warning_computer.Reset();
 
   trace_history_time.Reset();
+
+  idle_clock.gps.Reset();
+  team_code_clock.gps.Reset();
+}
+
+void
+GlideComputer::SaveCheckpoint(Checkpoint &checkpoint) const
+{
+  GlideComputerBlackboard::SaveCheckpoint(checkpoint.blackboard);
+  air_data_computer.SaveCheckpoint(checkpoint.air_data);
+  task_computer.SaveCheckpoint(checkpoint.task);
+  checkpoint.stats = stats_computer;
+  checkpoint.cu = cu_computer;
+  checkpoint.retrospective = retrospective.getNearWaypointList();
+  checkpoint.trace_history_time = trace_history_time;
+}
+
+void
+GlideComputer::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+  GlideComputerBlackboard::RestoreCheckpoint(checkpoint.blackboard);
+  air_data_computer.RestoreCheckpoint(checkpoint.air_data);
+  task_computer.RestoreCheckpoint(checkpoint.task);
+  stats_computer = checkpoint.stats;
+  cu_computer = checkpoint.cu;
+  log_computer.Reset();
+  retrospective.Restore(checkpoint.retrospective);
+  warning_computer.Reset();
+  trace_history_time = checkpoint.trace_history_time;
 }
 
 void
@@ -135,7 +175,7 @@ GlideComputer::ProcessGPS(bool force)
   // Update the ConditionMonitors
   condition_monitors.Update(Basic(), Calculated(), settings);
 
-  return idle_clock.CheckUpdate(milliseconds(500));
+  return CheckRateLimit(idle_clock, milliseconds(500));
 }
 
 void
@@ -190,7 +230,7 @@ GlideComputer::CalculateOwnTeamCode()
     return;
 
   // Only calculate every 10sec otherwise cancel calculation
-  if (!last_team_code_update.CheckUpdate(seconds(10)))
+  if (!CheckRateLimit(team_code_clock, seconds(10)))
     return;
 
   // Get bearing and distance to the reference waypoint
@@ -250,7 +290,7 @@ GlideComputer::CalculateTeammateBearingRange()
 
   if (settings.team_flarm_id.IsDefined()) {
     ComputeFlarmTeam(basic.location, team_code_ref_location,
-                     basic.flarm.traffic, settings.team_flarm_id,
+                     Traffic(), settings.team_flarm_id,
                      teamcode_info);
   } else if (settings.team_code.IsDefined()) {
     teamcode_info.flarm_teammate_code.Clear();
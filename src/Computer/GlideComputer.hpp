@@ -5,6 +5,7 @@
 
 #include "GlideComputerBlackboard.hpp"
 #include "time/PeriodClock.hpp"
+#include "time/GPSClock.hpp"
 #include "time/DeltaTime.hpp"
 #include "GlideComputerAirData.hpp"
 #include "StatsComputer.hpp"
@@ -44,7 +45,22 @@ class GlideComputer : public GlideComputerBlackboard
   bool team_code_ref_found;
   GeoPoint team_code_ref_location;
 
-  PeriodClock idle_clock;
+  /**
+   * A rate limiter which uses either the wall clock or the GPS time,
+   * see SetDeterministic().
+   */
+  struct RateLimiter {
+    PeriodClock wall;
+    GPSClock gps;
+  };
+
+  /**
+   * If true, then the rate limiters use the GPS time instead of the
+   * wall clock.
+   */
+  bool deterministic = false;
+
+  RateLimiter idle_clock, team_code_clock;
 
   /**
    * This object is used to check whether to update
@@ -53,6 +69,21 @@ class GlideComputer : public GlideComputerBlackboard
   DeltaTime trace_history_time;
 
 public:
+  /**
+   * A copy of the flight-dependent calculation state, which allows
+   * jumping back to an earlier point of a replay.  Settings, logger,
+   * airspace warnings and condition monitors are not included.
+   */
+  struct Checkpoint {
+    GlideComputerBlackboard::Checkpoint blackboard;
+    GlideComputerAirData::Checkpoint air_data;
+    TaskComputer::Checkpoint task;
+    StatsComputer stats;
+    CuComputer cu;
+    Retrospective::NearWaypointList retrospective;
+    DeltaTime trace_history_time;
+  };
+
   GlideComputer(const ComputerSettings &_settings,
                 const Waypoints &_way_points,
                 Airspaces &_airspace_database,
@@ -65,12 +96,35 @@ public:
     log_computer.SetLogger(logger);
   }
 
+  /**
+   * Let the GPS time instead of the wall clock drive all rate
+   * limiters (e.g. the return value of ProcessGPS()).  This makes the
+   * results independent of the processing speed, which is useful
+   * for replaying as quickly as possible.
+   */
+  void SetDeterministic(bool _deterministic) noexcept {
+    deterministic = _deterministic;
+  }
+
   /**
    * Resets the GlideComputer data
    * @param full Reset all data?
    */
   void ResetFlight(const bool full=true);
 
+  /**
+   * Copy the calculation state.  This must not be called while the
+   * CalculationThread is running.
+   */
+  void SaveCheckpoint(Checkpoint &checkpoint) const;
+
+  /**
+   * Restore the state saved by SaveCheckpoint().  Airspace warnings
+   * are reset.  This must not be called while the CalculationThread
+   * is running.
+   */
+  void RestoreCheckpoint(const Checkpoint &checkpoint);
+
   /**
    * Initializes the GlideComputer
    */
@@ -155,6 +209,12 @@ protected:
   void TakeoffLanding(bool last_flying);
 
 private:
+  /**
+   * Check whether the specified duration has passed since the last
+   * time this method returned true.
+   */
+  bool CheckRateLimit(RateLimiter &clock,
+                      std::chrono::steady_clock::duration duration) noexcept;
 
   /**
    * Fill the cache variable TeamCodeRefLocation.
@@ -56,6 +56,36 @@ GlideComputerAirData::ResetFlight(DerivedInfo &calculated,
   delta_time.Reset();
 }
 
+void
+GlideComputerAirData::SaveCheckpoint(Checkpoint &checkpoint) const
+{
+  checkpoint.gr_computer = gr_computer;
+  checkpoint.flying_computer = flying_computer;
+  checkpoint.circling_computer = circling_computer;
+  checkpoint.wave_computer = wave_computer;
+  checkpoint.thermal_band_computer = thermal_band_computer;
+  checkpoint.wind_computer = wind_computer;
+  checkpoint.lift_database_computer = lift_database_computer;
+  checkpoint.thermallocator = thermallocator;
+  checkpoint.average_vario = average_vario;
+  checkpoint.delta_time = delta_time;
+}
+
+void
+GlideComputerAirData::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+  gr_computer = checkpoint.gr_computer;
+  flying_computer = checkpoint.flying_computer;
+  circling_computer = checkpoint.circling_computer;
+  wave_computer = checkpoint.wave_computer;
+  thermal_band_computer = checkpoint.thermal_band_computer;
+  wind_computer = checkpoint.wind_computer;
+  lift_database_computer = checkpoint.lift_database_computer;
+  thermallocator = checkpoint.thermallocator;
+  average_vario = checkpoint.average_vario;
+  delta_time = checkpoint.delta_time;
+}
+
 void
 GlideComputerAirData::ProcessBasic(const MoreData &basic,
                                    DerivedInfo &calculated,
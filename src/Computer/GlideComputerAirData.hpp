@@ -51,6 +51,24 @@ class GlideComputerAirData {
   DeltaTime delta_time;
 
 public:
+  /**
+   * A copy of the flight-dependent state, see SaveCheckpoint().  The
+   * #AutoQNH state is not included, because it is only relevant
+   * before takeoff.
+   */
+  struct Checkpoint {
+    GlideRatioComputer gr_computer;
+    FlyingComputer flying_computer;
+    CirclingComputer circling_computer;
+    WaveComputer wave_computer;
+    ThermalBandComputer thermal_band_computer;
+    WindComputer wind_computer;
+    LiftDatabaseComputer lift_database_computer;
+    ThermalLocator thermallocator;
+    AverageVarioComputer average_vario;
+    DeltaTime delta_time;
+  };
+
   GlideComputerAirData(const Waypoints &way_points);
 
   void SetTerrain(const RasterTerrain* _terrain) {
@@ -63,6 +81,9 @@ public:
 
   void ResetFlight(DerivedInfo &calculated, const bool full=true);
 
+  void SaveCheckpoint(Checkpoint &checkpoint) const;
+  void RestoreCheckpoint(const Checkpoint &checkpoint);
+
   void ResetStats() {
     circling_computer.ResetStats();
   }
@@ -54,6 +54,22 @@ GlideComputerBlackboard::RestoreFinish()
   calculated_info.flight = flight;
 }
 
+void
+GlideComputerBlackboard::SaveCheckpoint(Checkpoint &checkpoint) const
+{
+  checkpoint.basic = gps_info;
+  checkpoint.calculated = calculated_info;
+  checkpoint.finish = Finish_Derived_Info;
+}
+
+void
+GlideComputerBlackboard::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+  gps_info = checkpoint.basic;
+  calculated_info = checkpoint.calculated;
+  Finish_Derived_Info = checkpoint.finish;
+}
+
 /**
  * Retrieves GPS data from the DeviceBlackboard
  * @param nmea_info New GPS data
@@ -64,6 +80,18 @@ GlideComputerBlackboard::ReadBlackboard(const MoreData &nmea_info)
   gps_info = nmea_info;
 }
 
+/**
+ * Retrieves FLARM traffic from the DeviceBlackboard
+ * @param new_traffic New traffic list
+ * @param version The version number of the traffic list
+ */
+void
+GlideComputerBlackboard::ReadTraffic(const TrafficList &new_traffic,
+                                     unsigned version) noexcept
+{
+  CopyTraffic(new_traffic, version);
+}
+
 /**
  * Retrieves settings from the DeviceBlackboard
  * @param settings New settings
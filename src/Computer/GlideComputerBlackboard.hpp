@@ -17,7 +17,17 @@ class GlideComputerBlackboard:
   DerivedInfo Finish_Derived_Info;
 
 public:
+  /**
+   * A copy of the blackboard state, see SaveCheckpoint().
+   */
+  struct Checkpoint {
+    MoreData basic;
+    DerivedInfo calculated, finish;
+  };
+
   void ReadBlackboard(const MoreData &nmea_info);
+  void ReadTraffic(const TrafficList &new_traffic,
+                   unsigned version) noexcept;
   void ReadComputerSettings(const ComputerSettings &settings);
 
 protected:
@@ -26,6 +36,9 @@ protected:
   void SaveFinish();
   void RestoreFinish();
 
+  void SaveCheckpoint(Checkpoint &checkpoint) const;
+  void RestoreCheckpoint(const Checkpoint &checkpoint);
+
   // only the glide computer can write to calculated
   DerivedInfo& SetCalculated() { return calculated_info; }
 };
@@ -33,3 +33,17 @@ GroundSpeedComputer::Compute(NMEAInfo &basic)
   last_location = basic.location;
   last_location_available = basic.location_available;
 }
+
+void
+GroundSpeedComputer::Resume(const NMEAInfo &last) noexcept
+{
+  delta_time.Reset();
+  last_location_available.Clear();
+
+  if (!last.time_available || !last.location_available)
+    return;
+
+  delta_time.Update(last.time, {}, {});
+  last_location = last.location;
+  last_location_available = last.location_available;
+}
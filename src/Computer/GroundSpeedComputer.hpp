@@ -29,4 +29,10 @@ public:
    * Fill the missing attributes with a fallback.
    */
   void Compute(NMEAInfo &basic);
+
+  /**
+   * Continue with the specified fix as the previous one, e.g. after
+   * the calculation state has been restored from a checkpoint.
+   */
+  void Resume(const NMEAInfo &last) noexcept;
 };
@@ -7,12 +7,16 @@
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Engine/Task/Unordered/AbortTask.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
 
 #include <algorithm>
 
-RouteComputer::RouteComputer(const Airspaces &airspace_database,
+RouteComputer::RouteComputer(const Waypoints &_waypoints,
+                             const Airspaces &airspace_database,
                              const ProtectedAirspaceWarningManager *warnings)
-  :protected_route_planner(route_planner, airspace_database, warnings),
+  :waypoints(_waypoints),
+   protected_route_planner(route_planner, airspace_database, warnings),
    terrain(NULL)
 {}
 
@@ -32,7 +36,8 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                             const GlideSettings &settings,
                             const RoutePlannerConfig &config,
                             const GlidePolar &glide_polar,
-                            const GlidePolar &safety_polar)
+                            const GlidePolar &safety_polar,
+                            const double safety_height_arrival)
 {
   if (!basic.location_available || !basic.NavAltitudeAvailable())
     return;
@@ -42,7 +47,7 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                                     calculated.GetWindOrZero(),
                                     calculated.common_stats.height_min_working);
 
-  Reach(basic, calculated, config);
+  Reach(basic, calculated, config, glide_polar, safety_height_arrival);
   TerrainWarning(basic, calculated, config);
 }
 
@@ -106,7 +111,9 @@ RouteComputer::TerrainWarning(const MoreData &basic,
 
 inline void
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
-                     const RoutePlannerConfig &config)
+                     const RoutePlannerConfig &config,
+                     const GlidePolar &glide_polar,
+                     const double safety_height_arrival)
 {
   if (!calculated.terrain_valid) {
     /* without valid terrain information, we cannot calculate
@@ -124,7 +131,22 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
                                (int)calculated.common_stats.height_max_working));
 
   if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
-    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
+    /* the landables which AbortTask and the map will look up; their
+       arrival heights are calculated in one pass together with the
+       reach */
+    ArrivalTable landables;
+    if (do_solve && glide_polar.IsValid()) {
+      const double range = AbortTask::GetAbortRange(state, glide_polar);
+      waypoints.VisitWithinRange(state.location, range, [&](const auto &wp){
+        if (wp->IsLandable())
+          landables.Add(wp->id,
+                        AGeoPoint(wp->location, wp->GetElevationOrZero()
+                                  + safety_height_arrival));
+      });
+    }
+
+    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve,
+                                       std::move(landables));
 
     if (do_solve) {
       calculated.terrain_base = protected_route_planner.GetTerrainBase();
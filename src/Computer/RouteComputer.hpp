@@ -15,10 +15,13 @@ struct RoutePlannerConfig;
 class ProtectedAirspaceWarningManager;
 class RasterTerrain;
 class GlidePolar;
+class Waypoints;
 
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
 
+  const Waypoints &waypoints;
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
@@ -31,7 +34,8 @@ class RouteComputer {
   unsigned last_active_tp;
 
 public:
-  RouteComputer(const Airspaces &airspace_database,
+  RouteComputer(const Waypoints &_waypoints,
+                const Airspaces &airspace_database,
                 const ProtectedAirspaceWarningManager *warnings);
 
   const ProtectedRoutePlanner &GetProtectedRoutePlanner() const {
@@ -51,7 +55,8 @@ public:
                     const GlideSettings &settings,
                     const RoutePlannerConfig &config,
                     const GlidePolar &glide_polar,
-                    const GlidePolar &safety_polar);
+                    const GlidePolar &safety_polar,
+                    double safety_height_arrival);
 
   void set_terrain(const RasterTerrain* _terrain);
 
@@ -61,5 +66,7 @@ private:
                       const RoutePlannerConfig &config);
 
   void Reach(const MoreData &basic, DerivedInfo &calculated,
-             const RoutePlannerConfig &config);
+             const RoutePlannerConfig &config,
+             const GlidePolar &glide_polar,
+             double safety_height_arrival);
 };
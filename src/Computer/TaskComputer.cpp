@@ -11,6 +11,7 @@
 #include "Settings.hpp"
 
 #include <algorithm>
+#include <cassert>
 
 using std::max;
 using namespace std::chrono;
@@ -19,10 +20,11 @@ using namespace std::chrono;
 // call any event
 
 TaskComputer::TaskComputer(ProtectedTaskManager &_task,
+                           const Waypoints &waypoints,
                            const Airspaces &airspace_database,
                            const ProtectedAirspaceWarningManager *warnings)
   :task(_task),
-   route(airspace_database, warnings),
+   route(waypoints, airspace_database, warnings),
    contest(trace.GetFull(), trace.GetContest(), trace.GetSprint())
 {
   task.SetRoutePlanner(&route.GetProtectedRoutePlanner());
@@ -42,6 +44,43 @@ TaskComputer::ResetFlight([[maybe_unused]] const bool full)
   last_location_available.Clear();
 }
 
+void
+TaskComputer::SaveCheckpoint(Checkpoint &checkpoint) const
+{
+  trace.SaveCheckpoint(checkpoint.trace);
+  contest.SaveCheckpoint(checkpoint.contest);
+
+  {
+    ProtectedTaskManager::Lease _task(task);
+    _task->SaveProgress(checkpoint.task);
+  }
+
+  checkpoint.last_state = last_state;
+  checkpoint.valid_last_state = valid_last_state;
+  checkpoint.last_flying = last_flying;
+  checkpoint.last_location_available = last_location_available;
+}
+
+void
+TaskComputer::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+  {
+    ProtectedTaskManager::ExclusiveLease _task(task);
+    _task->RestoreProgress(checkpoint.task);
+  }
+
+  route.ResetFlight();
+  trace.RestoreCheckpoint(checkpoint.trace);
+
+  assert(checkpoint.contest);
+  contest.RestoreCheckpoint(*checkpoint.contest);
+
+  last_state = checkpoint.last_state;
+  valid_last_state = checkpoint.valid_last_state;
+  last_flying = checkpoint.last_flying;
+  last_location_available = checkpoint.last_location_available;
+}
+
 void
 TaskComputer::ProcessBasicTask(const MoreData &basic,
                                DerivedInfo &calculated,
@@ -92,7 +131,8 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
   route.ProcessRoute(basic, calculated,
                      settings_computer.task.glide,
                      settings_computer.task.route_planner,
-                     glide_polar, safety_polar);
+                     glide_polar, safety_polar,
+                     settings_computer.task.safety_height_arrival);
 
   if (settings_computer.features.block_stf_enabled)
     calculated.V_stf = calculated.common_stats.V_block;
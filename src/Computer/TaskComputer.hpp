@@ -7,6 +7,7 @@
 #include "TraceComputer.hpp"
 #include "ContestComputer.hpp"
 #include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/TaskProgress.hpp"
 #include "NMEA/Validity.hpp"
 
 struct NMEAInfo;
@@ -31,7 +32,24 @@ class TaskComputer
   Validity last_location_available;
 
 public:
+  /**
+   * A copy of the flight-dependent state, see SaveCheckpoint().
+   */
+  struct Checkpoint {
+    TraceComputer::Checkpoint trace;
+    std::optional<ContestManager> contest;
+    TaskProgress task;
+
+    AircraftState last_state;
+    bool valid_last_state;
+
+    bool last_flying;
+
+    Validity last_location_available;
+  };
+
   TaskComputer(ProtectedTaskManager &_task,
+               const Waypoints &waypoints,
                const Airspaces &airspace_database,
                const ProtectedAirspaceWarningManager *warnings);
 
@@ -70,6 +88,13 @@ public:
 
   void ResetFlight(const bool full=true);
 
+  void SaveCheckpoint(Checkpoint &checkpoint) const;
+
+  /**
+   * Restore the state saved by SaveCheckpoint().
+   */
+  void RestoreCheckpoint(const Checkpoint &checkpoint);
+
   void SetTerrain(const RasterTerrain* _terrain);
 
   void SetContestIncremental(bool incremental) {
@@ -6,6 +6,8 @@
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 
+#include <cassert>
+
 static constexpr unsigned full_trace_size = 1024;
 static constexpr unsigned contest_trace_size = 256;
 static constexpr unsigned sprint_trace_size = 128;
@@ -13,9 +15,9 @@ static constexpr unsigned sprint_trace_size = 128;
 static constexpr auto full_trace_no_thin_time = std::chrono::minutes{2};
 
 TraceComputer::TraceComputer()
- :full(full_trace_no_thin_time, Trace::null_time, full_trace_size),
-  contest({}, Trace::null_time, contest_trace_size),
-  sprint({}, std::chrono::minutes{150}, sprint_trace_size)
+ :full(store, full_trace_no_thin_time, Trace::null_time, full_trace_size),
+  contest(store, {}, Trace::null_time, contest_trace_size),
+  sprint(store, {}, std::chrono::minutes{150}, sprint_trace_size)
 {
 }
 
@@ -25,12 +27,65 @@ TraceComputer::Reset()
   {
     const std::lock_guard lock{mutex};
     full.clear();
+    ++full_serial;
   }
 
   contest.clear();
   sprint.clear();
 }
 
+static void
+Save(const Trace &trace, TraceComputer::Checkpoint::Points &points) noexcept
+{
+  trace.GetPoints(points.points);
+  points.append_serial = trace.GetAppendSerial();
+  points.modify_serial = trace.GetModifySerial();
+}
+
+void
+TraceComputer::SaveCheckpoint(Checkpoint &checkpoint) const
+{
+  Save(full, checkpoint.full);
+  Save(contest, checkpoint.contest);
+  Save(sprint, checkpoint.sprint);
+}
+
+static void
+Restore(Trace &trace, const TraceComputer::Checkpoint::Points &points) noexcept
+{
+  assert(trace.empty());
+
+  for (const auto &i : points.points)
+    trace.push_back(i);
+
+  trace.RestoreSerials(points.append_serial, points.modify_serial);
+}
+
+void
+TraceComputer::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+  /* clear all traces before refilling any of them: this empties the
+     shared store, so the first restored point becomes the origin of
+     its projection, as if the flight had been replayed */
+  Reset();
+
+  {
+    const std::lock_guard lock{mutex};
+    Restore(full, checkpoint.full);
+    ++full_serial;
+  }
+
+  Restore(contest, checkpoint.contest);
+  Restore(sprint, checkpoint.sprint);
+}
+
+Serial
+TraceComputer::LockedGetSerial() const
+{
+  const std::lock_guard lock{mutex};
+  return full_serial;
+}
+
 void
 TraceComputer::LockedCopyTo(TracePointVector &v) const
 {
@@ -64,6 +119,7 @@ TraceComputer::Update(const ComputerSettings &settings_computer,
   {
     const std::lock_guard lock{mutex};
     full.push_back(point);
+    ++full_serial;
   }
 
   // only contest requires trace_sprint
@@ -5,6 +5,8 @@
 
 #include "thread/Mutex.hxx"
 #include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "util/Serial.hpp"
 
 struct ComputerSettings;
 struct MoreData;
@@ -21,9 +23,38 @@ class TraceComputer {
    */
   mutable Mutex mutex;
 
+  /**
+   * The points of all three traces.  Most points are contained in
+   * more than one of them; this way, they are stored only once.
+   *
+   * Only #full is protected by #mutex.  #contest and #sprint modify
+   * the store without holding the lock, but they only allocate and
+   * free nodes which are not in #full, and they change only the
+   * reference counters of nodes shared with it, which readers of
+   * #full never access.
+   */
+  TracePointStore store;
+
   Trace full, contest, sprint;
 
+  /**
+   * Incremented each time #full is modified.  Protected by #mutex.
+   */
+  Serial full_serial;
+
 public:
+  /**
+   * A copy of the trace points, see SaveCheckpoint().
+   */
+  struct Checkpoint {
+    struct Points {
+      TracePointVector points;
+      Serial append_serial, modify_serial;
+    };
+
+    Points full, contest, sprint;
+  };
+
   TraceComputer();
 
   operator Mutex &() const {
@@ -56,6 +87,22 @@ public:
 
   void Reset();
 
+  void SaveCheckpoint(Checkpoint &checkpoint) const;
+
+  /**
+   * Replace the traces with the points of a checkpoint.  The points
+   * are appended again, which means the thinning may differ slightly
+   * from the original traces.
+   */
+  void RestoreCheckpoint(const Checkpoint &checkpoint);
+
+  /**
+   * Returns a #Serial which changes each time the full trace is
+   * modified.  The trace is locked, and the method may be called from
+   * any thread.
+   */
+  Serial LockedGetSerial() const;
+
   /**
    * Extract all trace points.  The trace is locked, and the method
    * may be called from any thread.
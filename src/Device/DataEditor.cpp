@@ -7,7 +7,8 @@
 DeviceDataEditor::DeviceDataEditor(DeviceBlackboard &_blackboard,
                                    std::size_t idx) noexcept
   :blackboard(_blackboard), lock(blackboard.mutex),
-   basic(blackboard.SetRealState(idx)) {}
+   basic(blackboard.SetRealState(idx)),
+   traffic(blackboard.SetRealTraffic(idx)) {}
 
 void
 DeviceDataEditor::Commit() const noexcept
@@ -7,6 +7,7 @@
 
 class DeviceBlackboard;
 struct NMEAInfo;
+struct TrafficList;
 
 class DeviceDataEditor {
   DeviceBlackboard &blackboard;
@@ -15,6 +16,8 @@ class DeviceDataEditor {
 
   NMEAInfo &basic;
 
+  TrafficList &traffic;
+
 public:
   DeviceDataEditor(DeviceBlackboard &blackboard,
                    std::size_t idx) noexcept;
@@ -28,4 +31,11 @@ public:
   NMEAInfo &operator*() const noexcept {
     return basic;
   }
+
+  /**
+   * The device's FLARM traffic, which is not part of #NMEAInfo.
+   */
+  TrafficList &GetTraffic() const noexcept {
+    return traffic;
+  }
 };
@@ -26,6 +26,8 @@
 #include "../Simulator.hpp"
 #include "Input/InputQueue.hpp"
 #include "LogFile.hpp"
+#include "LatencyTrace.hpp"
+#include "Audio/VarioGlue.hpp"
 #include "Job/Job.hpp"
 
 #ifdef ANDROID
@@ -65,6 +67,7 @@ DeviceDescriptor::DeviceDescriptor(DeviceBlackboard &_blackboard,
    port_listener(_port_listener)
 {
   config.Clear();
+  parser.SetTraffic(&blackboard.SetRealTraffic(index));
 }
 
 DeviceDescriptor::~DeviceDescriptor() noexcept
@@ -186,6 +189,7 @@ try {
   {
     const auto e = BeginEdit();
     e->Reset();
+    e.GetTraffic().Clear();
     e.Commit();
   }
 
@@ -524,6 +528,7 @@ DeviceDescriptor::Close() noexcept
   {
     const auto e = BeginEdit();
     e->Reset();
+    e.GetTraffic().Clear();
     e.Commit();
   }
 
@@ -1312,9 +1317,11 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
 
   // Pass data directly to drivers that use binary data protocols
   if (driver != nullptr && device != nullptr && driver->UsesRawData()) {
+    const auto received = std::chrono::steady_clock::now();
     auto basic = blackboard.LockGetDeviceDataUpdateClock(index);
 
     const ExternalSettings old_settings = basic.settings;
+    const Validity old_vario = basic.total_energy_vario_available;
 
     /* call Device::DataReceived() without holding
        DeviceBlackboard::mutex to avoid blocking all other threads */
@@ -1322,6 +1329,8 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
+      SubmitVario(basic, old_vario, received);
+
       blackboard.LockSetDeviceDataScheduleMerge(index, basic);
     }
 
@@ -1334,9 +1343,25 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
   return true;
 }
 
+inline void
+DeviceDescriptor::SubmitVario(const NMEAInfo &basic, Validity old_vario,
+                              std::chrono::steady_clock::time_point received) const noexcept
+{
+  /* pass new vario values to the audio vario right away, without
+     waiting for the MergeThread; not during replay or in simulator
+     mode, because then the MergeThread submits the replayed or
+     simulated values, which must not be overridden by a connected
+     device */
+  if (basic.total_energy_vario_available.Modified(old_vario) &&
+      blackboard.IsRealDataMerged())
+    AudioVarioGlue::SetDeviceValue(index, basic.total_energy_vario, received);
+}
+
 bool
 DeviceDescriptor::LineReceived(const char *line) noexcept
 {
+  const LatencyTrace::ScopeStage trace{LatencyTrace::Stage::NMEA_LINE};
+
   if (nmea_logger != nullptr)
     nmea_logger->Log(line);
 
@@ -1345,7 +1370,9 @@ DeviceDescriptor::LineReceived(const char *line) noexcept
 
   const auto e = BeginEdit();
   e->UpdateClock();
+  const Validity old_vario = e->total_energy_vario_available;
   ParseNMEA(line, *e);
+  SubmitVario(*e, old_vario, trace.GetBegin());
   e.Commit();
 
   return true;
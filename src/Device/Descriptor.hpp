@@ -58,6 +58,7 @@ class RecordedFlightList;
 struct RecordedFlightInfo;
 class OperationEnvironment;
 class OpenDeviceJob;
+class Validity;
 class DeviceDataEditor;
 class DeviceFactory;
 
@@ -514,6 +515,16 @@ public:
 private:
   bool ParseNMEA(const char *line, struct NMEAInfo &info) noexcept;
 
+  /**
+   * Submit the total energy vario value to the audio vario if the
+   * driver has just updated it.
+   *
+   * @param old_vario the vario validity before the driver has parsed
+   * the new data
+   */
+  void SubmitVario(const NMEAInfo &basic, Validity old_vario,
+                   std::chrono::steady_clock::time_point received) const noexcept;
+
 public:
   void SetMonitor(DataHandler  *_monitor) noexcept {
     monitor = _monitor;
@@ -8,6 +8,7 @@
 #include "NMEA/InputLine.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
+#include "FLARM/List.hpp"
 #include "util/CharUtil.hxx"
 #include "util/NumberParser.hxx"
 #include "util/StringSplit.hxx"
@@ -86,7 +87,10 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
     }
 
     if (type2 == "PFLAA"sv) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
+      if (traffic == nullptr)
+        return false;
+
+      ParsePFLAA(line, *traffic, info.clock);
       return true;
     }
 
@@ -639,7 +643,8 @@ NMEAParser::RMZ(NMEAInputLine &line, NMEAInfo &info)
   double value;
   if (ReadAltitude(line, value)) {
     // JMW no in-built baro sources, so use this generic one
-    if (info.flarm.IsDetected()) {
+    if (info.flarm.IsDetected() ||
+        (traffic != nullptr && !traffic->IsEmpty())) {
       /* FLARM emulates the Garmin $PGRMZ sentence, but emits the
          altitude above 1013.25 hPa - since the don't have a "FLARM"
          device driver, we use the auto-detected "isFlarm" flag
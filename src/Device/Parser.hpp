@@ -6,6 +6,7 @@
 #include "time/Stamp.hpp"
 
 struct NMEAInfo;
+struct TrafficList;
 class NMEAInputLine;
 struct GeoPoint;
 struct BrokenDate;
@@ -15,6 +16,13 @@ class NMEAParser
 {
   TimeStamp last_time;
 
+  /**
+   * The FLARM traffic received by ParseLine() is stored here.  It is
+   * not part of #NMEAInfo because it is too large.  If this is
+   * nullptr, then traffic is ignored.
+   */
+  TrafficList *traffic = nullptr;
+
 public:
   bool real;
 
@@ -36,6 +44,15 @@ public:
     use_geoid = false;
   }
 
+  /**
+   * Set the #TrafficList which receives FLARM traffic; it is not
+   * affected by Reset().  It must be protected by the same lock as
+   * the #NMEAInfo passed to ParseLine().
+   */
+  void SetTraffic(TrafficList *_traffic) noexcept {
+    traffic = _traffic;
+  }
+
   /**
    * Parses a provided NMEA String into a NMEA_INFO struct
    * @param line NMEA string
@@ -28,12 +28,14 @@ public:
   void CreateButtons(WidgetDialog &dialog) noexcept {
     dialog.AddButton(_("Start"), [this](){ OnStartClicked(); });
     dialog.AddButton(_("Stop"), [this](){ OnStopClicked(); });
+    dialog.AddButton(_T("-10'"), [this](){ OnRewindClicked(); });
     dialog.AddButton(_T("+10'"), [this](){ OnFastForwardClicked(); });
   }
 
 private:
   void OnStopClicked() noexcept;
   void OnStartClicked() noexcept;
+  void OnRewindClicked() noexcept;
   void OnFastForwardClicked() noexcept;
 
 public:
@@ -47,9 +49,9 @@ ReplayControlWidget::Prepare([[maybe_unused]] ContainerWindow &parent,
                              [[maybe_unused]] const PixelRect &rc) noexcept
 {
   AddFile(_("File"),
-          _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea), or if blank, runs the demo."),
+          _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea), a sensor recording (.xsr), or if blank, runs the demo."),
           {},
-          _T("*.nmea\0*.igc\0"),
+          _T("*.nmea\0*.igc\0*.xsr\0"),
           true);
   LoadValue(FILE, replay.GetFilename());
 
@@ -80,6 +82,20 @@ ReplayControlWidget::OnStartClicked() noexcept
   }
 }
 
+inline void
+ReplayControlWidget::OnRewindClicked() noexcept
+{
+  const TimeStamp virtual_time = replay.GetVirtualTime();
+  if (!virtual_time.IsDefined())
+    return;
+
+  try {
+    replay.Seek(virtual_time - std::chrono::minutes{10});
+  } catch (...) {
+    ShowError(std::current_exception(), _("Replay"));
+  }
+}
+
 inline void
 ReplayControlWidget::OnFastForwardClicked() noexcept
 {
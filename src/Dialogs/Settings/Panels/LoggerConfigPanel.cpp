@@ -24,6 +24,7 @@ enum ControlIndex {
   LoggerTimeStepCircling,
   DisableAutoLogger,
   EnableNMEALogger,
+  EnableSensorRecorder,
   EnableFlightLogger,
   LoggerID,
 };
@@ -86,6 +87,12 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent,
              logger.enable_nmea_logger);
   SetExpertRow(EnableNMEALogger);
 
+  AddBoolean(_("Sensor recorder"),
+             _("Record the data of all devices in a compact binary file, "
+               "which can be replayed and searched quickly."),
+             logger.enable_sensor_recorder);
+  SetExpertRow(EnableSensorRecorder);
+
   AddBoolean(_("Log book"), _("Logs each start and landing."),
              logger.enable_flight_logger);
   SetExpertRow(EnableFlightLogger);
@@ -125,6 +132,14 @@ LoggerConfigPanel::Save(bool &changed) noexcept
   if (logger.enable_nmea_logger && backend_components->nmea_logger != nullptr)
     backend_components->nmea_logger->Enable();
 
+  if (SaveValue(EnableSensorRecorder, ProfileKeys::EnableSensorRecorder,
+                logger.enable_sensor_recorder)) {
+    changed = true;
+
+    /* the SensorRecorder instance is created on startup only */
+    require_restart = true;
+  }
+
   if (SaveValue(EnableFlightLogger, ProfileKeys::EnableFlightLogger,
                 logger.enable_flight_logger)) {
     changed = true;
@@ -150,7 +150,7 @@ FlarmTrafficDetailsWidget::UpdateChanging(const MoreData &basic)
   const TCHAR *value;
 
   const FlarmTraffic* target =
-    basic.flarm.traffic.FindTraffic(target_id);
+    CommonInterface::Traffic().FindTraffic(target_id);
 
   bool target_ok = target && target->IsDefined();
 
@@ -241,7 +241,7 @@ FlarmTrafficDetailsWidget::Update()
 
     // Fill the plane type field
     const FlarmTraffic* target =
-      CommonInterface::Basic().flarm.traffic.FindTraffic(target_id);
+      CommonInterface::Traffic().FindTraffic(target_id);
 
     const TCHAR* actype;
     if (target == nullptr ||
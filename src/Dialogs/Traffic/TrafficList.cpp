@@ -368,7 +368,7 @@ TrafficListWidget::UpdateList()
        traffic */
 
     /* add live FLARM traffic */
-    for (const auto &i : CommonInterface::Basic().flarm.traffic.list) {
+    for (const auto &i : CommonInterface::Traffic()) {
       AddItem(i.id);
     }
 
@@ -427,7 +427,7 @@ TrafficListWidget::UpdateList()
 void
 TrafficListWidget::UpdateVolatile()
 {
-  const TrafficList &live_list = CommonInterface::Basic().flarm.traffic;
+  const TrafficList &live_list = CommonInterface::Traffic();
 
   bool modified = false;
 
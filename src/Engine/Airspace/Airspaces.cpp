@@ -83,9 +83,21 @@ Airspaces::Optimise() noexcept
     airspace_tree.clear();
   }
 
-  for (auto &i : tmp_as) {
-    Airspace as(std::move(i), task_projection);
-    airspace_tree.insert(as);
+  if (airspace_tree.empty()) {
+    /* (re-)building the whole tree: bulk-load it with the packing
+       algorithm, which is a lot faster than inserting the airspaces
+       one by one and yields a tree with less node overlap */
+    std::vector<Airspace> v;
+    v.reserve(tmp_as.size());
+    for (auto &i : tmp_as)
+      v.emplace_back(std::move(i), task_projection);
+
+    airspace_tree = AirspaceTree{v.begin(), v.end()};
+  } else {
+    for (auto &i : tmp_as) {
+      Airspace as(std::move(i), task_projection);
+      airspace_tree.insert(as);
+    }
   }
 
   tmp_as.clear();
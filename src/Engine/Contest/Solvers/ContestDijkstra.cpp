@@ -29,40 +29,63 @@ ContestDijkstra::ContestDijkstra(const Trace &_trace,
   std::fill_n(stage_weights, num_stages - 1, 5);
 }
 
+inline bool
+ContestDijkstra::ExtendSearch(bool force) noexcept
+{
+  assert(incremental);
+  assert(continuous);
+
+  if (!IsTraceExtensible())
+    return false;
+
+  if (!finished && !dijkstra.IsEmpty() && !force)
+    /* the search is still running on its own copy of the trace; the
+       new points will be added when it has finished */
+    return true;
+
+  if (!force && !HasMasterAdvanced())
+    /* wait for more points, to extend the search in larger
+       batches */
+    return true;
+
+  /* the working trace may grow up to twice the size of the master
+     before the search is restarted with a fresh (thinned) copy; this
+     limits the cost of each extension */
+  const unsigned max_size = std::min(2 * trace_master.GetMaxSize(),
+                                     predicted_index);
+
+  const unsigned old_size = n_points;
+  if (!ExtendTrace(max_size))
+    return false;
+
+  if (n_points > old_size) {
+    if (trace_dirty)
+      /* the search has not been started yet */
+      first_finish_candidate = n_points - 1;
+    else
+      AddIncrementalEdges(old_size);
+  }
+
+  return true;
+}
+
 void
 ContestDijkstra::UpdateTrace(bool force) noexcept
 {
   if (IsMasterAppended()) return; /* unmodified */
 
-  if (IsMasterUpdated(continuous)) {
-    UpdateTraceFull();
-
-    trace_dirty = true;
-    finished = false;
+  if (incremental && continuous) {
+    if (ExtendSearch(force))
+      return;
+  } else if (!force && !IsMasterUpdated(continuous))
+    return;
 
-    first_finish_candidate = incremental ? n_points - 1 : 0;
-  } else if (finished) {
-    const unsigned old_size = n_points;
-    if (UpdateTraceTail())
-      /* new data from the master trace, start incremental solver */
-      AddIncrementalEdges(old_size);
-  } else if (force) {
-    if (incremental && continuous) {
-      if (UpdateTraceTail()) {
-        /* new data from the master trace, restart the non-incremental
-           solver */
-        trace_dirty = true;
-        first_finish_candidate = incremental ? n_points - 1 : 0;
-      }
-    } else {
-      UpdateTraceFull();
+  UpdateTraceFull();
 
-      trace_dirty = true;
-      finished = false;
+  trace_dirty = true;
+  finished = false;
 
-      first_finish_candidate = incremental ? n_points - 1 : 0;
-    }
-  }
+  first_finish_candidate = incremental ? n_points - 1 : 0;
 }
 
 SolverResult
@@ -202,9 +225,10 @@ ContestDijkstra::AddStartEdges() noexcept
   }
 }
 
-void
-ContestDijkstra::AddEdges(const ScanTaskPoint origin,
-                          const unsigned first_point) noexcept
+template<typename F>
+inline ScanTaskPoint
+ContestDijkstra::VisitEdges(const ScanTaskPoint origin,
+                            const unsigned first_point, F &&f) const noexcept
 {
   ScanTaskPoint destination(origin.GetStageNumber() + 1,
                             std::max(origin.GetPointIndex(), first_point));
@@ -225,7 +249,7 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
   bool previous_above = false;
   for (const ScanTaskPoint end(destination.GetStageNumber(), n_points);
        destination != end; destination.IncrementPointIndex()) {
-    const auto destination_tp = GetPoint(destination);
+    const auto &destination_tp = GetPoint(destination);
     const bool above = destination_tp.GetIntegerAltitude() >= min_altitude;
 
     /* Check if the distance is withing the minimum distance.
@@ -235,8 +259,7 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
         CheckMinDistance(origin_tp.GetLocation(),
                          destination_tp.GetLocation())) {
       if (above) {
-        const value_type d = weight * CalcEdgeDistance(origin, destination);
-        Link(destination, origin, d);
+        f(destination, weight * CalcEdgeDistance(origin, destination));
       } else if (previous_above) {
         /* After excessive thinning, the exact TracePoint that matches
            the required altitude difference may be gone, and the
@@ -245,16 +268,29 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
            matches. */
 
         /* TODO: interpolate the distance */
-        const value_type d = weight * CalcEdgeDistance(origin, destination);
-        Link(destination, origin, d);
+        f(destination, weight * CalcEdgeDistance(origin, destination));
       }
     }
 
     previous_above = above;
   }
 
+  return destination;
+}
+
+void
+ContestDijkstra::AddEdges(const ScanTaskPoint origin,
+                          const unsigned first_point) noexcept
+{
+  ScanTaskPoint destination =
+    VisitEdges(origin, first_point,
+               [this, origin](ScanTaskPoint destination, value_type d){
+                 Link(destination, origin, d);
+               });
+
   if (IsFinal(destination) && predicted.IsDefined()) {
-    const value_type d = weight * origin_tp.FlatDistanceTo(predicted);
+    const unsigned weight = GetStageWeight(origin.GetStageNumber());
+    const value_type d = weight * GetPoint(origin).FlatDistanceTo(predicted);
     destination.SetPointIndex(predicted_index);
     Link(destination, origin, d);
   }
@@ -272,35 +308,51 @@ ContestDijkstra::AddIncrementalEdges(unsigned first_point) noexcept
   assert(first_point < n_points);
   assert(continuous);
   assert(incremental);
-  assert(finished);
+
+  if (finished || dijkstra.IsEmpty())
+    /* the previous search is complete, consider only the new points
+       as finish */
+    first_finish_candidate = first_point;
 
   finished = false;
-  first_finish_candidate = first_point;
-
-  /* we need a copy of the current edge map, because the following
-     loop will modify it, invalidating the iterator */
-#if GCC_VERSION < 40800 || GCC_VERSION > 40802
-  const Dijkstra::EdgeMap edges = dijkstra.GetEdgeMap();
-#else
-  // workaround for http://gcc.gnu.org/bugzilla/show_bug.cgi?id=59548
-  Dijkstra::EdgeMap edges;
-  edges = dijkstra.GetEdgeMap();
-#endif
-
-  /* establish links between each old node and each new node, to
-     initiate the follow-up search, hoping a better solution will be
-     found here */
-  for (const auto &i : edges) {
-    if (IsFinal(i.first))
-      /* ignore final nodes */
-      continue;
-
-    /* "seek" the Dijkstra object to the current "old" node */
-    dijkstra.SetCurrentValue(i.second.value);
-
-    /* add edges from the current "old" node to all "new" nodes
-       (first_point .. n_points-1) */
-    AddEdges(i.first, first_point);
+
+  /* collect the "old" nodes first, because the following code adds
+     new nodes to the edge map, which would invalidate the
+     iterator */
+  incremental_origins.clear();
+  for (const auto &[node, edge] : dijkstra.GetEdgeMap())
+    if (!IsFinal(node))
+      incremental_origins.emplace_back(node, edge.value);
+
+  /* find the best link from an "old" node to each "new" node
+     (first_point .. n_points-1) in each stage; this is equivalent to
+     linking all pairs, but updates the Dijkstra object only once per
+     new node */
+  const unsigned n_new = n_points - first_point;
+  incremental_links.assign((num_stages - 1) * n_new,
+                           {ScanTaskPoint(0, 0), value_type(0) - 1});
+
+  for (const auto &[origin, value] : incremental_origins) {
+    VisitEdges(origin, first_point,
+               [&, origin=origin, value=value](ScanTaskPoint destination,
+                                               value_type d){
+                 auto &link = incremental_links[(destination.GetStageNumber() - 1) * n_new
+                                                + destination.GetPointIndex() - first_point];
+                 const value_type total = value + DIJKSTRA_MINMAX_OFFSET - d;
+                 if (total < link.second)
+                   link = {origin, total};
+               });
+  }
+
+  /* establish the links to initiate the follow-up search, hoping a
+     better solution will be found here */
+  dijkstra.SetCurrentValue({});
+  for (unsigned i = 0; i < incremental_links.size(); ++i) {
+    const auto &[origin, total] = incremental_links[i];
+    if (total != value_type(0) - 1)
+      NavDijkstra::Link(ScanTaskPoint(i / n_new + 1,
+                                      first_point + i % n_new),
+                        origin, total);
   }
 
   /* see if new start points are possible now (due to relaxed start
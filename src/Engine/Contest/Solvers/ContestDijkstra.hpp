@@ -8,6 +8,8 @@
 #include "TraceManager.hpp"
 
 #include <cassert>
+#include <utility>
+#include <vector>
 
 class Trace;
 
@@ -29,6 +31,10 @@ class ContestDijkstra : public AbstractContest, protected NavDijkstra<>, public
    * Do an incremental analysis, attempting to improve the result in
    * each iteration?  If set, then only the last point is considered
    * as finish point, and start points are selected according to this.
+   *
+   * In a continuous contest, the search is then extended with points
+   * appended to the master trace instead of being restarted, even if
+   * the master gets thinned (see ExtendSearch()).
    */
   bool incremental = false;
 
@@ -45,6 +51,19 @@ class ContestDijkstra : public AbstractContest, protected NavDijkstra<>, public
    */
   ContestTraceVector solution;
 
+  /**
+   * The non-final nodes of the edge map and their values, collected
+   * by AddIncrementalEdges().  This is a member only to reuse the
+   * allocation.
+   */
+  std::vector<std::pair<ScanTaskPoint, value_type>> incremental_origins;
+
+  /**
+   * The best link (origin and total value) to each new node, see
+   * AddIncrementalEdges().
+   */
+  std::vector<std::pair<ScanTaskPoint, value_type>> incremental_links;
+
   /**
    * The required minimum leg distance.
    */
@@ -89,11 +108,24 @@ protected:
     return TraceManager::GetPoint(sp.GetPointIndex());
   }
 
+  /**
+   * Invoke a function for each edge from the given node to the
+   * nodes of the next stage with a point index not below
+   * #first_point, passing the destination node and the weighted
+   * distance.
+   *
+   * @return the end of the destination range
+   */
+  template<typename F>
+  ScanTaskPoint VisitEdges(ScanTaskPoint origin, unsigned first_point,
+                           F &&f) const noexcept;
+
   void AddEdges(ScanTaskPoint origin, unsigned first_point) noexcept;
 
   /**
-   * Restart the solver with the new points added by
-   * UpdateTraceTail().
+   * Extend the search with the new points added by ExtendTrace(),
+   * keeping the existing Dijkstra edge map.  If the previous search
+   * has finished, only the new points are finish candidates.
    *
    * @param first_point the first point that was added
    */
@@ -146,6 +178,14 @@ private:
 
   bool SaveSolution() noexcept;
 
+  /**
+   * Extend the working trace and the search with points appended to
+   * the master trace (incremental continuous mode only).
+   *
+   * @return false if the search must be restarted from scratch
+   */
+  bool ExtendSearch(bool force) noexcept;
+
 protected:
   /**
    * Update working trace from master.
@@ -47,6 +47,15 @@ public:
   }
 
   bool UpdateSample(const GeoPoint &aircraft_location) noexcept;
+
+  /**
+   * Replace the candidate list with a copy obtained from
+   * getNearWaypointList().
+   */
+  void Restore(const NearWaypointList &list) noexcept {
+    candidate_list = list;
+  }
+
   void Clear() noexcept;
   void Reset() noexcept {
     Clear();
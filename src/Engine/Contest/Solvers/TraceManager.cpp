@@ -5,6 +5,7 @@
 #include "Trace/Trace.hpp"
 
 #include <cassert>
+#include <iterator>
 
 TraceManager::TraceManager(const Trace &_trace) noexcept
   :trace_master(_trace),
@@ -58,12 +59,20 @@ TraceManager::IsMasterUpdated(bool continuous) const noexcept
   //if (n_points < num_stages)
   //  return true;
 
+  return HasMasterAdvanced();
+}
+
+bool
+TraceManager::HasMasterAdvanced() const noexcept
+{
+  assert(!trace.empty());
+
   // find min distance and time step within this trace
   const auto threshold_delta_t_trace = trace_master.GetAverageDeltaTime();
   const unsigned threshold_distance_trace = trace_master.GetAverageDeltaDistance();
 
   const TracePoint &last_master = trace_master.back();
-  const TracePoint &last_point = *trace.back();
+  const TracePoint &last_point = trace.back();
 
   // update trace if time and distance are greater than significance thresholds
 
@@ -95,6 +104,43 @@ TraceManager::UpdateTraceFull() noexcept
   modify_serial = trace_master.GetModifySerial();
 }
 
+/**
+ * Find the first point of the #Trace which is newer than the last
+ * point of the #TracePointVector.
+ */
+[[gnu::pure]]
+static Trace::const_iterator
+FindNewPoints(const Trace &trace, const TracePointVector &v) noexcept
+{
+  if (v.empty())
+    return trace.begin();
+
+  const auto last_time = v.back().GetTime();
+
+  const auto begin = trace.begin();
+  auto i = trace.end();
+  while (i != begin) {
+    const auto previous = std::prev(i);
+    if (previous->GetTime() <= last_time)
+      break;
+
+    i = previous;
+  }
+
+  return i;
+}
+
+void
+TraceManager::AppendPoints(Trace::const_iterator begin) noexcept
+{
+  trace.insert(trace.end(), begin, trace_master.end());
+  n_points = trace.size();
+  if (predicted.IsDefined())
+    predicted.Project(trace_master.GetProjection());
+
+  append_serial = trace_master.GetAppendSerial();
+}
+
 bool
 TraceManager::UpdateTraceTail() noexcept
 {
@@ -104,16 +150,38 @@ TraceManager::UpdateTraceTail() noexcept
   //assert(incremental == finished || force);
   assert(modify_serial == trace_master.GetModifySerial());
 
-  if (!trace_master.SyncPoints(trace))
+  const auto begin = FindNewPoints(trace_master, trace);
+  if (begin == trace_master.end())
     /* no new points */
     return false;
 
-  n_points = trace.size();
+  AppendPoints(begin);
+  return true;
+}
 
-  if (n_points > 0 && predicted.IsDefined())
-    predicted.Project(trace_master.GetProjection());
+bool
+TraceManager::IsTraceExtensible() const noexcept
+{
+  return !trace.empty() && !trace_master.empty() &&
+    trace_master.front().GetTime() == trace.front().GetTime() &&
+    trace_master.back().GetTime() >= trace.back().GetTime();
+}
 
-  append_serial = trace_master.GetAppendSerial();
+bool
+TraceManager::ExtendTrace(unsigned max_size) noexcept
+{
+  if (!IsTraceExtensible())
+    return false;
+
+  const auto begin = FindNewPoints(trace_master, trace);
+  if (trace.size() + std::distance(begin, trace_master.end()) > max_size)
+    return false;
+
+  AppendPoints(begin);
+
+  /* the master may have been thinned, but our copy is still
+     consistent */
+  modify_serial = trace_master.GetModifySerial();
   return true;
 }
 
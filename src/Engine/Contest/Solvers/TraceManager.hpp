@@ -29,11 +29,11 @@ private:
 
 protected:
   /**
-   * Working trace for solver.  This contains pointers to trace_master
-   * records, which get Invalidated when the trace gets thinned.  Be
-   * careful!
+   * Working trace for solver.  This is a copy of the trace_master
+   * points; unlike pointers, the copies survive the thinning of the
+   * master, which allows ExtendTrace() to keep the solver state.
    */
-  TracePointerVector trace;
+  TracePointVector trace;
 
   /** Number of points in current trace set */
   unsigned n_points;
@@ -77,16 +77,46 @@ protected:
    */
   bool UpdateTraceTail() noexcept;
 
+  /**
+   * Can the working trace be extended with ExtendTrace()?  This is
+   * the case if the master has not been cleared, has not lost its
+   * first point and has not gone back in time; thinning is allowed.
+   */
+  [[gnu::pure]]
+  bool IsTraceExtensible() const noexcept;
+
+  /**
+   * Like UpdateTraceTail(), but works even if the master has been
+   * thinned meanwhile: the working trace keeps all of its points, and
+   * only the master points which are newer than its last one are
+   * appended.  This allows a solver to extend its previous search
+   * instead of starting over.
+   *
+   * @param max_size the maximum size of the working trace
+   * @return false if the working trace cannot be extended (see
+   * IsTraceExtensible()) or would grow beyond #max_size; the caller
+   * should obtain a new copy with UpdateTraceFull() then
+   */
+  bool ExtendTrace(unsigned max_size) noexcept;
+
   [[gnu::pure]]
   const TracePoint &GetPoint(unsigned i) const noexcept {
     assert(i < n_points);
 
-    return *trace[i];
+    return trace[i];
   }
 
   [[gnu::pure]]
   bool IsMasterUpdated(bool continuous) const noexcept;
 
+  /**
+   * Has the master moved on significantly (in time and distance,
+   * compared to its average point spacing) since the last point of
+   * the working trace?
+   */
+  [[gnu::pure]]
+  bool HasMasterAdvanced() const noexcept;
+
   [[gnu::pure]]
   bool CheckMasterSerial() const noexcept {
     return modify_serial != trace_master.GetModifySerial();
@@ -107,4 +137,11 @@ protected:
   virtual void UpdateTrace(bool force) noexcept;
 
   virtual void Reset() noexcept = 0;
+
+private:
+  /**
+   * Append copies of the master points from the given one to the
+   * end.
+   */
+  void AppendPoints(Trace::const_iterator begin) noexcept;
 };
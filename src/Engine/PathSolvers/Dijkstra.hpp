@@ -3,7 +3,10 @@
 
 #pragma once
 
-#include "util/ReservablePriorityQueue.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
 
 #define DIJKSTRA_MINMAX_OFFSET 134217727
 
@@ -11,6 +14,12 @@
  * Dijkstra search algorithm.
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * The edge map (MapTemplate::Bind<Edge>, e.g. #ScanTaskPointMap)
+ * addresses its items by stable integer positions; the queue is an
+ * indexed 4-ary min-heap of these positions, and each #Edge knows
+ * its position in the heap, which allows updating a node's value in
+ * place ("decrease-key") instead of queueing duplicates.
  */
 template<typename Node, typename MapTemplate, typename ValueType=unsigned>
 class Dijkstra
@@ -24,42 +33,44 @@ public:
 
     value_type value;
 
+    /**
+     * The position in #heap or #NOT_IN_HEAP.
+     */
+    uint32_t heap_index = NOT_IN_HEAP;
+
     constexpr Edge(Node _parent, value_type _value) noexcept
       :parent(_parent), value(_value) {}
   };
 
   using EdgeMap = typename MapTemplate::template Bind<Edge>;
-  using edge_iterator = typename EdgeMap::iterator;
-  using edge_const_iterator = typename EdgeMap::const_iterator;
+  using edge_position = typename EdgeMap::size_type;
 
 private:
-  struct Value
-  {
-    value_type edge_value;
+  static constexpr uint32_t NOT_IN_HEAP = UINT32_MAX;
 
-    edge_iterator iterator;
+  static constexpr unsigned HEAP_ARITY = 4;
 
-    constexpr Value(value_type _edge_value, edge_iterator _iterator) noexcept
-      :edge_value(_edge_value), iterator(_iterator) {}
-  };
+  struct HeapEntry {
+    /**
+     * A copy of the edge value, so sifting does not need to look up
+     * the edge.
+     */
+    value_type value;
 
-  struct Rank {
-    [[gnu::pure]]
-    constexpr bool operator()(const Value &x, const Value &y) const noexcept {
-      return x.edge_value > y.edge_value;
-    }
+    edge_position edge;
   };
 
   /**
    * Stores the predecessor and value of each node.  It is updated by
-   * push(), if a value lower than the current one is found.
+   * Push(), if a value lower than the current one is found.
    */
   EdgeMap edges;
 
   /**
-   * A sorted list of all possible node paths, lowest distance first.
+   * A min-heap of all nodes which have not been consumed by Pop()
+   * yet, lowest value first.
    */
-  reservable_priority_queue<Value, std::vector<Value>, Rank> q;
+  std::vector<HeapEntry> heap;
 
   /**
    * The value of the current edge, i.e. the one that was consumed by
@@ -68,28 +79,19 @@ private:
   value_type current_value;
 
 public:
-  /**
-   * Default constructor
-   */
-  Dijkstra() noexcept {
-    /* this is a kludge to prevent rehashing, because rehashing would
-       invalidate all iterators stored inside the priority queue
-       "q", and would thus lead to use-after-free crashes */
-    // TODO this hard-codes the use of std::unordered_map
-    // TODO come up with a better solution
-    edges.reserve(4093);
-    edges.max_load_factor(1e10);
-  }
+  Dijkstra() noexcept = default;
 
-  Dijkstra(const Dijkstra &) = delete;
-  Dijkstra &operator=(const Dijkstra &) = delete;
+  /* copying is allowed, but expensive; it is used to save the state
+     of a search in a checkpoint */
+  Dijkstra(const Dijkstra &) = default;
+  Dijkstra &operator=(const Dijkstra &) = default;
 
   /** 
    * Clears the queues
    */
   void Clear() noexcept {
     // Clear the search queue
-    q.clear();
+    heap.clear();
 
     // Clear EdgeMap
     edges.clear();
@@ -113,7 +115,7 @@ public:
    */
   [[gnu::pure]]
   bool IsEmpty() const noexcept {
-    return q.empty();
+    return heap.empty();
   }
 
   /**
@@ -123,7 +125,7 @@ public:
    */
   [[gnu::pure]]
   auto GetQueueSize() const noexcept {
-    return q.size();
+    return heap.size();
   }
 
   /**
@@ -140,14 +142,20 @@ public:
    * @return Node for processing
    */
   Node Pop() noexcept {
-    edge_const_iterator cur(q.top().iterator);
-    current_value = cur->second.value;
+    assert(!heap.empty());
 
-    do {
-      q.pop();
-    } while (!q.empty() && q.top().iterator->second.value < q.top().edge_value);
+    auto &top = edges[heap.front().edge];
+    top.second.heap_index = NOT_IN_HEAP;
+    current_value = top.second.value;
 
-    return cur->first;
+    const HeapEntry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+      HeapMove(0, last);
+      SiftDown(0);
+    }
+
+    return top.first;
   }
 
   /**
@@ -172,8 +180,8 @@ public:
   [[gnu::pure]]
   Node GetPredecessor(const Node node) const noexcept {
     // Try to find the given node in the node_parent_map
-    edge_const_iterator it = edges.find(node);
-    if (it == edges.end())
+    const auto *i = edges.find(node);
+    if (i == nullptr)
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -181,14 +189,15 @@ public:
     else
       // If the node was found
       // -> Return the parent node
-      return it->second.parent;
+      return i->second.parent;
   }
 
   /**
    * Reserve queue size (if available)
    */
   void Reserve(std::size_t size) noexcept {
-    q.reserve(size);
+    heap.reserve(size);
+    edges.reserve(size);
   }
 
   /**
@@ -196,10 +205,12 @@ public:
    */
   void RestartQueue() noexcept {
     // Clear the search queue
-    q.clear();
+    heap.clear();
 
-    for (const auto &i : edges)
-      q.emplace(i.second.value, i);
+    for (edge_position i = 0; i < edges.size(); ++i) {
+      edges[i].second.heap_index = NOT_IN_HEAP;
+      HeapPush(i);
+    }
   }
 
 private:
@@ -214,19 +225,80 @@ private:
   bool Push(const Node node, const Node parent,
             value_type edge_value = {}) noexcept {
     // Try to find the given node n in the EdgeMap
-    const auto [it, inserted] = edges.try_emplace(node, parent, edge_value);
+    const auto [position, inserted] =
+      edges.try_emplace(node, parent, edge_value);
+    Edge &edge = edges[position].second;
     if (inserted) {
       // first entry
-    } else if (it->second.value > edge_value)
+    } else if (edge.value > edge_value) {
       // If the node was found and the new value is smaller
       // -> Replace the value with the new one
-      it->second = Edge(parent, edge_value);
-    else
+      edge.parent = parent;
+      edge.value = edge_value;
+    } else
       // If the node was found but the new value is higher or equal
       // -> Don't use this new leg
       return false;
 
-    q.emplace(edge_value, it);
+    if (edge.heap_index == NOT_IN_HEAP) {
+      HeapPush(position);
+    } else {
+      /* decrease-key */
+      heap[edge.heap_index].value = edge_value;
+      SiftUp(edge.heap_index);
+    }
+
     return true;
   }
+
+  void HeapMove(uint32_t position, const HeapEntry &e) noexcept {
+    heap[position] = e;
+    edges[e.edge].second.heap_index = position;
+  }
+
+  void HeapPush(edge_position i) noexcept {
+    heap.push_back({edges[i].second.value, i});
+    SiftUp(heap.size() - 1);
+  }
+
+  void SiftUp(uint32_t position) noexcept {
+    const HeapEntry e = heap[position];
+
+    while (position > 0) {
+      const uint32_t parent = (position - 1) / HEAP_ARITY;
+      if (!(e.value < heap[parent].value))
+        break;
+
+      HeapMove(position, heap[parent]);
+      position = parent;
+    }
+
+    HeapMove(position, e);
+  }
+
+  void SiftDown(uint32_t position) noexcept {
+    const HeapEntry e = heap[position];
+    const uint32_t size = heap.size();
+
+    while (true) {
+      const uint32_t first = HEAP_ARITY * position + 1;
+      if (first >= size)
+        break;
+
+      /* find the smallest child */
+      const uint32_t last = std::min(first + HEAP_ARITY, size);
+      uint32_t child = first;
+      for (uint32_t i = first + 1; i < last; ++i)
+        if (heap[i].value < heap[child].value)
+          child = i;
+
+      if (!(heap[child].value < e.value))
+        break;
+
+      HeapMove(position, heap[child]);
+      position = child;
+    }
+
+    HeapMove(position, e);
+  }
 };
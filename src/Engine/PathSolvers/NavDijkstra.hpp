@@ -5,9 +5,9 @@
 
 #include "Dijkstra.hpp"
 #include "ScanTaskPoint.hpp"
+#include "ScanTaskPointMap.hpp"
 #include "SolverResult.hpp"
 
-#include <unordered_map>
 #include <cassert>
 
 /**
@@ -24,23 +24,8 @@ protected:
   static constexpr unsigned MAX_STAGES = 32;
 
   struct DijkstraMap {
-    struct Hash {
-      constexpr std::size_t operator()(ScanTaskPoint p) const noexcept {
-        return p.Key();
-      }
-    };
-
-    struct Equal {
-      constexpr bool operator()(ScanTaskPoint a,
-                                ScanTaskPoint b) const noexcept {
-        return a.Key() == b.Key();
-      }
-    };
-
     template<typename Value>
-    struct Bind : public std::unordered_map<ScanTaskPoint, Value,
-                                            Hash, Equal> {
-    };
+    using Bind = ScanTaskPointMap<Value, MAX_STAGES>;
   };
 
   using Dijkstra = ::Dijkstra<ScanTaskPoint, DijkstraMap, ValueType>;
@@ -69,7 +54,8 @@ protected:
     SetStageCount(_num_stages);
   }
 
-  NavDijkstra(const NavDijkstra &) = delete;
+  NavDijkstra(const NavDijkstra &) = default;
+  NavDijkstra &operator=(const NavDijkstra &) = default;
 
 protected:
   /**
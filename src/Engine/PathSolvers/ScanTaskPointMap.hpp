@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ScanTaskPoint.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * A map with #ScanTaskPoint keys for #Dijkstra.  The items are
+ * stored in a flat array in insertion order and are addressed by
+ * their (stable) position in that array; a lookup table per stage,
+ * indexed by the point index, maps keys to positions without
+ * hashing.
+ *
+ * Point indexes beyond #DENSE_LIMIT (e.g.
+ * TraceManager::predicted_index) are rare and are looked up linearly
+ * in a small overflow list instead, to keep the tables small.
+ */
+template<typename Value, unsigned MAX_STAGES>
+class ScanTaskPointMap {
+  static constexpr unsigned DENSE_LIMIT = 0x1000;
+
+public:
+  using value_type = std::pair<ScanTaskPoint, Value>;
+  using size_type = uint32_t;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+  std::vector<value_type> items;
+
+  /**
+   * The position of each item plus one, indexed by stage number and
+   * point index; zero means "not present".
+   */
+  std::array<std::vector<size_type>, MAX_STAGES> tables;
+
+  /**
+   * The positions of all items with a point index not below
+   * #DENSE_LIMIT.
+   */
+  std::vector<size_type> overflow;
+
+public:
+  const_iterator begin() const noexcept {
+    return items.begin();
+  }
+
+  const_iterator end() const noexcept {
+    return items.end();
+  }
+
+  size_type size() const noexcept {
+    return items.size();
+  }
+
+  void reserve(std::size_t n) noexcept {
+    items.reserve(n);
+  }
+
+  void clear() noexcept {
+    /* reset only the table entries which are in use; the tables
+       themselves are kept for the next search */
+    for (const auto &i : items) {
+      const ScanTaskPoint key = i.first;
+      if (key.GetPointIndex() < DENSE_LIMIT)
+        tables[key.GetStageNumber()][key.GetPointIndex()] = 0;
+    }
+
+    items.clear();
+    overflow.clear();
+  }
+
+  value_type &operator[](size_type position) noexcept {
+    assert(position < items.size());
+    return items[position];
+  }
+
+  const value_type &operator[](size_type position) const noexcept {
+    assert(position < items.size());
+    return items[position];
+  }
+
+  /**
+   * @return the item with the given key or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const value_type *find(const ScanTaskPoint key) const noexcept {
+    assert(key.GetStageNumber() < MAX_STAGES);
+
+    const unsigned point = key.GetPointIndex();
+    if (point < DENSE_LIMIT) {
+      const auto &table = tables[key.GetStageNumber()];
+      if (point >= table.size() || table[point] == 0)
+        return nullptr;
+
+      return &items[table[point] - 1];
+    }
+
+    for (const auto position : overflow)
+      if (items[position].first == key)
+        return &items[position];
+
+    return nullptr;
+  }
+
+  /**
+   * Insert a new item unless the key exists already.
+   *
+   * @return the position of the item with the given key and whether
+   * it was inserted
+   */
+  template<typename... Args>
+  std::pair<size_type, bool> try_emplace(const ScanTaskPoint key,
+                                         Args&&... args) noexcept {
+    assert(key.GetStageNumber() < MAX_STAGES);
+
+    const size_type position = items.size();
+
+    const unsigned point = key.GetPointIndex();
+    if (point < DENSE_LIMIT) {
+      auto &table = tables[key.GetStageNumber()];
+      if (point >= table.size())
+        table.resize(point + 1);
+      else if (table[point] != 0)
+        return {table[point] - 1, false};
+
+      table[point] = position + 1;
+    } else {
+      for (const auto i : overflow)
+        if (items[i].first == key)
+          return {i, false};
+
+      overflow.push_back(position);
+    }
+
+    items.emplace_back(std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+    return {position, true};
+  }
+};
@@ -66,12 +66,17 @@ public:
 AirspaceRoute::RouteAirspaceIntersection
 AirspaceRoute::FirstIntersecting(const RouteLink &e) const noexcept
 {
+  if (const auto *cached = airspace_clearance.Find(e))
+    return *cached;
+
   const GeoPoint origin(projection.Unproject(e.first));
   const GeoPoint dest(projection.Unproject(e.second));
   AIV visitor(e, projection, rpolars_route);
   m_airspaces.VisitIntersecting(origin, dest, visitor);
   const AIV::AIVResult res(visitor.GetNearest());
-  return RouteAirspaceIntersection(res.first, res.second);
+  const RouteAirspaceIntersection inx(res.first, res.second);
+  airspace_clearance.Insert(e, inx);
+  return inx;
 }
 
 inline const AbstractAirspace *
@@ -175,11 +180,33 @@ AirspaceRoute::~AirspaceRoute() noexcept
 void
 AirspaceRoute::Reset() noexcept
 {
-  RoutePlanner::Reset();
+  TerrainRoute::Reset();
   m_airspaces.ClearClearances();
   m_airspaces.Clear();
 }
 
+void
+AirspaceRoute::ClearClearanceCache() noexcept
+{
+  TerrainRoute::ClearClearanceCache();
+  airspace_clearance.Clear();
+  airspace_clearance_center = GeoPoint::Invalid();
+}
+
+void
+AirspaceRoute::ValidateClearanceCache() noexcept
+{
+  TerrainRoute::ValidateClearanceCache();
+
+  if (projection.GetCenter() == airspace_clearance_center &&
+      rpolars_route.IsAirspaceClearanceEquivalent(airspace_clearance_rpolars))
+    return;
+
+  airspace_clearance.Clear();
+  airspace_clearance_center = projection.GetCenter();
+  airspace_clearance_rpolars = rpolars_route;
+}
+
 void
 AirspaceRoute::Synchronise(const Airspaces &master,
                            AirspacePredicate _condition,
@@ -201,6 +228,10 @@ AirspaceRoute::Synchronise(const Airspaces &master,
   if (m_airspaces.SynchroniseInRange(master, origin.Middle(destination),
                                      0.5 * origin.Distance(destination),
                                      predicate)) {
+    /* the cached intersections may refer to airspaces which have
+       just been removed */
+    airspace_clearance.Clear();
+
     if (!m_airspaces.IsEmpty())
       dirty = true;
   }
@@ -24,6 +24,15 @@ class AirspaceRoute : public TerrainRoute {
 
   mutable RouteAirspaceIntersection m_inx;
 
+  /**
+   * Results of FirstIntersecting() from previous solves.
+   */
+  mutable RouteClearanceCache<RouteAirspaceIntersection> airspace_clearance;
+
+  /* the parameters #airspace_clearance was filled with */
+  GeoPoint airspace_clearance_center = GeoPoint::Invalid();
+  RoutePolars airspace_clearance_rpolars;
+
 public:
   friend class PrintHelper;
 
@@ -35,6 +44,11 @@ public:
                    const AGeoPoint &destination) noexcept;
 
   void Reset() noexcept override;
+  void ClearClearanceCache() noexcept override;
+
+  const auto &GetAirspaceClearanceCache() const noexcept {
+    return airspace_clearance;
+  }
 
   [[gnu::pure]]
   unsigned AirspaceSize() const noexcept;
@@ -47,6 +61,7 @@ protected:
     return m_airspaces.IsEmpty() && RoutePlanner::IsTrivial();
   }
 
+  void ValidateClearanceCache() noexcept override;
   bool IsClear(const RouteLink &e) const noexcept override;
   void AddNearby(const RouteLink &e) noexcept override;
   bool CheckSecondary(const RouteLink &e) noexcept override;
@@ -55,7 +70,10 @@ private:
   void AddNearbyAirspace(const RouteAirspaceIntersection &inx,
                          const RouteLink &e) noexcept;
 
-  [[gnu::pure]]
+  /**
+   * Find the nearest airspace intersection, using the
+   * #airspace_clearance cache.
+   */
   RouteAirspaceIntersection FirstIntersecting(const RouteLink &e) const noexcept;
 
   [[gnu::pure]]
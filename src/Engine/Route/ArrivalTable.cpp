@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ArrivalTable.hpp"
+#include "ReachFan.hpp"
+
+#include <algorithm>
+
+void
+ArrivalTable::Solve(const ReachFan &reach,
+                    const RoutePolars &rpolars) noexcept
+{
+  std::sort(items.begin(), items.end(), [](const Item &a, const Item &b){
+    return a.id < b.id;
+  });
+
+  std::vector<AGeoPoint> destinations;
+  destinations.reserve(items.size());
+  for (const auto &i : items)
+    destinations.push_back(i.destination);
+
+  std::vector<ReachResult> results(items.size());
+  if (!reach.FindPositiveArrivals(destinations, rpolars, results)) {
+    items.clear();
+    return;
+  }
+
+  for (std::size_t i = 0; i < items.size(); ++i)
+    items[i].reach = results[i];
+}
+
+const ReachResult *
+ArrivalTable::Find(unsigned id, const AGeoPoint &destination) const noexcept
+{
+  const auto i = std::lower_bound(items.begin(), items.end(), id,
+                                  [](const Item &item, unsigned _id){
+                                    return item.id < _id;
+                                  });
+  if (i == items.end() || i->id != id ||
+      (const GeoPoint &)i->destination != (const GeoPoint &)destination ||
+      i->destination.altitude != destination.altitude)
+    return nullptr;
+
+  return &i->reach;
+}
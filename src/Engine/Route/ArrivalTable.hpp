@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ReachResult.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <vector>
+
+class ReachFan;
+class RoutePolars;
+
+/**
+ * The reach results of many destinations (e.g. all landables within
+ * the abort range), calculated in one pass over a #ReachFan by
+ * Solve().  Destinations are identified by a number, usually the
+ * waypoint id.
+ */
+class ArrivalTable {
+  struct Item {
+    unsigned id;
+    AGeoPoint destination;
+    ReachResult reach;
+  };
+
+  /**
+   * Sorted by id after Solve().
+   */
+  std::vector<Item> items;
+
+public:
+  bool empty() const noexcept {
+    return items.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return items.size();
+  }
+
+  void clear() noexcept {
+    items.clear();
+  }
+
+  void reserve(std::size_t n) noexcept {
+    items.reserve(n);
+  }
+
+  /**
+   * Add a destination.  Its result will be calculated by Solve().
+   */
+  void Add(unsigned id, const AGeoPoint &destination) noexcept {
+    items.push_back({id, destination, {}});
+  }
+
+  /**
+   * Calculate the results of all destinations.  If the reach is
+   * empty, the table is cleared.
+   */
+  void Solve(const ReachFan &reach, const RoutePolars &rpolars) noexcept;
+
+  /**
+   * Look up the result of a destination.
+   *
+   * @return nullptr if the destination is not in the table or if
+   * its location or altitude differs
+   */
+  [[gnu::pure]]
+  const ReachResult *Find(unsigned id,
+                          const AGeoPoint &destination) const noexcept;
+};
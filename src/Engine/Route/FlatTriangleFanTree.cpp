@@ -268,6 +268,51 @@ FlatTriangleFanTree::FindPositiveArrival(const FlatGeoPoint n,
   return retval;
 }
 
+void
+FlatTriangleFanTree::FindPositiveArrivals(std::span<const FlatGeoPoint> points,
+                                          const ReachFanParms &parms,
+                                          std::span<int> arrival_heights,
+                                          std::vector<unsigned> &candidates,
+                                          const std::size_t begin) const noexcept
+{
+  assert(points.size() == arrival_heights.size());
+
+  /* the candidates for the children are appended to the vector, and
+     removed again before returning */
+  const std::size_t end = candidates.size();
+
+  for (std::size_t i = begin; i < end; ++i) {
+    const unsigned j = candidates[i];
+    const FlatGeoPoint n = points[j];
+    int &arrival_height = arrival_heights[j];
+
+    if (GetHeight() < arrival_height)
+      continue; // can't possibly improve
+
+    if (!bb_children.IsInside(n))
+      continue; // not in scope
+
+    if (fan.IsInside(n, IsRoot())) {
+      /* found in this segment; as in FindPositiveArrival(), the
+         children need not be checked */
+      const int h =
+        parms.rpolars.CalcGlideArrival(fan.GetOrigin(), n, parms.projection);
+      if (h > arrival_height)
+        arrival_height = h;
+      continue;
+    }
+
+    candidates.push_back(j);
+  }
+
+  if (candidates.size() > end)
+    for (const auto &child : children)
+      child.FindPositiveArrivals(points, parms, arrival_heights,
+                                 candidates, end);
+
+  candidates.resize(end);
+}
+
 void
 FlatTriangleFanTree::AcceptInRange(const FlatBoundingBox &bb,
                                    FlatTriangleFanVisitor &visitor) const noexcept
@@ -9,6 +9,8 @@
 
 #include <cstdint>
 #include <forward_list>
+#include <span>
+#include <vector>
 
 class FlatProjection;
 struct GeoPoint;
@@ -83,6 +85,24 @@ public:
                            const ReachFanParms &parms,
                            int &arrival_height) const noexcept;
 
+  /**
+   * Like FindPositiveArrival(), but for many points in one traversal
+   * of the tree.  Each node checks only those points which are still
+   * relevant for its subtree.
+   *
+   * @param points all destinations
+   * @param arrival_heights the arrival height of each destination,
+   * updated like by FindPositiveArrival()
+   * @param candidates scratch space; the elements from index
+   * #begin to the end are the indexes of the destinations to be
+   * checked; on return, it has the same contents as on entry
+   */
+  void FindPositiveArrivals(std::span<const FlatGeoPoint> points,
+                            const ReachFanParms &parms,
+                            std::span<int> arrival_heights,
+                            std::vector<unsigned> &candidates,
+                            std::size_t begin=0) const noexcept;
+
   void AcceptInRange(const FlatBoundingBox &bb,
                      FlatTriangleFanVisitor &visitor) const noexcept;
 
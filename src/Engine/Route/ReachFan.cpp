@@ -6,6 +6,10 @@
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
 
+#include <vector>
+
+#include <cassert>
+
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
 void
@@ -98,6 +102,67 @@ ReachFan::FindPositiveArrival(const AGeoPoint dest,
   return result_r;
 }
 
+bool
+ReachFan::FindPositiveArrivals(std::span<const AGeoPoint> dests,
+                               const RoutePolars &rpolars,
+                               std::span<ReachResult> results) const noexcept
+{
+  assert(dests.size() == results.size());
+
+  if (root.IsEmpty())
+    return false;
+
+  const ReachFanParms parms(rpolars, projection, terrain_base);
+
+  std::vector<FlatGeoPoint> points;
+  points.reserve(dests.size());
+
+  std::vector<int> arrival_heights(dests.size());
+  std::vector<unsigned> candidates;
+  candidates.reserve(dests.size());
+
+  /* the same early checks as in FindPositiveArrival(); the remaining
+     destinations are candidates for the tree search */
+  for (std::size_t i = 0; i < dests.size(); ++i) {
+    const AGeoPoint &dest = dests[i];
+    ReachResult &result_r = results[i];
+
+    const FlatGeoPoint d(projection.ProjectInteger(dest));
+    points.push_back(d);
+
+    result_r.Clear();
+    result_r.direct = root.DirectArrival(d, parms);
+
+    if (root.IsDummy())
+      continue;
+
+    if (std::min(root.GetHeight(), result_r.direct) < dest.altitude) {
+      result_r.terrain = result_r.direct;
+      result_r.terrain_valid = ReachResult::Validity::UNREACHABLE;
+      continue;
+    }
+
+    result_r.terrain = dest.altitude - 1;
+    arrival_heights[i] = result_r.terrain;
+    candidates.push_back(i);
+  }
+
+  if (candidates.empty())
+    return true;
+
+  root.FindPositiveArrivals(points, parms, arrival_heights, candidates);
+
+  for (const unsigned i : candidates) {
+    ReachResult &result_r = results[i];
+    result_r.terrain_valid = arrival_heights[i] > result_r.terrain
+      ? ReachResult::Validity::VALID
+      : ReachResult::Validity::UNREACHABLE;
+    result_r.terrain = arrival_heights[i];
+  }
+
+  return true;
+}
+
 void
 ReachFan::AcceptInRange(const GeoBounds &bounds,
                         FlatTriangleFanVisitor &visitor) const noexcept
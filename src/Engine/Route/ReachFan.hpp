@@ -7,6 +7,7 @@
 #include "FlatTriangleFanTree.hpp"
 
 #include <optional>
+#include <span>
 
 class RoutePolars;
 class RasterMap;
@@ -50,6 +51,18 @@ public:
   std::optional<ReachResult> FindPositiveArrival(const AGeoPoint dest,
                                                  const RoutePolars &rpolars) const noexcept;
 
+  /**
+   * Find the arrival heights of many destinations in one pass; the
+   * results are the same as those of FindPositiveArrival().
+   *
+   * @param results receives one result per destination
+   * @return false if no reach has been calculated (#results is
+   * unmodified then)
+   */
+  bool FindPositiveArrivals(std::span<const AGeoPoint> dests,
+                            const RoutePolars &rpolars,
+                            std::span<ReachResult> results) const noexcept;
+
   /** Visit reach (working or terrain reach) */
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor) const noexcept;
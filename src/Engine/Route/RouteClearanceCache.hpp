@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "RouteLink.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+
+/**
+ * A bounded cache of obstacle clearance test results, keyed on the
+ * end points (including their altitudes) of a #RouteLink.  It allows
+ * RoutePlanner::Solve() to reuse the results of the previous solve.
+ * The owner may quantise the altitudes of the key (see
+ * RoutePolars::QuantiseClearanceLink()) and perform the test with
+ * the quantised link, so small altitude changes between two solves
+ * still hit the cache.
+ *
+ * The owner is responsible for calling Clear() whenever the outcome
+ * of the test may change (obstacle database, polar or projection).
+ */
+template<typename Value>
+class RouteClearanceCache {
+  struct Hasher {
+    constexpr std::size_t operator()(const RoutePoint &p) const noexcept {
+      return (p.x * std::size_t(104729) + p.y) * std::size_t(31) + p.altitude;
+    }
+
+    constexpr std::size_t operator()(const RouteLinkBase &l) const noexcept {
+      return (*this)(l.first) * std::size_t(27644437) + (*this)(l.second);
+    }
+  };
+
+  /**
+   * If the cache grows beyond this number of items, it is flushed.
+   */
+  static constexpr std::size_t MAX_SIZE = 8192;
+
+  std::unordered_map<RouteLinkBase, Value, Hasher> items;
+
+  unsigned hits = 0, misses = 0;
+
+public:
+  void Clear() noexcept {
+    items.clear();
+  }
+
+  /**
+   * @return the cached result or nullptr if there is none
+   */
+  const Value *Find(const RouteLinkBase &link) noexcept {
+    const auto i = items.find(link);
+    if (i == items.end()) {
+      ++misses;
+      return nullptr;
+    }
+
+    ++hits;
+    return &i->second;
+  }
+
+  void Insert(const RouteLinkBase &link, const Value &value) noexcept {
+    if (items.size() >= MAX_SIZE)
+      items.clear();
+
+    items.emplace(link, value);
+  }
+
+  unsigned GetHits() const noexcept {
+    return hits;
+  }
+
+  unsigned GetMisses() const noexcept {
+    return misses;
+  }
+};
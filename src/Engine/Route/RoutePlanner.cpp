@@ -72,6 +72,8 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   if (!rpolars_route.IsAchievable(e_test))
     return false;
 
+  ValidateClearanceCache();
+
   bool retval = false;
   planner.Restart(start);
 
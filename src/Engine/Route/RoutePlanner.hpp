@@ -258,6 +258,13 @@ protected:
   virtual void OnSolve(const AGeoPoint &origin,
                        const AGeoPoint &destination) noexcept;
 
+  /**
+   * Hook to allow subclasses to discard cached IsClear() results
+   * before the search starts, if anything they depend on has changed
+   * since the previous solve.
+   */
+  virtual void ValidateClearanceCache() noexcept {}
+
 private:
   /**
    * For a link known to not clear obstacles, generate whatever candidate edges
@@ -8,6 +8,9 @@
 #include "Geo/Flat/FlatGeoPoint.hpp"
 #include "util/Macros.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 GlideResult
 RoutePolar::SolveTask(const GlideSettings &settings,
                       const GlidePolar& glide_polar,
@@ -99,3 +102,14 @@ RoutePolar::IndexToDXDY(const int index)
 
   return index_to_point[index];
 }
+
+bool
+RoutePolar::HasSameGradients(const RoutePolar &other) const noexcept
+{
+  return std::equal(std::begin(points), std::end(points),
+                    std::begin(other.points),
+                    [](const RoutePolarPoint &a, const RoutePolarPoint &b){
+                      return a.valid == b.valid &&
+                        (!a.valid || a.gradient == b.gradient);
+                    });
+}
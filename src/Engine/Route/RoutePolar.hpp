@@ -76,6 +76,13 @@ public:
     return points[index];
   }
 
+  /**
+   * Does the other object have the same glide gradient in all
+   * directions?
+   */
+  [[gnu::pure]]
+  bool HasSameGradients(const RoutePolar &other) const noexcept;
+
   /**
    * Calculate distances normalised to 128 corresponding to direction index
    *
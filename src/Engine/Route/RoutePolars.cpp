@@ -185,6 +185,34 @@ RoutePolars::SetConfig(const RoutePlannerConfig& _config,
     climb_ceiling = INT_MAX;
 }
 
+RouteLink
+RoutePolars::QuantiseClearanceLink(const RouteLink &link) noexcept
+{
+  RouteLink result = link;
+  result.first.altitude = QuantiseClearanceAltitude(link.first.altitude);
+  result.second.altitude = QuantiseClearanceAltitude(link.second.altitude);
+  return result;
+}
+
+bool
+RoutePolars::IsTerrainClearanceEquivalent(const RoutePolars &other) const noexcept
+{
+  return config.IsTerrainEnabled() == other.config.IsTerrainEnabled() &&
+    config.safety_height_terrain == other.config.safety_height_terrain &&
+    QuantiseClearanceAltitude(climb_ceiling) ==
+    QuantiseClearanceAltitude(other.climb_ceiling) &&
+    polar_glide.HasSameGradients(other.polar_glide);
+}
+
+bool
+RoutePolars::IsAirspaceClearanceEquivalent(const RoutePolars &other) const noexcept
+{
+  return config.IsAirspaceEnabled() == other.config.IsAirspaceEnabled() &&
+    cruise_altitude == other.cruise_altitude &&
+    CanClimb() == other.CanClimb() &&
+    polar_glide.HasSameGradients(other.polar_glide);
+}
+
 bool
 RoutePolars::CanClimb() const noexcept
 {
@@ -227,6 +227,55 @@ public:
                        const FlatGeoPoint &dest,
                        const FlatProjection &proj) const noexcept;
 
+  /**
+   * The altitude resolution [m] of cached terrain clearance tests.
+   * These are performed with all altitudes rounded down to a
+   * multiple of this, so one solve can reuse the results of the
+   * previous one although the aircraft has climbed or sunk a few
+   * metres since then.  Rounding down errs on the safe side for
+   * terrain, but not for airspace (a link could pass below the floor
+   * of an airspace it actually enters), so airspace intersection
+   * tests are always performed with exact altitudes.
+   */
+  static constexpr int CLEARANCE_ALTITUDE_BAND = 16;
+
+  static constexpr int QuantiseClearanceAltitude(int altitude) noexcept {
+    static_assert((CLEARANCE_ALTITUDE_BAND & (CLEARANCE_ALTITUDE_BAND - 1)) == 0);
+    return altitude & ~(CLEARANCE_ALTITUDE_BAND - 1);
+  }
+
+  /**
+   * Round the altitudes of both end points down, see
+   * #CLEARANCE_ALTITUDE_BAND.
+   */
+  [[gnu::const]]
+  static RouteLink QuantiseClearanceLink(const RouteLink &link) noexcept;
+
+  /**
+   * Round the climb ceiling down, see #CLEARANCE_ALTITUDE_BAND.  This
+   * is applied to the copy the terrain clearance tests are performed
+   * with.
+   */
+  void QuantiseClearanceAltitudes() noexcept {
+    climb_ceiling = QuantiseClearanceAltitude(climb_ceiling);
+  }
+
+  /**
+   * Would CheckClearance() yield the same results with the other
+   * object, after QuantiseClearanceAltitudes()?
+   */
+  [[gnu::pure]]
+  bool IsTerrainClearanceEquivalent(const RoutePolars &other) const noexcept;
+
+  /**
+   * Would airspace intersection tests yield the same results with
+   * the other object?  Unlike
+   * terrain clearance tests, these depend on the cruise altitude and
+   * the climb settings, see GenerateIntermediate().
+   */
+  [[gnu::pure]]
+  bool IsAirspaceClearanceEquivalent(const RoutePolars &other) const noexcept;
+
   int GetSafetyHeight() const noexcept {
     return config.safety_height_terrain;
   }
@@ -69,15 +69,63 @@ TerrainRoute::Intersection(const AGeoPoint &origin,
   return rpolars_route.Intersection(origin, destination, terrain, proj);
 }
 
+void
+TerrainRoute::ClearClearanceCache() noexcept
+{
+  terrain_clearance.Clear();
+  clearance_center = GeoPoint::Invalid();
+}
+
+void
+TerrainRoute::Reset() noexcept
+{
+  RoutePlanner::Reset();
+  ClearClearanceCache();
+}
+
+void
+TerrainRoute::ValidateClearanceCache() noexcept
+{
+  if (terrain == nullptr)
+    return;
+
+  /* the terrain serial changes when tiles are loaded or discarded */
+  if (terrain == clearance_terrain &&
+      terrain->GetSerial() == clearance_terrain_serial &&
+      projection.GetCenter() == clearance_center &&
+      rpolars_route.IsTerrainClearanceEquivalent(clearance_rpolars))
+    return;
+
+  terrain_clearance.Clear();
+  clearance_terrain = terrain;
+  clearance_terrain_serial = terrain->GetSerial();
+  clearance_center = projection.GetCenter();
+  clearance_rpolars = rpolars_route;
+  clearance_rpolars.QuantiseClearanceAltitudes();
+}
+
 bool
 TerrainRoute::IsClear(const RouteLink &e) const noexcept
 {
   if (terrain == nullptr || !terrain->IsDefined())
     return true;
 
-  auto inp = rpolars_route.CheckClearance(e, *terrain, projection);
-  if (inp)
+  const RouteLink q = RoutePolars::QuantiseClearanceLink(e);
+
+  std::optional<RoutePoint> inp;
+  if (const auto *cached = terrain_clearance.Find(q))
+    inp = *cached;
+  else {
+    inp = clearance_rpolars.CheckClearance(q, *terrain, projection);
+    terrain_clearance.Insert(q, inp);
+  }
+
+  if (inp) {
+    /* undo the rounding of the origin altitude, so the intercept is
+       not below the start of the link */
     m_inx_terrain = *inp;
+    m_inx_terrain.altitude += e.first.altitude - q.first.altitude;
+  }
   return !inp;
 }
 
@@ -4,6 +4,10 @@
 #pragma once
 
 #include "RoutePlanner.hpp"
+#include "RouteClearanceCache.hpp"
+#include "util/Serial.hpp"
+
+#include <optional>
 
 class ReachFan;
 
@@ -27,6 +31,19 @@ class TerrainRoute: public RoutePlanner
 
   mutable RoutePoint m_inx_terrain;
 
+  /**
+   * Results of RoutePolars::CheckClearance() from previous solves.
+   */
+  mutable RouteClearanceCache<std::optional<RoutePoint>> terrain_clearance;
+
+  /* the parameters #terrain_clearance was filled with; the tests
+     are performed with #clearance_rpolars, whose altitudes are
+     quantised (see RoutePolars::CLEARANCE_ALTITUDE_BAND) */
+  const RasterMap *clearance_terrain = nullptr;
+  Serial clearance_terrain_serial;
+  GeoPoint clearance_center = GeoPoint::Invalid();
+  RoutePolars clearance_rpolars;
+
 public:
   friend class PrintHelper;
 
@@ -38,6 +55,17 @@ public:
     terrain = _terrain;
   }
 
+  const auto &GetTerrainClearanceCache() const noexcept {
+    return terrain_clearance;
+  }
+
+  /**
+   * Discard all cached clearance test results.
+   */
+  virtual void ClearClearanceCache() noexcept;
+
+  void Reset() noexcept override;
+
   const auto &GetReachPolar() const noexcept {
     return rpolars_reach;
   }
@@ -77,6 +105,7 @@ public:
                         const AGeoPoint &destination) const noexcept;
 
 protected:
+  void ValidateClearanceCache() noexcept override;
   bool IsClear(const RouteLink &e) const noexcept override;
   void AddNearby(const RouteLink &e) noexcept override;
 
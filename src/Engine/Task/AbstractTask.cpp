@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "AbstractTask.hpp"
+#include "TaskProgress.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Points/TaskWaypoint.hpp"
 #include "Util/Gradient.hpp"
@@ -291,6 +292,31 @@ AbstractTask::Reset() noexcept
   force_full_update = true;
 }
 
+void
+AbstractTask::SaveProgress(TaskProgress &progress) const noexcept
+{
+  progress.active_task_point = active_task_point;
+  progress.stats = stats;
+  progress.stats_computer = stats_computer;
+  progress.mc_lpf = mc_lpf;
+  progress.ce_lpf = ce_lpf;
+  progress.em_lpf = em_lpf;
+  progress.mc_lpf_valid = mc_lpf_valid;
+}
+
+void
+AbstractTask::RestoreProgress(const TaskProgress &progress) noexcept
+{
+  active_task_point = progress.active_task_point;
+  stats = progress.stats;
+  stats_computer = progress.stats_computer;
+  mc_lpf = progress.mc_lpf;
+  ce_lpf = progress.ce_lpf;
+  em_lpf = progress.em_lpf;
+  mc_lpf_valid = progress.mc_lpf_valid;
+  force_full_update = true;
+}
+
 double
 AbstractTask::CalcLegGradient(const AircraftState &aircraft) const noexcept
 {
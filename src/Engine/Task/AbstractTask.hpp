@@ -13,6 +13,7 @@
 class TaskPointConstVisitor;
 class TaskEvents;
 class GlidePolar;
+struct TaskProgress;
 
 /**
  * Abstract base class for actual navigatable tasks.
@@ -378,6 +379,9 @@ protected:
    */
   void UpdateStatsDistances(const GeoPoint &location, const bool full_update) noexcept;
 
+  void SaveProgress(TaskProgress &progress) const noexcept;
+  void RestoreProgress(const TaskProgress &progress) noexcept;
+
 private:
   void UpdateGlideSolutions(const AircraftState &state,
                             const GlidePolar &glide_polar) noexcept;
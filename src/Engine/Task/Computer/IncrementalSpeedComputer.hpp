@@ -19,7 +19,7 @@ class IncrementalSpeedComputer {
   AvFilter<N_AV> av_dist;
   DiffFilter df;
   Filter v_lpf;
-  const bool is_positive;
+  bool is_positive;
 
   TimeStamp last_time;
 
@@ -3,6 +3,7 @@
 
 #include "OrderedTask.hpp"
 #include "Task/TaskEvents.hpp"
+#include "Task/TaskProgress.hpp"
 #include "Points/OrderedTaskPoint.hpp"
 #include "Points/StartPoint.hpp"
 #include "Points/FinishPoint.hpp"
@@ -28,6 +29,8 @@
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
 #include "Task/ObservationZones/CylinderZone.hpp"
 
+#include <algorithm>
+
 /**
  * According to "FAI Sporting Code / Annex A to Section 3 - Gliding",
  * 6.3.1c and 6.3.2dii, the radius of the "start/finish ring" must be
@@ -1102,6 +1105,73 @@ OrderedTask::Reset() noexcept
   UpdateStatsGeometry();
 }
 
+static void
+SaveProgress(const OrderedTask::OrderedTaskPointVector &points,
+             std::vector<TaskPointProgress> &progress) noexcept
+{
+  progress.resize(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const OrderedTaskPoint &tp = *points[i];
+    tp.SaveProgress(progress[i]);
+    progress[i].type = tp.GetType();
+    progress[i].observation_zone = tp.GetObservationZone().Clone();
+  }
+}
+
+[[gnu::pure]]
+static bool
+MatchProgress(const OrderedTask::OrderedTaskPointVector &points,
+              const std::vector<TaskPointProgress> &progress) noexcept
+{
+  return std::equal(points.begin(), points.end(),
+                    progress.begin(), progress.end(),
+                    [](const auto &tp, const TaskPointProgress &p){
+                      return tp->GetLocation() == p.location &&
+                        tp->GetType() == p.type &&
+                        p.observation_zone != nullptr &&
+                        tp->GetObservationZone().Equals(*p.observation_zone);
+                    });
+}
+
+static void
+RestoreProgress(OrderedTask::OrderedTaskPointVector &points,
+                const std::vector<TaskPointProgress> &progress) noexcept
+{
+  assert(points.size() == progress.size());
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+    points[i]->RestoreProgress(progress[i]);
+}
+
+void
+OrderedTask::SaveProgress(TaskProgress &progress) const noexcept
+{
+  AbstractTask::SaveProgress(progress);
+  progress.task_advance = task_advance;
+  progress.last_min_location = last_min_location;
+  ::SaveProgress(task_points, progress.task_points);
+  ::SaveProgress(optional_start_points, progress.optional_start_points);
+}
+
+bool
+OrderedTask::RestoreProgress(const TaskProgress &progress) noexcept
+{
+  if (!MatchProgress(task_points, progress.task_points) ||
+      !MatchProgress(optional_start_points, progress.optional_start_points))
+    return false;
+
+  AbstractTask::RestoreProgress(progress);
+  task_advance = progress.task_advance;
+  last_min_location = progress.last_min_location;
+  ::RestoreProgress(task_points, progress.task_points);
+  ::RestoreProgress(optional_start_points, progress.optional_start_points);
+
+  if (taskpoint_start != nullptr)
+    taskpoint_start->ScanActive(*task_points[active_task_point]);
+
+  return true;
+}
+
 bool
 OrderedTask::TaskStarted(bool soft) const noexcept
 {
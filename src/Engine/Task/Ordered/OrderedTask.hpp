@@ -646,6 +646,20 @@ public:
   bool UpdateIdle(const AircraftState& state_now,
                   const GlidePolar &glide_polar) noexcept override;
 
+  /**
+   * Copy the state which changes while flying the task (but not the
+   * task definition) to the specified #TaskProgress.
+   */
+  void SaveProgress(TaskProgress &progress) const noexcept;
+
+  /**
+   * Restore the state saved by SaveProgress().
+   *
+   * @return false if the task has been edited since, and nothing
+   * was restored
+   */
+  bool RestoreProgress(const TaskProgress &progress) noexcept;
+
   /* virtual methods from class AbstractTask */
   void Reset() noexcept override;
   bool TaskStarted(bool soft=false) const noexcept override;
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "AATPoint.hpp"
+#include "Task/Points/TaskPointProgress.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/Flat/FlatLine.hpp"
 #include "util/Compiler.h"
@@ -18,6 +19,22 @@ AATPoint::GetLocationRemaining() const noexcept
   return GetLocationMin();
 }
 
+void
+AATPoint::SaveProgress(TaskPointProgress &progress) const noexcept
+{
+  IntermediateTaskPoint::SaveProgress(progress);
+  progress.target_location = target_location;
+  progress.target_locked = target_locked;
+}
+
+void
+AATPoint::RestoreProgress(const TaskPointProgress &progress) noexcept
+{
+  IntermediateTaskPoint::RestoreProgress(progress);
+  target_location = progress.target_location;
+  target_locked = progress.target_locked;
+}
+
 bool
 AATPoint::UpdateSampleNear(const AircraftState &state,
                            const FlatProjection &projection) noexcept
@@ -188,6 +188,10 @@ public:
   /* virtual methods from class TaskPoint */
   const GeoPoint &GetLocationRemaining() const noexcept override;
 
+  /* virtual methods from class ScoredTaskPoint */
+  void SaveProgress(TaskPointProgress &progress) const noexcept override;
+  void RestoreProgress(const TaskPointProgress &progress) noexcept override;
+
   /* virtual methods from class ObservationZoneClient */
   double ScoreAdjustment() const noexcept override {
     return 0;
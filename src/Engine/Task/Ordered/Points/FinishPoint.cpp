@@ -3,6 +3,7 @@
 
 #include "FinishPoint.hpp"
 #include "Task/TaskBehaviour.hpp"
+#include "Task/Points/TaskPointProgress.hpp"
 
 #include <stdlib.h>
 #include <cassert>
@@ -31,6 +32,20 @@ FinishPoint::Reset() noexcept
   fai_finish_height = 0;
 }
 
+void
+FinishPoint::SaveProgress(TaskPointProgress &progress) const noexcept
+{
+  OrderedTaskPoint::SaveProgress(progress);
+  progress.fai_finish_height = fai_finish_height;
+}
+
+void
+FinishPoint::RestoreProgress(const TaskPointProgress &progress) noexcept
+{
+  OrderedTaskPoint::RestoreProgress(progress);
+  fai_finish_height = progress.fai_finish_height;
+}
+
 bool
 FinishPoint::EntryPrecondition() const noexcept
 {
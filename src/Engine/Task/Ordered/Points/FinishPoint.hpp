@@ -57,6 +57,8 @@ public:
 
   /* virtual methods from class ScoredTaskPoint */
   void Reset() noexcept override;
+  void SaveProgress(TaskPointProgress &progress) const noexcept override;
+  void RestoreProgress(const TaskPointProgress &progress) noexcept override;
   bool CheckEnterTransition(const AircraftState &ref_now,
                             const AircraftState &ref_last) const noexcept override;
 
@@ -4,6 +4,7 @@
 #include "SampledTaskPoint.hpp"
 #include "Task/ObservationZones/Boundary.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "TaskPointProgress.hpp"
 
 SampledTaskPoint::SampledTaskPoint(const GeoPoint &location,
                                    const bool b_scored) noexcept
@@ -88,6 +89,25 @@ SampledTaskPoint::Reset() noexcept
   sampled_points.clear();
 }
 
+void
+SampledTaskPoint::SaveProgress(TaskPointProgress &progress) const noexcept
+{
+  progress.location = GetLocation();
+  progress.past = past;
+  progress.sampled_points = sampled_points;
+  progress.search_max = search_max;
+  progress.search_min = search_min;
+}
+
+void
+SampledTaskPoint::RestoreProgress(const TaskPointProgress &progress) noexcept
+{
+  past = progress.past;
+  sampled_points = progress.sampled_points;
+  search_max = progress.search_max;
+  search_min = progress.search_min;
+}
+
 const SearchPointVector &
 SampledTaskPoint::GetSearchPoints() const noexcept
 {
@@ -9,6 +9,7 @@ class FlatProjection;
 class OZBoundary;
 struct GeoPoint;
 struct AircraftState;
+struct TaskPointProgress;
 
 /**
  * Abstract specialisation of TaskPoint which has an observation zone
@@ -56,6 +57,17 @@ public:
   /** Reset the task (as if never flown) */
   void Reset() noexcept;
 
+  /**
+   * Copy the samples to the specified #TaskPointProgress.
+   */
+  void SaveProgress(TaskPointProgress &progress) const noexcept;
+
+  /**
+   * Restore the samples saved by SaveProgress().  The task projection
+   * must not have changed since then.
+   */
+  void RestoreProgress(const TaskPointProgress &progress) noexcept;
+
   const GeoPoint &GetLocation() const noexcept {
     return nominal_points.front().GetLocation();
   }
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright The XCSoar Project
 #include "ScoredTaskPoint.hpp"
+#include "TaskPointProgress.hpp"
 
 ScoredTaskPoint::ScoredTaskPoint(const GeoPoint &location, bool b_scored) noexcept
   :SampledTaskPoint(location, b_scored)
@@ -9,6 +10,22 @@ ScoredTaskPoint::ScoredTaskPoint(const GeoPoint &location, bool b_scored) noexce
   exited_state.ResetTime();
 }
 
+void
+ScoredTaskPoint::SaveProgress(TaskPointProgress &progress) const noexcept
+{
+  SampledTaskPoint::SaveProgress(progress);
+  progress.entered_state = entered_state;
+  progress.exited_state = exited_state;
+}
+
+void
+ScoredTaskPoint::RestoreProgress(const TaskPointProgress &progress) noexcept
+{
+  SampledTaskPoint::RestoreProgress(progress);
+  entered_state = progress.entered_state;
+  exited_state = progress.exited_state;
+}
+
 bool 
 ScoredTaskPoint::TransitionEnter(const AircraftState &ref_now,
                                  const AircraftState &ref_last) noexcept
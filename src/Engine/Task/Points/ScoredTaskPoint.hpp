@@ -65,6 +65,17 @@ public:
 
   virtual void Reset() noexcept;
 
+  /**
+   * Copy the state which changes while flying to the specified
+   * #TaskPointProgress.
+   */
+  virtual void SaveProgress(TaskPointProgress &progress) const noexcept;
+
+  /**
+   * Restore the state saved by SaveProgress().
+   */
+  virtual void RestoreProgress(const TaskPointProgress &progress) noexcept;
+
   /**
    * Test whether aircraft has exited the OZ
    *
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Type.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Navigation/Aircraft.hpp"
+
+#include <memory>
+
+class ObservationZonePoint;
+
+/**
+ * A copy of the state of a task point which changes while the task
+ * is being flown (but not of its definition).  It is used to restore
+ * the task progress, e.g. when seeking backwards during replay.
+ */
+struct TaskPointProgress {
+  /**
+   * The reference location of the task point, used to verify that
+   * the progress is restored to the same task.
+   */
+  GeoPoint location;
+
+  /**
+   * A copy of the task point's definition, used to verify that the
+   * observation zone has not been edited since.
+   */
+  TaskPointType type;
+  std::shared_ptr<const ObservationZonePoint> observation_zone;
+
+  /* SampledTaskPoint */
+  bool past;
+  SearchPointVector sampled_points;
+  SearchPoint search_max, search_min;
+
+  /* ScoredTaskPoint */
+  AircraftState entered_state, exited_state;
+
+  /* AATPoint */
+  GeoPoint target_location;
+  bool target_locked;
+
+  /* FinishPoint */
+  double fai_finish_height;
+};
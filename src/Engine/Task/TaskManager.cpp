@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "TaskManager.hpp"
+#include "TaskProgress.hpp"
 #include "Ordered/OrderedTask.hpp"
 #include "Ordered/Points/OrderedTaskPoint.hpp"
 #include "Ordered/Points/AATPoint.hpp"
@@ -368,6 +369,25 @@ TaskManager::Reset() noexcept
   glide_polar.SetCruiseEfficiency(1);
 }
 
+void
+TaskManager::SaveProgress(TaskProgress &progress) const noexcept
+{
+  ordered_task->SaveProgress(progress);
+  progress.common_stats = common_stats;
+}
+
+bool
+TaskManager::RestoreProgress(const TaskProgress &progress) noexcept
+{
+  if (!ordered_task->RestoreProgress(progress)) {
+    Reset();
+    return false;
+  }
+
+  common_stats = progress.common_stats;
+  return true;
+}
+
 GeoPoint
 TaskManager::RandomPointInTask(const unsigned index, const double mag) const noexcept
 {
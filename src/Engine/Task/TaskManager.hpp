@@ -25,6 +25,7 @@ class AlternateList;
 class TaskWaypoint;
 class AbortIntersectionTest;
 struct RangeAndRadial;
+struct TaskProgress;
 
 /**
  *  Main interface exposed to clients for providing access to common types
@@ -121,6 +122,20 @@ public:
   /** Reset the tasks (as if never flown) */
   void Reset() noexcept;
 
+  /**
+   * Copy the progress of the ordered task to the specified
+   * #TaskProgress, see OrderedTask::SaveProgress().
+   */
+  void SaveProgress(TaskProgress &progress) const noexcept;
+
+  /**
+   * Restore the progress saved by SaveProgress().  If the ordered
+   * task has been edited since, it is reset instead.
+   *
+   * @return true if the progress was restored
+   */
+  bool RestoreProgress(const TaskProgress &progress) noexcept;
+
   /** Set active task to abort mode. */
   void Abort() noexcept {
     SetMode(TaskType::ABORT);
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Stats/TaskStats.hpp"
+#include "Stats/CommonStats.hpp"
+#include "Computer/TaskStatsComputer.hpp"
+#include "Ordered/SmartTaskAdvance.hpp"
+#include "Points/TaskPointProgress.hpp"
+#include "Math/Filter.hpp"
+
+#include <vector>
+
+/**
+ * A copy of the state of a #TaskManager which changes while the
+ * ordered task is being flown (but not of the task definition).  It
+ * is used to restore the task progress, e.g. when seeking backwards
+ * during replay.
+ */
+struct TaskProgress {
+  /* AbstractTask */
+  unsigned active_task_point;
+  TaskStats stats;
+  TaskStatsComputer stats_computer;
+  Filter mc_lpf, ce_lpf, em_lpf;
+  bool mc_lpf_valid;
+
+  /* OrderedTask */
+  SmartTaskAdvance task_advance;
+  GeoPoint last_min_location;
+  std::vector<TaskPointProgress> task_points, optional_start_points;
+
+  /* TaskManager */
+  CommonStats common_stats;
+};
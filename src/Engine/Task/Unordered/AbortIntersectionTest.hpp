@@ -7,6 +7,11 @@ struct AGeoPoint;
 
 class AbortIntersectionTest {
 public:
+  /**
+   * @param waypoint_id the id of the destination waypoint, which
+   * allows looking up a precalculated result
+   */
   [[gnu::pure]]
-  virtual bool Intersects(const AGeoPoint &destination) const noexcept = 0;
+  virtual bool Intersects(const AGeoPoint &destination,
+                          unsigned waypoint_id) const noexcept = 0;
 };
@@ -81,7 +81,7 @@ AbortTask::Clear() noexcept
 
 double
 AbortTask::GetAbortRange(const AircraftState &state,
-                         const GlidePolar &glide_polar) const noexcept
+                         const GlidePolar &glide_polar) noexcept
 {
   // always scan at least min range or approx glide range
   return std::clamp(state.altitude * glide_polar.GetBestLD(),
@@ -129,7 +129,8 @@ AbortTask::FillReachable(const AircraftState &state,
 
       if (intersection_test && final_glide && is_reachable_final)
         intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint->location, result.min_arrival_altitude));
+            AGeoPoint(v->waypoint->location, result.min_arrival_altitude),
+            v->waypoint->id);
 
       if (!intersects) {
         q.emplace_back(v->waypoint, result);
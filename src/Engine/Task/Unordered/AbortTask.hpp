@@ -108,6 +108,17 @@ public:
   GeoVector GetHomeVector(const AircraftState &state) const noexcept;
   WaypointPtr GetHome() const noexcept;
 
+  /**
+   * Calculate distance to search for landable waypoints for aircraft.
+   *
+   * @param state_now Aircraft state
+   *
+   * @return Distance (m) of approximate glide range of aircraft
+   */
+  [[gnu::pure]]
+  static double GetAbortRange(const AircraftState &state_now,
+                              const GlidePolar &glide_polar) noexcept;
+
 protected:
   /**
    * Clears task points in list
@@ -124,17 +135,6 @@ protected:
     return task_points.size() >= max_abort;
   }
 
-  /**
-   * Calculate distance to search for landable waypoints for aircraft.
-   *
-   * @param state_now Aircraft state
-   *
-   * @return Distance (m) of approximate glide range of aircraft
-   */
-  [[gnu::pure]]
-  double GetAbortRange(const AircraftState &state_now,
-                       const GlidePolar &glide_polar) const noexcept;
-
   /**
    * Fill abort task list with candidate waypoints given a list of
    * waypoints satisfying approximate range queries.  Can be used
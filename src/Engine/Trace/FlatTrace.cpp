@@ -0,0 +1,490 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlatTrace.hpp"
+#include "Metric.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+
+FlatTrace::FlatTrace(const Time _no_thin_time, const Time _max_time,
+                     const unsigned _max_size) noexcept
+  :max_time(_max_time),
+   no_thin_time(_no_thin_time),
+   max_size(_max_size),
+   opt_size((3 * _max_size) / 4),
+   points(new TracePoint[_max_size]),
+   ranks(new Rank[_max_size]),
+   average_delta_time{}, average_delta_distance(0)
+{
+  assert(max_size >= 4);
+
+  heap.reserve(max_size);
+}
+
+void
+FlatTrace::SiftUp(uint32_t position) noexcept
+{
+  const HeapEntry e = heap[position];
+
+  while (position > 0) {
+    const uint32_t parent = (position - 1) / 2;
+    if (!(e < heap[parent]))
+      break;
+
+    HeapMove(position, heap[parent]);
+    position = parent;
+  }
+
+  HeapMove(position, e);
+}
+
+void
+FlatTrace::SiftDown(uint32_t position) noexcept
+{
+  const HeapEntry e = heap[position];
+  const uint32_t size = heap.size();
+
+  while (true) {
+    uint32_t child = 2 * position + 1;
+    if (child >= size)
+      break;
+
+    if (child + 1 < size && heap[child + 1] < heap[child])
+      ++child;
+
+    if (!(heap[child] < e))
+      break;
+
+    HeapMove(position, heap[child]);
+    position = child;
+  }
+
+  HeapMove(position, e);
+}
+
+inline void
+FlatTrace::Sift(uint32_t position) noexcept
+{
+  if (position > 0 && heap[position] < heap[(position - 1) / 2])
+    SiftUp(position);
+  else
+    SiftDown(position);
+}
+
+void
+FlatTrace::HeapPush(uint32_t i) noexcept
+{
+  assert(ranks[i].heap_index == NOT_IN_HEAP);
+
+  heap.push_back(MakeHeapEntry(i));
+  SiftUp(heap.size() - 1);
+}
+
+void
+FlatTrace::HeapRemove(uint32_t i) noexcept
+{
+  const uint32_t position = ranks[i].heap_index;
+  assert(position < heap.size());
+  assert(heap[position].index == i);
+
+  ranks[i].heap_index = NOT_IN_HEAP;
+
+  const HeapEntry last = heap.back();
+  heap.pop_back();
+  if (last.index == i)
+    return;
+
+  HeapMove(position, last);
+  Sift(position);
+}
+
+void
+FlatTrace::UpdateRank(uint32_t previous, uint32_t i, uint32_t next) noexcept
+{
+  const TracePoint &p_last = points[previous];
+  const TracePoint &point = points[i];
+  const TracePoint &p_next = points[next];
+
+  Rank &rank = ranks[i];
+  rank.elim_time = TraceMetric::Time(p_last, point, p_next);
+  rank.elim_distance = TraceMetric::Distance(p_last, point, p_next);
+  rank.delta_distance = point.FlatDistanceTo(p_last);
+
+  if (rank.heap_index == NOT_IN_HEAP) {
+    /* this was an edge point */
+    HeapPush(i);
+  } else if (rank.heap_index == DEFERRED) {
+    /* EraseDelta() will put it back into the heap */
+  } else {
+    const uint32_t position = rank.heap_index;
+    heap[position] = MakeHeapEntry(i);
+    Sift(position);
+  }
+}
+
+void
+FlatTrace::MakeEdge(uint32_t i) noexcept
+{
+  Rank &rank = ranks[i];
+  if (rank.heap_index != NOT_IN_HEAP)
+    HeapRemove(i);
+
+  /* delta_distance is kept, just like Trace::EraseStart() does */
+  rank.elim_distance = null_delta;
+  rank.elim_time = null_time;
+}
+
+void
+FlatTrace::clear() noexcept
+{
+  average_delta_distance = 0;
+  average_delta_time = {};
+
+  head = n_points = 0;
+  heap.clear();
+
+  ++modify_serial;
+  ++append_serial;
+}
+
+FlatTrace::Time
+FlatTrace::GetRecentTime(const Time t) const noexcept
+{
+  if (empty())
+    return {};
+
+  const TracePoint &last = back();
+  if (last.GetTime() > t)
+    return last.GetTime() - t;
+
+  return {};
+}
+
+bool
+FlatTrace::EraseEarlierThan(const Time p_time) noexcept
+{
+  if (p_time == Time{} || empty() || front().GetTime() >= p_time)
+    // there will be nothing to remove
+    return false;
+
+  do {
+    if (ranks[head].heap_index != NOT_IN_HEAP)
+      HeapRemove(head);
+
+    if (++head == max_size)
+      head = 0;
+    --n_points;
+  } while (!empty() && front().GetTime() < p_time);
+
+  if (empty())
+    head = 0;
+  else
+    MakeEdge(head);
+
+  ++modify_serial;
+  ++append_serial;
+  return true;
+}
+
+void
+FlatTrace::EraseLaterThan(const Time min_time) noexcept
+{
+  assert(min_time.count() > 0);
+  assert(!empty());
+
+  while (!empty() && back().GetTime() > min_time) {
+    const uint32_t i = ToIndex(n_points - 1);
+    if (ranks[i].heap_index != NOT_IN_HEAP)
+      HeapRemove(i);
+
+    --n_points;
+  }
+
+  if (!empty())
+    MakeEdge(ToIndex(n_points - 1));
+}
+
+void
+FlatTrace::EnforceTimeWindow(const Time latest_time) noexcept
+{
+  if (max_time == null_time)
+    /* no time window configured */
+    return;
+
+  if (latest_time <= max_time)
+    /* see Trace::EnforceTimeWindow() */
+    return;
+
+  EraseEarlierThan(latest_time - max_time);
+}
+
+inline void
+FlatTrace::EraseInside(uint32_t i) noexcept
+{
+  assert(ranks[i].heap_index != NOT_IN_HEAP);
+
+  HeapRemove(i);
+
+  const uint32_t previous = prev_link[i], next = next_link[i];
+  next_link[previous] = next;
+  prev_link[next] = previous;
+
+  // and update the deltas (except for the edges)
+  if (previous != head)
+    UpdateRank(prev_link[previous], previous, next);
+
+  if (next != ToIndex(n_points - 1))
+    UpdateRank(previous, next, next_link[next]);
+}
+
+unsigned
+FlatTrace::EraseDelta(unsigned n, const unsigned target_size,
+                      const Time recent_time) noexcept
+{
+  if (n <= 2)
+    return n;
+
+  /* Trace::EraseDelta() walks the ranking from the top, skipping
+     recent points, and restarts after each erasure; popping recent
+     points from the heap until the end of this pass selects the same
+     points */
+
+  assert(deferred.empty());
+
+  while (n > target_size && !heap.empty()) {
+    const uint32_t i = heap.front().index;
+    if (points[i].GetTime() < recent_time) {
+      EraseInside(i);
+      --n;
+    } else {
+      HeapRemove(i);
+      ranks[i].heap_index = DEFERRED;
+      deferred.push_back(i);
+    }
+  }
+
+  for (const auto i : deferred) {
+    ranks[i].heap_index = NOT_IN_HEAP;
+    HeapPush(i);
+  }
+
+  deferred.clear();
+
+  return n;
+}
+
+inline void
+FlatTrace::Compact(unsigned n) noexcept
+{
+  unsigned src = head;
+  for (unsigned position = 0; position < n; ++position) {
+    const unsigned dest = ToIndex(position);
+    if (src != dest) {
+      points[dest] = points[src];
+      ranks[dest] = ranks[src];
+
+      if (ranks[dest].heap_index != NOT_IN_HEAP)
+        heap[ranks[dest].heap_index].index = dest;
+    }
+
+    src = next_link[src];
+  }
+
+  n_points = n;
+}
+
+void
+FlatTrace::Thin() noexcept
+{
+  assert(size() == max_size);
+
+  /* link all points; the edges stay where they are during thinning,
+     therefore front() and back() remain valid */
+  prev_link.resize(max_size);
+  next_link.resize(max_size);
+  for (unsigned position = 0; position < n_points; ++position) {
+    const unsigned i = ToIndex(position);
+    prev_link[i] = position > 0 ? ToIndex(position - 1) : i;
+    next_link[i] = position + 1 < n_points ? ToIndex(position + 1) : i;
+  }
+
+  const unsigned target_size = opt_size;
+
+  // if still too big, remove points based on line simplification
+  unsigned n = EraseDelta(n_points, target_size,
+                          GetRecentTime(no_thin_time));
+
+  // if still too big, thin again, ignoring recency
+  if (n > target_size && no_thin_time.count() > 0)
+    n = EraseDelta(n, target_size, GetRecentTime({}));
+
+  assert(n <= target_size);
+
+  Compact(n);
+
+  assert(size() < max_size);
+
+  average_delta_distance = CalcAverageDeltaDistance(no_thin_time);
+  average_delta_time = CalcAverageDeltaTime(no_thin_time);
+
+  ++modify_serial;
+  ++append_serial;
+}
+
+void
+FlatTrace::push_back(const TracePoint &point) noexcept
+{
+  const Time min_delta = std::chrono::seconds{2};
+
+  if (empty()) {
+    // first point determines origin for flat projection
+    task_projection.Reset(point.GetLocation());
+    task_projection.Update();
+  } else if (point.GetTime() < back().GetTime()) {
+    // gone back in time
+
+    const Time clear_threshold = std::chrono::minutes{3};
+    const Time fix_threshold = std::chrono::seconds{10};
+
+    if (point.GetTime() + clear_threshold < back().GetTime()) {
+      /* not fixable, clear the trace and restart from scratch */
+      clear();
+      return;
+    }
+
+    /* not much, try to fix it */
+    EraseLaterThan(point.GetTime() - fix_threshold);
+    ++modify_serial;
+  } else if (point.GetTime() - back().GetTime() < min_delta)
+    // only add one item per two seconds
+    return;
+
+  EnforceTimeWindow(point.GetTime());
+
+  if (size() >= max_size)
+    Thin();
+
+  assert(size() < max_size);
+
+  const uint32_t i = ToIndex(n_points++);
+  points[i] = point;
+  points[i].Project(task_projection);
+  ranks[i] = {null_time, null_delta, 0, NOT_IN_HEAP};
+
+  if (n_points >= 3)
+    /* the previous point is not an edge anymore */
+    UpdateRank(ToIndex(n_points - 3), ToIndex(n_points - 2), i);
+
+  ++append_serial;
+}
+
+unsigned
+FlatTrace::CalcAverageDeltaDistance(const Time no_thin) const noexcept
+{
+  const Time r = GetRecentTime(no_thin);
+  unsigned acc = 0;
+  unsigned counter = 0;
+
+  for (; counter < n_points; ++counter) {
+    const unsigned i = ToIndex(counter);
+    if (points[i].GetTime() >= r)
+      break;
+
+    acc += ranks[i].delta_distance;
+  }
+
+  if (counter)
+    return acc / counter;
+
+  return 0;
+}
+
+FlatTrace::Time
+FlatTrace::CalcAverageDeltaTime(const Time no_thin) const noexcept
+{
+  const Time r = GetRecentTime(no_thin);
+
+  /* find the last item before the "r" timestamp */
+  unsigned counter = 0;
+  while (counter < n_points && At(counter).GetTime() < r)
+    ++counter;
+
+  if (counter < 2)
+    return {};
+
+  Time start_time = front().GetTime();
+  Time end_time = At(counter - 1).GetTime();
+  return (end_time - start_time) / (counter - 1);
+}
+
+void
+FlatTrace::GetPoints(TracePointVector &v) const noexcept
+{
+  v.clear();
+  v.reserve(size());
+
+  /* copy the (at most two) contiguous parts of the ring buffer */
+  const unsigned first = std::min(n_points, max_size - head);
+  v.insert(v.end(), &points[head], &points[head] + first);
+  v.insert(v.end(), &points[0], &points[0] + (n_points - first));
+}
+
+void
+FlatTrace::GetPoints(TracePointerVector &v) const noexcept
+{
+  v.clear();
+  v.reserve(size());
+
+  for (unsigned position = 0; position < n_points; ++position)
+    v.push_back(&At(position));
+}
+
+bool
+FlatTrace::SyncPoints(TracePointerVector &v) const noexcept
+{
+  assert(v.size() <= size());
+
+  if (v.size() == size())
+    /* no news */
+    return false;
+
+  v.reserve(size());
+
+  for (unsigned position = v.size(); position < n_points; ++position)
+    v.push_back(&At(position));
+
+  return true;
+}
+
+void
+FlatTrace::GetPoints(TracePointVector &v, const Time min_time,
+                     const GeoPoint &location,
+                     double min_distance) const noexcept
+{
+  /* skip the trace points that are before min_time */
+  const_iterator i = begin(), end = this->end();
+  unsigned skipped = 0;
+  while (true) {
+    if (i == end)
+      /* nothing left */
+      return;
+
+    if (i->GetTime() >= min_time)
+      /* found the first point that is within range */
+      break;
+
+    ++i;
+    ++skipped;
+  }
+
+  assert(skipped < size());
+
+  v.reserve(size() - skipped);
+  const unsigned range = ProjectRange(location, min_distance);
+  const unsigned sq_range = range * range;
+  do {
+    v.push_back(*i);
+    i.NextSquareRange(sq_range, end);
+  } while (i != end);
+}
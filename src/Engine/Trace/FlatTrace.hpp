@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Point.hpp"
+#include "util/NonCopyable.hpp"
+#include "util/Serial.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "time/Stamp.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+class TracePointVector;
+class TracePointerVector;
+
+/**
+ * An alternative implementation of #Trace with the same interface
+ * and the same thinning algorithm (and results), but with a flat
+ * memory layout: the points are kept in chronological order in a
+ * ring buffer which is allocated once, their thinning ranks in a
+ * parallel array, and the ranking is a binary heap of buffer indexes
+ * and ranking keys.
+ * Iterating over the points does not chase pointers.
+ *
+ * Erasing points in the middle (thinning) leaves holes which are
+ * linked temporarily and compacted at the end of each Thin() call.
+ * Pointers to points remain valid until the modify serial changes,
+ * just like with #Trace.
+ *
+ * Unlike #Trace, points cannot be shared with other instances.
+ */
+class FlatTrace : private NonCopyable
+{
+  using Time = TracePoint::Time;
+
+  /**
+   * The thinning metrics of one point, see Trace::TraceDelta.  Edge
+   * points (the first and the last one) have #null_delta and
+   * #null_time and are not in the heap.
+   */
+  struct Rank {
+    Time elim_time;
+    unsigned elim_distance;
+    unsigned delta_distance;
+
+    /**
+     * The position in #heap, #NOT_IN_HEAP or #DEFERRED.
+     */
+    uint32_t heap_index;
+  };
+
+  static constexpr uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+  /**
+   * Removed from the heap temporarily by EraseDelta(), see #deferred.
+   */
+  static constexpr uint32_t DEFERRED = UINT32_MAX - 1;
+
+  /**
+   * An element of #heap.  It contains a copy of the ranking key, so
+   * sifting does not need to look up the #Rank of each point.
+   */
+  struct HeapEntry {
+    /**
+     * The distance error (upper 32 bits) and the time error (lower
+     * 32 bits); this orders like Trace::TraceDelta::DeltaRank().
+     */
+    uint64_t key;
+
+    /**
+     * The time stamp of the point, the final tie breaker.
+     */
+    uint32_t time;
+
+    /**
+     * The buffer index of the point.
+     */
+    uint32_t index;
+
+    constexpr bool operator<(const HeapEntry &other) const noexcept {
+      return key != other.key ? key < other.key : time < other.time;
+    }
+  };
+
+  const Time max_time;
+  const Time no_thin_time;
+  const unsigned max_size;
+  const unsigned opt_size;
+
+  const std::unique_ptr<TracePoint[]> points;
+  const std::unique_ptr<Rank[]> ranks;
+
+  /**
+   * The buffer index of the first (oldest) point and the number of
+   * points.
+   */
+  unsigned head = 0, n_points = 0;
+
+  /**
+   * A binary min-heap of all non-edge points.
+   */
+  std::vector<HeapEntry> heap;
+
+  /**
+   * Temporary links between the remaining points during Thin(),
+   * indexed by buffer index.
+   */
+  std::vector<uint32_t> prev_link, next_link;
+
+  /**
+   * Points removed from #heap temporarily by EraseDelta() because
+   * they are too recent to be erased.
+   */
+  std::vector<uint32_t> deferred;
+
+  TaskProjection task_projection;
+
+  Time average_delta_time;
+  unsigned average_delta_distance;
+
+  Serial append_serial, modify_serial;
+
+public:
+  /**
+   * @see Trace::Trace()
+   */
+  explicit FlatTrace(const Time no_thin_time = {},
+                     const Time max_time = null_time,
+                     const unsigned max_size = 1000) noexcept;
+
+  /**
+   * @see Trace::push_back()
+   */
+  void push_back(const TracePoint &point) noexcept;
+
+  void clear() noexcept;
+
+  void EraseEarlierThan(TimeStamp time) noexcept {
+    EraseEarlierThan(time.Cast<Time>());
+  }
+
+  void EraseLaterThan(TimeStamp time) noexcept {
+    EraseLaterThan(time.Cast<Time>());
+  }
+
+  unsigned GetMaxSize() const noexcept {
+    return max_size;
+  }
+
+  unsigned size() const noexcept {
+    return n_points;
+  }
+
+  bool empty() const noexcept {
+    return n_points == 0;
+  }
+
+  /**
+   * @see Trace::GetAppendSerial()
+   */
+  const Serial &GetAppendSerial() const noexcept {
+    return append_serial;
+  }
+
+  /**
+   * @see Trace::GetModifySerial()
+   */
+  const Serial &GetModifySerial() const noexcept {
+    return modify_serial;
+  }
+
+  void GetPoints(TracePointVector &v) const noexcept;
+  void GetPoints(TracePointerVector &v) const noexcept;
+
+  /**
+   * @see Trace::SyncPoints()
+   */
+  bool SyncPoints(TracePointerVector &v) const noexcept;
+
+  /**
+   * @see Trace::GetPoints()
+   */
+  void GetPoints(TracePointVector &v, Time min_time,
+                 const GeoPoint &location, double resolution) const noexcept;
+
+  const TracePoint &front() const noexcept {
+    assert(!empty());
+
+    return points[head];
+  }
+
+  const TracePoint &back() const noexcept {
+    assert(!empty());
+
+    return points[ToIndex(n_points - 1)];
+  }
+
+  static constexpr auto null_time = TracePoint::INVALID_TIME;
+
+  /**
+   * The number of bytes per point used by this object, for memory
+   * statistics.
+   */
+  static constexpr std::size_t BYTES_PER_POINT =
+    sizeof(TracePoint) + sizeof(Rank) + sizeof(HeapEntry);
+
+  unsigned GetAverageDeltaDistance() const noexcept {
+    return average_delta_distance;
+  }
+
+  Time GetAverageDeltaTime() const noexcept {
+    return average_delta_time;
+  }
+
+  class const_iterator {
+    friend class FlatTrace;
+
+    const FlatTrace *trace;
+
+    /**
+     * The chronological position (not the buffer index).
+     */
+    unsigned position;
+
+    constexpr const_iterator(const FlatTrace &_trace,
+                             unsigned _position) noexcept
+      :trace(&_trace), position(_position) {}
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = const TracePoint;
+    using pointer = const TracePoint *;
+    using reference = const TracePoint &;
+
+    const_iterator() = default;
+
+    const TracePoint &operator*() const noexcept {
+      return trace->At(position);
+    }
+
+    const TracePoint *operator->() const noexcept {
+      return &trace->At(position);
+    }
+
+    const_iterator &operator++() noexcept {
+      ++position;
+      return *this;
+    }
+
+    const_iterator &operator--() noexcept {
+      --position;
+      return *this;
+    }
+
+    constexpr bool operator==(const const_iterator &other) const noexcept {
+      return position == other.position;
+    }
+
+    constexpr bool operator!=(const const_iterator &other) const noexcept {
+      return position != other.position;
+    }
+
+    const_iterator &NextSquareRange(unsigned sq_resolution,
+                                    const const_iterator &end) noexcept {
+      const TracePoint &previous = **this;
+      while (true) {
+        ++*this;
+
+        if (*this == end)
+          return *this;
+
+        if ((**this).FlatSquareDistanceTo(previous) >= sq_resolution)
+          return *this;
+      }
+    }
+  };
+
+  const_iterator begin() const noexcept {
+    return {*this, 0};
+  }
+
+  const_iterator end() const noexcept {
+    return {*this, n_points};
+  }
+
+  const TaskProjection &GetProjection() const noexcept {
+    return task_projection;
+  }
+
+  [[gnu::pure]]
+  unsigned ProjectRange(const GeoPoint &location, double distance) const noexcept {
+    return task_projection.ProjectRangeInteger(location, distance);
+  }
+
+private:
+  static constexpr unsigned null_delta = 0 - 1;
+
+  /**
+   * Convert a chronological position to a buffer index.
+   */
+  unsigned ToIndex(unsigned position) const noexcept {
+    assert(position < max_size);
+
+    unsigned i = head + position;
+    if (i >= max_size)
+      i -= max_size;
+    return i;
+  }
+
+  const TracePoint &At(unsigned position) const noexcept {
+    assert(position < n_points);
+
+    return points[ToIndex(position)];
+  }
+
+  [[gnu::pure]]
+  HeapEntry MakeHeapEntry(uint32_t i) const noexcept {
+    const Rank &rank = ranks[i];
+    return {
+      (uint64_t(rank.elim_distance) << 32) | rank.elim_time.count(),
+      points[i].GetTime().count(),
+      i,
+    };
+  }
+
+  void HeapMove(uint32_t position, const HeapEntry &e) noexcept {
+    heap[position] = e;
+    ranks[e.index].heap_index = position;
+  }
+
+  /**
+   * Move the entry at the given position up or down to restore the
+   * heap property.
+   */
+  void Sift(uint32_t position) noexcept;
+
+  void SiftUp(uint32_t position) noexcept;
+  void SiftDown(uint32_t position) noexcept;
+  void HeapPush(uint32_t i) noexcept;
+  void HeapRemove(uint32_t i) noexcept;
+
+  /**
+   * Recalculate the rank of a non-edge point and update the heap.
+   */
+  void UpdateRank(uint32_t previous, uint32_t i, uint32_t next) noexcept;
+
+  /**
+   * Turn a point into an edge point (the new first or last one).
+   */
+  void MakeEdge(uint32_t i) noexcept;
+
+  [[gnu::pure]]
+  Time GetRecentTime(Time t) const noexcept;
+
+  bool EraseEarlierThan(Time p_time) noexcept;
+  void EraseLaterThan(Time min_time) noexcept;
+  void EnforceTimeWindow(Time latest_time) noexcept;
+
+  /**
+   * Erase a non-edge point during Thin().
+   */
+  void EraseInside(uint32_t i) noexcept;
+
+  /**
+   * Erase points by rank until only #target_size remain, skipping
+   * points not older than #recent_time.  Must be called only from
+   * Thin().
+   *
+   * @param n the number of remaining points
+   * @return the new number of remaining points
+   */
+  unsigned EraseDelta(unsigned n, unsigned target_size,
+                      Time recent_time) noexcept;
+
+  /**
+   * Move the remaining points together after thinning.
+   */
+  void Compact(unsigned n) noexcept;
+
+  void Thin() noexcept;
+
+  [[gnu::pure]]
+  unsigned CalcAverageDeltaDistance(Time no_thin) const noexcept;
+
+  [[gnu::pure]]
+  Time CalcAverageDeltaTime(Time no_thin) const noexcept;
+};
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Point.hpp"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+/**
+ * The metrics used to rank trace points for thinning, shared by
+ * #Trace and #FlatTrace.
+ */
+namespace TraceMetric {
+
+/**
+ * Calculate error distance, between last through this to next,
+ * if this node is removed.  This metric provides for Douglas-Peuker
+ * thinning.
+ *
+ * @param last Point previous in time to this node
+ * @param node This node
+ * @param next Point succeeding this node
+ *
+ * @return Distance error if this node is thinned
+ */
+[[gnu::pure]]
+inline unsigned
+Distance(const TracePoint &last, const TracePoint &node,
+         const TracePoint &next) noexcept
+{
+  const int d_this = last.FlatDistanceTo(node) + node.FlatDistanceTo(next);
+  const int d_rem = last.FlatDistanceTo(next);
+  return abs(d_this - d_rem);
+}
+
+/**
+ * Calculate error time, between last through this to next,
+ * if this node is removed.  This metric provides for fair thinning
+ * (tendency to to result in equal time steps)
+ *
+ * @param last Point previous in time to this node
+ * @param node This node
+ * @param next Point succeeding this node
+ *
+ * @return Time delta if this node is thinned
+ */
+constexpr TracePoint::Time
+Time(const TracePoint &last, const TracePoint &node,
+     const TracePoint &next) noexcept
+{
+  return next.DeltaTime(last)
+    - std::min(next.DeltaTime(node), node.DeltaTime(last));
+}
+
+} // namespace TraceMetric
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Point.hpp"
+#include "util/NonCopyable.hpp"
+#include "util/Sanitizer.hxx"
+#include "util/SliceAllocator.hxx"
+#include "Geo/Flat/TaskProjection.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+/**
+ * Storage for #TracePoint objects which may be shared by several
+ * #Trace instances.  Each #Trace ranks and thins its points according
+ * to its own capacity and time window, but a point which is contained
+ * in more than one of them is stored (and projected) only once.  The
+ * points are reference counted, and each one is freed as soon as the
+ * last #Trace has dropped it.
+ *
+ * All #Trace instances sharing a store use its #TaskProjection.
+ */
+class TracePointStore : private NonCopyable {
+public:
+  struct Node : TracePoint {
+    /**
+     * The number of #Trace instances containing this point.
+     */
+    unsigned n_refs;
+
+    Node(const TracePoint &_point) noexcept
+      :TracePoint(_point), n_refs(1) {}
+  };
+
+  /**
+   * The number of bytes per stored point, for memory statistics.
+   */
+  static constexpr std::size_t BYTES_PER_POINT = sizeof(Node);
+
+private:
+  /**
+   * See Trace::Allocator.
+   */
+  using Allocator = std::conditional_t<HaveAddressSanitizer(),
+                                       std::allocator<Node>,
+                                       SliceAllocator<Node, 128u>>;
+
+  Allocator allocator;
+
+  TaskProjection projection;
+
+  /**
+   * The node which was allocated most recently, or nullptr if it has
+   * been freed already.  When the next #Trace appends the same point,
+   * this node is shared instead of allocating a new one.
+   */
+  Node *last = nullptr;
+
+  unsigned n_nodes = 0;
+
+public:
+  TracePointStore() noexcept = default;
+
+  ~TracePointStore() noexcept {
+    /* all Trace instances must have been destroyed already */
+    assert(n_nodes == 0);
+  }
+
+  /**
+   * The number of distinct points in all #Trace instances.
+   */
+  unsigned size() const noexcept {
+    return n_nodes;
+  }
+
+  bool empty() const noexcept {
+    return n_nodes == 0;
+  }
+
+  const TaskProjection &GetProjection() const noexcept {
+    return projection;
+  }
+
+  /**
+   * Choose a new origin for the flat projection.  This is only
+   * allowed while the store is empty.
+   */
+  void ResetProjection(const GeoPoint &origin) noexcept {
+    assert(empty());
+
+    projection.Reset(origin);
+    projection.Update();
+  }
+
+  /**
+   * Obtain a reference to a node containing the given point.  If it
+   * is the same point which was added last (by another #Trace),
+   * that node is shared; otherwise a new one is allocated.
+   *
+   * @param point the new point; its "flat" (projected) location is
+   * ignored
+   */
+  Node &Add(const TracePoint &point) noexcept {
+    if (last != nullptr && IsSame(*last, point)) {
+      ++last->n_refs;
+      return *last;
+    }
+
+    Node *node = allocator.allocate(1);
+    std::allocator_traits<Allocator>::construct(allocator, node, point);
+    node->Project(projection);
+    ++n_nodes;
+
+    last = node;
+    return *node;
+  }
+
+  /**
+   * Drop a reference obtained by Add(), and free the node if this
+   * was the last one.
+   */
+  void Release(Node &node) noexcept {
+    assert(node.n_refs > 0);
+    assert(n_nodes > 0);
+
+    if (--node.n_refs > 0)
+      return;
+
+    if (&node == last)
+      last = nullptr;
+
+    std::allocator_traits<Allocator>::destroy(allocator, &node);
+    allocator.deallocate(&node, 1);
+    --n_nodes;
+  }
+
+private:
+  /**
+   * Are these the same GPS fix?  The flat location is not compared,
+   * because the new point has not been projected yet.
+   */
+  [[gnu::pure]]
+  static bool IsSame(const TracePoint &a, const TracePoint &b) noexcept {
+    return a.GetTime() == b.GetTime() &&
+      a.GetLocation() == b.GetLocation() &&
+      a.GetAltitude() == b.GetAltitude() &&
+      a.GetVario() == b.GetVario();
+  }
+};
@@ -10,11 +10,24 @@
 
 Trace::Trace(const Time _no_thin_time, const Time max_time,
              const unsigned max_size) noexcept
-  :cached_size(0),
+  :Trace(nullptr, _no_thin_time, max_time, max_size) {}
+
+Trace::Trace(TracePointStore &_store,
+             const Time _no_thin_time, const Time max_time,
+             const unsigned max_size) noexcept
+  :Trace(&_store, _no_thin_time, max_time, max_size) {}
+
+Trace::Trace(TracePointStore *_store,
+             const Time _no_thin_time, const Time max_time,
+             const unsigned max_size) noexcept
+  :own_store(_store == nullptr ? std::make_unique<TracePointStore>() : nullptr),
+   store(_store != nullptr ? *_store : *own_store),
+   cached_size(0),
    max_time(max_time),
    no_thin_time(_no_thin_time),
    max_size(max_size),
-   opt_size((3 * max_size) / 4)
+   opt_size((3 * max_size) / 4),
+   average_delta_time{}, average_delta_distance(0)
 {
   assert(max_size >= 4);
 }
@@ -201,9 +214,11 @@ Trace::push_back(const TracePoint &point) noexcept
   const Time min_delta = std::chrono::seconds{2};
 
   if (empty()) {
-    // first point determines origin for flat projection
-    task_projection.Reset(point.GetLocation());
-    task_projection.Update();
+    /* first point determines origin for flat projection (unless
+       other Trace instances still have points in the shared
+       store) */
+    if (store.empty())
+      store.ResetProjection(point.GetLocation());
   } else if (point.GetTime() < back().GetTime()) {
     // gone back in time
 
@@ -231,8 +246,8 @@ Trace::push_back(const TracePoint &point) noexcept
   assert(size() < max_size);
 
   TraceDelta *td = allocator.allocate(1);
-  std::allocator_traits<Allocator>::construct(allocator, td, point);
-  td->point.Project(task_projection);
+  std::allocator_traits<Allocator>::construct(allocator, td,
+                                              store.Add(point));
 
   delta_list.insert(*td);
   chronological_list.push_back(*td);
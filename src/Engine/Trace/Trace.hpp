@@ -4,17 +4,20 @@
 #pragma once
 
 #include "Point.hpp"
+#include "Store.hpp"
+#include "Metric.hpp"
 #include "util/NonCopyable.hpp"
 #include "util/Sanitizer.hxx"
 #include "util/SliceAllocator.hxx"
 #include "util/Serial.hpp"
-#include "Geo/Flat/TaskProjection.hpp"
 #include "time/Stamp.hpp"
 
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <stdlib.h>
 
@@ -30,6 +33,10 @@ class TracePointerVector;
  * the candidate point removed.  In this version, time differences is also a
  * secondary factor, such that thinning attempts to remove points such that,
  * for equal distance ranking, smaller time step details are removed first.
+ *
+ * The points themselves live in a #TracePointStore, which may be
+ * shared with other #Trace instances that receive the same points,
+ * but thin them differently.
  */
 class Trace : private NonCopyable
 {
@@ -79,27 +86,21 @@ class Trace : private NonCopyable
       }
     };
 
-    TracePoint point;
+    /**
+     * The point, owned by the #TracePointStore.  This object holds
+     * one reference to it.
+     */
+    TracePointStore::Node &point;
 
     Time elim_time;
     unsigned elim_distance;
     unsigned delta_distance;
 
-    explicit TraceDelta(const TracePoint &p) noexcept
+    explicit TraceDelta(TracePointStore::Node &p) noexcept
       :point(p),
        elim_time(null_time), elim_distance(null_delta),
        delta_distance(0) {}
 
-    TraceDelta(const TracePoint &p_last, const TracePoint &p,
-               const TracePoint &p_next) noexcept
-      :point(p),
-       elim_time(TimeMetric(p_last, p, p_next)),
-       elim_distance(DistanceMetric(p_last, p, p_next)),
-       delta_distance(p.FlatDistanceTo(p_last))
-    {
-      assert(elim_distance != null_delta);
-    }
-
     /**
      * Is this the first or the last point?
      */
@@ -108,48 +109,10 @@ class Trace : private NonCopyable
     }
 
     void Update(const TracePoint &p_last, const TracePoint &p_next) noexcept {
-      elim_time = TimeMetric(p_last, point, p_next);
-      elim_distance = DistanceMetric(p_last, point, p_next);
+      elim_time = TraceMetric::Time(p_last, point, p_next);
+      elim_distance = TraceMetric::Distance(p_last, point, p_next);
       delta_distance = point.FlatDistanceTo(p_last);
     }
-
-    /**
-     * Calculate error distance, between last through this to next,
-     * if this node is removed.  This metric provides for Douglas-Peuker
-     * thinning.
-     *
-     * @param last Point previous in time to this node
-     * @param node This node
-     * @param next Point succeeding this node
-     *
-     * @return Distance error if this node is thinned
-     */
-    [[gnu::pure]]
-    static unsigned DistanceMetric(const TracePoint &last,
-                                   const TracePoint &node,
-                                   const TracePoint &next) noexcept {
-      const int d_this = last.FlatDistanceTo(node) + node.FlatDistanceTo(next);
-      const int d_rem = last.FlatDistanceTo(next);
-      return abs(d_this - d_rem);
-    }
-
-    /**
-     * Calculate error time, between last through this to next,
-     * if this node is removed.  This metric provides for fair thinning
-     * (tendency to to result in equal time steps)
-     *
-     * @param last Point previous in time to this node
-     * @param node This node
-     * @param next Point succeeding this node
-     *
-     * @return Time delta if this node is thinned
-     */
-    static constexpr Time TimeMetric(const TracePoint &last,
-                                     const TracePoint &node,
-                                     const TracePoint &next) noexcept {
-      return next.DeltaTime(last)
-        - std::min(next.DeltaTime(node), node.DeltaTime(last));
-    }
   };
 
   /* using multiset, not because we need multiple values (we don't),
@@ -174,12 +137,18 @@ class Trace : private NonCopyable
 
   Allocator allocator;
 
+  /**
+   * The store used by a #Trace which was constructed without one;
+   * nullptr if the store is shared.
+   */
+  std::unique_ptr<TracePointStore> own_store;
+
+  TracePointStore &store;
+
   DeltaList delta_list;
   ChronologicalList chronological_list;
   unsigned cached_size;
 
-  TaskProjection task_projection;
-
   const Time max_time;
   const Time no_thin_time;
   const unsigned max_size;
@@ -193,20 +162,22 @@ class Trace : private NonCopyable
   template<typename Alloc>
   struct Disposer {
     Alloc &alloc;
+    TracePointStore &store;
 
     void operator()(typename std::allocator_traits<Alloc>::pointer td) {
+      store.Release(td->point);
       std::allocator_traits<Alloc>::destroy(alloc, td);
       alloc.deallocate(td, 1);
     }
   };
 
   template<typename Alloc>
-  static Disposer<Alloc> MakeDisposer(Alloc &alloc) {
-    return {alloc};
+  static Disposer<Alloc> MakeDisposer(Alloc &alloc, TracePointStore &store) {
+    return {alloc, store};
   }
 
   Disposer<decltype(allocator)> MakeDisposer() {
-    return MakeDisposer(allocator);
+    return MakeDisposer(allocator, store);
   }
 
 public:
@@ -222,10 +193,29 @@ public:
                  const Time max_time = null_time,
                  const unsigned max_size = 1000) noexcept;
 
+  /**
+   * Construct a #Trace which keeps its points in the given (shared)
+   * store.  Points which are appended to several #Trace instances
+   * sharing the store, one after another, are stored only once.  The
+   * store must outlive this object.
+   */
+  Trace(TracePointStore &_store,
+        const Time no_thin_time = {},
+        const Time max_time = null_time,
+        const unsigned max_size = 1000) noexcept;
+
   ~Trace() noexcept {
     clear();
   }
 
+private:
+  /**
+   * @param _store the shared store, or nullptr to allocate a private
+   * one
+   */
+  Trace(TracePointStore *_store, Time no_thin_time, Time max_time,
+        unsigned max_size) noexcept;
+
 protected:
   /**
    * Find recent time after which points should not be culled
@@ -363,6 +353,17 @@ public:
     return modify_serial;
   }
 
+  /**
+   * Overwrite both serials with values obtained earlier, after the
+   * points have been restored from a checkpoint.  This lets the
+   * contest solvers restored from the same checkpoint consider their
+   * copies up to date.
+   */
+  void RestoreSerials(Serial _append_serial, Serial _modify_serial) noexcept {
+    append_serial = _append_serial;
+    modify_serial = _modify_serial;
+  }
+
   /** 
    * Retrieve a vector of trace points sorted by time
    * 
@@ -451,6 +452,12 @@ private:
 public:
   static constexpr auto null_time = TracePoint::INVALID_TIME;
 
+  /**
+   * The number of bytes per point used by this object (not counting
+   * the #TracePointStore), for memory statistics.
+   */
+  static constexpr std::size_t BYTES_PER_POINT = sizeof(TraceDelta);
+
   unsigned GetAverageDeltaDistance() const noexcept {
     return average_delta_distance;
   }
@@ -509,12 +516,16 @@ public:
     return chronological_list.end();
   }
 
+  const TracePointStore &GetStore() const noexcept {
+    return store;
+  }
+
   const TaskProjection &GetProjection() const noexcept {
-    return task_projection;
+    return store.GetProjection();
   }
 
   [[gnu::pure]]
   unsigned ProjectRange(const GeoPoint &location, double distance) const noexcept {
-    return task_projection.ProjectRangeInteger(location, distance);
+    return GetProjection().ProjectRangeInteger(location, distance);
   }
 };
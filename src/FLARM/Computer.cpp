@@ -3,20 +3,22 @@
 
 #include "Computer.hpp"
 #include "Details.hpp"
+#include "List.hpp"
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 #include "time/Cast.hxx"
 
 void
-FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
+FlarmComputer::Process(TrafficList &traffic_list,
+                       const TrafficList &last_traffic_list,
                        const NMEAInfo &basic) noexcept
 {
   // Cleanup old calculation instances
   if (basic.time_available)
     flarm_calculations.CleanUp(basic.time);
 
-  // if (FLARM data is available)
-  if (!flarm.IsDetected())
+  // if (FLARM traffic is available)
+  if (traffic_list.IsEmpty())
     return;
 
   double north_to_latitude(0);
@@ -43,7 +45,7 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
   }
 
   // for each item in traffic
-  for (auto &traffic : flarm.traffic.list) {
+  for (auto &traffic : traffic_list) {
     // if we don't know the target's name yet
     if (!traffic.HasName()) {
       // lookup the name of this target's id
@@ -86,7 +88,7 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
 
     // Check if the target has been seen before in the last seconds
     const FlarmTraffic *last_traffic =
-      last_flarm.traffic.FindTraffic(traffic.id);
+      last_traffic_list.FindTraffic(traffic.id);
     if (last_traffic == NULL || !last_traffic->valid)
       continue;
 
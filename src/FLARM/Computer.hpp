@@ -5,7 +5,7 @@
 
 #include "Calculations.hpp"
 
-struct FlarmData;
+struct TrafficList;
 struct NMEAInfo;
 
 class FlarmComputer {
@@ -16,6 +16,6 @@ public:
    * Calculates location, altitude, average climb speed and
    * looks up the callsign of each target
    */
-  void Process(FlarmData &flarm, const FlarmData &last_flarm,
+  void Process(TrafficList &traffic, const TrafficList &last_traffic,
                const NMEAInfo &basic) noexcept;
 };
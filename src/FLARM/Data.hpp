@@ -6,12 +6,13 @@
 #include "FLARM/Error.hpp"
 #include "FLARM/Version.hpp"
 #include "FLARM/Status.hpp"
-#include "FLARM/List.hpp"
 
 #include <type_traits>
 
 /**
- * A container for all data received by a FLARM.
+ * A container for all data received by a FLARM, except for the
+ * traffic (#TrafficList), which is too large to be copied with each
+ * #NMEAInfo.
  */
 struct FlarmData {
   FlarmError error;
@@ -20,31 +21,26 @@ struct FlarmData {
 
   FlarmStatus status;
 
-  TrafficList traffic;
-
   constexpr bool IsDetected() const noexcept {
-    return status.available || !traffic.IsEmpty();
+    return status.available;
   }
 
   constexpr void Clear() noexcept {
     error.Clear();
     version.Clear();
     status.Clear();
-    traffic.Clear();
   }
 
   constexpr void Complement(const FlarmData &add) noexcept {
     error.Complement(add.error);
     version.Complement(add.version);
     status.Complement(add.status);
-    traffic.Complement(add.traffic);
   }
 
   constexpr void Expire(TimeStamp clock) noexcept {
     error.Expire(clock);
     version.Expire(clock);
     status.Expire(clock);
-    traffic.Expire(clock);
   }
 };
 
@@ -36,6 +36,14 @@ public:
     value = UNDEFINED_VALUE;
   }
 
+  /**
+   * Returns a well-distributed hash value (Fibonacci hashing); the
+   * upper bits are the best ones.
+   */
+  constexpr uint32_t Hash() const noexcept {
+    return value * UINT32_C(0x9e3779b1);
+  }
+
   friend constexpr auto operator<=>(const FlarmId &,
                                     const FlarmId &) noexcept = default;
 
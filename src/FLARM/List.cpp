@@ -8,7 +8,7 @@ TrafficList::FindMaximumAlert() const noexcept
 {
   const FlarmTraffic *alert = NULL;
 
-  for (const auto &traffic : list)
+  for (const auto &traffic : *this)
     if (traffic.HasAlarm() &&
         (alert == NULL ||
          ((unsigned)traffic.alarm_level > (unsigned)alert->alarm_level ||
@@ -24,6 +24,6 @@ TrafficList::FindMaximumAlert() const noexcept
 bool
 TrafficList::InCloseRange() const noexcept
 {
-  return std::any_of(list.begin(), list.end(), [](const auto &traffic)
+  return std::any_of(begin(), end(), [](const auto &traffic)
     { return traffic.distance < (RoughDistance)4000; });
 }
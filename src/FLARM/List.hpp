@@ -5,16 +5,41 @@
 
 #include "Traffic.hpp"
 #include "NMEA/Validity.hpp"
-#include "util/TrivialArray.hxx"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <type_traits>
 
 /**
  * This class keeps track of the traffic objects received from a
  * FLARM.
+ *
+ * Each object lives in a slot which does not change until it
+ * expires; the slots of expired objects are reused by new ones.  A
+ * slot is free if its object is not FlarmTraffic::IsDefined().  All
+ * slots from #n_slots on are free and uninitialised.  A small
+ * open-addressing hash table indexed by #FlarmId makes lookups O(1).
+ *
+ * This object is too large to be copied with each #NMEAInfo;
+ * therefore the blackboards keep it separately.  It is trivial, and
+ * CopyFrom() copies only the slots which have been used.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  static constexpr size_t MAX_COUNT = 128;
+
+  /**
+   * The number of buckets in #index.  It is at least twice
+   * #MAX_COUNT, which keeps the linear probe sequences short.
+   */
+  static constexpr unsigned INDEX_BITS = 8;
+  static constexpr size_t INDEX_SIZE = size_t(1) << INDEX_BITS;
+
+  static_assert(INDEX_SIZE >= 2 * MAX_COUNT);
+  static_assert(MAX_COUNT < UINT8_MAX);
 
   /**
    * Time stamp of the latest modification to this object.
@@ -26,17 +51,136 @@ struct TrafficList {
    */
   Validity new_traffic;
 
+  /**
+   * The number of slots which may be in use; all slots at and after
+   * this one are free.
+   */
+  unsigned n_slots;
+
+  /**
+   * The number of slots which are in use.
+   */
+  unsigned n_active;
+
   /** Flarm traffic information */
-  TrivialArray<FlarmTraffic, MAX_COUNT> list;
+  std::array<FlarmTraffic, MAX_COUNT> slots;
+
+  /**
+   * Maps #FlarmId to a slot.  Each bucket contains the slot number
+   * plus one; 0 means the bucket is empty.
+   *
+   * The methods of this class keep it up to date.  Code which
+   * modifies FlarmTraffic::id must call RebuildIndex() afterwards.
+   */
+  std::array<uint8_t, INDEX_SIZE> index;
+
+  /**
+   * Iterates over the slots which are in use.
+   */
+  template<typename T>
+  class Iterator {
+    T *i, *end;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(T *_i, T *_end) noexcept
+      :i(_i), end(_end) {
+      SkipFree();
+    }
+
+    constexpr reference operator*() const noexcept {
+      return *i;
+    }
+
+    constexpr pointer operator->() const noexcept {
+      return i;
+    }
+
+    constexpr Iterator &operator++() noexcept {
+      ++i;
+      SkipFree();
+      return *this;
+    }
+
+    constexpr Iterator operator++(int) noexcept {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    constexpr bool operator==(const Iterator &other) const noexcept {
+      return i == other.i;
+    }
+
+  private:
+    constexpr void SkipFree() noexcept {
+      while (i != end && !i->IsDefined())
+        ++i;
+    }
+  };
+
+  using iterator = Iterator<FlarmTraffic>;
+  using const_iterator = Iterator<const FlarmTraffic>;
+
+  constexpr iterator begin() noexcept {
+    return {slots.data(), slots.data() + n_slots};
+  }
+
+  constexpr iterator end() noexcept {
+    return {slots.data() + n_slots, slots.data() + n_slots};
+  }
+
+  constexpr const_iterator begin() const noexcept {
+    return {slots.data(), slots.data() + n_slots};
+  }
+
+  constexpr const_iterator end() const noexcept {
+    return {slots.data() + n_slots, slots.data() + n_slots};
+  }
 
   constexpr void Clear() noexcept {
     modified.Clear();
     new_traffic.Clear();
-    list.clear();
+    n_slots = n_active = 0;
+    index.fill(0);
   }
 
   constexpr bool IsEmpty() const noexcept {
-    return list.empty();
+    return n_active == 0;
+  }
+
+  /**
+   * Copy another object like operator=, but copy only the slots
+   * which have been used.
+   */
+  constexpr void CopyFrom(const TrafficList &src) noexcept {
+    modified = src.modified;
+    new_traffic = src.new_traffic;
+    n_slots = src.n_slots;
+    n_active = src.n_active;
+    std::copy_n(src.slots.begin(), src.n_slots, slots.begin());
+    index = src.index;
+  }
+
+  /**
+   * Compare the used slots of both objects bytewise.  This may report
+   * a difference in two objects which are equal (e.g. in their
+   * padding bytes), but never the other way round.  The #index is
+   * not compared, because it is derived from the slots.
+   */
+  bool IsSame(const TrafficList &other) const noexcept {
+    return modified == other.modified &&
+      new_traffic == other.new_traffic &&
+      n_slots == other.n_slots && n_active == other.n_active &&
+      std::memcmp(slots.data(), other.slots.data(),
+                  n_slots * sizeof(slots.front())) == 0;
   }
 
   /**
@@ -50,21 +194,30 @@ struct TrafficList {
     if (add.new_traffic.Modified(new_traffic))
       new_traffic = add.new_traffic;
 
-    if (list.empty() && !add.list.empty()) {
-      /* don't bother merging the two lists, we can simply memcpy()
-         it */
-      list = add.list;
+    if (IsEmpty()) {
+      /* don't bother merging the two lists, we can simply copy the
+         used slots and the index */
+      n_slots = add.n_slots;
+      n_active = add.n_active;
+      std::copy_n(add.slots.begin(), add.n_slots, slots.begin());
+      index = add.index;
       return;
     }
 
     // Add unique traffic from 'add' list
-    for (auto &traffic : add.list) {
-      if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
-        if (new_traffic == nullptr)
-          return;
-        *new_traffic = traffic;
-      }
+    unsigned slot = 0;
+    for (const auto &traffic : add) {
+      const size_t bucket = FindBucket(traffic.id);
+      if (index[bucket] != 0)
+        continue;
+
+      /* no slot is freed here, so the search for a free slot can
+         continue where the previous one ended */
+      slot = FindFreeSlot(slot);
+      if (slot >= MAX_COUNT)
+        return;
+
+      Assign(slot, bucket) = traffic;
     }
   }
 
@@ -72,13 +225,25 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
-        list.quick_remove(i);
+    bool removed = false;
+    for (unsigned i = 0; i < n_slots; ++i) {
+      FlarmTraffic &traffic = slots[i];
+      if (traffic.IsDefined() && !traffic.Refresh(clock)) {
+        --n_active;
+        removed = true;
+      }
+    }
+
+    if (removed) {
+      while (n_slots > 0 && !slots[n_slots - 1].IsDefined())
+        --n_slots;
+
+      RebuildIndex();
+    }
   }
 
   constexpr unsigned GetActiveTrafficCount() const noexcept {
-    return list.size();
+    return n_active;
   }
 
   /**
@@ -88,11 +253,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr FlarmTraffic *FindTraffic(FlarmId id) noexcept {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const unsigned i = index[FindBucket(id)];
+    return i > 0 ? &slots[i - 1] : NULL;
   }
 
   /**
@@ -102,11 +264,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr const FlarmTraffic *FindTraffic(FlarmId id) const noexcept {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const unsigned i = index[FindBucket(id)];
+    return i > 0 ? &slots[i - 1] : NULL;
   }
 
   /**
@@ -116,7 +275,7 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr FlarmTraffic *FindTraffic(const TCHAR *name) noexcept {
-    for (auto &traffic : list)
+    for (auto &traffic : *this)
       if (traffic.name.equals(name))
         return &traffic;
 
@@ -130,7 +289,7 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr const FlarmTraffic *FindTraffic(const TCHAR *name) const noexcept {
-    for (const auto &traffic : list)
+    for (const auto &traffic : *this)
       if (traffic.name.equals(name))
         return &traffic;
 
@@ -138,46 +297,77 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object in the first free slot,
+   * clears it and assigns the specified id.  The id must not be
+   * present already.  The slot remains free until the caller
+   * validates the object (FlarmTraffic::valid).
    *
-   * @return the FLARM_TRAFFIC pointer, NULL if the array is full
+   * @return the FLARM_TRAFFIC pointer, NULL if all slots are in use
    */
-  constexpr FlarmTraffic *AllocateTraffic() noexcept {
-    return list.full()
-      ? NULL
-      : &list.append();
+  constexpr FlarmTraffic *AllocateTraffic(FlarmId id) noexcept {
+    const unsigned slot = FindFreeSlot(0);
+    if (slot >= MAX_COUNT)
+      return NULL;
+
+    const size_t bucket = FindBucket(id);
+    assert(index[bucket] == 0);
+
+    FlarmTraffic &traffic = Assign(slot, bucket);
+    traffic.Clear();
+    traffic.id = id;
+    return &traffic;
+  }
+
+  /**
+   * Recreate the #index from the #slots.
+   */
+  constexpr void RebuildIndex() noexcept {
+    index.fill(0);
+
+    for (unsigned i = 0; i < n_slots; ++i)
+      if (slots[i].IsDefined())
+        index[FindBucket(slots[i].id)] = i + 1;
   }
 
   /**
    * Search for the previous traffic in the ordered list.
    */
   constexpr const FlarmTraffic *PreviousTraffic(const FlarmTraffic *t) const noexcept {
-    return t > list.begin()
-      ? t - 1
-      : NULL;
+    for (unsigned i = TrafficIndex(t); i-- > 0;)
+      if (slots[i].IsDefined())
+        return &slots[i];
+
+    return NULL;
   }
 
   /**
    * Search for the next traffic in the ordered list.
    */
   constexpr const FlarmTraffic *NextTraffic(const FlarmTraffic *t) const noexcept {
-    return t + 1 < list.end()
-      ? t + 1
-      : NULL;
+    for (unsigned i = TrafficIndex(t) + 1; i < n_slots; ++i)
+      if (slots[i].IsDefined())
+        return &slots[i];
+
+    return NULL;
   }
 
   /**
    * Search for the first traffic in the ordered list.
    */
   constexpr const FlarmTraffic *FirstTraffic() const noexcept {
-    return list.empty() ? NULL : list.begin();
+    const auto i = begin();
+    return i != end() ? &*i : NULL;
   }
 
   /**
    * Search for the last traffic in the ordered list.
    */
   constexpr const FlarmTraffic *LastTraffic() const noexcept {
-    return list.empty() ? NULL : list.end() - 1;
+    for (unsigned i = n_slots; i-- > 0;)
+      if (slots[i].IsDefined())
+        return &slots[i];
+
+    return NULL;
   }
 
   /**
@@ -187,14 +377,59 @@ struct TrafficList {
   [[gnu::pure]]
   const FlarmTraffic *FindMaximumAlert() const noexcept;
 
+  /**
+   * Returns the slot number of the specified object.
+   */
   constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
-    return t - list.begin();
+    return t - slots.data();
   }
 
   /**
    * Is set if traffic is present and closer than 4Km.
    */
   bool InCloseRange() const noexcept;
+
+private:
+  /**
+   * Returns the #index bucket which refers to the specified id, or
+   * the empty bucket where it would be inserted.
+   */
+  constexpr size_t FindBucket(FlarmId id) const noexcept {
+    for (size_t i = id.Hash() >> (32 - INDEX_BITS);;
+         i = (i + 1) & (INDEX_SIZE - 1)) {
+      const unsigned slot = index[i];
+      if (slot == 0 || slots[slot - 1].id == id)
+        return i;
+    }
+  }
+
+  /**
+   * Returns the first free slot at or after the specified one, or
+   * #MAX_COUNT if there is none.
+   */
+  constexpr unsigned FindFreeSlot(unsigned slot) const noexcept {
+    while (slot < n_slots && slots[slot].IsDefined())
+      ++slot;
+
+    return slot;
+  }
+
+  /**
+   * Take the specified free slot into use and register it in the
+   * specified (empty) #index bucket.
+   */
+  constexpr FlarmTraffic &Assign(unsigned slot, size_t bucket) noexcept {
+    assert(slot < MAX_COUNT);
+    assert(slot >= n_slots || !slots[slot].IsDefined());
+    assert(index[bucket] == 0);
+
+    if (slot >= n_slots)
+      n_slots = slot + 1;
+
+    ++n_active;
+    index[bucket] = slot + 1;
+    return slots[slot];
+  }
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
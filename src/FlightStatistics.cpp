@@ -19,6 +19,34 @@ ToNormalisedHours(FloatDuration t) noexcept
     : 0.;
 }
 
+FlightStatistics::FlightStatistics(const FlightStatistics &src) noexcept
+  :thermal_average(src.thermal_average),
+   altitude(src.altitude),
+   altitude_base(src.altitude_base),
+   altitude_ceiling(src.altitude_ceiling),
+   task_speed(src.task_speed),
+   altitude_terrain(src.altitude_terrain),
+   vario_circling_histogram(src.vario_circling_histogram),
+   vario_cruise_histogram(src.vario_cruise_histogram)
+{
+}
+
+FlightStatistics &
+FlightStatistics::operator=(const FlightStatistics &src) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  thermal_average = src.thermal_average;
+  altitude = src.altitude;
+  altitude_base = src.altitude_base;
+  altitude_ceiling = src.altitude_ceiling;
+  task_speed = src.task_speed;
+  altitude_terrain = src.altitude_terrain;
+  vario_circling_histogram = src.vario_circling_histogram;
+  vario_cruise_histogram = src.vario_cruise_histogram;
+  return *this;
+}
+
 void
 FlightStatistics::Reset() noexcept
 {
@@ -21,6 +21,21 @@ public:
   Histogram vario_cruise_histogram;
   mutable Mutex mutex;
 
+  FlightStatistics() noexcept = default;
+
+  /**
+   * Copy the statistics (but not the mutex).  The caller is
+   * responsible for locking the source object.
+   */
+  FlightStatistics(const FlightStatistics &src) noexcept;
+
+  /**
+   * Replace the statistics with a copy (e.g. from a replay
+   * checkpoint).  This locks the mutex of this object; the caller is
+   * responsible for locking the source object.
+   */
+  FlightStatistics &operator=(const FlightStatistics &src) noexcept;
+
   void StartTask() noexcept;
 
   [[gnu::pure]]
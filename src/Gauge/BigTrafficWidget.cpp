@@ -179,7 +179,7 @@ FlarmTrafficControl::CalcAutoZoom()
   bool warning_mode = WarningMode();
   RoughDistance zoom_dist = 0;
 
-  for (auto it = data.list.begin(), end = data.list.end();
+  for (auto it = data.begin(), end = data.end();
       it != end; ++it) {
     if (warning_mode && !it->HasAlarm())
       continue;
@@ -474,7 +474,7 @@ FlarmTrafficControl::PaintTrafficInfo(Canvas &canvas) const
     return;
 
   // Shortcut to the selected traffic
-  FlarmTraffic traffic = data.list[WarningMode() ? warning : selection];
+  FlarmTraffic traffic = data.slots[WarningMode() ? warning : selection];
   assert(traffic.IsDefined());
 
   const unsigned padding = Layout::GetTextPadding();
@@ -735,10 +735,11 @@ void
 TrafficWidget::Update() noexcept
 {
   const NMEAInfo &basic = CommonInterface::Basic();
+  const TrafficList &traffic = CommonInterface::Traffic();
   const DerivedInfo &calculated = CommonInterface::Calculated();
 
   if (CommonInterface::GetUISettings().traffic.auto_close_dialog &&
-      basic.flarm.traffic.IsEmpty() &&
+      traffic.IsEmpty() &&
       /* auto-close only really closes the FLARM radar if the
          "restored" page has no FLARM radar */
       PageActions::GetConfiguredLayout().main != PageLayout::Main::FLARM_RADAR) {
@@ -750,7 +751,7 @@ TrafficWidget::Update() noexcept
   }
 
   windows->view.Update(basic.track,
-               basic.flarm.traffic,
+               traffic,
                CommonInterface::GetComputerSettings().team_code);
 
   windows->view.UpdateTaskDirection(calculated.task_stats.task_valid &&
@@ -875,7 +876,7 @@ void
 TrafficWidget::UpdateButtons() noexcept
 {
   const bool unlocked = !windows->view.WarningMode();
-  const TrafficList &traffic = CommonInterface::Basic().flarm.traffic;
+  const TrafficList &traffic = CommonInterface::Traffic();
   const bool not_empty = !traffic.IsEmpty();
   const bool two_or_more = traffic.GetActiveTrafficCount() >= 2;
 
@@ -37,9 +37,9 @@ FlarmTrafficWindow::FlarmTrafficWindow(const FlarmTrafficLook &_look,
 bool
 FlarmTrafficWindow::WarningMode() const noexcept
 {
-  assert(warning < (int)data.list.size());
-  assert(warning < 0 || data.list[warning].IsDefined());
-  assert(warning < 0 || data.list[warning].HasAlarm());
+  assert(warning < (int)data.n_slots);
+  assert(warning < 0 || data.slots[warning].IsDefined());
+  assert(warning < 0 || data.slots[warning].HasAlarm());
 
   return warning >= 0;
 }
@@ -55,8 +55,8 @@ FlarmTrafficWindow::OnResize(PixelSize new_size) noexcept
 void
 FlarmTrafficWindow::SetTarget(int i) noexcept
 {
-  assert(i < (int)data.list.size());
-  assert(i < 0 || data.list[i].IsDefined());
+  assert(i < (int)data.n_slots);
+  assert(i < 0 || data.slots[i].IsDefined());
 
   if (selection == i)
     return;
@@ -75,11 +75,11 @@ FlarmTrafficWindow::NextTarget() noexcept
   if (WarningMode())
     return;
 
-  assert(selection < (int)data.list.size());
+  assert(selection < (int)data.n_slots);
 
   const FlarmTraffic *traffic;
   if (selection >= 0)
-    traffic = data.NextTraffic(&data.list[selection]);
+    traffic = data.NextTraffic(&data.slots[selection]);
   else
     traffic = NULL;
 
@@ -99,11 +99,11 @@ FlarmTrafficWindow::PrevTarget() noexcept
   if (WarningMode())
     return;
 
-  assert(selection < (int)data.list.size());
+  assert(selection < (int)data.n_slots);
 
   const FlarmTraffic *traffic;
   if (selection >= 0)
-    traffic = data.PreviousTraffic(&data.list[selection]);
+    traffic = data.PreviousTraffic(&data.slots[selection]);
   else
     traffic = NULL;
 
@@ -165,7 +165,7 @@ FlarmTrafficWindow::Update(Angle new_direction, const TrafficList &new_data,
   FlarmId selection_id;
   PixelPoint pt;
   if (!small && selection >= 0) {
-    selection_id = data.list[selection].id;
+    selection_id = data.slots[selection].id;
     pt = sc[selection];
   } else {
     selection_id.Clear();
@@ -176,7 +176,7 @@ FlarmTrafficWindow::Update(Angle new_direction, const TrafficList &new_data,
   heading = new_direction;
   fr = -heading;
   fir = heading;
-  data = new_data;
+  data.CopyFrom(new_data);
   settings = new_settings;
 
   UpdateWarnings();
@@ -516,16 +516,16 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas) noexcept
   }
 
   // Iterate through the traffic (normal traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
-    const FlarmTraffic &traffic = data.list[i];
+  for (unsigned i = 0; i < data.n_slots; ++i) {
+    const FlarmTraffic &traffic = data.slots[i];
 
-    if (!traffic.HasAlarm() &&
+    if (traffic.IsDefined() && !traffic.HasAlarm() &&
         static_cast<unsigned> (selection) != i)
       PaintRadarTarget(canvas, traffic, i);
   }
 
   if (selection >= 0) {
-    const FlarmTraffic &traffic = data.list[selection];
+    const FlarmTraffic &traffic = data.slots[selection];
 
     if (!traffic.HasAlarm())
       PaintRadarTarget(canvas, traffic, selection);
@@ -535,10 +535,10 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas) noexcept
     return;
 
   // Iterate through the traffic (alarm traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
-    const FlarmTraffic &traffic = data.list[i];
+  for (unsigned i = 0; i < data.n_slots; ++i) {
+    const FlarmTraffic &traffic = data.slots[i];
 
-    if (traffic.HasAlarm())
+    if (traffic.IsDefined() && traffic.HasAlarm())
       PaintRadarTarget(canvas, traffic, i);
   }
 }
@@ -677,11 +677,11 @@ FlarmTrafficWindow::PaintRadarBackground(Canvas &canvas) const noexcept
 void
 FlarmTrafficWindow::Paint(Canvas &canvas) noexcept
 {
-  assert(selection < (int)data.list.size());
-  assert(selection < 0 || data.list[selection].IsDefined());
-  assert(warning < (int)data.list.size());
-  assert(warning < 0 || data.list[warning].IsDefined());
-  assert(warning < 0 || data.list[warning].HasAlarm());
+  assert(selection < (int)data.n_slots);
+  assert(selection < 0 || data.slots[selection].IsDefined());
+  assert(warning < (int)data.n_slots);
+  assert(warning < 0 || data.slots[warning].IsDefined());
+  assert(warning < 0 || data.slots[warning].HasAlarm());
 
   PaintRadarBackground(canvas);
   PaintRadarTraffic(canvas);
@@ -715,9 +715,9 @@ FlarmTrafficWindow::SelectNearTarget(PixelPoint p, int max_distance) noexcept
   int min_distance = 99999;
   int min_id = -1;
 
-  for (unsigned i = 0; i < data.list.size(); ++i) {
+  for (unsigned i = 0; i < data.n_slots; ++i) {
     // If FLARM target does not exist -> next one
-    if (!data.list[i].IsDefined())
+    if (!data.slots[i].IsDefined())
       continue;
 
     int distance_sq = (p - sc[i]).MagnitudeSquared();
@@ -60,7 +60,7 @@ public:
 
   const FlarmTraffic *GetTarget() const noexcept {
     return selection >= 0
-      ? &data.list[selection]
+      ? &data.slots[selection]
       : NULL;
   }
 
@@ -20,7 +20,7 @@ public:
                      const FlarmTrafficLook &look,
                      const WindowStyle style=WindowStyle()) noexcept;
 
-  void Update(const NMEAInfo &gps_info,
+  void Update(const NMEAInfo &gps_info, const TrafficList &traffic,
               const TeamCodeSettings &settings) noexcept;
 
 private:
@@ -51,9 +51,10 @@ SmallTrafficWindow::SmallTrafficWindow(ContainerWindow &parent,
 
 void
 SmallTrafficWindow::Update(const NMEAInfo &gps_info,
+                           const TrafficList &traffic,
                            const TeamCodeSettings &settings) noexcept
 {
-  FlarmTrafficWindow::Update(gps_info.track, gps_info.flarm.traffic, settings);
+  FlarmTrafficWindow::Update(gps_info.track, traffic, settings);
 }
 
 void
@@ -167,5 +168,6 @@ void
 GaugeFLARM::Update(const NMEAInfo &basic) noexcept
 {
   SmallTrafficWindow &window = (SmallTrafficWindow &)GetWindow();
-  window.Update(basic, blackboard.GetComputerSettings().team_code);
+  window.Update(basic, blackboard.Traffic(),
+                blackboard.GetComputerSettings().team_code);
 }
@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IGCBulkParser.hpp"
+#include "IGCParser.hpp"
+#include "IGCExtensions.hpp"
+#include "io/FileMapping.hpp"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**
+ * An #IGCExtension resolved to the #IGCFix attribute it fills.
+ */
+struct BulkExtension {
+  int16_t IGCFix::*field;
+
+  /**
+   * Offset of the first and behind the last character within the
+   * line.
+   */
+  unsigned start, finish;
+
+  /**
+   * The maximum number of digits to parse; 0 means the whole field.
+   * See ParseExtensionValueN() in IGCParser.cpp.
+   */
+  unsigned max_digits;
+};
+
+using BulkExtensions = TrivialArray<BulkExtension, 16>;
+
+} // anonymous namespace
+
+/**
+ * Parse exactly N decimal digits.
+ *
+ * @return the value or -1 if a character is not a digit
+ */
+template<unsigned N>
+static inline int
+ParseDigits(const char *p) noexcept
+{
+  int value = 0;
+  for (unsigned i = 0; i < N; ++i) {
+    const unsigned digit = (unsigned char)p[i] - '0';
+    if (digit > 9)
+      return -1;
+
+    value = value * 10 + (int)digit;
+  }
+
+  return value;
+}
+
+/**
+ * Parse a variable number of decimal digits.
+ *
+ * @return the value or -1 if a character is not a digit
+ */
+static inline int
+ParseDigits(const char *p, const char *end) noexcept
+{
+  int value = 0;
+  for (; p < end; ++p) {
+    const unsigned digit = (unsigned char)*p - '0';
+    if (digit > 9)
+      return -1;
+
+    value = value * 10 + (int)digit;
+  }
+
+  return value;
+}
+
+/**
+ * Parse a five character altitude field, which may start with a
+ * minus sign.
+ */
+static inline bool
+ParseAltitude(const char *p, int &value_r) noexcept
+{
+  int value;
+  if (*p == '-') {
+    value = ParseDigits<4>(p + 1);
+    if (value < 0)
+      return false;
+    value = -value;
+  } else {
+    value = ParseDigits<5>(p);
+    if (value < 0)
+      return false;
+  }
+
+  value_r = value;
+  return true;
+}
+
+/**
+ * Parse a location field (DDMMmmm[N/S]DDDMMmmm[E/W]).
+ */
+static inline bool
+ParseLocation(const char *p, GeoPoint &location) noexcept
+{
+  const int lat_degrees = ParseDigits<2>(p);
+  const int lat_minutes = ParseDigits<5>(p + 2);
+  const char lat_char = p[7];
+  const int lon_degrees = ParseDigits<3>(p + 8);
+  const int lon_minutes = ParseDigits<5>(p + 11);
+  const char lon_char = p[16];
+
+  if (lat_degrees < 0 || lat_degrees >= 90 ||
+      lat_minutes < 0 || lat_minutes >= 60000 ||
+      (lat_char != 'N' && lat_char != 'S'))
+    return false;
+
+  if (lon_degrees < 0 || lon_degrees >= 180 ||
+      lon_minutes < 0 || lon_minutes >= 60000 ||
+      (lon_char != 'E' && lon_char != 'W'))
+    return false;
+
+  /* same arithmetic as IGCParseLocation() to get bit-identical
+     results */
+  location.latitude = Angle::Degrees(lat_degrees + lat_minutes / 60000.);
+  if (lat_char == 'S')
+    location.latitude.Flip();
+
+  location.longitude = Angle::Degrees(lon_degrees + lon_minutes / 60000.);
+  if (lon_char == 'W')
+    location.longitude.Flip();
+
+  return true;
+}
+
+/**
+ * Parse a "B" record.  The line is not null-terminated.
+ */
+static bool
+ParseFix(const char *line, const char *end,
+         const BulkExtensions &extensions, IGCFix &fix) noexcept
+{
+  /* B HHMMSS DDMMmmmN DDDMMmmmE V PPPPP GGGGG */
+  if (end - line < 35)
+    return false;
+
+  const int hour = ParseDigits<2>(line + 1);
+  const int minute = ParseDigits<2>(line + 3);
+  const int second = ParseDigits<2>(line + 5);
+  if (hour < 0 || minute < 0 || second < 0)
+    return false;
+
+  fix.time = BrokenTime(hour, minute, second);
+  if (!fix.time.IsPlausible())
+    return false;
+
+  switch (line[24]) {
+  case 'A':
+    fix.gps_valid = true;
+    break;
+
+  case 'V':
+    fix.gps_valid = false;
+    break;
+
+  default:
+    return false;
+  }
+
+  if (!ParseAltitude(line + 25, fix.pressure_altitude) ||
+      !ParseAltitude(line + 30, fix.gps_altitude) ||
+      !ParseLocation(line + 7, fix.location))
+    return false;
+
+  fix.ClearExtensions();
+
+  const std::size_t line_length = end - line;
+  for (const auto &extension : extensions) {
+    if (extension.finish > line_length)
+      /* exceeds the input line length */
+      continue;
+
+    const char *start = line + extension.start;
+    const char *finish = line + extension.finish;
+    if (extension.max_digits > 0) {
+      if (extension.max_digits > extension.finish - extension.start)
+        continue;
+
+      finish = start + extension.max_digits;
+    }
+
+    const int value = ParseDigits(start, finish);
+    if (value >= 0)
+      fix.*extension.field = value;
+  }
+
+  return true;
+}
+
+/**
+ * Resolve the extension codes of an "I" record.  Unknown codes are
+ * omitted.
+ */
+static void
+ResolveExtensions(const IGCExtensions &src, BulkExtensions &dest) noexcept
+{
+  static constexpr struct {
+    const char *code;
+    int16_t IGCFix::*field;
+    unsigned max_digits;
+  } known[] = {
+    { "ENL", &IGCFix::enl, 0 },
+    { "RPM", &IGCFix::rpm, 0 },
+    { "HDM", &IGCFix::hdm, 0 },
+    { "HDT", &IGCFix::hdt, 0 },
+    { "TRM", &IGCFix::trm, 0 },
+    { "TRT", &IGCFix::trt, 0 },
+    { "GSP", &IGCFix::gsp, 3 },
+    { "IAS", &IGCFix::ias, 3 },
+    { "TAS", &IGCFix::tas, 3 },
+    { "SIU", &IGCFix::siu, 0 },
+  };
+
+  dest.clear();
+
+  for (const auto &extension : src) {
+    const auto i = std::find_if(std::begin(known), std::end(known),
+                                [&extension](const auto &k){
+                                  return StringIsEqual(k.code, extension.code);
+                                });
+    if (i == std::end(known))
+      continue;
+
+    dest.append({i->field, extension.start - 1u, extension.finish,
+                 i->max_digits});
+  }
+}
+
+/**
+ * Copy a (short) line to a null-terminated buffer, for the parsers
+ * which expect a C string.
+ *
+ * @return false if the line is too long
+ */
+static bool
+CopyLine(const char *line, const char *end, char *buffer,
+         std::size_t buffer_size) noexcept
+{
+  const std::size_t length = end - line;
+  if (length >= buffer_size)
+    return false;
+
+  std::copy(line, end, buffer);
+  buffer[length] = 0;
+  return true;
+}
+
+void
+IGCBulkParse(std::string_view src, IGCBulkResult &result) noexcept
+{
+  /* a B record is at least 35 bytes plus newline */
+  result.fixes.reserve(result.fixes.size() + src.size() / 36);
+
+  IGCExtensions raw_extensions;
+  raw_extensions.clear();
+
+  BulkExtensions extensions;
+  extensions.clear();
+
+  char buffer[256];
+
+  const char *p = src.data();
+  const char *const end = p + src.size();
+
+  while (p < end) {
+    const char *eol = (const char *)std::memchr(p, '\n', end - p);
+    const char *const next = eol != nullptr ? eol + 1 : end;
+    if (eol == nullptr)
+      eol = end;
+
+    if (eol > p && eol[-1] == '\r')
+      --eol;
+
+    switch (*p) {
+    case 'B':
+      if (IGCFix fix; ParseFix(p, eol, extensions, fix))
+        result.fixes.push_back(fix);
+      break;
+
+    case 'H':
+      if (!result.date.IsPlausible() && eol - p >= 5 &&
+          memcmp(p, "HFDTE", 5) == 0 &&
+          CopyLine(p, eol, buffer, sizeof(buffer))) {
+        BrokenDate date;
+        if (IGCParseDateRecord(buffer, date))
+          result.date = date;
+      }
+
+      break;
+
+    case 'I':
+      /* like DebugReplayIGC, keep whatever IGCParseExtensions() has
+         parsed even if it fails */
+      if (CopyLine(p, eol, buffer, sizeof(buffer))) {
+        IGCParseExtensions(buffer, raw_extensions);
+        ResolveExtensions(raw_extensions, extensions);
+      }
+      break;
+    }
+
+    p = next;
+  }
+}
+
+IGCBulkResult
+IGCBulkParseFile(Path path)
+{
+  const FileMapping mapping(path);
+  const std::span<const std::byte> data = mapping;
+
+  IGCBulkResult result;
+  IGCBulkParse({(const char *)data.data(), data.size()}, result);
+  return result;
+}
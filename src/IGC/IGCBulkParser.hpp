@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "IGCFix.hpp"
+#include "time/BrokenDate.hpp"
+
+#include <string_view>
+#include <vector>
+
+class Path;
+
+/**
+ * The fixes of an IGC file, as returned by IGCBulkParse().
+ */
+struct IGCBulkResult {
+  /**
+   * The date from the first valid "HFDTE" record; invalid if there
+   * is none.
+   */
+  BrokenDate date = BrokenDate::Invalid();
+
+  /**
+   * All valid "B" records in file order.  Extensions are decoded
+   * according to the most recent "I" record.
+   */
+  std::vector<IGCFix> fixes;
+};
+
+/**
+ * Parse all "B" records (and the "I" and "HFDTE" records needed to
+ * interpret them) from an IGC file which is already in memory.
+ *
+ * This yields the same fixes as feeding each line to IGCParseFix(),
+ * but the fixed-width fields are decoded directly from the buffer
+ * instead of going through sscanf(), and extension codes are resolved
+ * once per "I" record instead of once per fix.  Lines are split with
+ * memchr(), which libc implements with SIMD instructions on all
+ * relevant platforms.
+ *
+ * The buffer does not need to be null-terminated.
+ */
+void
+IGCBulkParse(std::string_view src, IGCBulkResult &result) noexcept;
+
+/**
+ * Map the specified IGC file into memory and parse it with
+ * IGCBulkParse().
+ *
+ * Throws on I/O error.
+ */
+IGCBulkResult
+IGCBulkParseFile(Path path);
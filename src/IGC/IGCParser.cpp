@@ -199,7 +199,7 @@ static void
 ParseExtensionValueN(const char *p, const char *end, size_t n,
                      int16_t &value_r)
 {
-  if (n > (size_t)(p - end))
+  if (n > (size_t)(end - p))
     /* string is too short */
     return;
 
@@ -16,7 +16,8 @@ IGCWriter::IGCWriter(Path path)
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   async("IGCWriter", file, AsyncOutputStream::Overflow::WAIT),
+   buffered(async)
 {
   fix.Clear();
 
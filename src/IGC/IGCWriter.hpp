@@ -5,6 +5,7 @@
 
 #include "Logger/GRecord.hpp"
 #include "IGCFix.hpp"
+#include "Logger/AsyncOutputStream.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 
@@ -21,6 +22,14 @@ struct GeoPoint;
 
 class IGCWriter {
   FileOutputStream file;
+
+  /**
+   * Writes to #file in a separate thread, so the calculation thread
+   * is not blocked by slow storage.  No line may be lost (it would
+   * break the G record), so this waits instead of dropping data.
+   */
+  AsyncOutputStream async;
+
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -35,10 +44,29 @@ public:
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Pass all pending lines to the writer thread.  This does not
+   * block.
+   */
   void Flush() {
     buffered.Flush();
   }
 
+  /**
+   * Wait until all lines have been written to the file.
+   *
+   * Throws on error.
+   */
+  void Sync() {
+    buffered.Flush();
+    async.Flush();
+  }
+
+  [[gnu::pure]]
+  AsyncOutputStream::Statistics GetStatistics() const noexcept {
+    return async.GetStatistics();
+  }
+
   void Sign();
 
 private:
@@ -69,7 +69,7 @@ InfoBoxContentTeamCode::HandleKey(const InfoBoxKeyCodes keycode) noexcept
 {
   TeamCodeSettings &settings =
     CommonInterface::SetComputerSettings().team_code;
-  const TrafficList &flarm = CommonInterface::Basic().flarm.traffic;
+  const TrafficList &flarm = CommonInterface::Traffic();
   const FlarmTraffic *traffic =
     settings.team_flarm_id.IsDefined()
     ? flarm.FindTraffic(settings.team_flarm_id)
@@ -99,7 +99,7 @@ UpdateInfoBoxTeamBearing(InfoBoxData &data) noexcept
 {
   const TeamCodeSettings &settings =
     CommonInterface::GetComputerSettings().team_code;
-  const TrafficList &flarm = CommonInterface::Basic().flarm.traffic;
+  const TrafficList &flarm = CommonInterface::Traffic();
   const TeamInfo &teamcode_info = CommonInterface::Calculated();
 
   if (teamcode_info.teammate_available) {
@@ -129,7 +129,7 @@ UpdateInfoBoxTeamBearingDiff(InfoBoxData &data) noexcept
   const TeamCodeSettings &settings =
     CommonInterface::GetComputerSettings().team_code;
   const NMEAInfo &basic = CommonInterface::Basic();
-  const TrafficList &flarm = basic.flarm.traffic;
+  const TrafficList &flarm = CommonInterface::Traffic();
   const TeamInfo &teamcode_info = CommonInterface::Calculated();
 
   if (teamcode_info.teammate_available && basic.track_available) {
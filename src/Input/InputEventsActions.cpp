@@ -53,6 +53,11 @@ doc/html/advanced/input/ALL  http://xcsoar.sourceforge.net/advanced/input/
 #include "Language/Language.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
+#include "LatencyTrace.hpp"
+#include "LocalPath.hpp"
+#include "system/Path.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/StaticString.hxx"
 #include "Waypoint/Waypoints.hpp"
 #include "Waypoint/Factory.hpp"
 #include "Waypoint/WaypointGlue.hpp"
@@ -436,6 +441,7 @@ InputEvents::eventAutoLogger(const TCHAR *misc)
 // toggle ask: toggles between on and off, asking the user to confirm
 // show: displays a status message indicating whether the logger is active
 // nmea: turns on and off NMEA logging
+// latency: writes the data path latency trace to a JSON file
 // note: the text following the 'note' characters is added to the log file
 void
 InputEvents::eventLogger(const TCHAR *misc)
@@ -476,6 +482,16 @@ try {
     } else {
       Message::AddMessage(_("NMEA log off"));
     }
+  } else if (StringIsEqual(misc, _T("latency"))) {
+    const BrokenDateTime dt = BrokenDateTime::NowUTC();
+    StaticString<64> name;
+    name.Format(_T("%04u-%02u-%02u_%02u-%02u-%02u-latency.json"),
+                dt.year, dt.month, dt.day,
+                dt.hour, dt.minute, dt.second);
+
+    LatencyTrace::Export(AllocatedPath::Build(MakeLocalPath(_T("logs")),
+                                              name));
+    Message::AddMessage(_("Latency trace written"));
   } else if (StringIsEqual(misc, _T("show")))
     if (logger->IsLoggerActive()) {
       Message::AddMessage(_("Logger on"));
@@ -49,6 +49,19 @@ Basic() noexcept
   return Private::blackboard.Basic();
 }
 
+/**
+ * Returns InterfaceBlackboard.Traffic (read-only)
+ * @return InterfaceBlackboard.Traffic
+ */
+[[gnu::const]]
+static inline const TrafficList &
+Traffic() noexcept
+{
+  assert(InMainThread());
+
+  return Private::blackboard.Traffic();
+}
+
 /**
  * Returns InterfaceBlackboard.Calculated (DERIVED_INFO) (read-only)
  * @return InterfaceBlackboard.Calculated
@@ -201,6 +214,14 @@ ReadBlackboardBasic(const MoreData &nmea_info) noexcept
   Private::blackboard.ReadBlackboardBasic(nmea_info);
 }
 
+static inline void
+ReadTraffic(const TrafficList &traffic, unsigned version) noexcept
+{
+  assert(InMainThread());
+
+  Private::blackboard.ReadTraffic(traffic, version);
+}
+
 static inline void
 ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept
 {
@@ -209,6 +230,14 @@ ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept
   Private::blackboard.ReadBlackboardCalculated(derived_info);
 }
 
+static inline void
+ReadBlackboardCalculated(const CalculatedSnapshot &snapshot) noexcept
+{
+  assert(InMainThread());
+
+  Private::blackboard.ReadBlackboardCalculated(snapshot);
+}
+
 static inline void
 ReadCommonStats(const CommonStats &common_stats) noexcept
 {
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "LatencyTrace.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/FileOutputStream.hxx"
+
+#include <array>
+#include <atomic>
+
+namespace LatencyTrace {
+
+static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+/**
+ * The number of events kept per stage; must be a power of two.
+ */
+static constexpr unsigned RING_SIZE = 2048;
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0);
+
+static constexpr const char *stage_names[N_STAGES] = {
+  "nmea_line",
+  "merge",
+  "process_gps",
+  "process_idle",
+  "draw",
+  "audio",
+};
+
+/**
+ * One event in the ring buffer.  The "sequence" attribute works
+ * like a seqlock: it is zero while the slot is being written and
+ * contains the (1-based) event number afterwards, which allows the
+ * (rare) reader to detect slots that were overwritten while it was
+ * copying them.
+ */
+struct Slot {
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<int64_t> begin{0}, end{0}, origin{0};
+};
+
+struct Ring {
+  std::atomic<uint64_t> head{0};
+
+  /**
+   * The origin of the most recently recorded event.
+   */
+  std::atomic<int64_t> last_origin{0};
+
+  std::array<Slot, RING_SIZE> slots;
+};
+
+static std::array<Ring, N_STAGES> rings;
+
+static constexpr int64_t
+ToInt(Clock::time_point t) noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+void
+Record(Stage stage, Clock::time_point begin, Clock::time_point end,
+       Clock::time_point origin) noexcept
+{
+  auto &ring = rings[unsigned(stage)];
+
+  const uint64_t n = ring.head.fetch_add(1, std::memory_order_relaxed);
+  auto &slot = ring.slots[n & (RING_SIZE - 1)];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.begin.store(ToInt(begin), std::memory_order_relaxed);
+  slot.end.store(ToInt(end), std::memory_order_relaxed);
+  slot.origin.store(ToInt(origin), std::memory_order_relaxed);
+  slot.sequence.store(n + 1, std::memory_order_release);
+
+  ring.last_origin.store(ToInt(origin), std::memory_order_relaxed);
+}
+
+Clock::time_point
+GetOrigin(Stage stage) noexcept
+{
+  const auto &ring = rings[unsigned(stage)];
+  const int64_t origin = ring.last_origin.load(std::memory_order_relaxed);
+  return Clock::time_point{std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds{origin})};
+}
+
+static void
+ExportStage(BufferedOutputStream &os, unsigned stage, bool &first)
+{
+  const auto &ring = rings[stage];
+  const uint64_t head = ring.head.load(std::memory_order_acquire);
+  const uint64_t start = head > RING_SIZE ? head - RING_SIZE : 0;
+
+  for (uint64_t n = start; n < head; ++n) {
+    const auto &slot = ring.slots[n & (RING_SIZE - 1)];
+
+    if (slot.sequence.load(std::memory_order_acquire) != n + 1)
+      continue;
+
+    const int64_t begin = slot.begin.load(std::memory_order_relaxed);
+    const int64_t end = slot.end.load(std::memory_order_relaxed);
+    const int64_t origin = slot.origin.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != n + 1)
+      /* overwritten while we were reading it */
+      continue;
+
+    if (!first)
+      os.Write(",\n");
+    first = false;
+
+    /* the trace event format uses microseconds */
+    os.Fmt(R"({{"name":"{}","cat":"xcsoar","ph":"X","pid":1,"tid":{},)"
+           R"("ts":{:.3f},"dur":{:.3f},"args":{{"latency_us":{:.3f}}}}})",
+           stage_names[stage], stage + 1,
+           begin / 1000., (end - begin) / 1000.,
+           origin > 0 ? (end - origin) / 1000. : 0.);
+  }
+}
+
+void
+Export(BufferedOutputStream &os)
+{
+  os.Write("{\"traceEvents\":[\n");
+
+  bool first = true;
+
+  /* name the "threads" after the stages */
+  for (unsigned i = 0; i < N_STAGES; ++i) {
+    if (!first)
+      os.Write(",\n");
+    first = false;
+
+    os.Fmt(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+           R"("args":{{"name":"{}"}}}})",
+           i + 1, stage_names[i]);
+  }
+
+  for (unsigned i = 0; i < N_STAGES; ++i)
+    ExportStage(os, i, first);
+
+  os.Write("\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void
+Export(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream buffered(file);
+  Export(buffered);
+  buffered.Flush();
+  file.Commit();
+}
+
+} // namespace LatencyTrace
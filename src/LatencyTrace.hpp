@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+class Path;
+class BufferedOutputStream;
+
+/**
+ * Lightweight always-on tracing of the data path from the NMEA
+ * receiver to the map and to the audio vario.  Each stage records
+ * its start/end time stamps into a fixed-size lock-free ring buffer.
+ * In addition to its own duration, each event carries an "origin"
+ * time stamp, i.e. the time the newest NMEA line contributing to the
+ * data processed by this stage was received; this allows measuring
+ * fix-to-pixel and sentence-to-sound latency.
+ *
+ * The buffers can be exported to a Chrome trace / Perfetto JSON file
+ * at any time.
+ */
+namespace LatencyTrace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Stage : uint8_t {
+  /**
+   * DeviceDescriptor::LineReceived()
+   */
+  NMEA_LINE,
+
+  /**
+   * MergeThread: DeviceBlackboard::Merge() and the #BasicComputer
+   */
+  MERGE,
+
+  /**
+   * CalculationThread: GlideComputer::ProcessGPS()
+   */
+  PROCESS_GPS,
+
+  /**
+   * CalculationThread: GlideComputer::ProcessIdle()
+   */
+  PROCESS_IDLE,
+
+  /**
+   * Map redraw (DrawThread or OpenGL paint)
+   */
+  DRAW,
+
+  /**
+   * Audio vario: the first audio buffer containing a new vario value
+   */
+  AUDIO,
+
+  COUNT
+};
+
+/**
+ * Record a completed event.  This is thread-safe and lock-free.
+ *
+ * @param origin the receipt time of the newest NMEA line this
+ * stage has processed
+ */
+void
+Record(Stage stage, Clock::time_point begin, Clock::time_point end,
+       Clock::time_point origin) noexcept;
+
+/**
+ * Returns the origin of the most recent event of the given stage,
+ * to be passed on to the next stage.  Returns a default-constructed
+ * time point if no event was recorded yet.
+ */
+Clock::time_point
+GetOrigin(Stage stage) noexcept;
+
+/**
+ * Measures the lifetime of this object and records it as an event.
+ */
+class ScopeStage {
+  const Stage stage;
+  const Clock::time_point begin = Clock::now();
+  Clock::time_point origin;
+
+public:
+  ScopeStage(Stage _stage, Clock::time_point _origin) noexcept
+    :stage(_stage), origin(_origin) {}
+
+  /**
+   * Use the begin time stamp as origin, i.e. this stage is where
+   * the data originates.
+   */
+  explicit ScopeStage(Stage _stage) noexcept
+    :stage(_stage), origin(begin) {}
+
+  ~ScopeStage() noexcept {
+    Record(stage, begin, Clock::now(), origin);
+  }
+
+  ScopeStage(const ScopeStage &) = delete;
+  ScopeStage &operator=(const ScopeStage &) = delete;
+
+  Clock::time_point GetBegin() const noexcept {
+    return begin;
+  }
+
+  void SetOrigin(Clock::time_point _origin) noexcept {
+    origin = _origin;
+  }
+};
+
+/**
+ * Write all buffered events in the Chrome "Trace Event Format"
+ * (understood by chrome://tracing and Perfetto).
+ *
+ * Throws on I/O error.
+ */
+void
+Export(BufferedOutputStream &os);
+
+/**
+ * Write all buffered events to the specified file.
+ *
+ * Throws on I/O error.
+ */
+void
+Export(Path path);
+
+} // namespace LatencyTrace
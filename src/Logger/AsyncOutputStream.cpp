@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AsyncOutputStream.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+AsyncOutputStream::AsyncOutputStream(const char *name, OutputStream &_next,
+                                     Overflow _overflow,
+                                     std::size_t _capacity,
+                                     std::chrono::steady_clock::duration _max_delay)
+  :Thread(name), next(_next), overflow(_overflow), max_delay(_max_delay),
+   capacity(_capacity), slots(new Slot[_capacity])
+{
+  assert(capacity >= 2);
+  assert((capacity & (capacity - 1)) == 0);
+
+  for (std::size_t i = 0; i < capacity; ++i)
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+
+  Start();
+}
+
+AsyncOutputStream::~AsyncOutputStream() noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    stop = true;
+    wake_cond.notify_one();
+  }
+
+  Join();
+}
+
+inline bool
+AsyncOutputStream::TryPush(std::span<const std::byte> src) noexcept
+{
+  assert(!src.empty());
+
+  const std::size_t n = (src.size() + SLOT_SIZE - 1) / SLOT_SIZE;
+  assert(n <= capacity);
+
+  std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+  while (true) {
+    const Slot &first = slots[pos & (capacity - 1)];
+    const std::size_t sequence = first.sequence.load(std::memory_order_acquire);
+    const auto diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+    if (diff == 0) {
+      /* the writer thread frees the slots in order: if the last
+         one is free, all slots in between are free as well */
+      const std::size_t last_pos = pos + n - 1;
+      const Slot &last = slots[last_pos & (capacity - 1)];
+      if ((std::ptrdiff_t)last.sequence.load(std::memory_order_acquire) -
+          (std::ptrdiff_t)last_pos < 0)
+        /* not enough room for all of the data */
+        return false;
+
+      /* the slots are free; try to claim all of them */
+      if (enqueue_pos.compare_exchange_weak(pos, pos + n,
+                                            std::memory_order_relaxed))
+        break;
+    } else if (diff < 0)
+      /* the writer thread has not consumed this slot yet: full */
+      return false;
+    else
+      /* another producer was faster */
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+  }
+
+  for (std::size_t i = 0; i < n; ++i, ++pos) {
+    const auto chunk = src.first(std::min(src.size(), SLOT_SIZE));
+    src = src.subspan(chunk.size());
+
+    Slot &slot = slots[pos & (capacity - 1)];
+    slot.length = chunk.size();
+    std::copy(chunk.begin(), chunk.end(), slot.data.begin());
+    slot.sequence.store(pos + 1, std::memory_order_release);
+  }
+
+  return true;
+}
+
+inline void
+AsyncOutputStream::WakeWriter() noexcept
+{
+  if (!wake_requested.exchange(true))
+    wake_cond.notify_one();
+}
+
+void
+AsyncOutputStream::Write(std::span<const std::byte> src)
+{
+  /* the largest write which can be queued at once */
+  const std::size_t max_size = SLOT_SIZE * capacity;
+
+  if (overflow == Overflow::DISCARD && src.size() > max_size) {
+    /* never queue a part of the data */
+    discarded.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  bool stalled = false;
+
+  while (!src.empty()) {
+    const auto chunk = src.first(std::min(src.size(), max_size));
+    if (TryPush(chunk)) {
+      src = src.subspan(chunk.size());
+      continue;
+    }
+
+    if (overflow == Overflow::DISCARD) {
+      discarded.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+
+    if (!stalled) {
+      stalls.fetch_add(1, std::memory_order_relaxed);
+      stalled = true;
+    }
+
+    const std::size_t n = (chunk.size() + SLOT_SIZE - 1) / SLOT_SIZE;
+
+    std::unique_lock lock{mutex};
+    wake_requested.store(true);
+    wake_cond.notify_one();
+    done_cond.wait(lock, [this, n]{ return GetFill() + n <= capacity; });
+  }
+
+  if (GetFill() >= capacity / 2)
+    WakeWriter();
+}
+
+void
+AsyncOutputStream::Flush()
+{
+  const std::size_t target = enqueue_pos.load();
+
+  std::unique_lock lock{mutex};
+  wake_requested.store(true);
+  wake_cond.notify_one();
+  done_cond.wait(lock, [this, target]{ return written_pos >= target; });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+AsyncOutputStream::Statistics
+AsyncOutputStream::GetStatistics() const noexcept
+{
+  return {
+    written_bytes.load(std::memory_order_relaxed),
+    batches.load(std::memory_order_relaxed),
+    discarded.load(std::memory_order_relaxed),
+    stalls.load(std::memory_order_relaxed),
+  };
+}
+
+inline void
+AsyncOutputStream::WriteBatch(std::span<const std::byte> src) noexcept
+{
+  try {
+    next.Write(src);
+    written_bytes.fetch_add(src.size(), std::memory_order_relaxed);
+    batches.fetch_add(1, std::memory_order_relaxed);
+  } catch (...) {
+    const std::lock_guard lock{mutex};
+    error = std::current_exception();
+  }
+}
+
+inline void
+AsyncOutputStream::Drain() noexcept
+{
+  std::array<std::byte, 4096> batch;
+  std::size_t fill = 0;
+
+  std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    Slot &slot = slots[pos & (capacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+      /* empty, or a producer is still filling this slot */
+      break;
+
+    if (fill + slot.length > batch.size()) {
+      if (!error)
+        WriteBatch({batch.data(), fill});
+      fill = 0;
+    }
+
+    std::copy_n(slot.data.begin(), slot.length, batch.begin() + fill);
+    fill += slot.length;
+
+    /* hand the slot back to the producers */
+    ++pos;
+    slot.sequence.store(pos + capacity - 1, std::memory_order_release);
+    dequeue_pos.store(pos, std::memory_order_relaxed);
+  }
+
+  if (fill > 0 && !error)
+    WriteBatch({batch.data(), fill});
+}
+
+void
+AsyncOutputStream::Run() noexcept
+{
+  std::unique_lock lock{mutex};
+
+  while (true) {
+    /* check the flag before draining: all data written before the
+       destructor was called will be passed to the underlying
+       stream */
+    const bool stopping = stop;
+
+    lock.unlock();
+    Drain();
+    lock.lock();
+
+    written_pos = dequeue_pos.load(std::memory_order_relaxed);
+    done_cond.notify_all();
+
+    if (stopping)
+      break;
+
+    if (!wake_requested.exchange(false) && !stop)
+      wake_cond.wait_for(lock, max_delay);
+
+    wake_requested.store(false);
+  }
+}
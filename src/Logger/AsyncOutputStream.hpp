@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "io/OutputStream.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+
+/**
+ * An #OutputStream which hands the data over to a dedicated writer
+ * thread, so a slow storage device (e.g. an SD card) does not stall
+ * the threads producing the data.
+ *
+ * Write() copies the data into a bounded lock-free multi-producer
+ * ring buffer of fixed-size slots (Dmitry Vyukov's bounded queue).
+ * The data of one Write() call is split into slots of #SLOT_SIZE
+ * bytes which are claimed all at once, so it is never interleaved
+ * with data from other threads, and in DISCARD mode, it is either
+ * queued completely or not at all.
+ *
+ * The writer thread collects the slots into batches and passes them
+ * to the underlying stream when the ring buffer is half full, after
+ * #max_delay, on Flush() and on destruction.
+ */
+class AsyncOutputStream final : public OutputStream, Thread {
+public:
+  static constexpr std::size_t SLOT_SIZE = 246;
+
+  /**
+   * What Write() does when the ring buffer is full.
+   */
+  enum class Overflow : uint8_t {
+    /**
+     * Drop the whole Write() call and count it in
+     * Statistics::discarded.
+     */
+    DISCARD,
+
+    /**
+     * Wait until the writer thread has made room.  This is counted
+     * in Statistics::stalls.  A Write() call larger than the whole
+     * ring buffer is queued in several parts.
+     */
+    WAIT,
+  };
+
+  struct Statistics {
+    /**
+     * The number of bytes passed to the underlying stream.
+     */
+    uint64_t written_bytes;
+
+    /**
+     * The number of OutputStream::Write() calls on the underlying
+     * stream.
+     */
+    uint32_t batches;
+
+    /**
+     * The number of Write() calls whose data was dropped because
+     * the ring buffer was full.
+     */
+    uint32_t discarded;
+
+    /**
+     * The number of Write() calls which had to wait for the writer
+     * thread.
+     */
+    uint32_t stalls;
+  };
+
+private:
+  struct Slot {
+    /**
+     * Vyukov's sequence number: equals the position when the slot
+     * is free for the producer claiming this position, and
+     * position+1 when it has been filled.
+     */
+    std::atomic_size_t sequence;
+
+    uint16_t length;
+
+    std::array<std::byte, SLOT_SIZE> data;
+  };
+
+  OutputStream &next;
+
+  const Overflow overflow;
+
+  const std::chrono::steady_clock::duration max_delay;
+
+  const std::size_t capacity;
+  const std::unique_ptr<Slot[]> slots;
+
+  /**
+   * The position of the next slot to be claimed by a producer.
+   */
+  alignas(64) std::atomic_size_t enqueue_pos{0};
+
+  /**
+   * The position of the next slot to be consumed.  Only modified
+   * by the writer thread.
+   */
+  alignas(64) std::atomic_size_t dequeue_pos{0};
+
+  /**
+   * Set to wake up the writer thread before #max_delay has passed.
+   */
+  std::atomic_bool wake_requested{false};
+
+  Mutex mutex;
+
+  /**
+   * Wakes up the writer thread.
+   */
+  Cond wake_cond;
+
+  /**
+   * Signalled by the writer thread after each batch; wakes up
+   * Flush() and producers waiting for room.
+   */
+  Cond done_cond;
+
+  /**
+   * The number of slots which have been passed to the underlying
+   * stream.  Protected by #mutex.
+   */
+  std::size_t written_pos = 0;
+
+  /**
+   * Protected by #mutex.
+   */
+  bool stop = false;
+
+  /**
+   * The first error thrown by the underlying stream; after that,
+   * all data is dropped.  Protected by #mutex.
+   */
+  std::exception_ptr error;
+
+  std::atomic_uint64_t written_bytes{0};
+  std::atomic_uint32_t batches{0}, discarded{0}, stalls{0};
+
+public:
+  /**
+   * Throws on error.
+   *
+   * @param name the name of the writer thread
+   * @param _capacity the number of slots; must be a power of two
+   * @param _max_delay the maximum time data is kept in the ring
+   * buffer
+   */
+  AsyncOutputStream(const char *name, OutputStream &_next,
+                    Overflow _overflow, std::size_t _capacity = 256,
+                    std::chrono::steady_clock::duration _max_delay = std::chrono::seconds{1});
+
+  /**
+   * Writes all pending data and stops the writer thread.  Errors
+   * are ignored; call Flush() before to catch them.
+   *
+   * The caller must ensure that no other thread calls Write()
+   * concurrently.
+   */
+  ~AsyncOutputStream() noexcept;
+
+  /**
+   * Wait until all data passed to Write() so far has been passed to
+   * the underlying stream.
+   *
+   * Throws the first error thrown by the underlying stream.
+   */
+  void Flush();
+
+  [[gnu::pure]]
+  Statistics GetStatistics() const noexcept;
+
+  /* virtual methods from class OutputStream */
+
+  /**
+   * This method may be called from any thread.  It does not throw.
+   */
+  void Write(std::span<const std::byte> src) override;
+
+private:
+  [[gnu::pure]]
+  std::size_t GetFill() const noexcept {
+    return enqueue_pos.load(std::memory_order_relaxed) -
+      dequeue_pos.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Claim all slots needed for the data at once and copy it.
+   *
+   * @param src the data; must fit into #capacity slots
+   * @return false if there is not enough room
+   */
+  bool TryPush(std::span<const std::byte> src) noexcept;
+
+  /**
+   * Wake up the writer thread without taking the mutex.  A wakeup
+   * may get lost, which delays the batch until #max_delay.
+   */
+  void WakeWriter() noexcept;
+
+  void WriteBatch(std::span<const std::byte> src) noexcept;
+
+  /**
+   * Pass all filled slots to the underlying stream.
+   */
+  void Drain() noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
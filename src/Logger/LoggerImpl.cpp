@@ -70,9 +70,13 @@ LoggerImpl::StopLogger([[maybe_unused]] const NMEAInfo &gps_info)
   if (!simulator)
     writer->Sign();
 
-  writer->Flush();
+  /* make sure everything is on the storage before the pilot
+     switches off the device */
+  writer->Sync();
 
-  LogFormat(_T("Logger stopped: %s"), filename.c_str());
+  const auto stats = writer->GetStatistics();
+  LogFormat(_T("Logger stopped: %s (%u writes, %u stalls)"), filename.c_str(),
+            (unsigned)stats.batches, (unsigned)stats.stalls);
 
   // Logger off
   writer.reset();
@@ -2,20 +2,39 @@
 // Copyright The XCSoar Project
 
 #include "Logger/NMEALogger.hpp"
+#include "Logger/AsyncOutputStream.hpp"
 #include "io/FileOutputStream.hxx"
 #include "LocalPath.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "system/Path.hpp"
 #include "util/SpanCast.hxx"
 #include "util/StaticString.hxx"
+#include "LogFile.hpp"
+
+#include <algorithm>
 
 NMEALogger::NMEALogger() noexcept {}
-NMEALogger::~NMEALogger() noexcept = default;
+
+NMEALogger::~NMEALogger() noexcept
+{
+  if (stream != nullptr) {
+    const auto stats = stream->GetStatistics();
+    if (stats.discarded > 0)
+      LogFormat("NMEA logger dropped %u lines", (unsigned)stats.discarded);
+
+    const unsigned n_rejected = rejected.load(std::memory_order_relaxed);
+    if (n_rejected > 0)
+      LogFormat("NMEA logger rejected %u overlong lines", n_rejected);
+
+    /* write all pending lines before closing the file */
+    stream.reset();
+  }
+}
 
 inline void
 NMEALogger::Start()
 {
-  if (file != nullptr)
+  if (stream != nullptr)
     return;
 
   BrokenDateTime dt = BrokenDateTime::NowUTC();
@@ -31,15 +50,32 @@ NMEALogger::Start()
   const auto path = AllocatedPath::Build(logs_path, name);
   file = std::make_unique<FileOutputStream>(path,
                                             FileOutputStream::Mode::APPEND_OR_CREATE);
+  stream = std::make_unique<AsyncOutputStream>("NMEALogger", *file,
+                                               AsyncOutputStream::Overflow::DISCARD);
+  started.store(true, std::memory_order_release);
 }
 
-static void
+/**
+ * Write the line and its newline with one Write() call, so it cannot
+ * be interleaved with lines from other threads, and in DISCARD mode,
+ * it is either queued completely or not at all.
+ *
+ * @return false if the line is too long (it is not written)
+ */
+static bool
 WriteLine(OutputStream &os, std::string_view text)
 {
-  os.Write(AsBytes(text));
+  /* NMEA sentences are much shorter than one slot; longer lines are
+     garbage and are rejected, which allows using a small stack
+     buffer */
+  std::array<char, AsyncOutputStream::SLOT_SIZE> buffer;
+  if (text.size() >= buffer.size())
+    return false;
 
-  static constexpr char newline = '\n';
-  os.Write(ReferenceAsBytes(newline));
+  auto end = std::copy(text.begin(), text.end(), buffer.begin());
+  *end++ = '\n';
+  os.Write(AsBytes(std::string_view{buffer.data(), end}));
+  return true;
 }
 
 void
@@ -48,11 +84,26 @@ NMEALogger::Log(const char *text) noexcept
   if (!enabled)
     return;
 
-  const std::lock_guard lock{mutex};
+  try {
+    if (!started.load(std::memory_order_acquire)) {
+      const std::lock_guard lock{mutex};
+      Start();
+    }
+
+    if (!WriteLine(*stream, text))
+      rejected.fetch_add(1, std::memory_order_relaxed);
+  } catch (...) {
+  }
+}
+
+void
+NMEALogger::Flush() noexcept
+{
+  if (!started.load(std::memory_order_acquire))
+    return;
 
   try {
-    Start();
-    WriteLine(*file, text);
+    stream->Flush();
   } catch (...) {
   }
 }
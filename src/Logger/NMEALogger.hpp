@@ -5,14 +5,38 @@
 
 #include "thread/Mutex.hxx"
 
+#include <atomic>
 #include <memory>
 
 class FileOutputStream;
+class AsyncOutputStream;
 
 class NMEALogger {
+  /**
+   * Protects Start().
+   */
   Mutex mutex;
+
   std::unique_ptr<FileOutputStream> file;
 
+  /**
+   * Writes to #file in a separate thread, so the device threads
+   * calling Log() never block on the file.
+   */
+  std::unique_ptr<AsyncOutputStream> stream;
+
+  /**
+   * Set when #stream is ready; Log() does not lock #mutex after
+   * that.
+   */
+  std::atomic_bool started{false};
+
+  /**
+   * The number of lines which were not logged because they do not
+   * fit into one AsyncOutputStream slot.
+   */
+  std::atomic_uint rejected{0};
+
   bool enabled = false;
 
 public:
@@ -29,14 +53,25 @@ public:
 
   void ToggleEnabled() noexcept {
     enabled = !enabled;
+    if (!enabled)
+      Flush();
   }
 
   /**
-   * Logs NMEA string to log file
+   * Logs NMEA string to log file.  This method may be called from
+   * any thread; if the writer thread cannot keep up, the line is
+   * dropped.  Lines which do not fit into one AsyncOutputStream slot
+   * (including the newline) are rejected.
+   *
    * @param text
    */
   void Log(const char *line) noexcept;
 
+  /**
+   * Wait until all lines have been written to the file.
+   */
+  void Flush() noexcept;
+
 private:
   void Start();
 };
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Logger/SensorRecorder.hpp"
+#include "Logger/AsyncOutputStream.hpp"
+#include "Replay/SensorRecord.hpp"
+#include "NMEA/Info.hpp"
+#include "io/FileOutputStream.hxx"
+#include "LocalPath.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "system/Path.hpp"
+#include "util/StaticString.hxx"
+#include "LogFile.hpp"
+
+SensorRecorder::SensorRecorder() noexcept
+  :StandbyThread("SensorRecorder"),
+   queue(std::make_unique<NMEAInfo[]>(QUEUE_SIZE)) {}
+
+SensorRecorder::~SensorRecorder() noexcept
+{
+  LockStop();
+
+  /* the thread has exited; write what it has left behind */
+  while (queue_length > 0 && !failed) {
+    failed = !WriteHead();
+    queue_head = (queue_head + 1) % QUEUE_SIZE;
+    --queue_length;
+  }
+
+  if (dropped > 0)
+    LogFormat(_T("Sensor recording: dropped %u snapshots"), dropped);
+
+  if (writer == nullptr)
+    return;
+
+  try {
+    writer->Finish();
+    async->Flush();
+    file->Commit();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to finish sensor recording");
+  }
+
+  writer.reset();
+  async.reset();
+}
+
+inline void
+SensorRecorder::Open()
+{
+  BrokenDateTime dt = BrokenDateTime::NowUTC();
+  assert(dt.IsPlausible());
+
+  StaticString<64> name;
+  name.Format(_T("%04u-%02u-%02u_%02u-%02u.xsr"),
+              dt.year, dt.month, dt.day,
+              dt.hour, dt.minute);
+
+  const auto logs_path = MakeLocalPath(_T("logs"));
+
+  const auto path = AllocatedPath::Build(logs_path, name);
+  file = std::make_unique<FileOutputStream>(path,
+                                            FileOutputStream::Mode::CREATE_VISIBLE);
+
+  /* a lost record would break the delta chain, therefore wait
+     instead of discarding data if the writer thread falls behind;
+     this blocks only the recorder thread */
+  async = std::make_unique<AsyncOutputStream>("SensorRecorder", *file,
+                                              AsyncOutputStream::Overflow::WAIT);
+  writer = std::make_unique<SensorRecordWriter>(*async);
+
+  LogFormat(_T("Sensor recording to %s"), path.c_str());
+}
+
+inline bool
+SensorRecorder::WriteHead() noexcept
+{
+  try {
+    if (writer == nullptr)
+      Open();
+
+    writer->Write(queue[queue_head]);
+    return true;
+  } catch (...) {
+    LogError(std::current_exception(), "Sensor recording failed");
+    return false;
+  }
+}
+
+void
+SensorRecorder::Tick() noexcept
+{
+  while (queue_length > 0 && !failed && !IsStopped()) {
+    bool success;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      success = WriteHead();
+    }
+
+    failed = !success;
+    queue_head = (queue_head + 1) % QUEUE_SIZE;
+    --queue_length;
+  }
+}
+
+void
+SensorRecorder::Record(const NMEAInfo &basic) noexcept
+{
+  if (!basic.alive)
+    return;
+
+  const std::lock_guard lock{mutex};
+
+  if (failed)
+    return;
+
+  if (queue_length == QUEUE_SIZE) {
+    ++dropped;
+    return;
+  }
+
+  queue[(queue_head + queue_length) % QUEUE_SIZE] = basic;
+  ++queue_length;
+
+  try {
+    Trigger();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to start sensor recording");
+    failed = true;
+  }
+}
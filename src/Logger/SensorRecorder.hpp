@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/StandbyThread.hpp"
+
+#include <cstddef>
+#include <memory>
+
+struct NMEAInfo;
+class FileOutputStream;
+class AsyncOutputStream;
+class SensorRecordWriter;
+
+/**
+ * Records the merged data of all physical devices in a compact
+ * binary file (see #SensorRecordWriter) in the "logs" directory,
+ * which can be replayed by #SensorReplay.
+ *
+ * Record() only copies the snapshot into a small queue; a separate
+ * thread creates the file when the first data arrives, encodes the
+ * snapshots and writes them (see #AsyncOutputStream), so neither
+ * file creation nor a slow SD card stalls the caller.
+ */
+class SensorRecorder final : private StandbyThread {
+  static constexpr std::size_t QUEUE_SIZE = 16;
+
+  /**
+   * A ring buffer of snapshots waiting for the thread.  The slot at
+   * #queue_head is being encoded by the thread, while Record() may
+   * fill the free slots.  Protected by #mutex (except for the
+   * contents of the slot being encoded).
+   */
+  const std::unique_ptr<NMEAInfo[]> queue;
+  std::size_t queue_head = 0, queue_length = 0;
+
+  /**
+   * The number of snapshots dropped because the queue was full.
+   * This does not break the delta chain, because the deltas are
+   * calculated by the thread.  Protected by #mutex.
+   */
+  unsigned dropped = 0;
+
+  /**
+   * Set after an I/O error; the recording is stopped then.
+   * Protected by #mutex.
+   */
+  bool failed = false;
+
+  /* the following attributes are only used by the thread, and by
+     the destructor after the thread has been stopped */
+
+  std::unique_ptr<FileOutputStream> file;
+  std::unique_ptr<AsyncOutputStream> async;
+  std::unique_ptr<SensorRecordWriter> writer;
+
+public:
+  SensorRecorder() noexcept;
+
+  /**
+   * Writes the pending snapshots and the index and closes the
+   * file.
+   */
+  ~SensorRecorder() noexcept;
+
+  SensorRecorder(const SensorRecorder &) = delete;
+  SensorRecorder &operator=(const SensorRecorder &) = delete;
+
+  /**
+   * Queue a snapshot.  This is called by DeviceBlackboard::Merge()
+   * while the blackboard is locked, i.e. from one thread at a time;
+   * it does not block on I/O.
+   */
+  void Record(const NMEAInfo &basic) noexcept;
+
+private:
+  /**
+   * Create the file.
+   *
+   * Throws on error.
+   */
+  void Open();
+
+  /**
+   * Encode and write the oldest queued snapshot.  Caller must not
+   * lock the mutex.
+   *
+   * @return false on error
+   */
+  bool WriteHead() noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
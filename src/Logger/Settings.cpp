@@ -19,4 +19,5 @@ LoggerSettings::SetDefaults()
   enable_flight_logger = false;
 
   enable_nmea_logger = false;
+  enable_sensor_recorder = false;
 }
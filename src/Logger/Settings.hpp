@@ -21,6 +21,11 @@ struct LoggerSettings {
    */
   bool enable_nmea_logger;
 
+  /**
+   * Enable the #SensorRecorder?
+   */
+  bool enable_sensor_recorder;
+
   /** Logger interval in cruise mode */
   std::chrono::duration<unsigned> time_step_cruise;
 
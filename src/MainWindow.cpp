@@ -1094,11 +1094,12 @@ void
 MainWindow::UpdateTrafficGaugeVisibility() noexcept
 {
   const FlarmData &flarm = CommonInterface::Basic().flarm;
+  const TrafficList &traffic = CommonInterface::Traffic();
 
   bool traffic_visible =
     (force_traffic_gauge ||
      (CommonInterface::GetUISettings().traffic.enable_gauge &&
-      !flarm.traffic.IsEmpty())) &&
+      !traffic.IsEmpty())) &&
     !CommonInterface::GetUIState().screen_blanked &&
     /* hide the traffic gauge while the traffic widget is visible, to
        avoid showing the same information twice */
@@ -1116,7 +1117,7 @@ MainWindow::UpdateTrafficGaugeVisibility() noexcept
     if (HasDialog())
       return;
 
-    if (!flarm.traffic.InCloseRange())
+    if (!traffic.InCloseRange())
       return;
 
     if (!traffic_gauge.IsDefined())
@@ -47,6 +47,7 @@ MapSettings::SetDefaults() noexcept
   final_glide_bar_display_mode = FinalGlideBarDisplayMode::ON;
   vario_bar_enabled = false;
   show_fai_triangle_areas = false;
+  show_layer_statistics = false;
   skylines_traffic_map_mode = DisplaySkyLinesTrafficMapMode::SYMBOL;
 
   trail.SetDefaults();
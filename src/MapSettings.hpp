@@ -178,6 +178,11 @@ struct MapSettings {
    */
   bool show_fai_triangle_areas;
 
+  /**
+   * Show the drawing time of each map layer (for developers)?
+   */
+  bool show_layer_statistics;
+
   /**
    * Display skylines name on map
    */
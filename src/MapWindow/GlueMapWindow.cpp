@@ -105,9 +105,16 @@ GlueMapWindow::ExchangeBlackboard() noexcept
 
   {
     auto &device_blackboard = *backend_components->device_blackboard;
+
     const std::lock_guard lock{device_blackboard.mutex};
-    ReadBlackboard(device_blackboard.Basic(),
-                   device_blackboard.Calculated());
+    ReadBlackboardBasic(device_blackboard.Basic());
+    ReadTraffic(device_blackboard.Traffic(),
+                device_blackboard.GetTrafficVersion());
+
+    /* the snapshot is lock-free, but reading it while Basic() cannot
+       change guarantees that both values existed at the same time */
+    ReadBlackboardCalculated(device_blackboard.GetCalculatedSnapshot());
+    latency_origin = LatencyTrace::GetOrigin(LatencyTrace::Stage::MERGE);
   }
 
 #ifndef ENABLE_OPENGL
@@ -12,6 +12,7 @@
 #include "Renderer/VarioBarRenderer.hpp"
 #include "ui/event/Timer.hpp"
 #include "ui/event/Notify.hpp"
+#include "LatencyTrace.hpp"
 #include "ui/window/Features.hpp"
 
 #ifdef ENABLE_OPENGL
@@ -115,6 +116,12 @@ class GlueMapWindow : public MapWindow {
   UIState next_ui_state;
 #endif
 
+  /**
+   * The #LatencyTrace origin of the data obtained by the last
+   * ExchangeBlackboard() call.  Only accessed by the drawing thread.
+   */
+  LatencyTrace::Clock::time_point latency_origin;
+
   ThermalBandRenderer thermal_band_renderer;
   FinalGlideBarRenderer final_glide_bar_renderer;
   VarioBarRenderer vario_bar_renderer;
@@ -251,6 +258,7 @@ private:
   void DrawFinalGlide(Canvas &canvas, const PixelRect &rc) const noexcept;
   void DrawVario(Canvas &canvas, const PixelRect &rc) const noexcept;
   void DrawStallRatio(Canvas &canvas, const PixelRect &rc) const noexcept;
+  void DrawLayerStatistics(Canvas &canvas, const PixelRect &rc) const noexcept;
 
   void SwitchZoomClimb() noexcept;
 
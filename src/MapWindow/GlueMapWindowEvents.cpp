@@ -395,6 +395,9 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas) noexcept
   EnterDrawThread();
 #endif
 
+  const LatencyTrace::ScopeStage trace{LatencyTrace::Stage::DRAW,
+                                       latency_origin};
+
   MapWindow::OnPaintBuffer(canvas);
 
   DrawMapScale(canvas, GetClientRect(), render_projection);
@@ -452,4 +455,7 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
     DrawVario(canvas, rc);
     DrawGPSStatus(canvas, rc, Basic());
   }
+
+  if (GetMapSettings().show_layer_statistics)
+    DrawLayerStatistics(canvas, rc);
 }
@@ -80,7 +80,7 @@ GlueMapWindow::ShowMapItems(const GeoPoint &location,
     builder.AddWeatherStations(*noaa_store);
 #endif
 
-  builder.AddTraffic(basic.flarm.traffic);
+  builder.AddTraffic(Traffic());
 
 #ifdef HAVE_SKYLINES_TRACKING
   builder.AddSkyLinesTraffic();
@@ -445,6 +445,51 @@ GlueMapWindow::DrawThermalBand(Canvas &canvas,
   }
 }
 
+void
+GlueMapWindow::DrawLayerStatistics(Canvas &canvas,
+                                   const PixelRect &rc) const noexcept
+{
+  using ms = std::chrono::duration<double, std::milli>;
+
+  TextInBoxMode mode;
+  mode.shape = LabelShape::OUTLINED;
+
+  const Font &font = *look.overlay.overlay_font;
+  canvas.Select(font);
+
+  const unsigned padding = Layout::FastScale(4);
+  const unsigned height = font.GetHeight();
+
+  /* below the thermal band */
+  PixelPoint p(rc.left + Layout::Scale(25) + padding,
+               rc.top + rc.GetHeight() / 5 + padding);
+
+  StaticString<64> buffer;
+
+  const auto &frame = layer_statistics.GetFrame();
+  buffer.UnsafeFormat(_T("Frame %.1f ms (max %.1f)"),
+                      ms(frame.average).count(),
+                      ms(frame.maximum).count());
+  TextInBox(canvas, buffer, p, mode, rc);
+  p.y += height;
+
+  for (unsigned i = 0; i < unsigned(MapLayer::COUNT); ++i) {
+    const MapLayer layer = MapLayer(i);
+    const auto &entry = layer_statistics.Get(layer);
+
+    /* omit layers which are disabled or trivial */
+    if (entry.maximum < std::chrono::microseconds{100})
+      continue;
+
+    buffer.UnsafeFormat(_T("%s %.1f ms (max %.1f)"),
+                        MapLayerStatistics::GetName(layer),
+                        ms(entry.average).count(),
+                        ms(entry.maximum).count());
+    TextInBox(canvas, buffer, p, mode, rc);
+    p.y += height;
+  }
+}
+
 void
 GlueMapWindow::DrawStallRatio(Canvas &canvas,
                               const PixelRect &rc) const noexcept
@@ -14,7 +14,7 @@
 void
 MapItemListBuilder::AddTraffic(const TrafficList &flarm)
 {
-  for (const auto &t : flarm.list) {
+  for (const auto &t : flarm) {
     if (list.full())
       break;
 
@@ -42,8 +42,7 @@ void
 MapCanvas::Project(const Projection &projection,
                    const SearchPointVector &points, BulkPixelPoint *screen) noexcept
 {
-  for (const auto i : points)
-    *screen++ = projection.GeoToScreen(i.GetLocation());
+  projection.GeoToScreen(points, screen);
 }
 
 bool
@@ -67,8 +66,15 @@ MapCanvas::PreparePolygon(const SearchPointVector &points) noexcept
 
   /* project all GeoPoints to screen coordinates */
   raster_points.GrowDiscard(num_raster_points);
-  for (unsigned i = 0; i < num_raster_points; ++i)
-    raster_points[i] = projection.GeoToScreen(geo_points[i]);
+
+  /* the margin leaves room for thick outline pens */
+  const auto screen_rect = PixelRect{canvas.GetSize()}
+    .WithMargin(Layout::Scale(20));
+  if (projection.GeoToScreen({geo_points.data(), num_raster_points},
+                             raster_points.data(), &screen_rect) != 0)
+    /* all points are beyond the same screen edge; this can happen
+       despite the GeoClip when the map is rotated */
+    return false;
 
   return true;
 }
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "MapLayerStatistics.hpp"
+
+#include <algorithm>
+
+void
+MapLayerStatistics::Entry::Update(Duration d) noexcept
+{
+  last = d;
+
+  /* smoothing factor 1/16 */
+  average += (d - average) / 16;
+
+  window_maximum = std::max(window_maximum, d);
+  maximum = std::max(maximum, d);
+}
+
+void
+MapLayerStatistics::Entry::RotateWindow() noexcept
+{
+  maximum = window_maximum;
+  window_maximum = {};
+}
+
+void
+MapLayerStatistics::BeginFrame() noexcept
+{
+  pending.fill({});
+  frame_start = Clock::now();
+  current = MapLayer::COUNT;
+}
+
+inline void
+MapLayerStatistics::FinishLayer(Clock::time_point now) noexcept
+{
+  if (current != MapLayer::COUNT)
+    pending[std::size_t(current)] += now - layer_start;
+}
+
+void
+MapLayerStatistics::Mark(MapLayer layer) noexcept
+{
+  const auto now = Clock::now();
+  FinishLayer(now);
+
+  current = layer;
+  layer_start = now;
+}
+
+void
+MapLayerStatistics::EndFrame() noexcept
+{
+  const auto now = Clock::now();
+  FinishLayer(now);
+  current = MapLayer::COUNT;
+
+  for (std::size_t i = 0; i < layers.size(); ++i)
+    layers[i].Update(pending[i]);
+
+  frame.Update(now - frame_start);
+
+  if (++n_frames % WINDOW == 0) {
+    for (auto &i : layers)
+      i.RotateWindow();
+    frame.RotateWindow();
+  }
+}
+
+const TCHAR *
+MapLayerStatistics::GetName(MapLayer layer) noexcept
+{
+  switch (layer) {
+  case MapLayer::TERRAIN:
+    return _T("Terrain");
+  case MapLayer::RASP:
+    return _T("RASP");
+  case MapLayer::TOPOGRAPHY:
+    return _T("Topography");
+  case MapLayer::OVERLAYS:
+    return _T("Overlays");
+  case MapLayer::NOAA:
+    return _T("NOAA");
+  case MapLayer::FINAL_GLIDE:
+    return _T("Glide range");
+  case MapLayer::AIRSPACE:
+    return _T("Airspace");
+  case MapLayer::CONTEST:
+    return _T("Contest");
+  case MapLayer::TASK:
+    return _T("Task");
+  case MapLayer::WAYPOINTS:
+    return _T("Waypoints");
+  case MapLayer::TRAIL:
+    return _T("Trail");
+  case MapLayer::WAVES:
+    return _T("Waves");
+  case MapLayer::THERMAL:
+    return _T("Thermal");
+  case MapLayer::LABELS:
+    return _T("Labels");
+  case MapLayer::NAVIGATION:
+    return _T("Navigation");
+  case MapLayer::TRAFFIC:
+    return _T("Traffic");
+  case MapLayer::AIRCRAFT:
+    return _T("Aircraft");
+  case MapLayer::COUNT:
+    break;
+  }
+
+  return _T("?");
+}
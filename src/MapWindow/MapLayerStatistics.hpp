@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <tchar.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * The layers drawn by MapWindow::Render(), from bottom to top.
+ */
+enum class MapLayer : uint8_t {
+  TERRAIN,
+  RASP,
+  TOPOGRAPHY,
+  OVERLAYS,
+  NOAA,
+  FINAL_GLIDE,
+  AIRSPACE,
+  CONTEST,
+  TASK,
+  WAYPOINTS,
+  TRAIL,
+  WAVES,
+  THERMAL,
+  LABELS,
+  NAVIGATION,
+  TRAFFIC,
+  AIRCRAFT,
+
+  COUNT
+};
+
+/**
+ * Measures how long each #MapLayer takes to draw.  Unlike
+ * #ScreenStopWatch, this is always enabled; it is cheap enough to run
+ * on every frame, and its numbers can be displayed on the map.
+ *
+ * This object is only accessed by the thread which draws the map.
+ */
+class MapLayerStatistics {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  struct Entry {
+    /**
+     * The time spent in the most recent frame.
+     */
+    Duration last{};
+
+    /**
+     * An exponential moving average over recent frames.
+     */
+    Duration average{};
+
+    /**
+     * The maximum of the previous and the current window of
+     * #WINDOW frames.
+     */
+    Duration maximum{};
+
+    /**
+     * The maximum of the current (incomplete) window.
+     */
+    Duration window_maximum{};
+
+    void Update(Duration d) noexcept;
+    void RotateWindow() noexcept;
+  };
+
+private:
+  /**
+   * The number of frames after which Entry::maximum is updated.
+   */
+  static constexpr unsigned WINDOW = 64;
+
+  std::array<Entry, std::size_t(MapLayer::COUNT)> layers;
+
+  /**
+   * The time spent in each layer during the current frame.
+   */
+  std::array<Duration, std::size_t(MapLayer::COUNT)> pending;
+
+  Entry frame;
+
+  unsigned n_frames = 0;
+
+  Clock::time_point frame_start, layer_start;
+
+  /**
+   * The layer which is currently being drawn; #MapLayer::COUNT
+   * outside of a frame.
+   */
+  MapLayer current = MapLayer::COUNT;
+
+public:
+  void BeginFrame() noexcept;
+
+  /**
+   * Finish the current layer (if any) and start measuring the given
+   * one.  Layers which are not marked during a frame are accounted
+   * as zero; a layer may be marked more than once.
+   */
+  void Mark(MapLayer layer) noexcept;
+
+  void EndFrame() noexcept;
+
+  unsigned GetFrameCount() const noexcept {
+    return n_frames;
+  }
+
+  const Entry &Get(MapLayer layer) const noexcept {
+    return layers[std::size_t(layer)];
+  }
+
+  const Entry &GetFrame() const noexcept {
+    return frame;
+  }
+
+  [[gnu::const]]
+  static const TCHAR *GetName(MapLayer layer) noexcept;
+
+private:
+  void FinishLayer(Clock::time_point now) noexcept;
+};
@@ -14,6 +14,12 @@
 #include "ui/canvas/opengl/Scissor.hpp"
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+#include "ui/canvas/memory/TiledRenderer.hpp"
+#include "thread/ThreadPool.hpp"
+#include "LogFile.hpp"
+#endif
+
 /**
  * Constructor of the MapWindow class
  */
@@ -103,6 +109,31 @@ MapWindow::UpdateTerrain() noexcept
   return terrain->UpdateTiles(location, radius);
 }
 
+#ifdef USE_MEMORY_CANVAS
+
+inline TiledRenderer *
+MapWindow::GetTiledRenderer() noexcept
+{
+  if (tiled_renderer == nullptr) {
+    const unsigned concurrency = ThreadPool::GetDefaultConcurrency();
+    if (concurrency > 1) {
+      try {
+        raster_pool = std::make_unique<ThreadPool>(concurrency);
+      } catch (...) {
+        /* draw everything on this thread */
+        LogError(std::current_exception(),
+                 "Failed to create map rasteriser threads");
+      }
+    }
+
+    tiled_renderer = std::make_unique<TiledRenderer>(raster_pool.get());
+  }
+
+  return tiled_renderer.get();
+}
+
+#endif
+
 /**
  * Handles the drawing of the moving map and is called by the DrawThread
  */
@@ -120,8 +151,18 @@ MapWindow::OnPaintBuffer(Canvas &canvas) noexcept
     const ScopeUnlock unlock{mutex};
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+    canvas.SetTiledRenderer(GetTiledRenderer());
+#endif
+
     // Render the moving map
     Render(canvas, GetClientRect());
+
+#ifdef USE_MEMORY_CANVAS
+    /* this flushes the remaining deferred operations */
+    canvas.SetTiledRenderer(nullptr);
+#endif
+
     draw_sw.Finish();
   }
 
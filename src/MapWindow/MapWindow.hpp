@@ -11,6 +11,7 @@
 #endif
 #include "Renderer/LabelBlock.hpp"
 #include "Screen/StopWatch.hpp"
+#include "MapLayerStatistics.hpp"
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
@@ -36,6 +37,8 @@ class GlideComputer;
 class ContainerWindow;
 class NOAAStore;
 class MapOverlay;
+class ThreadPool;
+class TiledRenderer;
 
 namespace SkyLinesTracking {
   struct Data;
@@ -160,12 +163,28 @@ protected:
   unsigned scale_buffer = 0;
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * Rasterises the vector layers of the map on all processors.
+   * Created by the DrawThread on its first frame, and only if there
+   * is more than one processor.
+   */
+  std::unique_ptr<ThreadPool> raster_pool;
+  std::unique_ptr<TiledRenderer> tiled_renderer;
+#endif
+
   /**
    * The #StopWatch used to benchmark the DrawThread,
    * i.e. OnPaintBuffer().
    */
   ScreenStopWatch draw_sw;
 
+  /**
+   * Per-layer frame times of Render(), see
+   * MapSettings::show_layer_statistics.
+   */
+  MapLayerStatistics layer_statistics;
+
   friend class DrawThread;
 
 public:
@@ -332,6 +351,13 @@ protected:
   void OnPaintBuffer(Canvas& canvas) noexcept override;
 
 private:
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * Create #tiled_renderer (and #raster_pool) on the first call.
+   */
+  TiledRenderer *GetTiledRenderer() noexcept;
+#endif
+
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
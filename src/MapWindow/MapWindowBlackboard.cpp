@@ -26,7 +26,7 @@ IsFriend(FlarmId id) noexcept
 static void
 UpdateFadingTraffic(bool fade_traffic,
                     std::map<FlarmId, FlarmTraffic> &dest,
-                    const TrafficList &old_list, const TrafficList &new_list,
+                    const TrafficList *old_list, const TrafficList &new_list,
                     TimeStamp now) noexcept
 {
   if (!fade_traffic) {
@@ -34,15 +34,16 @@ UpdateFadingTraffic(bool fade_traffic,
     return;
   }
 
-  if (new_list.modified.Modified(old_list.modified)||true) {
+  /* old_list is nullptr if the list has not changed */
+  if (old_list != nullptr) {
     /* first add all items from the old list */
-    for (const auto &traffic : old_list.list)
+    for (const auto &traffic : *old_list)
       if (traffic.location_available)
         dest.try_emplace(traffic.id, traffic);
 
     /* now remove all items that are in the new list; now only items
        remain that have disappeared */
-    for (const auto &traffic : new_list.list)
+    for (const auto &traffic : new_list)
       if (auto i = dest.find(traffic.id); i != dest.end())
         dest.erase(i);
   }
@@ -59,15 +60,29 @@ UpdateFadingTraffic(bool fade_traffic,
 }
 
 void
-MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
-				    const DerivedInfo &derived_info) noexcept
+MapWindowBlackboard::ReadBlackboardBasic(const MoreData &nmea_info) noexcept
+{
+  gps_info = nmea_info;
+}
+
+void
+MapWindowBlackboard::ReadTraffic(const TrafficList &new_traffic,
+                                 unsigned version) noexcept
 {
+  const bool modified = version != GetTrafficVersion();
   UpdateFadingTraffic(settings_map.fade_traffic,
-                      fading_flarm_traffic, gps_info.flarm.traffic,
-                      nmea_info.flarm.traffic,
-                      nmea_info.clock);
+                      fading_flarm_traffic,
+                      modified ? &traffic : nullptr, new_traffic,
+                      gps_info.clock);
 
-  gps_info = nmea_info;
+  CopyTraffic(new_traffic, version);
+}
+
+void
+MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
+				    const DerivedInfo &derived_info) noexcept
+{
+  ReadBlackboardBasic(nmea_info);
   calculated_info = derived_info;
 }
 
@@ -6,6 +6,7 @@
 #include "Blackboard/BaseBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Blackboard/MapSettingsBlackboard.hpp"
+#include "Blackboard/CalculatedSnapshot.hpp"
 #include "thread/Debug.hpp"
 #include "UIState.hpp"
 
@@ -31,8 +32,8 @@ class MapWindowBlackboard:
 
 protected:
   MapWindowBlackboard() noexcept {
-    /* this needs to be initialised because ReadBlackboard() uses the
-       previous FLARM traffic list */
+    /* initialise the data which may be read before the first
+       ReadBlackboard() call */
     gps_info.Reset();
   }
 
@@ -50,6 +51,13 @@ protected:
     return BaseBlackboard::Calculated();
   }
 
+  [[gnu::const]]
+  const TrafficList &Traffic() const noexcept {
+    assert(InDrawThread());
+
+    return BaseBlackboard::Traffic();
+  }
+
   [[gnu::const]]
   const auto &GetFadingFlarmTraffic() const noexcept {
     return fading_flarm_traffic;
@@ -78,6 +86,18 @@ protected:
 
   void ReadBlackboard(const MoreData &nmea_info,
                       const DerivedInfo &derived_info) noexcept;
+  void ReadBlackboardBasic(const MoreData &nmea_info) noexcept;
+
+  /**
+   * Copy the traffic list.  Call this after ReadBlackboardBasic(),
+   * which provides the clock for fading out disappeared traffic.
+   */
+  void ReadTraffic(const TrafficList &new_traffic,
+                   unsigned version) noexcept;
+
+  void ReadBlackboardCalculated(const CalculatedSnapshot &snapshot) noexcept {
+    snapshot.Read(calculated_info);
+  }
   void ReadComputerSettings(const ComputerSettings &settings) noexcept;
   void ReadMapSettings(const MapSettings &settings) noexcept;
 
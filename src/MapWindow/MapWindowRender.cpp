@@ -184,64 +184,81 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   // - increasing importance drawn above
   // - attempt to not obscure text
 
+  layer_statistics.BeginFrame();
+
   //////////////////////////////////////////////// items on ground
 
   // Render terrain, groundline and topography
   draw_sw.Mark("RenderTerrain");
+  layer_statistics.Mark(MapLayer::TERRAIN);
   RenderTerrain(canvas);
 
   draw_sw.Mark("RenderRasp");
+  layer_statistics.Mark(MapLayer::RASP);
   RenderRasp(canvas);
 
   draw_sw.Mark("RenderTopography");
+  layer_statistics.Mark(MapLayer::TOPOGRAPHY);
   RenderTopography(canvas);
 
   draw_sw.Mark("RenderOverlays");
+  layer_statistics.Mark(MapLayer::OVERLAYS);
   RenderOverlays(canvas);
 
   draw_sw.Mark("DrawNOAAStations");
+  layer_statistics.Mark(MapLayer::NOAA);
   RenderNOAAStations(canvas);
 
   //////////////////////////////////////////////// glide range info
 
   draw_sw.Mark("RenderFinalGlideShading");
+  layer_statistics.Mark(MapLayer::FINAL_GLIDE);
   RenderFinalGlideShading(canvas);
 
   //////////////////////////////////////////////// airspace
 
   // Render airspace
   draw_sw.Mark("RenderAirspace");
+  layer_statistics.Mark(MapLayer::AIRSPACE);
   RenderAirspace(canvas);
 
   //////////////////////////////////////////////// task
 
   // Render task, waypoints
   draw_sw.Mark("DrawContest");
+  layer_statistics.Mark(MapLayer::CONTEST);
   DrawContest(canvas);
 
   draw_sw.Mark("DrawTask");
+  layer_statistics.Mark(MapLayer::TASK);
   DrawTask(canvas);
 
   draw_sw.Mark("DrawWaypoints");
+  layer_statistics.Mark(MapLayer::WAYPOINTS);
   DrawWaypoints(canvas);
 
   //////////////////////////////////////////////// aircraft level items
   // Render the snail trail
+  layer_statistics.Mark(MapLayer::TRAIL);
   RenderTrail(canvas, aircraft_pos);
 
+  layer_statistics.Mark(MapLayer::WAVES);
   DrawWaves(canvas);
 
   // Render estimate of thermal location
+  layer_statistics.Mark(MapLayer::THERMAL);
   DrawThermalEstimate(canvas);
 
   //////////////////////////////////////////////// text items
   // Render topography on top of airspace, to keep the text readable
   draw_sw.Mark("RenderTopographyLabels");
+  layer_statistics.Mark(MapLayer::LABELS);
   RenderTopographyLabels(canvas);
 
   //////////////////////////////////////////////// navigation overlays
   // Render glide through terrain range
   draw_sw.Mark("RenderGlide");
+  layer_statistics.Mark(MapLayer::NAVIGATION);
   RenderGlide(canvas);
 
   draw_sw.Mark("RenderMisc1");
@@ -265,6 +282,8 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   //////////////////////////////////////////////// traffic
   // Draw traffic
 
+  layer_statistics.Mark(MapLayer::TRAFFIC);
+
 #ifdef HAVE_SKYLINES_TRACKING
   DrawSkyLinesTraffic(canvas);
 #endif
@@ -277,6 +296,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
 
   //////////////////////////////////////////////// own aircraft
   // Finally, draw you!
+  layer_statistics.Mark(MapLayer::AIRCRAFT);
   if (basic.location_available)
     AircraftRenderer::Draw(canvas, GetMapSettings(), look.aircraft,
                            basic.attitude.heading - render_projection.GetScreenAngle(),
@@ -285,4 +305,6 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   //////////////////////////////////////////////// important overlays
   // Draw intersections on top of aircraft
   airspace_renderer.DrawIntersections(canvas, render_projection);
+
+  layer_statistics.EndFrame();
 }
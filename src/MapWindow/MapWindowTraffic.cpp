@@ -83,7 +83,7 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
     return;
 
   // Return if FLARM data is not available
-  const TrafficList &flarm = Basic().flarm.traffic;
+  const TrafficList &flarm = Traffic();
 
   const WindowProjection &projection = render_projection;
 
@@ -96,7 +96,7 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
   canvas.Select(*traffic_look.font);
 
   // Circle through the FLARM targets
-  for (const auto &traffic : flarm.list) {
+  for (const auto &traffic : flarm) {
     if (!traffic.location_available)
       continue;
 
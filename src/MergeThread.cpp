@@ -7,6 +7,7 @@
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "LatencyTrace.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard,
                          MultipleDevices *_devices) noexcept
@@ -25,6 +26,7 @@ MergeThread::MergeThread(DeviceBlackboard &_device_blackboard,
    devices(_devices)
 {
   last_fix.Reset();
+  last_fix_traffic.Clear();
   last_any.Reset();
 }
 
@@ -43,8 +45,9 @@ MergeThread::Process() noexcept
   computer.Compute(device_blackboard.SetMoreData(), last_any, last_fix,
                    device_blackboard.Calculated());
 
-  flarm_computer.Process(device_blackboard.SetBasic().flarm,
-                         last_fix.flarm, basic);
+  flarm_computer.Process(device_blackboard.SetMergedTraffic(),
+                         last_fix_traffic, basic);
+  device_blackboard.PublishTraffic();
 }
 
 void
@@ -57,9 +60,22 @@ MergeThread::Tick() noexcept
   double vario;
 #endif
 
+  LatencyTrace::Clock::time_point origin;
+
   {
     const std::lock_guard lock{device_blackboard.mutex};
 
+    origin = LatencyTrace::GetOrigin(LatencyTrace::Stage::NMEA_LINE);
+
+    /* recorded while still holding the lock, so the origin is
+       published together with the merged data */
+    const LatencyTrace::ScopeStage trace{
+      LatencyTrace::Stage::MERGE,
+      origin,
+    };
+
+    device_blackboard.ReadCalculatedSnapshot();
+
     Process();
 
     const MoreData &basic = device_blackboard.Basic();
@@ -88,15 +104,25 @@ MergeThread::Tick() noexcept
     /* update last_fix only when a new GPS fix was received */
     if ((basic.time_available &&
          (!last_fix.time_available || basic.time != last_fix.time)) ||
-        basic.location_available != last_fix.location_available)
+        basic.location_available != last_fix.location_available) {
       last_fix = basic;
+
+      if (device_blackboard.GetTrafficVersion() != last_fix_traffic_version) {
+        last_fix_traffic.CopyFrom(device_blackboard.Traffic());
+        last_fix_traffic_version = device_blackboard.GetTrafficVersion();
+      }
+    }
   }
 
 #ifdef HAVE_PCM_PLAYER
+  /* this is only a fallback for vario values which were not
+     submitted by the device driver directly (see
+     DeviceDescriptor::LineReceived()), e.g. those calculated from
+     the altitude */
   if (vario_available)
-    AudioVarioGlue::SetValue(vario);
+    AudioVarioGlue::SetValue(vario, origin);
   else
-    AudioVarioGlue::NoValue();
+    AudioVarioGlue::NoValue(origin);
 #endif
 
   if (gps_updated)
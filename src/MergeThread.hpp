@@ -6,6 +6,7 @@
 #include "thread/WorkerThread.hpp"
 #include "Computer/BasicComputer.hpp"
 #include "FLARM/Computer.hpp"
+#include "FLARM/List.hpp"
 #include "NMEA/MoreData.hpp"
 
 class DeviceBlackboard;
@@ -26,6 +27,16 @@ class MergeThread final : public WorkerThread {
    */
   MoreData last_fix;
 
+  /**
+   * The traffic at the time of #last_fix.
+   */
+  TrafficList last_fix_traffic;
+
+  /**
+   * The DeviceBlackboard::GetTrafficVersion() of #last_fix_traffic.
+   */
+  unsigned last_fix_traffic_version = 0;
+
   /**
    * The previous values at the time of the last update of any
    * attribute (last Connected modification).
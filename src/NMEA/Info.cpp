@@ -5,6 +5,7 @@
 #include "Atmosphere/AirDensity.hpp"
 #include "time/Cast.hxx"
 
+
 void
 NMEAInfo::UpdateClock() noexcept
 {
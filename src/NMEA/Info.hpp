@@ -625,3 +625,12 @@ struct NMEAInfo {
 };
 
 static_assert(std::is_trivial<NMEAInfo>::value, "type is not trivial");
+
+/* this struct is copied many times per second, in and between the
+   blackboards of several threads; keep it small */
+#ifdef ANDROID
+static_assert(sizeof(NMEAInfo) <= 4096 + sizeof(GliderLinkData),
+              "NMEAInfo is too large");
+#else
+static_assert(sizeof(NMEAInfo) <= 4096, "NMEAInfo is too large");
+#endif
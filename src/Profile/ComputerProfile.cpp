@@ -65,6 +65,7 @@ Profile::Load(const ProfileMap &map, LoggerSettings &settings)
   map.Get(ProfileKeys::CrewWeightTemplate, settings.crew_mass_template);
   map.Get(ProfileKeys::EnableFlightLogger, settings.enable_flight_logger);
   map.Get(ProfileKeys::EnableNMEALogger, settings.enable_nmea_logger);
+  map.Get(ProfileKeys::EnableSensorRecorder, settings.enable_sensor_recorder);
 }
 
 void
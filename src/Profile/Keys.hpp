@@ -196,10 +196,12 @@ constexpr std::string_view FinalGlideBarDisplayMode = "FinalGlideBarDisplayMode"
 constexpr std::string_view EnableVarioBar = "EnableVarioBar";
 constexpr std::string_view ShowFAITriangleAreas = "ShowFAITriangleAreas";
 constexpr std::string_view FAITriangleThreshold = "FAITriangleThreshold";
+constexpr std::string_view ShowMapLayerStatistics = "ShowMapLayerStatistics";
 constexpr std::string_view AutoLogger = "AutoLogger";
 constexpr std::string_view DisableAutoLogger = "DisableAutoLogger";
 constexpr std::string_view EnableFlightLogger = "EnableFlightLogger";
 constexpr std::string_view EnableNMEALogger = "EnableNMEALogger";
+constexpr std::string_view EnableSensorRecorder = "EnableSensorRecorder";
 constexpr std::string_view MapFile = "MapFile"; // pL
 constexpr std::string_view BallastSecsToEmpty = "BallastSecsToEmpty";
 constexpr std::string_view DialogFont = "DialogFont";
@@ -124,6 +124,8 @@ Profile::Load(const ProfileMap &map, MapSettings &settings)
   map.Get(ProfileKeys::ShowFAITriangleAreas,
           settings.show_fai_triangle_areas);
   ::Load(map, settings.fai_triangle_settings);
+  map.Get(ProfileKeys::ShowMapLayerStatistics,
+          settings.show_layer_statistics);
 
   map.Get(ProfileKeys::EnableVarioBar,
           settings.vario_bar_enabled);
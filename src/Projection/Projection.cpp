@@ -4,9 +4,16 @@
 #include "Projection.hpp"
 #include "Geo/FAISphere.hpp"
 #include "Math/Angle.hpp"
+#include "Math/FastTrig.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "ui/dim/Rect.hpp"
 
 #include <algorithm>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 Projection::Projection() noexcept
 {
   SetScale(1);
@@ -53,6 +60,164 @@ Projection::GeoToScreen(const GeoPoint &g) const noexcept
   return sc;
 }
 
+static constexpr unsigned
+GetClipFlags(PixelPoint p, const PixelRect &clip) noexcept
+{
+  return (p.x < clip.left ? unsigned(Projection::CLIP_LEFT) : 0U) |
+    (p.x >= clip.right ? unsigned(Projection::CLIP_RIGHT) : 0U) |
+    (p.y < clip.top ? unsigned(Projection::CLIP_TOP) : 0U) |
+    (p.y >= clip.bottom ? unsigned(Projection::CLIP_BOTTOM) : 0U);
+}
+
+static inline const GeoPoint &
+NextGeoPoint(const GeoPoint *&src, std::size_t stride) noexcept
+{
+  const GeoPoint &g = *src;
+  src = reinterpret_cast<const GeoPoint *>
+    (reinterpret_cast<const std::byte *>(src) + stride);
+  return g;
+}
+
+#ifdef __SSE2__
+
+/**
+ * Load the longitude and the latitude of a #GeoPoint.
+ */
+static inline __m128d
+LoadGeoPoint(const GeoPoint &g) noexcept
+{
+  static_assert(sizeof(GeoPoint) == 2 * sizeof(double));
+  return _mm_loadu_pd(reinterpret_cast<const double *>(&g));
+}
+
+/**
+ * Round towards zero, like a cast to int.
+ */
+static inline __m128d
+TruncatePD(__m128d x) noexcept
+{
+  return _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+}
+
+#endif
+
+unsigned
+Projection::GeoToScreen(const GeoPoint *src, std::size_t n,
+                        const std::size_t stride, BulkPixelPoint *dest,
+                        const PixelRect *clip) const noexcept
+{
+  assert(IsValid());
+
+  if (n == 0)
+    return 0;
+
+  unsigned flags = ~0U;
+
+#ifdef __SSE2__
+  /* two points per iteration; this implements exactly the same
+     formulas as the scalar GeoToScreen() (including Angle::AsDelta()
+     and GeoPoint::Normalize()), only the cosine table lookup is
+     scalar; the integer rotation is done with doubles, which is exact
+     because all operands are integers below 2^53 */
+
+  const __m128d location_longitude =
+    _mm_set1_pd(geo_location.longitude.Native());
+  const __m128d location_latitude =
+    _mm_set1_pd(geo_location.latitude.Native());
+  const __m128d half_circle = _mm_set1_pd(Angle::HalfCircle().Native());
+  const __m128d minus_half_circle =
+    _mm_set1_pd(-Angle::HalfCircle().Native());
+  const __m128d full_circle = _mm_set1_pd(Angle::FullCircle().Native());
+  const __m128d quarter_circle =
+    _mm_set1_pd(Angle::QuarterCircle().Native());
+  const __m128d minus_quarter_circle =
+    _mm_set1_pd(-Angle::QuarterCircle().Native());
+  const __m128d int_angle_mult = _mm_set1_pd(INT_ANGLE_MULT);
+  const __m128d int_angle_offset = _mm_set1_pd(10 * INT_ANGLE_RANGE + 0.5);
+  const __m128i quarter_int_circle = _mm_set1_epi32(INT_QUARTER_CIRCLE);
+  const __m128i int_angle_mask = _mm_set1_epi32(INT_ANGLE_MASK);
+  const __m128d scale = _mm_set1_pd(draw_scale);
+
+  const auto rotation = screen_rotation.RotateRaw({1, 0});
+  const __m128d cost = _mm_set1_pd(rotation.x);
+  const __m128d sint = _mm_set1_pd(rotation.y);
+  const __m128d rotation_half = _mm_set1_pd(FastIntegerRotation::HALF);
+  const __m128i origin_x = _mm_set1_epi32(screen_origin.x);
+  const __m128i origin_y = _mm_set1_epi32(screen_origin.y);
+
+  for (; n >= 2; n -= 2) {
+    /* load (longitude, latitude) of two points and transpose */
+    const __m128d a = LoadGeoPoint(NextGeoPoint(src, stride));
+    const __m128d b = LoadGeoPoint(NextGeoPoint(src, stride));
+    const __m128d longitude = _mm_unpacklo_pd(a, b);
+    const __m128d latitude = _mm_unpackhi_pd(a, b);
+
+    /* GeoPoint::operator-() */
+    __m128d d_longitude = _mm_sub_pd(location_longitude, longitude);
+    d_longitude = _mm_add_pd(d_longitude,
+                             _mm_and_pd(_mm_cmple_pd(d_longitude,
+                                                     minus_half_circle),
+                                        full_circle));
+    d_longitude = _mm_sub_pd(d_longitude,
+                             _mm_and_pd(_mm_cmpgt_pd(d_longitude,
+                                                     half_circle),
+                                        full_circle));
+
+    const __m128d d_latitude =
+      _mm_min_pd(_mm_max_pd(_mm_sub_pd(location_latitude, latitude),
+                            minus_quarter_circle),
+                 quarter_circle);
+
+    /* Angle::fastcosine() */
+    __m128i cos_index =
+      _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(latitude, int_angle_mult),
+                                  int_angle_offset));
+    cos_index = _mm_and_si128(_mm_add_epi32(cos_index, quarter_int_circle),
+                              int_angle_mask);
+    const __m128d cosine =
+      _mm_set_pd(SINETABLE[_mm_cvtsi128_si32(_mm_srli_si128(cos_index, 4))],
+                 SINETABLE[_mm_cvtsi128_si32(cos_index)]);
+
+    /* truncate to integer pixels, like the scalar version does */
+    const __m128d x = TruncatePD(_mm_mul_pd(cosine,
+                                            _mm_mul_pd(d_longitude, scale)));
+    const __m128d y = TruncatePD(_mm_mul_pd(d_latitude, scale));
+
+    /* FastIntegerRotation::Rotate() */
+    const __m128d raw_x = _mm_sub_pd(_mm_mul_pd(x, cost), _mm_mul_pd(y, sint));
+    const __m128d raw_y = _mm_add_pd(_mm_mul_pd(y, cost), _mm_mul_pd(x, sint));
+    const __m128i rx =
+      _mm_srai_epi32(_mm_cvtpd_epi32(_mm_add_pd(raw_x, rotation_half)),
+                     FastIntegerRotation::SHIFT);
+    const __m128i ry =
+      _mm_srai_epi32(_mm_cvtpd_epi32(_mm_add_pd(raw_y, rotation_half)),
+                     FastIntegerRotation::SHIFT);
+
+    alignas(16) int32_t result[4];
+    _mm_store_si128((__m128i *)result,
+                    _mm_unpacklo_epi32(_mm_sub_epi32(origin_x, rx),
+                                       _mm_add_epi32(origin_y, ry)));
+
+    const PixelPoint p0(result[0], result[1]), p1(result[2], result[3]);
+    *dest++ = p0;
+    *dest++ = p1;
+
+    if (clip != nullptr)
+      flags &= GetClipFlags(p0, *clip) & GetClipFlags(p1, *clip);
+  }
+#endif
+
+  for (; n > 0; --n) {
+    const PixelPoint p = GeoToScreen(NextGeoPoint(src, stride));
+    *dest++ = p;
+
+    if (clip != nullptr)
+      flags &= GetClipFlags(p, *clip);
+  }
+
+  return clip != nullptr ? flags : 0;
+}
+
 void
 Projection::SetScale(const double _scale) noexcept
 {
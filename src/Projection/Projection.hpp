@@ -9,6 +9,12 @@
 #include "ui/dim/Point.hpp"
 
 #include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+struct BulkPixelPoint;
+struct PixelRect;
 
 /**
  * This is a class that can be used for converting geographical into screen
@@ -119,6 +125,60 @@ public:
   [[gnu::pure]]
   PixelPoint GeoToScreen(const GeoPoint &g) const noexcept;
 
+  /**
+   * Flags for the position of a screen point relative to a clipping
+   * rectangle, see GeoToScreen(const GeoPoint *, ...).
+   */
+  enum ClipFlags : unsigned {
+    CLIP_LEFT = 0x1,
+    CLIP_RIGHT = 0x2,
+    CLIP_TOP = 0x4,
+    CLIP_BOTTOM = 0x8,
+  };
+
+  /**
+   * Converts many GeoPoints to screen coordinates.  The results are
+   * the same as with GeoToScreen(const GeoPoint &), but this is
+   * faster: the projection parameters are loaded only once, and the
+   * points are processed with vector instructions (if available).
+   *
+   * @param stride the distance between two GeoPoints in bytes; this
+   * allows projecting GeoPoints which are embedded in larger objects
+   * @param clip if not nullptr, check the points against this
+   * rectangle
+   * @return the bitwise AND of the #ClipFlags of all points, i.e.
+   * non-zero if all of them are beyond the same edge of the clipping
+   * rectangle (a polyline or polygon through them is invisible); 0 if
+   * no clipping rectangle was given or if there are no points
+   */
+  unsigned GeoToScreen(const GeoPoint *src, std::size_t n,
+                       std::size_t stride, BulkPixelPoint *dest,
+                       const PixelRect *clip=nullptr) const noexcept;
+
+  unsigned GeoToScreen(std::span<const GeoPoint> src, BulkPixelPoint *dest,
+                       const PixelRect *clip=nullptr) const noexcept {
+    return GeoToScreen(src.data(), src.size(), sizeof(GeoPoint),
+                       dest, clip);
+  }
+
+  /**
+   * Converts the locations of a contiguous container of objects
+   * with a GetLocation() method (e.g. #SearchPointVector,
+   * #TracePointVector) to screen coordinates.
+   */
+  template<typename C>
+  requires requires(const C &c) {
+    { c.data()->GetLocation() } -> std::same_as<const GeoPoint &>;
+  }
+  unsigned GeoToScreen(const C &src, BulkPixelPoint *dest,
+                       const PixelRect *clip=nullptr) const noexcept {
+    if (src.empty())
+      return 0;
+
+    return GeoToScreen(&src.data()->GetLocation(), src.size(),
+                       sizeof(*src.data()), dest, clip);
+  }
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
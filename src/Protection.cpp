@@ -84,10 +84,14 @@ CreateCalculationThread() noexcept
      important fallback values set by BasicComputer
      (e.g. AttitudeState::heading) */
   CommonInterface::ReadBlackboardBasic(device_blackboard.Basic());
+  CommonInterface::ReadTraffic(device_blackboard.Traffic(),
+                               device_blackboard.GetTrafficVersion());
 
   /* initialise the GlideComputer and run the first iteration */
   auto &glide_computer = *backend_components->glide_computer;
   glide_computer.ReadBlackboard(device_blackboard.Basic());
+  glide_computer.ReadTraffic(device_blackboard.Traffic(),
+                             device_blackboard.GetTrafficVersion());
   glide_computer.ReadComputerSettings(device_blackboard.GetComputerSettings());
   glide_computer.ProcessGPS(true);
 
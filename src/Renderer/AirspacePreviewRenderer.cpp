@@ -35,9 +35,8 @@ GetPolygonPoints(std::vector<BulkPixelPoint> &pts,
 
   const SearchPointVector &border = airspace.GetPoints();
 
-  pts.reserve(border.size());
-  for (auto it = border.begin(), it_end = border.end(); it != it_end; ++it)
-    pts.push_back(projection.GeoToScreen(it->GetLocation()));
+  pts.resize(border.size());
+  projection.GeoToScreen(border, pts.data());
 }
 
 bool
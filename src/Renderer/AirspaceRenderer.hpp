@@ -39,7 +39,7 @@ class AirspaceRenderer
    */
   TransparentRendererCache fill_cache;
 
-  Serial last_warning_serial;
+  Serial last_warning_serial, last_airspaces_serial;
 #endif
 
 public:
@@ -22,9 +22,9 @@ RenderFAISector(Canvas &canvas, const WindowProjection &projection,
     GeoClip(projection.GetScreenBounds().Scale(1.1))
     .ClipPolygon(clipped, geo_points, geo_end - geo_points);
 
-  BulkPixelPoint points[FAI_TRIANGLE_SECTOR_MAX], *p = points;
-  for (GeoPoint *geo_i = clipped; geo_i != clipped_end;)
-    *p++ = projection.GeoToScreen(*geo_i++);
+  const std::size_t n = clipped_end - clipped;
+  BulkPixelPoint points[FAI_TRIANGLE_SECTOR_MAX];
+  projection.GeoToScreen({clipped, n}, points);
 
-  canvas.DrawPolygon(points, p - points);
+  canvas.DrawPolygon(points, n);
 }
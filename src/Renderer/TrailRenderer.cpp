@@ -88,31 +88,12 @@ GetMinMax(TrailSettings::Type type, const TracePointVector &trace) noexcept
   return std::make_pair(value_min, value_max);
 }
 
-void
-TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
-                    const WindowProjection &projection,
-                    TimeStamp min_time,
-                    bool enable_traildrift, const PixelPoint pos,
-                    const NMEAInfo &basic, const DerivedInfo &calculated,
-                    const TrailSettings &settings) noexcept
+const Pen *
+TrailRenderer::DrawTrail(Canvas &canvas, const WindowProjection &projection,
+                         const GeoPoint *traildrift, TimeStamp time,
+                         const TrailSettings &settings,
+                         PixelPoint &last_point) noexcept
 {
-  if (settings.length == TrailSettings::Length::OFF)
-    return;
-
-  if (!LoadTrace(trace_computer, min_time, projection))
-    return;
-
-  if (!basic.location_available || !calculated.wind_available)
-    enable_traildrift = false;
-
-  GeoPoint traildrift;
-  if (enable_traildrift) {
-    GeoPoint tp1 = FindLatitudeLongitude(basic.location,
-                                         calculated.wind.bearing,
-                                         calculated.wind.norm);
-    traildrift = basic.location - tp1;
-  }
-
   auto minmax = GetMinMax(settings.type, trace);
   auto value_min = minmax.first;
   auto value_max = minmax.second;
@@ -122,11 +103,30 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
 
   const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
 
-  PixelPoint last_point(0, 0);
+  /* the pen which is selected when the loop finishes; nullptr if no
+     point was drawn or if the null pen is selected */
+  const Pen *pen = nullptr;
+
+  /* project all points at once */
+  const unsigned n = trace.size();
+  BulkPixelPoint *const screen = Prepare(n);
+  if (traildrift != nullptr) {
+    drifted.GrowDiscard(n);
+    for (unsigned j = 0; j < n; ++j) {
+      const auto &i = trace[j];
+      drifted[j] = i.GetLocation().Parametric(*traildrift,
+                                              i.CalculateDrift(time));
+    }
+
+    projection.GeoToScreen({drifted.data(), n}, screen);
+  } else
+    projection.GeoToScreen(trace, screen);
+
   bool last_valid = false;
-  for (const auto &i : trace) {
-    const GeoPoint gp = enable_traildrift
-      ? i.GetLocation().Parametric(traildrift, i.CalculateDrift(basic.time))
+  for (unsigned j = 0; j < n; ++j) {
+    const auto &i = trace[j];
+    const GeoPoint &gp = traildrift != nullptr
+      ? drifted[j]
       : i.GetLocation();
     if (!bounds.IsInside(gp)) {
       /* the point is outside of the MapWindow; don't paint it */
@@ -134,13 +134,14 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
       continue;
     }
 
-    auto pt = projection.GeoToScreen(gp);
+    const auto pt = (PixelPoint)screen[j];
 
     if (last_valid) {
       if (settings.type == TrailSettings::Type::ALTITUDE) {
         unsigned index = GetAltitudeColorIndex(i.GetAltitude(),
                                                value_min, value_max);
-        canvas.Select(look.trail_pens[index]);
+        pen = &look.trail_pens[index];
+        canvas.Select(*pen);
         canvas.DrawLinePiece(last_point, pt);
       } else {
         unsigned color_index = GetSnailColorIndex(i.GetVario(),
@@ -150,6 +151,7 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
              settings.type == TrailSettings::Type::VARIO_2_DOTS ||
              settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
              settings.type == TrailSettings::Type::VARIO_EINK)) {
+          pen = nullptr;
           canvas.SelectNullPen();
           canvas.Select(look.trail_brushes[color_index]);
           canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
@@ -158,16 +160,22 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
           // positive vario case
           if (settings.type == TrailSettings::Type::VARIO_DOTS_AND_LINES ||
               settings.type == TrailSettings::Type::VARIO_EINK) {
+            pen = &look.trail_pens[color_index]; //fixed-width pen
             canvas.Select(look.trail_brushes[color_index]);
-            canvas.Select(look.trail_pens[color_index]); //fixed-width pen
+            canvas.Select(*pen);
             canvas.DrawCircle({(pt.x + last_point.x) / 2, (pt.y + last_point.y) / 2},
                             look.trail_widths[color_index]);
-          } else if (scaled_trail)
-            // width scaled to vario
-            canvas.Select(look.scaled_trail_pens[color_index]);
-          else
-            // fixed-width pen
-            canvas.Select(look.trail_pens[color_index]);
+          } else {
+            if (scaled_trail)
+              // width scaled to vario
+              pen = &look.scaled_trail_pens[color_index];
+            else
+              // fixed-width pen
+              pen = &look.trail_pens[color_index];
+
+            canvas.Select(*pen);
+          }
+
           canvas.DrawLinePiece(last_point, pt);
         }
       }
@@ -176,7 +184,108 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
     last_valid = true;
   }
 
-  if (last_valid)
+  /* no line to the aircraft if the last point was not visible */
+  return last_valid ? pen : nullptr;
+}
+
+#ifndef ENABLE_OPENGL
+
+inline bool
+TrailRenderer::CheckCache(Serial serial, TracePoint::Time min_time,
+                          const WindowProjection &projection,
+                          const TrailSettings &settings) const noexcept
+{
+  /* the trail drawn into the cache contains the points not before
+     cache_min_time; if none of them is before the new min_time, the
+     new trail would be identical */
+  return serial == cache_serial &&
+    min_time >= cache_min_time && cache_oldest >= min_time &&
+    uint8_t(settings.type) == cache_type &&
+    settings.scaling_enabled == cache_scaling &&
+    cache.Check(projection);
+}
+
+inline void
+TrailRenderer::DrawCached(Canvas &canvas, const TraceComputer &trace_computer,
+                          const WindowProjection &projection,
+                          TimeStamp _min_time, const PixelPoint pos,
+                          const TrailSettings &settings) noexcept
+{
+  const Serial serial = trace_computer.LockedGetSerial();
+  const auto min_time = _min_time.Cast<TracePoint::Time>();
+
+  if (!CheckCache(serial, min_time, projection, settings)) {
+    cache_serial = serial;
+    cache_min_time = min_time;
+    cache_type = uint8_t(settings.type);
+    cache_scaling = settings.scaling_enabled;
+    cache_pen = nullptr;
+
+    Canvas &buffer_canvas = cache.Begin(canvas, projection);
+
+    if (LoadTrace(trace_computer, _min_time, projection)) {
+      cache_oldest = trace.front().GetTime();
+
+      buffer_canvas.ClearWhite();
+      cache_pen = DrawTrail(buffer_canvas, projection, nullptr, {}, settings,
+                            cache_last_point);
+      cache.Commit(canvas, projection);
+    } else {
+      /* an empty trail remains valid until the trace is modified */
+      cache_oldest = TracePoint::Time::max();
+      cache.CommitEmpty();
+    }
+  }
+
+  cache.CopyTransparentWhiteTo(canvas, projection);
+
+  if (cache_pen != nullptr) {
+    canvas.Select(*cache_pen);
+    canvas.DrawLine(cache_last_point, pos);
+  }
+}
+
+#endif
+
+void
+TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
+                    const WindowProjection &projection,
+                    TimeStamp min_time,
+                    bool enable_traildrift, const PixelPoint pos,
+                    const NMEAInfo &basic, const DerivedInfo &calculated,
+                    const TrailSettings &settings) noexcept
+{
+  if (settings.length == TrailSettings::Length::OFF)
+    return;
+
+  if (!basic.location_available || !calculated.wind_available)
+    enable_traildrift = false;
+
+#ifndef ENABLE_OPENGL
+  if (!enable_traildrift) {
+    /* without wind drift, the trail changes only when the trace
+       does */
+    DrawCached(canvas, trace_computer, projection, min_time, pos, settings);
+    return;
+  }
+#endif
+
+  if (!LoadTrace(trace_computer, min_time, projection))
+    return;
+
+  GeoPoint traildrift;
+  if (enable_traildrift) {
+    GeoPoint tp1 = FindLatitudeLongitude(basic.location,
+                                         calculated.wind.bearing,
+                                         calculated.wind.norm);
+    traildrift = basic.location - tp1;
+  }
+
+  PixelPoint last_point;
+  const Pen *pen = DrawTrail(canvas, projection,
+                             enable_traildrift ? &traildrift : nullptr,
+                             basic.time, settings, last_point);
+  if (pen != nullptr)
     canvas.DrawLine(last_point, pos);
 }
 
@@ -254,9 +363,7 @@ TrailRenderer::DrawTraceVector(Canvas &canvas, const Projection &projection,
 {
   const unsigned n = trace.size();
 
-  std::transform(trace.begin(), trace.end(), Prepare(n), [&projection](const auto &i){
-    return projection.GeoToScreen(i.GetLocation());
-  });
+  projection.GeoToScreen(trace, Prepare(n));
 
   DrawPreparedPolyline(canvas, n);
 }
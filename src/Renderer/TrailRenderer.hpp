@@ -8,9 +8,19 @@
 #include "Engine/Trace/Vector.hpp"
 #include "time/Stamp.hpp"
 
+#ifndef ENABLE_OPENGL
+#include "TransparentRendererCache.hpp"
+#include "ui/dim/Point.hpp"
+#include "util/Serial.hpp"
+#endif
+
+#include <cstdint>
+
 struct PixelPoint;
 struct BulkPixelPoint;
+struct GeoPoint;
 class Canvas;
+class Pen;
 class TraceComputer;
 class Projection;
 class WindowProjection;
@@ -32,6 +42,33 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<BulkPixelPoint> points;
 
+  /**
+   * The locations of #trace with wind drift applied, see
+   * DrawTrail().
+   */
+  AllocatedArray<GeoPoint> drifted;
+
+#ifndef ENABLE_OPENGL
+  /**
+   * Caches the trail drawn by Draw() without wind drift, which
+   * changes only when the trace does.  The line from the last point
+   * to the aircraft is not cached, because it moves with every fix.
+   */
+  TransparentRendererCache cache;
+
+  Serial cache_serial;
+  TracePoint::Time cache_min_time, cache_oldest;
+  uint8_t cache_type;
+  bool cache_scaling;
+
+  /**
+   * The pen and the screen position for the line to the aircraft;
+   * nullptr if that line is not drawn.
+   */
+  const Pen *cache_pen = nullptr;
+  PixelPoint cache_last_point;
+#endif
+
 public:
   TrailRenderer(const TrailLook &_look) noexcept:look(_look) {}
 
@@ -89,4 +126,30 @@ public:
 private:
   void DrawTraceVector(Canvas &canvas, const Projection &projection,
                        const TracePointVector &trace) noexcept;
+
+  /**
+   * Draw the trace that was obtained by LoadTrace() with the trail
+   * pens.
+   *
+   * @param traildrift the wind drift to apply, or nullptr
+   * @param last_point receives the screen position of the last point
+   * @return the pen for the line to the aircraft, or nullptr if no
+   * such line shall be drawn
+   */
+  const Pen *DrawTrail(Canvas &canvas, const WindowProjection &projection,
+                       const GeoPoint *traildrift, TimeStamp time,
+                       const TrailSettings &settings,
+                       PixelPoint &last_point) noexcept;
+
+#ifndef ENABLE_OPENGL
+  [[gnu::pure]]
+  bool CheckCache(Serial serial, TracePoint::Time min_time,
+                  const WindowProjection &projection,
+                  const TrailSettings &settings) const noexcept;
+
+  void DrawCached(Canvas &canvas, const TraceComputer &trace_computer,
+                  const WindowProjection &projection,
+                  TimeStamp min_time, PixelPoint pos,
+                  const TrailSettings &settings) noexcept;
+#endif
 };
@@ -95,7 +95,7 @@ struct VisibleWaypoint {
       task_behaviour.safety_height_arrival;
     const AGeoPoint p_dest (waypoint->location, elevation);
 
-    auto _reach = route_planner.FindPositiveArrival(p_dest);
+    auto _reach = route_planner.FindPositiveArrival(p_dest, waypoint->id);
     if (!_reach)
       return false;
 
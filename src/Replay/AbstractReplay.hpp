@@ -4,6 +4,7 @@
 #pragma once
 
 struct NMEAInfo;
+struct TrafficList;
 
 class AbstractReplay 
 {
@@ -11,4 +12,13 @@ public:
   virtual ~AbstractReplay() {}
 
   virtual bool Update(NMEAInfo &data) = 0;
+
+  /**
+   * Returns the FLARM traffic which belongs to the #NMEAInfo filled
+   * by the last Update() call, or nullptr if this replay does not
+   * provide traffic.
+   */
+  virtual const TrafficList *GetTraffic() const noexcept {
+    return nullptr;
+  }
 };
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Checkpoints.hpp"
+
+#include <algorithm>
+
+inline std::vector<std::unique_ptr<ReplayCheckpoints::Checkpoint>>::const_iterator
+ReplayCheckpoints::UpperBound(TimeStamp time) const noexcept
+{
+  return std::upper_bound(checkpoints.begin(), checkpoints.end(), time,
+                          [](TimeStamp t, const auto &c){
+                            return t < c->time;
+                          });
+}
+
+std::unique_ptr<ReplayCheckpoints::Checkpoint>
+ReplayCheckpoints::Capture(const GlideComputer &glide_computer,
+                           const WrapClock &clock) noexcept
+{
+  auto checkpoint = std::make_unique<Checkpoint>();
+  checkpoint->time = glide_computer.Basic().time;
+  checkpoint->clock = clock;
+  glide_computer.SaveCheckpoint(checkpoint->computer);
+  return checkpoint;
+}
+
+bool
+ReplayCheckpoints::IsDue(TimeStamp time) const noexcept
+{
+  const auto i = UpperBound(time);
+
+  if (i != checkpoints.end() && (*i)->time - time < interval)
+    return false;
+
+  if (i != checkpoints.begin() && time - (*std::prev(i))->time < interval)
+    return false;
+
+  return true;
+}
+
+void
+ReplayCheckpoints::Add(std::unique_ptr<Checkpoint> checkpoint) noexcept
+{
+  const auto i = UpperBound(checkpoint->time);
+  checkpoints.insert(i, std::move(checkpoint));
+
+  if (checkpoints.size() > MAX_CHECKPOINTS) {
+    /* thin out: keep only the checkpoints with an even index */
+    std::size_t n = 0;
+    for (std::size_t j = 0; j < checkpoints.size(); j += 2)
+      checkpoints[n++] = std::move(checkpoints[j]);
+    checkpoints.resize(n);
+
+    interval *= 2;
+  }
+}
+
+const ReplayCheckpoints::Checkpoint *
+ReplayCheckpoints::FindBefore(TimeStamp time) const noexcept
+{
+  const auto i = UpperBound(time);
+  if (i == checkpoints.begin())
+    return nullptr;
+
+  return std::prev(i)->get();
+}
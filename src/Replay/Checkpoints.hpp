@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Computer/GlideComputer.hpp"
+#include "time/Stamp.hpp"
+#include "time/WrapClock.hpp"
+
+#include <memory>
+#include <vector>
+
+/**
+ * A collection of #GlideComputer checkpoints captured during replay,
+ * sorted by time.  It allows Replay::Seek() to jump back without
+ * recalculating the whole flight.
+ *
+ * The number of checkpoints is limited: when the limit is reached,
+ * every other checkpoint is deleted, and the interval is doubled.
+ */
+class ReplayCheckpoints {
+public:
+  struct Checkpoint {
+    /**
+     * The time of the last GPS fix processed by the #GlideComputer
+     * (#NMEAInfo::time, normalised by #WrapClock).
+     */
+    TimeStamp time;
+
+    /**
+     * The state of the #WrapClock which produced #time.
+     */
+    WrapClock clock;
+
+    GlideComputer::Checkpoint computer;
+  };
+
+private:
+  static constexpr std::size_t MAX_CHECKPOINTS = 32;
+
+  static constexpr FloatDuration DEFAULT_INTERVAL = std::chrono::minutes{5};
+
+  /**
+   * The minimum distance between two checkpoints.
+   */
+  FloatDuration interval = DEFAULT_INTERVAL;
+
+  std::vector<std::unique_ptr<Checkpoint>> checkpoints;
+
+public:
+  bool empty() const noexcept {
+    return checkpoints.empty();
+  }
+
+  void Clear() noexcept {
+    checkpoints.clear();
+    interval = DEFAULT_INTERVAL;
+  }
+
+  /**
+   * Capture the current state of the #GlideComputer.  This must not
+   * be called while the CalculationThread is running.
+   */
+  static std::unique_ptr<Checkpoint> Capture(const GlideComputer &glide_computer,
+                                             const WrapClock &clock) noexcept;
+
+  /**
+   * Shall a new checkpoint be captured at the specified time?  This
+   * is the case if there is no checkpoint close to it.
+   */
+  [[gnu::pure]]
+  bool IsDue(TimeStamp time) const noexcept;
+
+  /**
+   * Insert a new checkpoint.
+   */
+  void Add(std::unique_ptr<Checkpoint> checkpoint) noexcept;
+
+  /**
+   * Find the latest checkpoint which is not newer than the specified
+   * time.
+   *
+   * @return the checkpoint or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const Checkpoint *FindBefore(TimeStamp time) const noexcept;
+
+private:
+  /**
+   * Find the first checkpoint which is newer than the specified time.
+   */
+  [[gnu::pure]]
+  std::vector<std::unique_ptr<Checkpoint>>::const_iterator
+  UpperBound(TimeStamp time) const noexcept;
+};
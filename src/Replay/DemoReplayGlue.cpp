@@ -19,6 +19,8 @@ DemoReplayGlue::DemoReplayGlue(DeviceBlackboard &_device_blackboard,
   DemoReplay::Start(ta, device_blackboard.Basic().location);
 
   // get wind from aircraft
+  const std::lock_guard lock{device_blackboard.mutex};
+  device_blackboard.ReadCalculatedSnapshot();
   aircraft.GetState().wind = device_blackboard.Calculated().GetWindOrZero();
 }
 
@@ -26,8 +28,14 @@ bool
 DemoReplayGlue::Update(NMEAInfo &data)
 {
   double floor_alt = 300;
-  if (device_blackboard.Calculated().terrain_valid) {
-    floor_alt += device_blackboard.Calculated().terrain_altitude;
+
+  {
+    const std::lock_guard lock{device_blackboard.mutex};
+    device_blackboard.ReadCalculatedSnapshot();
+
+    const DerivedInfo &calculated = device_blackboard.Calculated();
+    if (calculated.terrain_valid)
+      floor_alt += calculated.terrain_altitude;
   }
 
   bool retval;
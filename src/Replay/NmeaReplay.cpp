@@ -18,6 +18,9 @@ NmeaReplay::NmeaReplay(std::unique_ptr<NLineReader> &&_reader,
 {
   parser->SetReal(false);
 
+  traffic.Clear();
+  parser->SetTraffic(&traffic);
+
   const struct DeviceRegister *driver = FindDriverByName(config.driver_name);
   assert(driver != nullptr);
   if (driver->CreateOnPort != nullptr) {
@@ -73,5 +76,9 @@ NmeaReplay::ReadUntilRMC(NMEAInfo &data)
 bool
 NmeaReplay::Update(NMEAInfo &data)
 {
-  return ReadUntilRMC(data);
+  if (!ReadUntilRMC(data))
+    return false;
+
+  traffic.Expire(data.clock);
+  return true;
 }
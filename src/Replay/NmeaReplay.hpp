@@ -6,6 +6,7 @@
 #include "AbstractReplay.hpp"
 #include "time/ReplayClock.hpp"
 #include "Device/Port/NullPort.hpp"
+#include "FLARM/List.hpp"
 
 #include <memory>
 
@@ -25,6 +26,8 @@ class NmeaReplay: public AbstractReplay
 
   ReplayClock clock;
 
+  TrafficList traffic;
+
 public:
   NmeaReplay(std::unique_ptr<NLineReader> &&_reader,
              const DeviceConfig &config);
@@ -32,6 +35,10 @@ public:
 
   bool Update(NMEAInfo &data) override;
 
+  const TrafficList *GetTraffic() const noexcept override {
+    return &traffic;
+  }
+
 protected:
   bool ParseLine(const char *line, NMEAInfo &data);
 
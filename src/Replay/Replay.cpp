@@ -4,11 +4,16 @@
 #include "Replay.hpp"
 #include "IgcReplay.hpp"
 #include "NmeaReplay.hpp"
+#include "SensorReplay.hpp"
 #include "DemoReplayGlue.hpp"
+#include "Checkpoints.hpp"
+#include "SeekFeeder.hpp"
 #include "io/FileLineReader.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
+#include "Computer/GlideComputer.hpp"
 #include "Logger/Logger.hpp"
 #include "Interface.hpp"
+#include "Protection.hpp"
 #include "CatmullRomInterpolator.hpp"
 #include "time/Cast.hxx"
 
@@ -16,6 +21,21 @@
 #include <cassert>
 #include <stdexcept>
 
+using namespace std::chrono;
+
+Replay::Replay(DeviceBlackboard &_device_blackboard,
+               GlideComputer &_glide_computer,
+               Logger *_logger, ProtectedTaskManager &_task_manager) noexcept
+  :device_blackboard(_device_blackboard),
+   glide_computer(_glide_computer),
+   logger(_logger), task_manager(_task_manager),
+   checkpoints(std::make_unique<ReplayCheckpoints>()) {}
+
+Replay::~Replay() noexcept
+{
+  Stop();
+}
+
 void
 Replay::Stop()
 {
@@ -30,12 +50,29 @@ Replay::Stop()
   delete cli;
   cli = nullptr;
 
+  checkpoints->Clear();
+
   device_blackboard.StopReplay();
 
   if (logger != nullptr)
     logger->ClearBuffer();
 }
 
+/**
+ * Throws on error.
+ */
+static AbstractReplay *
+OpenFile(Path path)
+{
+  if (path.EndsWithIgnoreCase(_T(".igc")))
+    return new IgcReplay(std::make_unique<FileLineReaderA>(path));
+  else if (path.EndsWithIgnoreCase(_T(".xsr")))
+    return new SensorReplay(path);
+  else
+    return new NmeaReplay(std::make_unique<FileLineReaderA>(path),
+                          CommonInterface::GetSystemSettings().devices[0]);
+}
+
 void
 Replay::Start(Path _path)
 {
@@ -49,14 +86,13 @@ Replay::Start(Path _path)
 
   if (path == nullptr || path.empty()) {
     replay = new DemoReplayGlue(device_blackboard, task_manager);
-  } else if (path.EndsWithIgnoreCase(_T(".igc"))) {
-    replay = new IgcReplay(std::make_unique<FileLineReaderA>(path));
-
-    cli = new CatmullRomInterpolator(FloatDuration{0.98});
-    cli->Reset();
   } else {
-    replay = new NmeaReplay(std::make_unique<FileLineReaderA>(path),
-                            CommonInterface::GetSystemSettings().devices[0]);
+    replay = OpenFile(path);
+
+    if (path.EndsWithIgnoreCase(_T(".igc"))) {
+      cli = new CatmullRomInterpolator(FloatDuration{0.98});
+      cli->Reset();
+    }
   }
 
   if (logger != nullptr)
@@ -69,6 +105,13 @@ Replay::Start(Path _path)
   timer.Schedule(std::chrono::milliseconds(100));
 }
 
+inline void
+Replay::PublishTraffic() noexcept
+{
+  if (const auto *traffic = replay->GetTraffic())
+    device_blackboard.SetReplayTraffic().CopyFrom(*traffic);
+}
+
 bool
 Replay::Update()
 {
@@ -113,6 +156,7 @@ Replay::Update()
     {
       const std::lock_guard lock{device_blackboard.mutex};
       device_blackboard.SetReplayState() = next_data;
+      PublishTraffic();
       device_blackboard.ScheduleMerge();
     }
 
@@ -187,6 +231,7 @@ Replay::Update()
     {
       const std::lock_guard lock{device_blackboard.mutex};
       device_blackboard.SetReplayState() = data;
+      PublishTraffic();
       device_blackboard.ScheduleMerge();
     }
   }
@@ -194,12 +239,145 @@ Replay::Update()
   return true;
 }
 
+void
+Replay::CheckCaptureCheckpoint() noexcept
+{
+  if (cli == nullptr && path.empty())
+    /* the demo replay cannot seek */
+    return;
+
+  /* cheap check without suspending the CalculationThread */
+  if (!virtual_time.IsDefined() || !checkpoints->IsDue(virtual_time))
+    return;
+
+  const ScopeSuspendAllThreads suspend;
+
+  const MoreData &basic = glide_computer.Basic();
+  if (!basic.time_available || !checkpoints->IsDue(basic.time))
+    return;
+
+  WrapClock clock;
+  {
+    const std::lock_guard lock{device_blackboard.mutex};
+    clock = device_blackboard.GetReplayClock();
+  }
+
+  checkpoints->Add(ReplayCheckpoints::Capture(glide_computer, clock));
+}
+
+bool
+Replay::Seek(TimeStamp target)
+{
+  if (replay == nullptr || (cli == nullptr && path.empty()) ||
+      !virtual_time.IsDefined())
+    return false;
+
+  const ScopeSuspendAllThreads suspend;
+
+  const MoreData &current = glide_computer.Basic();
+  const auto *checkpoint = checkpoints->FindBefore(target);
+
+  NMEAInfo data;
+  WrapClock wrap_clock;
+
+  if (current.time_available && current.time <= target &&
+      (checkpoint == nullptr || checkpoint->time <= current.time)) {
+    /* forward: continue with the pending input */
+    data = next_data;
+
+    const std::lock_guard lock{device_blackboard.mutex};
+    wrap_clock = device_blackboard.GetReplayClock();
+  } else {
+    /* backward: restore the checkpoint (or start over) and skip the
+       input up to it */
+    AbstractReplay *new_replay = OpenFile(path);
+    delete replay;
+    replay = new_replay;
+
+    TimeStamp skip = TimeStamp::Undefined();
+    if (checkpoint != nullptr) {
+      glide_computer.RestoreCheckpoint(checkpoint->computer);
+      wrap_clock = checkpoint->clock;
+      skip = checkpoint->time;
+    } else {
+      glide_computer.ResetFlight();
+      wrap_clock.Reset();
+    }
+
+    data.Reset();
+    while (true) {
+      if (!replay->Update(data)) {
+        Stop();
+        return true;
+      }
+
+      if (data.time_available &&
+          (!skip.IsDefined() || data.time > skip))
+        break;
+    }
+  }
+
+  glide_computer.SetLogger(nullptr);
+  glide_computer.SetDeterministic(true);
+
+  SeekFeeder feeder{glide_computer, *checkpoints, wrap_clock};
+
+  bool end = false;
+  while (true) {
+    assert(!data.gps.real);
+
+    if (data.time_available && data.time > target)
+      break;
+
+    feeder.Feed(data);
+
+    if (!replay->Update(data)) {
+      end = true;
+      break;
+    }
+  }
+
+  glide_computer.SetDeterministic(false);
+  glide_computer.SetLogger(logger);
+
+  {
+    const std::lock_guard lock{device_blackboard.mutex};
+    device_blackboard.SeekReplay(feeder.GetLastInput(), feeder.GetClock(),
+                                 feeder.GetBasic());
+  }
+
+  device_blackboard.ScheduleMerge();
+
+  if (logger != nullptr)
+    logger->ClearBuffer();
+
+  if (end) {
+    Stop();
+    return true;
+  }
+
+  next_data = data;
+  virtual_time = target;
+  fast_forward = TimeStamp::Undefined();
+  clock.Update();
+
+  if (cli != nullptr) {
+    cli->Reset();
+    cli->Update(next_data.time, next_data.location,
+                next_data.gps_altitude, next_data.pressure_altitude);
+  }
+
+  return true;
+}
+
 void
 Replay::OnTimer()
 {
   if (!Update())
     return;
 
+  CheckCaptureCheckpoint();
+
   std::chrono::steady_clock::duration schedule;
   if (time_scale <= 0)
     schedule = std::chrono::seconds(1);
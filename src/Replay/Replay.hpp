@@ -9,16 +9,21 @@
 #include "time/Stamp.hpp"
 #include "system/Path.hpp"
 
+#include <memory>
+
 class DeviceBlackboard;
+class GlideComputer;
 class Logger;
 class ProtectedTaskManager;
 class AbstractReplay;
 class CatmullRomInterpolator;
+class ReplayCheckpoints;
 class Error;
 
 class Replay final
 {
   DeviceBlackboard &device_blackboard;
+  GlideComputer &glide_computer;
 
   UI::Timer timer{[this]{ OnTimer(); }};
 
@@ -59,15 +64,18 @@ class Replay final
 
   CatmullRomInterpolator *cli = nullptr;
 
+  /**
+   * Snapshots of the #GlideComputer state, captured periodically
+   * during replay, which allow Seek() to jump back quickly.
+   */
+  const std::unique_ptr<ReplayCheckpoints> checkpoints;
+
 public:
   Replay(DeviceBlackboard &_device_blackboard,
-         Logger *_logger, ProtectedTaskManager &_task_manager)
-    :device_blackboard(_device_blackboard),
-     logger(_logger), task_manager(_task_manager) {}
+         GlideComputer &_glide_computer,
+         Logger *_logger, ProtectedTaskManager &_task_manager) noexcept;
 
-  ~Replay() {
-    Stop();
-  }
+  ~Replay() noexcept;
 
   bool IsActive() const {
     return replay != nullptr;
@@ -118,6 +126,34 @@ public:
     return virtual_time;
   }
 
+  /**
+   * Jump to the specified virtual time (forward or backward).  This
+   * restores the nearest earlier checkpoint of the #GlideComputer
+   * (or starts over from the beginning of the file) and then feeds
+   * the input to the #GlideComputer as quickly as possible, without
+   * the calculation and drawing threads.  The demo replay cannot
+   * seek.
+   *
+   * Midnight wraparounds in the input are not accounted for.
+   *
+   * Throws on error.
+   *
+   * @return false if seeking is not possible
+   */
+  bool Seek(TimeStamp target);
+
 private:
+  /**
+   * Copy the traffic of the #AbstractReplay to the #DeviceBlackboard,
+   * together with the replay state.  Caller must lock the
+   * blackboard.
+   */
+  void PublishTraffic() noexcept;
+
+  /**
+   * Capture a checkpoint if the last one is old enough.
+   */
+  void CheckCaptureCheckpoint() noexcept;
+
   void OnTimer();
 };
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SeekFeeder.hpp"
+#include "Checkpoints.hpp"
+#include "Computer/GlideComputer.hpp"
+
+#include <cmath>
+
+using namespace std::chrono;
+
+/**
+ * Call GlideComputer::ProcessIdle() once per this amount of replayed
+ * time.
+ */
+static constexpr FloatDuration SEEK_IDLE_INTERVAL = seconds{10};
+
+/**
+ * Is GlideComputer::ProcessIdle() due for the new fix?  This is the
+ * case whenever it enters a new interval.  The intervals are aligned
+ * to the time of day, so the schedule continues seamlessly after a
+ * checkpoint has been restored.
+ */
+[[gnu::pure]]
+static bool
+IsIdleDue(const NMEAInfo &last_fix, TimeStamp time) noexcept
+{
+  if (!last_fix.time_available)
+    return true;
+
+  const auto Slot = [](TimeStamp t){
+    return std::floor(t.ToDuration() / SEEK_IDLE_INTERVAL);
+  };
+
+  return Slot(time) != Slot(last_fix.time);
+}
+
+SeekFeeder::SeekFeeder(GlideComputer &_glide_computer,
+                       ReplayCheckpoints &_checkpoints,
+                       const WrapClock &_clock) noexcept
+  :glide_computer(_glide_computer), checkpoints(_checkpoints),
+   clock(_clock)
+{
+  last_input.Reset();
+  basic = last_any = last_fix = glide_computer.Basic();
+  computer.Resume(last_fix);
+}
+
+void
+SeekFeeder::Feed(const NMEAInfo &input) noexcept
+{
+  const ComputerSettings &settings = glide_computer.GetComputerSettings();
+
+  last_input = input;
+  static_cast<NMEAInfo &>(basic) = input;
+  clock.Normalise(basic);
+
+  computer.Fill(basic, settings);
+  computer.Compute(basic, last_any, last_fix, glide_computer.Calculated());
+
+  const bool gps_updated =
+    basic.location_available.Modified(glide_computer.Basic().location_available);
+
+  glide_computer.ReadBlackboard(basic);
+  glide_computer.Expire();
+
+  if (gps_updated) {
+    glide_computer.ProcessGPS();
+
+    if (basic.time_available && IsIdleDue(last_fix, basic.time))
+      glide_computer.ProcessIdle();
+
+    if (basic.time_available && checkpoints.IsDue(basic.time))
+      checkpoints.Add(ReplayCheckpoints::Capture(glide_computer, clock));
+  }
+
+  last_any = basic;
+
+  if ((basic.time_available &&
+       (!last_fix.time_available || basic.time != last_fix.time)) ||
+      basic.location_available != last_fix.location_available)
+    last_fix = basic;
+}
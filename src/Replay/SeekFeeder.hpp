@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Computer/BasicComputer.hpp"
+#include "NMEA/MoreData.hpp"
+#include "time/Stamp.hpp"
+#include "time/WrapClock.hpp"
+
+class GlideComputer;
+class ReplayCheckpoints;
+
+/**
+ * Feeds replay input to the #GlideComputer synchronously, doing what
+ * the #MergeThread and the #CalculationThread would do.  Checkpoints
+ * are captured whenever one is due.  This is used by Replay::Seek().
+ */
+class SeekFeeder {
+  GlideComputer &glide_computer;
+  ReplayCheckpoints &checkpoints;
+
+  WrapClock clock;
+
+  BasicComputer computer;
+
+  /**
+   * The last input passed to Feed().
+   */
+  NMEAInfo last_input;
+
+  MoreData basic, last_any, last_fix;
+
+public:
+  SeekFeeder(GlideComputer &_glide_computer, ReplayCheckpoints &_checkpoints,
+             const WrapClock &_clock) noexcept;
+
+  const NMEAInfo &GetLastInput() const noexcept {
+    return last_input;
+  }
+
+  const WrapClock &GetClock() const noexcept {
+    return clock;
+  }
+
+  const MoreData &GetBasic() const noexcept {
+    return basic;
+  }
+
+  void Feed(const NMEAInfo &input) noexcept;
+};
@@ -0,0 +1,1196 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SensorRecord.hpp"
+#include "NMEA/Info.hpp"
+#include "io/OutputStream.hxx"
+#include "util/PackedLittleEndian.hxx"
+#include "util/SpanCast.hxx"
+#include "util/Compiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+using namespace SensorRecord;
+
+static constexpr std::array<char, 4> MAGIC{'X', 'C', 'S', 'R'};
+static constexpr std::array<char, 8> INDEX_MAGIC{
+  'X', 'C', 'S', 'R', 'I', 'N', 'D', 'X',
+};
+
+namespace {
+
+struct FileHeader {
+  std::array<char, 4> magic;
+  PackedLE32 version;
+};
+
+/**
+ * The last bytes of a finished recording.
+ */
+struct FileFooter {
+  PackedLE64 index_offset;
+  std::array<char, 8> magic;
+};
+
+static_assert(sizeof(FileHeader) == 8);
+static_assert(sizeof(FileFooter) == 16);
+
+enum class Tag : uint8_t {
+  KEYFRAME = 'K',
+  DELTA = 'D',
+  INDEX = 'I',
+};
+
+/**
+ * The recorded #NMEAInfo attributes.  The numeric values are bit
+ * positions in the record's field masks; never change them, only
+ * append new ones (and bump #SensorRecord::VERSION).
+ */
+enum class SensorField : uint8_t {
+  LOCATION,
+  TRACK,
+  GROUND_SPEED,
+  AIRSPEED,
+  GPS_ALTITUDE,
+  BARO_ALTITUDE,
+  PRESSURE_ALTITUDE,
+  STATIC_PRESSURE,
+  DYN_PRESSURE,
+  PITOT_PRESSURE,
+  TIME,
+  DATE,
+  NONCOMP_VARIO,
+  TOTAL_ENERGY_VARIO,
+  NETTO_VARIO,
+  EXTERNAL_WIND,
+  TEMPERATURE,
+  HUMIDITY,
+  VARIATION,
+  G_LOAD,
+  BANK_ANGLE,
+  PITCH_ANGLE,
+  HEADING,
+  VOLTAGE,
+  BATTERY_LEVEL,
+  HEART_RATE,
+  ENGINE_NOISE_LEVEL,
+  STALL_RATIO,
+  MAC_CREADY,
+  BALLAST_FRACTION,
+  BUGS,
+  QNH,
+  FIX_QUALITY,
+  SATELLITES_USED,
+
+  COUNT
+};
+
+/**
+ * Appends little-endian values to a fixed buffer.
+ */
+class ValueWriter {
+  std::byte *const begin;
+  std::byte *p;
+
+public:
+  explicit constexpr ValueWriter(std::span<std::byte> buffer) noexcept
+    :begin(buffer.data()), p(buffer.data()) {}
+
+  constexpr std::size_t size() const noexcept {
+    return p - begin;
+  }
+
+  void Append(std::span<const std::byte> src) noexcept {
+    p = std::copy(src.begin(), src.end(), p);
+  }
+
+  void Byte(uint8_t value) noexcept {
+    *p++ = std::byte{value};
+  }
+
+  void Uint32(uint32_t value) noexcept {
+    const PackedLE32 le{value};
+    Append(ReferenceAsBytes(le));
+  }
+
+  void Uint64(uint64_t value) noexcept {
+    const PackedLE64 le{value};
+    Append(ReferenceAsBytes(le));
+  }
+
+  void Varint(uint64_t value) noexcept {
+    while (value >= 0x80) {
+      Byte(uint8_t(value) | 0x80);
+      value >>= 7;
+    }
+
+    Byte(uint8_t(value));
+  }
+
+  void Double(double value) noexcept {
+    Uint64(std::bit_cast<uint64_t>(value));
+  }
+
+  void Angle(::Angle value) noexcept {
+    Double(value.Native());
+  }
+};
+
+/**
+ * Reads the values written by #ValueWriter.  Throws if the input
+ * is too short.
+ */
+class ValueReader {
+  std::span<const std::byte> src;
+
+public:
+  explicit constexpr ValueReader(std::span<const std::byte> _src) noexcept
+    :src(_src) {}
+
+  std::span<const std::byte> Bytes(std::size_t n) {
+    if (n > src.size())
+      throw std::runtime_error("Truncated sensor record");
+
+    const auto result = src.first(n);
+    src = src.subspan(n);
+    return result;
+  }
+
+  uint8_t Byte() {
+    return uint8_t(Bytes(1).front());
+  }
+
+  uint32_t Uint32() {
+    PackedLE32 le;
+    std::memcpy(&le, Bytes(sizeof(le)).data(), sizeof(le));
+    return le;
+  }
+
+  uint64_t Uint64() {
+    PackedLE64 le;
+    std::memcpy(&le, Bytes(sizeof(le)).data(), sizeof(le));
+    return le;
+  }
+
+  uint64_t Varint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      const uint8_t b = Byte();
+      value |= uint64_t(b & 0x7f) << shift;
+      if ((b & 0x80) == 0)
+        return value;
+    }
+
+    throw std::runtime_error("Malformed varint in sensor record");
+  }
+
+  double Double() {
+    return std::bit_cast<double>(Uint64());
+  }
+
+  ::Angle Angle() {
+    return ::Angle::Native(Double());
+  }
+};
+
+} // anonymous namespace
+
+static constexpr unsigned N_FIELDS = unsigned(SensorField::COUNT);
+static_assert(N_FIELDS <= 64);
+
+static constexpr uint64_t ALL_FIELDS = (uint64_t(1) << N_FIELDS) - 1;
+
+/**
+ * A #Validity for attributes which have only a "bool" flag.
+ */
+static constexpr Validity
+Flag(bool available) noexcept
+{
+  Validity v{TimeStamp{FloatDuration{1}}};
+  if (!available)
+    v.Clear();
+  return v;
+}
+
+static constexpr int64_t
+ToMilliseconds(TimeStamp t) noexcept
+{
+  return std::chrono::round<std::chrono::milliseconds>(t.ToDuration()).count();
+}
+
+static constexpr TimeStamp
+FromMilliseconds(int64_t ms) noexcept
+{
+  return TimeStamp{std::chrono::duration_cast<FloatDuration>(std::chrono::milliseconds{ms})};
+}
+
+/**
+ * Write the value of the specified attribute if it is available.
+ *
+ * @return the attribute's #Validity (cleared if it is not available)
+ */
+static Validity
+EncodeField(SensorField field, const NMEAInfo &info, ValueWriter &w) noexcept
+{
+  switch (field) {
+  case SensorField::LOCATION:
+    if (info.location_available) {
+      w.Angle(info.location.longitude);
+      w.Angle(info.location.latitude);
+    }
+    return info.location_available;
+
+  case SensorField::TRACK:
+    if (info.track_available)
+      w.Angle(info.track);
+    return info.track_available;
+
+  case SensorField::GROUND_SPEED:
+    if (info.ground_speed_available)
+      w.Double(info.ground_speed);
+    return info.ground_speed_available;
+
+  case SensorField::AIRSPEED:
+    if (info.airspeed_available) {
+      w.Double(info.indicated_airspeed);
+      w.Double(info.true_airspeed);
+      w.Byte(info.airspeed_real);
+    }
+    return info.airspeed_available;
+
+  case SensorField::GPS_ALTITUDE:
+    if (info.gps_altitude_available)
+      w.Double(info.gps_altitude);
+    return info.gps_altitude_available;
+
+  case SensorField::BARO_ALTITUDE:
+    if (info.baro_altitude_available) {
+      w.Double(info.baro_altitude);
+      w.Byte(info.baro_altitude_weak);
+    }
+    return info.baro_altitude_available;
+
+  case SensorField::PRESSURE_ALTITUDE:
+    if (info.pressure_altitude_available) {
+      w.Double(info.pressure_altitude);
+      w.Byte(info.pressure_altitude_weak);
+    }
+    return info.pressure_altitude_available;
+
+  case SensorField::STATIC_PRESSURE:
+    if (info.static_pressure_available)
+      w.Double(info.static_pressure.GetHectoPascal());
+    return info.static_pressure_available;
+
+  case SensorField::DYN_PRESSURE:
+    if (info.dyn_pressure_available)
+      w.Double(info.dyn_pressure.GetHectoPascal());
+    return info.dyn_pressure_available;
+
+  case SensorField::PITOT_PRESSURE:
+    if (info.pitot_pressure_available)
+      w.Double(info.pitot_pressure.GetHectoPascal());
+    return info.pitot_pressure_available;
+
+  case SensorField::TIME:
+    if (info.time_available)
+      w.Double(info.time.ToDuration().count());
+    return info.time_available;
+
+  case SensorField::DATE:
+    if (info.date_time_utc.IsDatePlausible()) {
+      w.Uint32(info.date_time_utc.year);
+      w.Byte(info.date_time_utc.month);
+      w.Byte(info.date_time_utc.day);
+    }
+    return Flag(info.date_time_utc.IsDatePlausible());
+
+  case SensorField::NONCOMP_VARIO:
+    if (info.noncomp_vario_available)
+      w.Double(info.noncomp_vario);
+    return info.noncomp_vario_available;
+
+  case SensorField::TOTAL_ENERGY_VARIO:
+    if (info.total_energy_vario_available)
+      w.Double(info.total_energy_vario);
+    return info.total_energy_vario_available;
+
+  case SensorField::NETTO_VARIO:
+    if (info.netto_vario_available)
+      w.Double(info.netto_vario);
+    return info.netto_vario_available;
+
+  case SensorField::EXTERNAL_WIND:
+    if (info.external_wind_available) {
+      w.Angle(info.external_wind.bearing);
+      w.Double(info.external_wind.norm);
+    }
+    return info.external_wind_available;
+
+  case SensorField::TEMPERATURE:
+    if (info.temperature_available)
+      w.Double(info.temperature.ToKelvin());
+    return Flag(info.temperature_available);
+
+  case SensorField::HUMIDITY:
+    if (info.humidity_available)
+      w.Double(info.humidity);
+    return Flag(info.humidity_available);
+
+  case SensorField::VARIATION:
+    if (info.variation_available)
+      w.Angle(info.variation);
+    return info.variation_available;
+
+  case SensorField::G_LOAD:
+    if (info.acceleration.available) {
+      w.Double(info.acceleration.g_load);
+      w.Byte(info.acceleration.real);
+    }
+    return Flag(info.acceleration.available);
+
+  case SensorField::BANK_ANGLE:
+    if (info.attitude.bank_angle_available)
+      w.Angle(info.attitude.bank_angle);
+    return info.attitude.bank_angle_available;
+
+  case SensorField::PITCH_ANGLE:
+    if (info.attitude.pitch_angle_available)
+      w.Angle(info.attitude.pitch_angle);
+    return info.attitude.pitch_angle_available;
+
+  case SensorField::HEADING:
+    if (info.attitude.heading_available)
+      w.Angle(info.attitude.heading);
+    return info.attitude.heading_available;
+
+  case SensorField::VOLTAGE:
+    if (info.voltage_available)
+      w.Double(info.voltage);
+    return info.voltage_available;
+
+  case SensorField::BATTERY_LEVEL:
+    if (info.battery_level_available)
+      w.Double(info.battery_level);
+    return info.battery_level_available;
+
+  case SensorField::HEART_RATE:
+    if (info.heart_rate_available)
+      w.Uint32(info.heart_rate);
+    return info.heart_rate_available;
+
+  case SensorField::ENGINE_NOISE_LEVEL:
+    if (info.engine_noise_level_available)
+      w.Uint32(info.engine_noise_level);
+    return info.engine_noise_level_available;
+
+  case SensorField::STALL_RATIO:
+    if (info.stall_ratio_available)
+      w.Double(info.stall_ratio);
+    return info.stall_ratio_available;
+
+  case SensorField::MAC_CREADY:
+    if (info.settings.mac_cready_available)
+      w.Double(info.settings.mac_cready);
+    return info.settings.mac_cready_available;
+
+  case SensorField::BALLAST_FRACTION:
+    if (info.settings.ballast_fraction_available)
+      w.Double(info.settings.ballast_fraction);
+    return info.settings.ballast_fraction_available;
+
+  case SensorField::BUGS:
+    if (info.settings.bugs_available)
+      w.Double(info.settings.bugs);
+    return info.settings.bugs_available;
+
+  case SensorField::QNH:
+    if (info.settings.qnh_available)
+      w.Double(info.settings.qnh.GetHectoPascal());
+    return info.settings.qnh_available;
+
+  case SensorField::FIX_QUALITY:
+    if (info.gps.fix_quality_available)
+      w.Byte(uint8_t(info.gps.fix_quality));
+    return info.gps.fix_quality_available;
+
+  case SensorField::SATELLITES_USED:
+    if (info.gps.satellites_used_available)
+      w.Uint32(info.gps.satellites_used);
+    return info.gps.satellites_used_available;
+
+  case SensorField::COUNT:
+    break;
+  }
+
+  assert(false);
+  gcc_unreachable();
+}
+
+/**
+ * Read the value of the specified attribute and mark it available
+ * at #NMEAInfo::clock.
+ */
+static void
+DecodeField(SensorField field, ValueReader &r, NMEAInfo &info)
+{
+  const TimeStamp clock = info.clock;
+
+  switch (field) {
+  case SensorField::LOCATION:
+    info.location.longitude = r.Angle();
+    info.location.latitude = r.Angle();
+    info.location_available.Update(clock);
+    return;
+
+  case SensorField::TRACK:
+    info.track = r.Angle();
+    info.track_available.Update(clock);
+    return;
+
+  case SensorField::GROUND_SPEED:
+    info.ground_speed = r.Double();
+    info.ground_speed_available.Update(clock);
+    return;
+
+  case SensorField::AIRSPEED:
+    info.indicated_airspeed = r.Double();
+    info.true_airspeed = r.Double();
+    info.airspeed_real = r.Byte() != 0;
+    info.airspeed_available.Update(clock);
+    return;
+
+  case SensorField::GPS_ALTITUDE:
+    info.gps_altitude = r.Double();
+    info.gps_altitude_available.Update(clock);
+    return;
+
+  case SensorField::BARO_ALTITUDE:
+    info.baro_altitude = r.Double();
+    info.baro_altitude_weak = r.Byte() != 0;
+    info.baro_altitude_available.Update(clock);
+    return;
+
+  case SensorField::PRESSURE_ALTITUDE:
+    info.pressure_altitude = r.Double();
+    info.pressure_altitude_weak = r.Byte() != 0;
+    info.pressure_altitude_available.Update(clock);
+    return;
+
+  case SensorField::STATIC_PRESSURE:
+    info.ProvideStaticPressure(AtmosphericPressure::HectoPascal(r.Double()));
+    return;
+
+  case SensorField::DYN_PRESSURE:
+    info.ProvideDynamicPressure(AtmosphericPressure::HectoPascal(r.Double()));
+    return;
+
+  case SensorField::PITOT_PRESSURE:
+    info.ProvidePitotPressure(AtmosphericPressure::HectoPascal(r.Double()));
+    return;
+
+  case SensorField::TIME:
+    {
+      const double time = r.Double();
+      if (!(time >= 0))
+        throw std::runtime_error("Malformed time in sensor record");
+
+      info.ProvideTime(TimeStamp{FloatDuration{time}});
+    }
+    return;
+
+  case SensorField::DATE:
+    {
+      const unsigned year = r.Uint32();
+      const unsigned month = r.Byte();
+      const unsigned day = r.Byte();
+      const BrokenDate date(year, month, day);
+      if (date.IsPlausible())
+        info.ProvideDate(date);
+    }
+    return;
+
+  case SensorField::NONCOMP_VARIO:
+    info.ProvideNoncompVario(r.Double());
+    return;
+
+  case SensorField::TOTAL_ENERGY_VARIO:
+    info.ProvideTotalEnergyVario(r.Double());
+    return;
+
+  case SensorField::NETTO_VARIO:
+    info.ProvideNettoVario(r.Double());
+    return;
+
+  case SensorField::EXTERNAL_WIND:
+    {
+      const auto bearing = r.Angle();
+      info.ProvideExternalWind(SpeedVector(bearing, r.Double()));
+    }
+    return;
+
+  case SensorField::TEMPERATURE:
+    info.temperature = Temperature::FromKelvin(r.Double());
+    info.temperature_available = true;
+    return;
+
+  case SensorField::HUMIDITY:
+    info.humidity = r.Double();
+    info.humidity_available = true;
+    return;
+
+  case SensorField::VARIATION:
+    info.variation = r.Angle();
+    info.variation_available.Update(clock);
+    return;
+
+  case SensorField::G_LOAD:
+    {
+      const double g_load = r.Double();
+      info.acceleration.ProvideGLoad(g_load, r.Byte() != 0);
+    }
+    return;
+
+  case SensorField::BANK_ANGLE:
+    info.attitude.bank_angle = r.Angle();
+    info.attitude.bank_angle_available.Update(clock);
+    return;
+
+  case SensorField::PITCH_ANGLE:
+    info.attitude.pitch_angle = r.Angle();
+    info.attitude.pitch_angle_available.Update(clock);
+    return;
+
+  case SensorField::HEADING:
+    info.attitude.heading = r.Angle();
+    info.attitude.heading_available.Update(clock);
+    return;
+
+  case SensorField::VOLTAGE:
+    info.voltage = r.Double();
+    info.voltage_available.Update(clock);
+    return;
+
+  case SensorField::BATTERY_LEVEL:
+    info.battery_level = r.Double();
+    info.battery_level_available.Update(clock);
+    return;
+
+  case SensorField::HEART_RATE:
+    info.heart_rate = r.Uint32();
+    info.heart_rate_available.Update(clock);
+    return;
+
+  case SensorField::ENGINE_NOISE_LEVEL:
+    info.engine_noise_level = r.Uint32();
+    info.engine_noise_level_available.Update(clock);
+    return;
+
+  case SensorField::STALL_RATIO:
+    info.stall_ratio = r.Double();
+    info.stall_ratio_available.Update(clock);
+    return;
+
+  case SensorField::MAC_CREADY:
+    info.settings.mac_cready = r.Double();
+    info.settings.mac_cready_available.Update(clock);
+    return;
+
+  case SensorField::BALLAST_FRACTION:
+    info.settings.ballast_fraction = r.Double();
+    info.settings.ballast_fraction_available.Update(clock);
+    return;
+
+  case SensorField::BUGS:
+    info.settings.bugs = r.Double();
+    info.settings.bugs_available.Update(clock);
+    return;
+
+  case SensorField::QNH:
+    info.settings.qnh = AtmosphericPressure::HectoPascal(r.Double());
+    info.settings.qnh_available.Update(clock);
+    return;
+
+  case SensorField::FIX_QUALITY:
+    info.gps.fix_quality = FixQuality(r.Byte());
+    info.gps.fix_quality_available.Update(clock);
+    return;
+
+  case SensorField::SATELLITES_USED:
+    info.gps.satellites_used = (int)r.Uint32();
+    info.gps.satellites_used_available.Update(clock);
+    return;
+
+  case SensorField::COUNT:
+    break;
+  }
+
+  assert(false);
+  gcc_unreachable();
+}
+
+/**
+ * Mark the specified attribute unavailable.
+ */
+static void
+ClearField(SensorField field, NMEAInfo &info) noexcept
+{
+  switch (field) {
+  case SensorField::LOCATION:
+    info.location_available.Clear();
+    return;
+
+  case SensorField::TRACK:
+    info.track_available.Clear();
+    return;
+
+  case SensorField::GROUND_SPEED:
+    info.ground_speed_available.Clear();
+    return;
+
+  case SensorField::AIRSPEED:
+    info.airspeed_available.Clear();
+    return;
+
+  case SensorField::GPS_ALTITUDE:
+    info.gps_altitude_available.Clear();
+    return;
+
+  case SensorField::BARO_ALTITUDE:
+    info.baro_altitude_available.Clear();
+    return;
+
+  case SensorField::PRESSURE_ALTITUDE:
+    info.pressure_altitude_available.Clear();
+    return;
+
+  case SensorField::STATIC_PRESSURE:
+    info.static_pressure_available.Clear();
+    return;
+
+  case SensorField::DYN_PRESSURE:
+    info.dyn_pressure_available.Clear();
+    return;
+
+  case SensorField::PITOT_PRESSURE:
+    info.pitot_pressure_available.Clear();
+    return;
+
+  case SensorField::TIME:
+    info.time_available.Clear();
+    return;
+
+  case SensorField::DATE:
+    (BrokenDate &)info.date_time_utc = BrokenDate::Invalid();
+    return;
+
+  case SensorField::NONCOMP_VARIO:
+    info.noncomp_vario_available.Clear();
+    return;
+
+  case SensorField::TOTAL_ENERGY_VARIO:
+    info.total_energy_vario_available.Clear();
+    return;
+
+  case SensorField::NETTO_VARIO:
+    info.netto_vario_available.Clear();
+    return;
+
+  case SensorField::EXTERNAL_WIND:
+    info.external_wind_available.Clear();
+    return;
+
+  case SensorField::TEMPERATURE:
+    info.temperature_available = false;
+    return;
+
+  case SensorField::HUMIDITY:
+    info.humidity_available = false;
+    return;
+
+  case SensorField::VARIATION:
+    info.variation_available.Clear();
+    return;
+
+  case SensorField::G_LOAD:
+    info.acceleration.Reset();
+    return;
+
+  case SensorField::BANK_ANGLE:
+    info.attitude.bank_angle_available.Clear();
+    return;
+
+  case SensorField::PITCH_ANGLE:
+    info.attitude.pitch_angle_available.Clear();
+    return;
+
+  case SensorField::HEADING:
+    info.attitude.heading_available.Clear();
+    return;
+
+  case SensorField::VOLTAGE:
+    info.voltage_available.Clear();
+    return;
+
+  case SensorField::BATTERY_LEVEL:
+    info.battery_level_available.Clear();
+    return;
+
+  case SensorField::HEART_RATE:
+    info.heart_rate_available.Clear();
+    return;
+
+  case SensorField::ENGINE_NOISE_LEVEL:
+    info.engine_noise_level_available.Clear();
+    return;
+
+  case SensorField::STALL_RATIO:
+    info.stall_ratio_available.Clear();
+    return;
+
+  case SensorField::MAC_CREADY:
+    info.settings.mac_cready_available.Clear();
+    return;
+
+  case SensorField::BALLAST_FRACTION:
+    info.settings.ballast_fraction_available.Clear();
+    return;
+
+  case SensorField::BUGS:
+    info.settings.bugs_available.Clear();
+    return;
+
+  case SensorField::QNH:
+    info.settings.qnh_available.Clear();
+    return;
+
+  case SensorField::FIX_QUALITY:
+    info.gps.fix_quality_available.Clear();
+    return;
+
+  case SensorField::SATELLITES_USED:
+    info.gps.satellites_used_available.Clear();
+    return;
+
+  case SensorField::COUNT:
+    break;
+  }
+
+  assert(false);
+}
+
+static void
+DecodeFields(uint64_t mask, ValueReader &r, NMEAInfo &info)
+{
+  if (mask & ~ALL_FIELDS)
+    throw std::runtime_error("Unsupported field in sensor record");
+
+  for (unsigned i = 0; mask != 0; ++i, mask >>= 1)
+    if (mask & 1)
+      DecodeField(SensorField(i), r, info);
+}
+
+/**
+ * Parse the record header at the specified offset.
+ *
+ * @return false if the record is truncated
+ */
+static bool
+ParseRecord(std::span<const std::byte> data, std::size_t &position,
+            Tag &tag, std::span<const std::byte> &payload) noexcept
+{
+  if (position >= data.size())
+    return false;
+
+  try {
+    ValueReader r{data.subspan(position)};
+    tag = Tag(r.Byte());
+    const uint64_t length = r.Varint();
+    payload = r.Bytes(length);
+  } catch (...) {
+    return false;
+  }
+
+  position = payload.data() + payload.size() - data.data();
+  return true;
+}
+
+bool
+SensorRecordWriter::Field::operator==(const Field &other) const noexcept
+{
+  return stamp == other.stamp && size == other.size &&
+    std::equal(value.begin(), value.begin() + size, other.value.begin());
+}
+
+SensorRecordWriter::SensorRecordWriter(OutputStream &_os)
+  :os(_os), fields(N_FIELDS)
+{
+  const FileHeader header{MAGIC, VERSION};
+  os.Write(ReferenceAsBytes(header));
+  position = sizeof(header);
+}
+
+SensorRecordWriter::~SensorRecordWriter() noexcept = default;
+
+void
+SensorRecordWriter::WriteRecord(std::byte tag,
+                                std::span<const std::byte> payload)
+{
+  std::array<std::byte, 16> header;
+  ValueWriter w{header};
+  w.Byte(uint8_t(tag));
+  w.Varint(payload.size());
+
+  os.Write(std::span{header}.first(w.size()));
+  os.Write(payload);
+  position += w.size() + payload.size();
+}
+
+void
+SensorRecordWriter::Write(const NMEAInfo &info)
+{
+  const int64_t clock = ToMilliseconds(info.clock);
+
+  /* a clock going backwards would produce a negative delta; start a
+     new chain instead */
+  const bool keyframe = index.empty() || clock < last_clock ||
+    clock >= next_keyframe;
+
+  uint64_t set = 0, cleared = 0, now_available = 0;
+
+  std::array<std::byte, N_FIELDS * sizeof(Field::value)> values_buffer;
+  ValueWriter values{values_buffer};
+
+  for (unsigned i = 0; i < N_FIELDS; ++i) {
+    const uint64_t bit = uint64_t(1) << i;
+
+    Field f;
+    ValueWriter w{f.value};
+    f.stamp = EncodeField(SensorField(i), info, w);
+    f.size = w.size();
+
+    if (!f.stamp) {
+      if (available & bit)
+        cleared |= bit;
+      continue;
+    }
+
+    now_available |= bit;
+
+    if (keyframe || !(available & bit) || !(f == fields[i])) {
+      set |= bit;
+      values.Append(std::span{f.value}.first(f.size));
+      fields[i] = f;
+    }
+  }
+
+  available = now_available;
+
+  if (!keyframe && set == 0 && cleared == 0 && clock < next_heartbeat)
+    return;
+
+  std::array<std::byte, 32> header_buffer;
+  ValueWriter header{header_buffer};
+
+  if (keyframe) {
+    header.Uint64(clock);
+    header.Varint(set);
+  } else {
+    header.Varint(clock - last_clock);
+    header.Varint(set);
+    header.Varint(cleared);
+  }
+
+  std::array<std::byte, header_buffer.size() + values_buffer.size()> payload;
+  ValueWriter w{payload};
+  w.Append(std::span{header_buffer}.first(header.size()));
+  w.Append(std::span{values_buffer}.first(values.size()));
+
+  if (keyframe) {
+    index.push_back({clock, position});
+    next_keyframe = clock + KEYFRAME_INTERVAL.count();
+  }
+
+  WriteRecord(std::byte(keyframe ? Tag::KEYFRAME : Tag::DELTA),
+              std::span{payload}.first(w.size()));
+
+  last_clock = clock;
+  next_heartbeat = clock + HEARTBEAT_INTERVAL.count();
+}
+
+void
+SensorRecordWriter::Finish()
+{
+  const uint64_t index_offset = position;
+
+  std::vector<std::byte> payload(10 + index.size() * 16);
+  ValueWriter w{payload};
+  w.Varint(index.size());
+  for (const auto &i : index) {
+    w.Uint64(i.clock);
+    w.Uint64(i.offset);
+  }
+
+  WriteRecord(std::byte(Tag::INDEX), std::span{payload}.first(w.size()));
+
+  const FileFooter footer{index_offset, INDEX_MAGIC};
+  os.Write(ReferenceAsBytes(footer));
+  position += sizeof(footer);
+}
+
+/**
+ * Parse the index written by SensorRecordWriter::Finish().
+ *
+ * @return the offset of the index record or 0 if there is no valid
+ * index
+ */
+static std::size_t
+LoadIndex(std::span<const std::byte> data,
+          std::vector<IndexEntry> &index) noexcept
+{
+  if (data.size() < sizeof(FileHeader) + sizeof(FileFooter))
+    return 0;
+
+  FileFooter footer;
+  std::memcpy(&footer, data.data() + data.size() - sizeof(footer),
+              sizeof(footer));
+  if (footer.magic != INDEX_MAGIC ||
+      footer.index_offset < sizeof(FileHeader) ||
+      footer.index_offset >= data.size() - sizeof(footer))
+    return 0;
+
+  const std::size_t index_offset = footer.index_offset;
+
+  std::size_t position = index_offset;
+  Tag tag;
+  std::span<const std::byte> payload;
+  if (!ParseRecord(data.first(data.size() - sizeof(footer)), position,
+                   tag, payload) ||
+      tag != Tag::INDEX)
+    return 0;
+
+  try {
+    ValueReader r{payload};
+    const uint64_t n = r.Varint();
+    if (n > payload.size() / 16)
+      return 0;
+
+    index.clear();
+    index.reserve(n);
+    for (uint64_t i = 0; i < n; ++i) {
+      const int64_t clock = r.Uint64();
+      const uint64_t offset = r.Uint64();
+      if (offset < sizeof(FileHeader) || offset >= index_offset ||
+          (!index.empty() && (clock < index.back().clock ||
+                              offset <= index.back().offset)))
+        return 0;
+
+      index.push_back({clock, offset});
+    }
+  } catch (...) {
+    return 0;
+  }
+
+  return index_offset;
+}
+
+/**
+ * Rebuild the index of a recording which was not finished.
+ *
+ * @return the end of the last complete record
+ */
+static std::size_t
+ScanIndex(std::span<const std::byte> data,
+          std::vector<IndexEntry> &index) noexcept
+{
+  index.clear();
+
+  std::size_t position = sizeof(FileHeader), end = position;
+  Tag tag;
+  std::span<const std::byte> payload;
+  while (ParseRecord(data, position, tag, payload)) {
+    if (tag == Tag::INDEX)
+      break;
+
+    if (tag == Tag::KEYFRAME) {
+      if (payload.size() < 8)
+        break;
+
+      PackedLE64 clock;
+      std::memcpy(&clock, payload.data(), sizeof(clock));
+      index.push_back({int64_t(uint64_t(clock)), end});
+    }
+
+    end = position;
+  }
+
+  return end;
+}
+
+SensorRecordReader::SensorRecordReader(std::span<const std::byte> _data)
+  :data(_data)
+{
+  FileHeader header;
+  if (data.size() < sizeof(header))
+    throw std::runtime_error("Not a sensor recording");
+
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != MAGIC)
+    throw std::runtime_error("Not a sensor recording");
+
+  if (header.version != VERSION)
+    throw std::runtime_error("Unsupported sensor recording version");
+
+  end = LoadIndex(data, index);
+  if (end == 0)
+    end = ScanIndex(data, index);
+
+  data = data.first(end);
+  position = sizeof(header);
+}
+
+TimeStamp
+SensorRecordReader::GetStartClock() const noexcept
+{
+  if (index.empty())
+    return TimeStamp::Undefined();
+
+  return FromMilliseconds(index.front().clock);
+}
+
+TimeStamp
+SensorRecordReader::GetEndClock() const noexcept
+{
+  if (index.empty())
+    return TimeStamp::Undefined();
+
+  int64_t result = index.back().clock;
+
+  std::size_t p = index.back().offset;
+  Tag tag;
+  std::span<const std::byte> payload;
+  while (ParseRecord(data, p, tag, payload)) {
+    if (tag != Tag::DELTA)
+      continue;
+
+    try {
+      ValueReader r{payload};
+      result += r.Varint();
+    } catch (...) {
+      break;
+    }
+  }
+
+  return FromMilliseconds(result);
+}
+
+bool
+SensorRecordReader::PeekClock(int64_t &next_clock) const
+{
+  std::size_t p = position;
+  Tag tag;
+  std::span<const std::byte> payload;
+  while (ParseRecord(data, p, tag, payload)) {
+    ValueReader r{payload};
+
+    switch (tag) {
+    case Tag::KEYFRAME:
+      next_clock = r.Uint64();
+      return true;
+
+    case Tag::DELTA:
+      if (!have_keyframe)
+        break;
+
+      next_clock = clock + r.Varint();
+      return true;
+
+    case Tag::INDEX:
+      break;
+    }
+  }
+
+  return false;
+}
+
+bool
+SensorRecordReader::Read(NMEAInfo &info)
+{
+  Tag tag;
+  std::span<const std::byte> payload;
+  while (ParseRecord(data, position, tag, payload)) {
+    ValueReader r{payload};
+
+    switch (tag) {
+    case Tag::KEYFRAME:
+      clock = r.Uint64();
+      info.Reset();
+      info.clock = FromMilliseconds(clock);
+      DecodeFields(r.Varint(), r, info);
+      have_keyframe = true;
+      break;
+
+    case Tag::DELTA:
+      if (!have_keyframe)
+        /* can't apply a delta without its keyframe */
+        continue;
+
+      clock += r.Varint();
+      info.clock = FromMilliseconds(clock);
+
+      {
+        const uint64_t set = r.Varint();
+        uint64_t cleared = r.Varint();
+        for (unsigned i = 0; cleared != 0 && i < N_FIELDS; ++i, cleared >>= 1)
+          if (cleared & 1)
+            ClearField(SensorField(i), info);
+
+        DecodeFields(set, r, info);
+      }
+
+      break;
+
+    default:
+      /* ignore unknown records */
+      continue;
+    }
+
+    info.alive.Update(info.clock);
+    return true;
+  }
+
+  return false;
+}
+
+void
+SensorRecordReader::Seek(TimeStamp target, NMEAInfo &info)
+{
+  have_keyframe = false;
+
+  if (index.empty()) {
+    position = end;
+    return;
+  }
+
+  const int64_t target_clock = ToMilliseconds(target);
+
+  /* find the last keyframe which is not newer than the target */
+  auto i = std::upper_bound(index.begin(), index.end(), target_clock,
+                            [](int64_t t, const IndexEntry &e){
+                              return t < e.clock;
+                            });
+  if (i != index.begin())
+    --i;
+
+  position = i->offset;
+  if (!Read(info))
+    return;
+
+  int64_t next_clock;
+  while (PeekClock(next_clock) && next_clock <= target_clock)
+    Read(info);
+}
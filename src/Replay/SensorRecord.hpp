@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "time/Stamp.hpp"
+#include "NMEA/Validity.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct NMEAInfo;
+class OutputStream;
+
+/*
+ * A compact binary recording of merged #NMEAInfo objects, which can
+ * be replayed without parsing NMEA sentences, and which allows
+ * seeking to any point in time.
+ *
+ * The file begins with a header (magic and version), followed by
+ * records.  Each record consists of a tag byte, the payload length
+ * (varint) and the payload.
+ *
+ * - a keyframe contains the absolute #NMEAInfo::clock (64 bit
+ *   little-endian milliseconds) and all available attributes; it
+ *   starts a new delta chain
+ *
+ * - a delta contains the clock difference to the previous record
+ *   (varint milliseconds), the set of attributes which were updated
+ *   since then with their new values, and the set of attributes
+ *   which have become unavailable
+ *
+ * - the index lists the clock and file offset of each keyframe; it
+ *   is written when the recording is finished, followed by a footer
+ *   pointing to it; if it is missing (e.g. after a crash), the
+ *   reader rebuilds it by scanning the record headers
+ *
+ * Only the attributes listed in #SensorField are recorded; FLARM
+ * traffic and device information are not.
+ */
+namespace SensorRecord {
+
+static constexpr uint32_t VERSION = 1;
+
+/**
+ * Write a keyframe at least this often.  This limits the number of
+ * deltas which need to be decoded after a seek.
+ */
+static constexpr std::chrono::milliseconds KEYFRAME_INTERVAL{10000};
+
+/**
+ * Write a (possibly empty) delta at least this often, so the
+ * #NMEAInfo::alive flag does not expire during replay.
+ */
+static constexpr std::chrono::milliseconds HEARTBEAT_INTERVAL{1000};
+
+struct IndexEntry {
+  /**
+   * The #NMEAInfo::clock of the keyframe [ms].
+   */
+  int64_t clock;
+
+  /**
+   * The file offset of the keyframe record.
+   */
+  uint64_t offset;
+};
+
+} // namespace SensorRecord
+
+/**
+ * Writes #NMEAInfo snapshots to a sensor recording file.  See
+ * namespace #SensorRecord for a description of the format.
+ */
+class SensorRecordWriter {
+  struct Field {
+    /**
+     * The time stamp of the most recent update, used to detect new
+     * values which happen to be equal to the previous one.
+     */
+    Validity stamp;
+
+    uint8_t size;
+
+    std::array<std::byte, 24> value;
+
+    bool operator==(const Field &other) const noexcept;
+  };
+
+  OutputStream &os;
+
+  /**
+   * The current file offset.
+   */
+  uint64_t position = 0;
+
+  /**
+   * The clock of the previous record [ms].
+   */
+  int64_t last_clock;
+
+  /**
+   * The clock of the next keyframe [ms].
+   */
+  int64_t next_keyframe;
+
+  /**
+   * The clock after which an empty delta shall be written [ms].
+   */
+  int64_t next_heartbeat;
+
+  /**
+   * A bit mask of the attributes which were available in the
+   * previous record.
+   */
+  uint64_t available = 0;
+
+  std::vector<Field> fields;
+
+  std::vector<SensorRecord::IndexEntry> index;
+
+public:
+  /**
+   * Writes the file header.
+   *
+   * Throws on error.
+   */
+  explicit SensorRecordWriter(OutputStream &_os);
+
+  ~SensorRecordWriter() noexcept;
+
+  std::span<const SensorRecord::IndexEntry> GetIndex() const noexcept {
+    return index;
+  }
+
+  /**
+   * Append a record describing the changes since the previous call.
+   * Nothing is written if nothing has changed (except for a
+   * heartbeat or keyframe).
+   *
+   * Throws on error.
+   */
+  void Write(const NMEAInfo &info);
+
+  /**
+   * Write the index.  No more records may be written after that.
+   *
+   * Throws on error.
+   */
+  void Finish();
+
+private:
+  void WriteRecord(std::byte tag, std::span<const std::byte> payload);
+};
+
+/**
+ * Reads a sensor recording which is completely in memory (e.g. with
+ * #FileMapping).  The buffer must remain valid until this object is
+ * destructed.
+ */
+class SensorRecordReader {
+  std::span<const std::byte> data;
+
+  /**
+   * The end of the record area (the beginning of the index).
+   */
+  std::size_t end;
+
+  /**
+   * The offset of the next record.
+   */
+  std::size_t position;
+
+  /**
+   * The clock of the previous record [ms]; only valid after a
+   * keyframe has been read.
+   */
+  int64_t clock;
+
+  /**
+   * Has a keyframe been read since the last seek?  Deltas are
+   * ignored until then.
+   */
+  bool have_keyframe = false;
+
+  std::vector<SensorRecord::IndexEntry> index;
+
+public:
+  /**
+   * Throws on error (e.g. if this is not a sensor recording).
+   */
+  explicit SensorRecordReader(std::span<const std::byte> _data);
+
+  std::span<const SensorRecord::IndexEntry> GetIndex() const noexcept {
+    return index;
+  }
+
+  /**
+   * The clock of the first keyframe, or TimeStamp::Undefined() if
+   * the recording is empty.
+   */
+  [[gnu::pure]]
+  TimeStamp GetStartClock() const noexcept;
+
+  /**
+   * The clock of the last record, or TimeStamp::Undefined() if the
+   * recording is empty.  This scans the records after the last
+   * keyframe.
+   */
+  [[gnu::pure]]
+  TimeStamp GetEndClock() const noexcept;
+
+  /**
+   * Apply the next record to the specified object.
+   *
+   * Throws if the record is malformed.
+   *
+   * @return false at the end of the recording
+   */
+  bool Read(NMEAInfo &info);
+
+  /**
+   * Reset the specified object to the state at the given clock,
+   * i.e. after the last record which is not newer.  This looks up
+   * the nearest keyframe with a binary search and then decodes at
+   * most #SensorRecord::KEYFRAME_INTERVAL of deltas.
+   *
+   * Throws if a record is malformed.
+   */
+  void Seek(TimeStamp target, NMEAInfo &info);
+
+private:
+  /**
+   * Determine the clock of the next record without applying it.
+   *
+   * @return false at the end of the recording
+   */
+  bool PeekClock(int64_t &next_clock) const;
+};
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Replay/SensorReplay.hpp"
+#include "NMEA/Info.hpp"
+#include "system/Path.hpp"
+
+SensorReplay::SensorReplay(Path path)
+  :mapping(path), reader(mapping)
+{
+}
+
+FloatDuration
+SensorReplay::GetDuration() const noexcept
+{
+  const auto start = reader.GetStartClock();
+  if (!start.IsDefined())
+    return {};
+
+  return reader.GetEndClock() - start;
+}
+
+static void
+MarkReplay(NMEAInfo &data) noexcept
+{
+  data.gps.real = false;
+  data.gps.replay = true;
+}
+
+void
+SensorReplay::Seek(FloatDuration offset, NMEAInfo &data)
+{
+  const auto start = reader.GetStartClock();
+  if (!start.IsDefined())
+    return;
+
+  reader.Seek(start + offset, data);
+  MarkReplay(data);
+}
+
+bool
+SensorReplay::Update(NMEAInfo &data)
+{
+  const bool had_time = data.time_available;
+  const TimeStamp old_time = data.time;
+
+  while (reader.Read(data)) {
+    MarkReplay(data);
+
+    /* return one GPS fix at a time, like NmeaReplay does */
+    if (data.time_available && (!had_time || data.time != old_time))
+      return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "AbstractReplay.hpp"
+#include "SensorRecord.hpp"
+#include "io/FileMapping.hpp"
+#include "time/FloatDuration.hxx"
+
+class Path;
+
+/**
+ * Replays a file written by #SensorRecorder.  Unlike #NmeaReplay,
+ * nothing needs to be parsed, and Seek() can jump to any point of
+ * the recording quickly.
+ */
+class SensorReplay final : public AbstractReplay
+{
+  FileMapping mapping;
+
+  SensorRecordReader reader;
+
+public:
+  /**
+   * Throws on error.
+   */
+  explicit SensorReplay(Path path);
+
+  /**
+   * The duration of the whole recording.
+   */
+  [[gnu::pure]]
+  FloatDuration GetDuration() const noexcept;
+
+  /**
+   * Continue replaying at the specified offset from the beginning
+   * of the recording.  @a data is overwritten with the state at
+   * that time.
+   *
+   * Throws if the file is malformed.
+   */
+  void Seek(FloatDuration offset, NMEAInfo &data);
+
+  /**
+   * Apply records until the GPS time changes.
+   *
+   * Throws if the file is malformed.
+   */
+  bool Update(NMEAInfo &data) override;
+};
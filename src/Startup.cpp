@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "Startup.hpp"
+#include "StartupLoader.hpp"
 #include "Interface.hpp"
 #include "Components.hpp"
 #include "NetComponents.hpp"
@@ -31,6 +32,7 @@
 #include "FLARM/Glue.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
+#include "Logger/SensorRecorder.hpp"
 #include "Logger/GlueFlightLogger.hpp"
 #include "Waypoint/WaypointDetailsReader.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
@@ -78,7 +80,6 @@
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Operation/VerboseOperationEnvironment.hpp"
 #include "Operation/PluggableOperationEnvironment.hpp"
-#include "Operation/SubOperationEnvironment.hpp"
 #include "Widget/ProgressWidget.hpp"
 #include "PageActions.hpp"
 #include "Weather/Features.hpp"
@@ -389,6 +390,7 @@ Startup(UI::Display &display)
 
   backend_components->replay =
     std::make_unique<Replay>(*backend_components->device_blackboard,
+                             *backend_components->glide_computer,
                              backend_components->igc_logger.get(),
                              *backend_components->protected_task_manager);
 
@@ -414,32 +416,59 @@ Startup(UI::Display &display)
                          CommonInterface::SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
+  // Load the data files concurrently
   data_components->topography = std::make_unique<TopographyStore>();
-  {
-    LogString("Loading Topography File...");
-    operation.SetText(_("Loading Topography File..."));
-    LoadConfiguredTopography(*data_components->topography);
-    operation.SetProgressPosition(256);
-  }
 
-  // Read the waypoint files
-  LogString("ReadWaypoints");
+#ifdef HAVE_NOAA
+  noaa_store = new NOAAStore();
+#endif
+
+  std::shared_ptr<RaspStore> rasp;
+
   {
-    SubOperationEnvironment sub_env(operation, 256, 512);
-    sub_env.SetText(_("Loading Waypoints..."));
-    WaypointGlue::LoadWaypoints(*data_components->waypoints,
-                                data_components->terrain.get(),
-                                sub_env);
-  }
+    StartupLoader loader;
+
+    loader.Add("Topography", [](OperationEnvironment &env){
+      LogString("Loading Topography File...");
+      env.SetText(_("Loading Topography File..."));
+      LoadConfiguredTopography(*data_components->topography);
+    });
+
+    const auto waypoints = loader.Add("Waypoints", [](OperationEnvironment &env){
+      LogString("ReadWaypoints");
+      env.SetText(_("Loading Waypoints..."));
+      WaypointGlue::LoadWaypoints(*data_components->waypoints,
+                                  data_components->terrain.get(),
+                                  env);
+    });
+
+    // Read and parse the airfield info file
+    loader.Add("AirfieldDetails", [](OperationEnvironment &env){
+      env.SetText(_("Loading Airfield Details File..."));
+      WaypointDetails::ReadFileFromProfile(*data_components->waypoints, env);
+    }, {waypoints});
+
+    // Scan for weather forecast
+    loader.Add("RASP", [&rasp](OperationEnvironment &){
+      LogString("RASP load");
+      rasp = LoadConfiguredRasp();
+    });
+
+    // Reads the airspace files
+    loader.Add("Airspace", [&computer_settings](OperationEnvironment &env){
+      ReadAirspace(*data_components->airspaces,
+                   computer_settings.pressure,
+                   file_cache,
+                   env);
+    });
 
-  // Read and parse the airfield info file
-  try {
-    SubOperationEnvironment sub_env(operation, 512, 768);
-    sub_env.SetText(_("Loading Airfield Details File..."));
-    WaypointDetails::ReadFileFromProfile(*data_components->waypoints, sub_env);
-  } catch (...) {
-    LogError(std::current_exception());
+#ifdef HAVE_NOAA
+    loader.Add("NOAA", [](OperationEnvironment &){
+      noaa_store->LoadFromProfile();
+    });
+#endif
+
+    loader.Run(operation);
   }
 
   // Set the home waypoint
@@ -453,36 +482,30 @@ Startup(UI::Display &display)
   // ReSynchronise the blackboards here since SetHome touches them
   backend_components->device_blackboard->Merge();
   CommonInterface::ReadBlackboardBasic(backend_components->device_blackboard->Basic());
+  CommonInterface::ReadTraffic(backend_components->device_blackboard->Traffic(),
+                               backend_components->device_blackboard->GetTrafficVersion());
 
-  // Scan for weather forecast
-  LogString("RASP load");
-  auto rasp = LoadConfiguredRasp();
-
-  // Reads the airspace files
-  {
-    SubOperationEnvironment sub_env(operation, 768, 1024);
-    ReadAirspace(*data_components->airspaces,
-                 computer_settings.pressure,
-                 sub_env);
-  }
-
+  /* if the terrain has not been loaded yet, OnTerrainLoaded() will
+     do this */
   if (data_components->terrain)
     SetAirspaceGroundLevels(*data_components->airspaces,
                             *data_components->terrain);
 
   {
-    const AircraftState aircraft_state =
-      ToAircraftState(backend_components->device_blackboard->Basic(),
-                      backend_components->device_blackboard->Calculated());
+    auto &device_blackboard = *backend_components->device_blackboard;
+    AircraftState aircraft_state;
+
+    {
+      const std::lock_guard lock{device_blackboard.mutex};
+      device_blackboard.ReadCalculatedSnapshot();
+      aircraft_state = ToAircraftState(device_blackboard.Basic(),
+                                       device_blackboard.Calculated());
+    }
+
     ProtectedAirspaceWarningManager::ExclusiveLease lease(backend_components->glide_computer->GetAirspaceWarnings());
     lease->Reset(aircraft_state);
   }
 
-#ifdef HAVE_NOAA
-  noaa_store = new NOAAStore();
-  noaa_store->LoadFromProfile();
-#endif
-
 #ifdef HAVE_VOLUME_CONTROLLER
   volume_controller->SetVolume(ui_settings.sound.master_volume);
 #endif
@@ -541,7 +564,7 @@ Startup(UI::Display &display)
   // Create the calculation thread
   CreateCalculationThread();
 
-  glide_computer_events = new GlideComputerEvents();
+  glide_computer_events = new GlideComputerEvents(live_blackboard);
   glide_computer_events->Reset();
   live_blackboard.AddListener(*glide_computer_events);
 
@@ -555,6 +578,13 @@ Startup(UI::Display &display)
   if (computer_settings.logger.enable_nmea_logger)
     backend_components->nmea_logger->Enable();
 
+  if (!is_simulator() && computer_settings.logger.enable_sensor_recorder) {
+    backend_components->sensor_recorder = std::make_unique<SensorRecorder>();
+
+    const std::lock_guard lock{backend_components->device_blackboard->mutex};
+    backend_components->device_blackboard->SetSensorRecorder(backend_components->sensor_recorder.get());
+  }
+
   LogString("ProgramStarted");
 
   // Give focus to the map
@@ -674,6 +704,14 @@ Shutdown()
       backend_components->calculation_thread->Join();
       backend_components->calculation_thread.reset();
     }
+
+    if (backend_components->device_blackboard) {
+      const auto stats = backend_components->device_blackboard
+        ->GetCalculatedSnapshot().GetStatistics();
+      LogFmt("Calculated snapshots: {} published, {} skipped, {} reads, {} read retries",
+             stats.publications, stats.skipped,
+             stats.reads, stats.read_retries);
+    }
   }
 
   //  Wait for the drawing thread to finish
@@ -721,6 +759,15 @@ Shutdown()
   if (backend_components != nullptr) {
     backend_components->nmea_logger.reset();
 
+    if (backend_components->sensor_recorder) {
+      {
+        const std::lock_guard lock{backend_components->device_blackboard->mutex};
+        backend_components->device_blackboard->SetSensorRecorder(nullptr);
+      }
+
+      backend_components->sensor_recorder.reset();
+    }
+
     if (backend_components->protected_task_manager) {
       backend_components->protected_task_manager->SetRoutePlanner(nullptr);
       backend_components->protected_task_manager.reset();
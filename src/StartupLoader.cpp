@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StartupLoader.hpp"
+#include "Operation/Operation.hpp"
+#include "LogFile.hpp"
+#include "system/Sleep.h"
+#include "thread/Thread.hpp"
+#include "util/StaticString.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+class StartupLoader::Task final : public Thread, public OperationEnvironment {
+  StartupLoader &loader;
+
+public:
+  const char *const name;
+
+  const Function function;
+
+  const std::vector<unsigned> dependencies;
+
+  /* the following attributes are protected by StartupLoader::mutex */
+
+  enum class State {
+    WAITING,
+    RUNNING,
+    DONE,
+  } state = State::WAITING;
+
+  StaticString<128> text;
+  StaticString<256> error;
+
+  unsigned progress_range = 0, progress_position = 0;
+
+  Clock::duration duration{};
+
+  /**
+   * Was this task started in its own thread?  If not, StartupLoader::Run() executes
+   * it in the calling thread.
+   */
+  bool started = false;
+
+  Task(StartupLoader &_loader, const char *_name, Function &&_function,
+       std::initializer_list<unsigned> _dependencies) noexcept
+    :Thread(_name), loader(_loader), name(_name),
+     function(std::move(_function)), dependencies(_dependencies)
+  {
+    text.clear();
+    error.clear();
+  }
+
+  /**
+   * Wait for the dependencies, then run the loader.
+   */
+  void Execute() noexcept;
+
+  /**
+   * Returns the progress of this task in the range [0, 1].
+   *
+   * Caller must lock the mutex.
+   */
+  [[gnu::pure]]
+  double GetProgress() const noexcept {
+    if (state == State::DONE)
+      return 1;
+
+    if (state == State::WAITING || progress_range == 0)
+      return 0;
+
+    return double(std::min(progress_position, progress_range)) /
+      progress_range;
+  }
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    Execute();
+  }
+
+public:
+  /* virtual methods from class OperationEnvironment */
+  bool IsCancelled() const noexcept override {
+    return false;
+  }
+
+  void SetCancelHandler(std::function<void()>) noexcept override {}
+
+  void Sleep(std::chrono::steady_clock::duration d) noexcept override {
+    ::Sleep(std::chrono::duration_cast<std::chrono::milliseconds>(d).count());
+  }
+
+  void SetErrorMessage(const TCHAR *_error) noexcept override {
+    const std::lock_guard lock{loader.mutex};
+    if (error.empty())
+      error = _error;
+  }
+
+  void SetText(const TCHAR *_text) noexcept override {
+    {
+      const std::lock_guard lock{loader.mutex};
+      text = _text;
+    }
+
+    loader.cond.notify_all();
+  }
+
+  void SetProgressRange(unsigned range) noexcept override {
+    const std::lock_guard lock{loader.mutex};
+    progress_range = range;
+  }
+
+  void SetProgressPosition(unsigned position) noexcept override {
+    const std::lock_guard lock{loader.mutex};
+    progress_position = position;
+  }
+};
+
+void
+StartupLoader::Task::Execute() noexcept
+{
+  {
+    std::unique_lock lock{loader.mutex};
+    loader.cond.wait(lock, [this]{
+      return std::all_of(dependencies.begin(), dependencies.end(),
+                         [this](unsigned i){
+                           return loader.tasks[i]->state == State::DONE;
+                         });
+    });
+
+    state = State::RUNNING;
+  }
+
+  const auto start = Clock::now();
+
+  try {
+    function(*this);
+  } catch (...) {
+    LogError(std::current_exception(), name);
+  }
+
+  {
+    const std::lock_guard lock{loader.mutex};
+    duration = Clock::now() - start;
+    state = State::DONE;
+  }
+
+  loader.cond.notify_all();
+}
+
+StartupLoader::StartupLoader() noexcept = default;
+
+StartupLoader::~StartupLoader() noexcept = default;
+
+unsigned
+StartupLoader::Add(const char *name, Function f,
+                   std::initializer_list<unsigned> dependencies) noexcept
+{
+  const unsigned i = tasks.size();
+
+  /* forward references only; this rules out cycles */
+  assert(std::all_of(dependencies.begin(), dependencies.end(),
+                     [i](unsigned d){ return d < i; }));
+
+  tasks.emplace_back(std::make_unique<Task>(*this, name, std::move(f),
+                                            dependencies));
+  return i;
+}
+
+void
+StartupLoader::Run(OperationEnvironment &env) noexcept
+{
+  const auto start = Clock::now();
+
+  for (auto &task : tasks) {
+    try {
+      task->Start();
+      task->started = true;
+    } catch (...) {
+      LogError(std::current_exception(), task->name);
+    }
+  }
+
+  /* tasks whose thread could not be started run here; this cannot
+     deadlock because dependencies always have a lower index */
+  for (auto &task : tasks)
+    if (!task->started)
+      task->Execute();
+
+  constexpr unsigned SCALE = 256;
+  env.SetProgressRange(tasks.size() * SCALE);
+
+  StaticString<128> current_text;
+  current_text.clear();
+
+  {
+    std::unique_lock lock{mutex};
+
+    while (true) {
+      double progress = 0;
+      bool finished = true;
+      const TCHAR *text = nullptr;
+
+      for (const auto &task : tasks) {
+        progress += task->GetProgress();
+
+        if (task->state != Task::State::DONE) {
+          finished = false;
+
+          if (text == nullptr && task->state == Task::State::RUNNING &&
+              !task->text.empty())
+            text = task->text;
+        }
+      }
+
+      if (finished)
+        break;
+
+      StaticString<128> new_text;
+      new_text = text != nullptr ? text : _T("");
+
+      {
+        const ScopeUnlock unlock{mutex};
+
+        if (!new_text.empty() && new_text != current_text) {
+          current_text = new_text;
+          env.SetText(current_text);
+        }
+
+        env.SetProgressPosition(unsigned(progress * SCALE));
+      }
+
+      cond.wait_for(lock, std::chrono::milliseconds(100));
+    }
+  }
+
+  env.SetProgressPosition(tasks.size() * SCALE);
+
+  for (auto &task : tasks) {
+    if (task->started)
+      task->Join();
+
+    if (!task->error.empty())
+      env.SetErrorMessage(task->error);
+
+    LogFmt("Startup: {} took {} ms", task->name,
+           std::chrono::duration_cast<std::chrono::milliseconds>(task->duration).count());
+  }
+
+  LogFmt("Startup: {} loaders finished after {} ms", tasks.size(),
+         std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+class OperationEnvironment;
+
+/**
+ * Runs the data file loaders of Startup() concurrently.  Each loader
+ * gets its own thread; a loader starts only after all loaders it
+ * depends on have finished.  The wall time of each loader is written
+ * to the log file.
+ *
+ * Loaders must not touch the user interface; they report progress
+ * through the #OperationEnvironment passed to them, which is
+ * forwarded to the caller's environment by Run().
+ */
+class StartupLoader {
+public:
+  using Function = std::function<void(OperationEnvironment &env)>;
+
+private:
+  class Task;
+
+  Mutex mutex;
+
+  /**
+   * Signalled when a task finishes or reports progress.
+   */
+  Cond cond;
+
+  std::vector<std::unique_ptr<Task>> tasks;
+
+public:
+  StartupLoader() noexcept;
+  ~StartupLoader() noexcept;
+
+  StartupLoader(const StartupLoader &) = delete;
+  StartupLoader &operator=(const StartupLoader &) = delete;
+
+  /**
+   * Add a loader.  Exceptions thrown by the function are logged.
+   *
+   * @param name a short name for the log file
+   * @param dependencies the handles of loaders which must finish
+   * before this one starts; they must have been added before
+   * @return a handle for the dependency list of other loaders
+   */
+  unsigned Add(const char *name, Function f,
+               std::initializer_list<unsigned> dependencies={}) noexcept;
+
+  /**
+   * Run all loaders and wait for them to finish.  Progress is
+   * reported to the given environment from the calling thread.
+   */
+  void Run(OperationEnvironment &env) noexcept;
+};
@@ -39,24 +39,31 @@ void
 ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
                                   const RoutePlannerConfig &config,
                                   const int h_ceiling,
-                                  const bool do_solve) noexcept
+                                  const bool do_solve,
+                                  ArrivalTable &&destinations) noexcept
 {
   /* these local variables help avoid locking both mutexes at the same
      time */
   ReachFan rt, rw;
+  RoutePolars rpolars;
 
   {
     const std::scoped_lock lock{route_mutex};
     rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve, false);
     rw = route_planner.SolveReach(origin, config, h_ceiling, do_solve, true);
-    rpolars_reach = route_planner.GetReachPolar();
+    rpolars = route_planner.GetReachPolar();
   }
 
+  if (!destinations.empty())
+    destinations.Solve(rt, rpolars);
+
   /* we lock this mutex not during the expensive reach calculation,
      but only for moving the result to the mutex-protected fields */
   const std::scoped_lock lock{reach_mutex};
   reach_terrain = std::move(rt);
   reach_working = std::move(rw);
+  rpolars_reach = rpolars;
+  arrivals = std::move(destinations);
 }
 
 const FlatProjection
@@ -73,6 +80,17 @@ ProtectedRoutePlanner::FindPositiveArrival(const AGeoPoint &dest) const noexcept
   return reach_terrain.FindPositiveArrival(dest, rpolars_reach);
 }
 
+std::optional<ReachResult>
+ProtectedRoutePlanner::FindPositiveArrival(const AGeoPoint &dest,
+                                           unsigned id) const noexcept
+{
+  const std::scoped_lock lock{reach_mutex};
+  if (const auto *result = arrivals.Find(id, dest))
+    return *result;
+
+  return reach_terrain.FindPositiveArrival(dest, rpolars_reach);
+}
+
 void
 ProtectedRoutePlanner::AcceptInRange(const GeoBounds &bounds,
                                      FlatTriangleFanVisitor &visitor,
@@ -5,6 +5,7 @@
 
 #include "RoutePlannerGlue.hpp"
 #include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/ArrivalTable.hpp"
 #include "Engine/Route/RoutePolars.hpp"
 #include "thread/Mutex.hxx"
 
@@ -37,6 +38,12 @@ class ProtectedRoutePlanner
   ReachFan reach_terrain;
   ReachFan reach_working;
 
+  /**
+   * The terrain reach results of the destinations passed to
+   * SolveReach().
+   */
+  ArrivalTable arrivals;
+
 public:
   ProtectedRoutePlanner(RoutePlannerGlue &route, const Airspaces &_airspaces,
                         const ProtectedAirspaceWarningManager *_warnings) noexcept
@@ -54,6 +61,7 @@ public:
     const std::scoped_lock lock{reach_mutex};
     reach_terrain.Reset();
     reach_working.Reset();
+    arrivals.clear();
   }
 
   [[gnu::pure]]
@@ -74,8 +82,14 @@ public:
                   const RoutePlannerConfig &config,
                   int h_ceiling) noexcept;
 
+  /**
+   * Calculate the reach and, in the same pass, the terrain reach
+   * results of the given destinations (see FindPositiveArrival()
+   * with a destination id).
+   */
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
-                  int h_ceiling, bool do_solve) noexcept;
+                  int h_ceiling, bool do_solve,
+                  ArrivalTable &&destinations={}) noexcept;
 
   [[gnu::pure]]
   const FlatProjection GetTerrainReachProjection() const noexcept;
@@ -83,6 +97,17 @@ public:
   [[gnu::pure]]
   std::optional<ReachResult> FindPositiveArrival(const AGeoPoint &dest) const noexcept;
 
+  /**
+   * Like FindPositiveArrival(const AGeoPoint &), but look up the
+   * result in the table calculated by SolveReach() first.
+   *
+   * @param id the id which was used to add the destination to the
+   * #ArrivalTable
+   */
+  [[gnu::pure]]
+  std::optional<ReachResult> FindPositiveArrival(const AGeoPoint &dest,
+                                                 unsigned id) const noexcept;
+
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor,
                      bool working) const noexcept;
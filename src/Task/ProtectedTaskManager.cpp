@@ -151,12 +151,13 @@ ProtectedTaskManager::SetRoutePlanner(const ProtectedRoutePlanner *_route) noexc
 }
 
 bool
-ReachIntersectionTest::Intersects(const AGeoPoint &destination) const noexcept
+ReachIntersectionTest::Intersects(const AGeoPoint &destination,
+                                  unsigned waypoint_id) const noexcept
 {
   if (!route)
     return false;
 
-  const auto result = route->FindPositiveArrival(destination);
+  const auto result = route->FindPositiveArrival(destination, waypoint_id);
   if (!result)
     return false;
 
@@ -27,7 +27,8 @@ public:
     route = _route;
   }
 
-  virtual bool Intersects(const AGeoPoint &destination) const noexcept;
+  virtual bool Intersects(const AGeoPoint &destination,
+                          unsigned waypoint_id) const noexcept;
 };
 
 /**
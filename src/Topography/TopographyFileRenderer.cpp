@@ -184,6 +184,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #else // !ENABLE_OPENGL
   const GeoClip clip(projection.GetScreenBounds().Scale(1.1));
   AllocatedArray<GeoPoint> geo_points;
+  AllocatedArray<BulkPixelPoint> screen_points;
 
   const unsigned iskip = file.GetSkipSteps(map_scale);
 #endif
@@ -234,14 +235,17 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         }
 #else // !ENABLE_OPENGL
         for (unsigned msize : lines) {
+        screen_points.GrowDiscard(msize);
+        projection.GeoToScreen({points, msize}, screen_points.data());
+        points += msize;
+
         shape_renderer.Begin(msize);
 
-        const GeoPoint *end = points + msize - 1;
-        for (; points < end; ++points)
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
+        for (unsigned i = 0; i + 1 < msize; ++i)
+          shape_renderer.AddPointIfDistant((PixelPoint)screen_points[i]);
 
         // make sure we always draw the last point
-        shape_renderer.AddPoint(projection.GeoToScreen(*points));
+        shape_renderer.AddPoint((PixelPoint)screen_points[msize - 1]);
 
         shape_renderer.FinishPolyline(canvas);
       }
@@ -292,12 +296,14 @@ TopographyFileRenderer::Paint(Canvas &canvas,
           if (msize < 3)
             continue;
 
+          screen_points.GrowDiscard(msize);
+          projection.GeoToScreen({geo_points.data(), msize},
+                                 screen_points.data());
+
           shape_renderer.Begin(msize);
 
-          for (unsigned i = 0; i < msize; ++i) {
-            GeoPoint g = geo_points[i];
-            shape_renderer.AddPointIfDistant(projection.GeoToScreen(g));
-          }
+          for (unsigned i = 0; i < msize; ++i)
+            shape_renderer.AddPointIfDistant((PixelPoint)screen_points[i]);
 
           shape_renderer.FinishPolygon(canvas);
 
@@ -157,6 +157,7 @@ SettingsLeave(const UISettings &old_ui_settings)
     airspace_database.Clear();
     ReadAirspace(airspace_database,
                  CommonInterface::GetComputerSettings().pressure,
+                 file_cache,
                  operation);
 
     if (data_components->terrain)
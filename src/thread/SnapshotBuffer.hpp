@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Publishes snapshots of an object from one writer thread to any
+ * number of reader threads without locks.
+ *
+ * The object is kept in #N slots.  Each slot has a reader count;
+ * Publish() copies the new value into a slot which is neither the
+ * current one nor in use by a reader, and then makes it current.
+ * Readers pin the current slot, verify that it is still current and
+ * copy it.  Neither side ever waits for the other: a reader which
+ * loses a race with the writer simply retries, and the writer skips a
+ * publication if all other slots are pinned (which cannot happen with
+ * fewer than N-1 concurrent readers).
+ *
+ * All atomic operations are sequentially consistent; the algorithm
+ * relies on the total order between a reader incrementing a counter
+ * and the writer checking it.
+ *
+ * @param T a trivially copyable type
+ * @param N the number of slots; at least the number of concurrent
+ * readers plus two
+ */
+template<typename T, unsigned N>
+class SnapshotBuffer {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(N >= 3);
+
+  struct Slot {
+    mutable std::atomic_uint readers{0};
+
+    /**
+     * The sequence number of #value.
+     */
+    uint32_t sequence = 0;
+
+    T value{};
+  };
+
+  std::array<Slot, N> slots;
+
+  /**
+   * The index of the slot holding the most recent value.
+   */
+  std::atomic_uint current{0};
+
+  /**
+   * The number of values published so far.  Only written by the
+   * writer.
+   */
+  std::atomic_uint32_t sequence{0};
+
+  /* statistics */
+  std::atomic_uint32_t skipped{0};
+  mutable std::atomic_uint32_t reads{0}, read_retries{0};
+
+public:
+  struct Statistics {
+    /**
+     * The number of successful Publish() calls.
+     */
+    uint32_t publications;
+
+    /**
+     * The number of Publish() calls which found no free slot.
+     */
+    uint32_t skipped;
+
+    /**
+     * The number of Read() calls, and the number of times a reader
+     * had to retry because the writer was faster.
+     */
+    uint32_t reads, read_retries;
+  };
+
+  SnapshotBuffer() noexcept = default;
+
+  SnapshotBuffer(const SnapshotBuffer &) = delete;
+  SnapshotBuffer &operator=(const SnapshotBuffer &) = delete;
+
+  /**
+   * Publish a new value.  Must only be called by the writer thread.
+   *
+   * @return false if no slot was available; the value was not
+   * published
+   */
+  bool Publish(const T &value) noexcept {
+    const unsigned old = current.load();
+
+    for (unsigned i = 0; i < N; ++i) {
+      if (i == old || slots[i].readers.load() != 0)
+        continue;
+
+      /* a reader may still increment this counter (because it has
+         loaded an old #current value), but it will notice that the
+         slot is not current and back off without accessing the
+         value */
+      const uint32_t new_sequence = sequence.load() + 1;
+      slots[i].sequence = new_sequence;
+      slots[i].value = value;
+      current.store(i);
+      sequence.store(new_sequence);
+      return true;
+    }
+
+    skipped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Copy the most recent value.  May be called from any thread.
+   * Before the first Publish(), this is a value-initialised object.
+   *
+   * @return the sequence number of the value (0 before the first
+   * Publish())
+   */
+  uint32_t Read(T &dest) const noexcept {
+    reads.fetch_add(1, std::memory_order_relaxed);
+
+    while (true) {
+      const unsigned i = current.load();
+      const Slot &slot = slots[i];
+
+      slot.readers.fetch_add(1);
+      if (current.load() == i) {
+        dest = slot.value;
+        const uint32_t result = slot.sequence;
+        slot.readers.fetch_sub(1);
+        return result;
+      }
+
+      slot.readers.fetch_sub(1);
+      read_retries.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Returns the number of values published so far.  Readers can
+   * compare it with the return value of an earlier Read() to skip
+   * copying an unchanged value.  It is updated after the new value
+   * has become visible to Read().
+   */
+  uint32_t GetSequence() const noexcept {
+    return sequence.load();
+  }
+
+  Statistics GetStatistics() const noexcept {
+    return {
+      sequence.load(std::memory_order_relaxed),
+      skipped.load(std::memory_order_relaxed),
+      reads.load(std::memory_order_relaxed),
+      read_retries.load(std::memory_order_relaxed),
+    };
+  }
+};
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ThreadPool.hpp"
+#include "Thread.hpp"
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <sysinfoapi.h>
+#endif
+
+#include <cassert>
+#include <utility>
+
+class ThreadPool::Worker final : public Thread {
+  ThreadPool &pool;
+
+public:
+  explicit Worker(ThreadPool &_pool) noexcept
+    :Thread("ThreadPool"), pool(_pool) {}
+
+protected:
+  void Run() noexcept override {
+    pool.Work();
+  }
+};
+
+ThreadPool::ThreadPool(unsigned concurrency)
+{
+  assert(concurrency > 0);
+
+  try {
+    for (unsigned i = 1; i < concurrency; ++i) {
+      auto worker = std::make_unique<Worker>(*this);
+      worker->Start();
+      workers.push_back(std::move(worker));
+    }
+  } catch (...) {
+    Stop();
+    throw;
+  }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+  Stop();
+}
+
+unsigned
+ThreadPool::GetDefaultConcurrency() noexcept
+{
+#ifdef HAVE_POSIX
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? unsigned(n) : 1;
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#endif
+}
+
+void
+ThreadPool::Stop() noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    stop = true;
+    command_cond.notify_all();
+  }
+
+  for (auto &worker : workers)
+    worker->Join();
+
+  workers.clear();
+}
+
+void
+ThreadPool::RunJobs([[maybe_unused]] std::unique_lock<Mutex> &lock) noexcept
+{
+  ++busy;
+
+  while (next < n_jobs) {
+    const std::size_t i = next++;
+    const auto &f = *job;
+
+    std::exception_ptr e;
+
+    {
+      const ScopeUnlock unlock{mutex};
+
+      try {
+        f(i);
+      } catch (...) {
+        e = std::current_exception();
+      }
+    }
+
+    if (e) {
+      if (!error)
+        error = std::move(e);
+
+      /* skip the remaining jobs */
+      next = n_jobs;
+    }
+  }
+
+  if (--busy == 0)
+    done_cond.notify_all();
+}
+
+void
+ThreadPool::ParallelFor(std::size_t n,
+                        const std::function<void(std::size_t)> &f)
+{
+  if (n == 0)
+    return;
+
+  if (workers.empty() || n == 1) {
+    /* no need to involve the worker threads */
+    for (std::size_t i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  std::unique_lock lock{mutex};
+  assert(job == nullptr);
+
+  job = &f;
+  n_jobs = n;
+  next = 0;
+  ++generation;
+  command_cond.notify_all();
+
+  RunJobs(lock);
+
+  done_cond.wait(lock, [this]{ return busy == 0; });
+
+  job = nullptr;
+  n_jobs = next = 0;
+
+  if (error)
+    std::rethrow_exception(std::exchange(error, {}));
+}
+
+void
+ThreadPool::Work() noexcept
+{
+  std::unique_lock lock{mutex};
+
+  unsigned seen_generation = generation;
+
+  while (true) {
+    command_cond.wait(lock, [this, seen_generation]{
+      return stop || generation != seen_generation;
+    });
+
+    if (stop)
+      break;
+
+    seen_generation = generation;
+    RunJobs(lock);
+  }
+}
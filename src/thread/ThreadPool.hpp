@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * A fixed set of worker threads which process batches of independent
+ * jobs.  The thread which submits a batch participates in processing
+ * it, therefore a pool with a concurrency of 1 has no worker threads
+ * and runs everything synchronously.
+ */
+class ThreadPool {
+  class Worker;
+
+  Mutex mutex;
+
+  /**
+   * Signalled when a new batch is submitted or when the pool shall
+   * stop.
+   */
+  Cond command_cond;
+
+  /**
+   * Signalled when the last busy thread finishes its work.
+   */
+  Cond done_cond;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  /**
+   * The job function of the current batch.  Only valid while
+   * #next is smaller than #n_jobs.
+   */
+  const std::function<void(std::size_t)> *job = nullptr;
+
+  /**
+   * The number of jobs in the current batch, and the index of the
+   * next one to be picked up.
+   */
+  std::size_t n_jobs = 0, next = 0;
+
+  /**
+   * Incremented for each new batch; this is how workers detect that
+   * there is new work.
+   */
+  unsigned generation = 0;
+
+  /**
+   * The number of threads currently inside RunJobs().
+   */
+  unsigned busy = 0;
+
+  /**
+   * The first exception thrown by a job of the current batch.
+   */
+  std::exception_ptr error;
+
+  bool stop = false;
+
+public:
+  /**
+   * Throws on error.
+   *
+   * @param concurrency the total number of threads working on a
+   * batch, including the calling thread
+   */
+  explicit ThreadPool(unsigned concurrency);
+
+  /**
+   * Stops and joins all worker threads.
+   */
+  ~ThreadPool() noexcept;
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Returns the number of processors available to this process,
+   * which is a good default for the constructor.
+   */
+  [[gnu::const]]
+  static unsigned GetDefaultConcurrency() noexcept;
+
+  unsigned GetConcurrency() const noexcept {
+    return workers.size() + 1;
+  }
+
+  /**
+   * Invoke f(i) for each i in [0, n), distributed over all threads
+   * of this pool, and wait for completion.  The order of invocation
+   * is unspecified.  The function must be thread-safe.
+   *
+   * If a job throws, the jobs which have not been started yet are
+   * skipped, and after all running jobs have finished, the first
+   * exception is rethrown.
+   *
+   * Must not be called from inside a job, and only one thread may
+   * submit batches at a time.
+   */
+  void ParallelFor(std::size_t n,
+                   const std::function<void(std::size_t)> &f);
+
+private:
+  void Stop() noexcept;
+
+  /**
+   * Pick up jobs from the current batch until there are none left.
+   *
+   * Caller must lock the mutex.
+   */
+  void RunJobs(std::unique_lock<Mutex> &lock) noexcept;
+
+  /**
+   * The main loop of a #Worker.
+   */
+  void Work() noexcept;
+};
@@ -6,6 +6,7 @@
 #include "ui/canvas/Util.hpp"
 #include "Optimised.hpp"
 #include "RasterCanvas.hpp"
+#include "TiledRenderer.hpp"
 #include "ui/canvas/custom/Cache.hpp"
 #include "Math/Angle.hpp"
 
@@ -39,9 +40,20 @@ public:
   }
 };
 
+void
+Canvas::FlushTiledRenderer() noexcept
+{
+  tiled_renderer->Flush(buffer);
+}
+
 void
 Canvas::DrawOutlineRectangle(PixelRect r, Color color) noexcept
 {
+  if (tiled_renderer != nullptr) {
+    tiled_renderer->OutlineRectangle(r, SDLRasterCanvas::Import(color));
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.DrawRectangle(r.left, r.top, r.right, r.bottom,
                        canvas.Import(color));
@@ -53,6 +65,11 @@ Canvas::DrawFilledRectangle(PixelRect r, Color color) noexcept
   if (r.IsEmpty())
     return;
 
+  if (tiled_renderer != nullptr) {
+    tiled_renderer->FillRectangle(r, SDLRasterCanvas::Import(color));
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.FillRectangle(r.left, r.top, r.right, r.bottom,
                        canvas.Import(color));
@@ -83,6 +100,13 @@ DrawPolyline(Canvas &canvas, [[maybe_unused]] PixelOperations operations, const
 void
 Canvas::DrawPolyline(const BulkPixelPoint *p, unsigned cPoints)
 {
+  if (tiled_renderer != nullptr) {
+    tiled_renderer->DrawPolyline(p, cPoints, false,
+                                 SDLRasterCanvas::Import(pen.GetColor()),
+                                 pen.GetWidth(), pen.GetMask());
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   ::DrawPolyline(canvas, ActivePixelTraits(), pen,
                  p, cPoints, false);
@@ -94,6 +118,19 @@ Canvas::DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints)
   if (brush.IsHollow() && !pen.IsDefined())
     return;
 
+  if (tiled_renderer != nullptr) {
+    if (!brush.IsHollow())
+      tiled_renderer->FillPolygon(lppt, cPoints,
+                                  SDLRasterCanvas::Import(brush.GetColor()),
+                                  brush.GetColor().Alpha());
+
+    if (IsPenOverBrush())
+      tiled_renderer->DrawPolyline(lppt, cPoints, true,
+                                   SDLRasterCanvas::Import(pen.GetColor()),
+                                   pen.GetWidth(), pen.GetMask());
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
 
   if (!brush.IsHollow()) {
@@ -113,6 +150,11 @@ Canvas::DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints)
 void
 Canvas::DrawHLine(int x1, int x2, int y, Color color)
 {
+  if (tiled_renderer != nullptr) {
+    tiled_renderer->DrawHLine(x1, x2, y, SDLRasterCanvas::Import(color));
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.DrawHLine(x1, x2, y, canvas.Import(color));
 }
@@ -123,6 +165,12 @@ Canvas::DrawLine(PixelPoint a, PixelPoint b) noexcept
   const unsigned thickness = pen.GetWidth();
   const unsigned mask = pen.GetMask();
 
+  if (tiled_renderer != nullptr) {
+    tiled_renderer->DrawLine(a, b, SDLRasterCanvas::Import(pen.GetColor()),
+                             thickness, mask);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   const auto color = canvas.Import(pen.GetColor());
   if (thickness > 1) {
@@ -136,6 +184,19 @@ Canvas::DrawLine(PixelPoint a, PixelPoint b) noexcept
 void
 Canvas::DrawCircle(PixelPoint center, unsigned radius) noexcept
 {
+  if (tiled_renderer != nullptr) {
+    if (!brush.IsHollow())
+      tiled_renderer->FillCircle(center, radius,
+                                 SDLRasterCanvas::Import(brush.GetColor()),
+                                 brush.GetColor().Alpha());
+
+    if (IsPenOverBrush())
+      tiled_renderer->DrawCircle(center, radius,
+                                 SDLRasterCanvas::Import(pen.GetColor()),
+                                 pen.GetWidth());
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
 
   if (!brush.IsHollow()) {
@@ -278,6 +339,7 @@ Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
   if (!s)
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   CopyTextRectangle(canvas, p.x, p.y, s.size.width, s.size.height, s,
                     text_color, background_color,
@@ -295,6 +357,7 @@ Canvas::DrawTransparentText(PixelPoint p, tstring_view text) noexcept
   if (s.data == nullptr)
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   ColoredAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
     transparent(canvas.Import(text_color));
@@ -325,6 +388,7 @@ Canvas::DrawClippedText(PixelPoint p, unsigned width,
   if (width > s.size.width)
     width = s.size.width;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   CopyTextRectangle(canvas, p.x, p.y, width, s.size.height, s,
                     text_color, background_color,
@@ -362,6 +426,7 @@ Canvas::Copy(PixelPoint dest_position, PixelSize dest_size,
       !Clip(dest_position.y, dest_size.height, GetHeight(), src_position.y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   canvas.CopyRectangle(dest_position.x, dest_position.y,
                        dest_size.width, dest_size.height,
@@ -404,6 +469,7 @@ Canvas::CopyTransparentWhite(PixelPoint dest_position, PixelSize dest_size,
       !Clip(dest_position.y, dest_size.height, GetHeight(), src_position.y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   TransparentPixelOperations<ActivePixelTraits> operations(canvas.Import(COLOR_WHITE));
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -422,6 +488,7 @@ Canvas::StretchTransparentWhite(PixelPoint dest_position, PixelSize dest_size,
       !Clip(dest_position.y, dest_size.height, GetHeight(), src_position.y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   TransparentPixelOperations<ActivePixelTraits> operations(canvas.Import(COLOR_WHITE));
   canvas.ScaleRectangle(dest_position, dest_size,
@@ -440,6 +507,7 @@ Canvas::StretchNot(const Bitmap &_src)
   const unsigned dest_x = 0, dest_y = 0;
   const auto dest_size = GetSize();
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   BitNotPixelOperations<ActivePixelTraits> operations;
 
@@ -460,6 +528,7 @@ Canvas::Stretch(PixelPoint dest_position, PixelSize dest_size,
     return;
   }
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.ScaleRectangle(dest_position, dest_size,
@@ -515,6 +584,7 @@ Canvas::StretchMono(PixelPoint dest_position, PixelSize dest_size,
     /* paranoid sanity check; shouldn't ever happen */
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   OpaqueTextPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
@@ -530,6 +600,7 @@ void
 Canvas::CopyNot(PixelPoint dest_position, PixelSize dest_size,
                 ConstImageBuffer src, PixelPoint src_position) noexcept
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -542,6 +613,7 @@ void
 Canvas::CopyOr(PixelPoint dest_position, PixelSize dest_size,
                ConstImageBuffer src, PixelPoint src_position) noexcept
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -554,6 +626,7 @@ void
 Canvas::CopyNotOr(PixelPoint dest_position, PixelSize dest_size,
                   ConstImageBuffer src, PixelPoint src_position) noexcept
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -575,6 +648,7 @@ void
 Canvas::CopyAnd(PixelPoint dest_position, PixelSize dest_size,
                 ConstImageBuffer src, PixelPoint src_position) noexcept
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -631,6 +705,7 @@ Canvas::AlphaBlend(PixelPoint dest_position, PixelSize dest_size,
 {
   // TODO: support scaling
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   AlphaPixelOperations<ActivePixelTraits> operations(alpha);
@@ -660,6 +735,7 @@ Canvas::AlphaBlendNotWhite(PixelPoint dest_position, PixelSize dest_size,
 {
   // TODO: support scaling
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   NotWhiteCondition<ActivePixelTraits> c;
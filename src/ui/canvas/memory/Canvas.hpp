@@ -25,6 +25,7 @@
 
 class Angle;
 class Bitmap;
+class TiledRenderer;
 
 /**
  * Base drawable canvas class
@@ -46,6 +47,12 @@ protected:
     OPAQUE, TRANSPARENT
   } background_mode = OPAQUE;
 
+  /**
+   * If set, vector drawing operations are recorded here instead of
+   * being drawn immediately.  See SetTiledRenderer().
+   */
+  TiledRenderer *tiled_renderer = nullptr;
+
 public:
   Canvas()
     :buffer(WritableImageBuffer<ActivePixelTraits>::Empty()) {}
@@ -57,6 +64,33 @@ public:
     buffer = _buffer;
   }
 
+  /**
+   * Defer lines, polygons, circles and rectangles to the given
+   * #TiledRenderer, which rasterises them in parallel.  They are
+   * flushed automatically before any other operation which accesses
+   * the pixels (text, bitmaps, copies); callers must call
+   * FlushDeferred() before the buffer is used elsewhere (e.g. as the
+   * source of another canvas's Copy()).
+   *
+   * @param _tiled_renderer the renderer, or nullptr to flush and go
+   * back to immediate drawing
+   */
+  void SetTiledRenderer(TiledRenderer *_tiled_renderer) noexcept {
+    FlushDeferred();
+    tiled_renderer = _tiled_renderer;
+  }
+
+  /**
+   * Draw all operations deferred by SetTiledRenderer().
+   */
+  void FlushDeferred() noexcept {
+    if (tiled_renderer != nullptr)
+      FlushTiledRenderer();
+  }
+
+private:
+  void FlushTiledRenderer() noexcept;
+
 protected:
   /**
    * Returns true if the outline should be drawn after the area has
@@ -8,6 +8,7 @@
 
 #include <math.h>
 #include <array>
+#include <cassert>
 #include <cstdint>
 #include <utility>
 
@@ -8,9 +8,14 @@
 #include "Bresenham.hpp"
 #include "Murphy.hpp"
 #include "ui/dim/Point.hpp"
+#include "ui/dim/Rect.hpp"
 #include "util/AllocatedArray.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
 
 /*
   line_masks:
@@ -44,13 +49,38 @@ public:
 private:
   WritableImageBuffer<PixelTraits> buffer;
 
+  /**
+   * Pixels outside of this rectangle are not modified.  Unlike the
+   * buffer boundaries, this does not affect the geometry of lines and
+   * polygons (they are still clipped against the whole buffer); it is
+   * applied to each pixel, which means that drawing the same
+   * primitives with several disjoint clip rectangles produces exactly
+   * the same result as drawing them once without one.  This is what
+   * #TiledRenderer relies on.
+   *
+   * CopyRectangle() and ScaleRectangle() ignore it.
+   */
+  PixelRect clip;
+
   AllocatedArray<int> polygon_buffer;
   AllocatedArray<BresenhamIterator> edge_buffer;
 
 public:
   RasterCanvas(WritableImageBuffer<PixelTraits> _buffer,
                PixelTraits _traits=PixelTraits()) noexcept
-    :PixelTraits(_traits), buffer(_buffer) {}
+    :PixelTraits(_traits), buffer(_buffer), clip(_buffer.size) {}
+
+  /**
+   * Restrict all subsequent vector drawing operations to the given
+   * rectangle, which must be inside the buffer.
+   */
+  void SetClip(PixelRect _clip) noexcept {
+    assert(_clip.left >= 0 && _clip.top >= 0);
+    assert(unsigned(_clip.right) <= buffer.size.width);
+    assert(unsigned(_clip.bottom) <= buffer.size.height);
+
+    clip = _clip;
+  }
 
 protected:
   PixelTraits &GetPixelTraits() noexcept {
@@ -61,8 +91,26 @@ protected:
     return GetPixelTraits();
   }
 
-  constexpr bool Check(unsigned x, unsigned y) const noexcept {
-    return buffer.Check(x, y);
+  constexpr bool Check(int x, int y) const noexcept {
+    return clip.Contains(PixelPoint{x, y});
+  }
+
+  /**
+   * Is the given rectangle (inclusive coordinates, in any order)
+   * completely inside the clip rectangle?
+   */
+  constexpr bool ClipContains(int x1, int y1, int x2, int y2) const noexcept {
+    return std::min(x1, x2) >= clip.left && std::max(x1, x2) < clip.right &&
+      std::min(y1, y2) >= clip.top && std::max(y1, y2) < clip.bottom;
+  }
+
+  /**
+   * Does the given rectangle (inclusive coordinates, in any order)
+   * overlap with the clip rectangle?
+   */
+  constexpr bool ClipOverlaps(int x1, int y1, int x2, int y2) const noexcept {
+    return std::max(x1, x2) >= clip.left && std::min(x1, x2) < clip.right &&
+      std::max(y1, y2) >= clip.top && std::min(y1, y2) < clip.bottom;
   }
 
   pointer At(unsigned x, unsigned y) noexcept {
@@ -246,17 +294,17 @@ public:
   template<AnyFillPixelOperation PixelOperations>
   void FillRectangle(int x1, int y1, int x2, int y2, color_type c,
                      PixelOperations operations) noexcept {
-    if (x1 < 0)
-      x1 = 0;
+    if (x1 < clip.left)
+      x1 = clip.left;
 
-    if (y1 < 0)
-      y1 = 0;
+    if (y1 < clip.top)
+      y1 = clip.top;
 
-    if (x2 > int(buffer.size.width))
-      x2 = buffer.size.width;
+    if (x2 > clip.right)
+      x2 = clip.right;
 
-    if (y2 > int(buffer.size.height))
-      y2 = buffer.size.height;
+    if (y2 > clip.bottom)
+      y2 = clip.bottom;
 
     if (x1 >= x2 || y1 >= y2)
       return;
@@ -276,14 +324,14 @@ public:
   template<AnyFillPixelOperation PixelOperations>
   void DrawHLine(int x1, int x2, int y, color_type c,
                  PixelOperations operations) noexcept {
-    if (y < 0 || unsigned(y) >= buffer.size.height)
+    if (y < clip.top || y >= clip.bottom)
       return;
 
-    if (x1 < 0)
-      x1 = 0;
+    if (x1 < clip.left)
+      x1 = clip.left;
 
-    if (x2 > int(buffer.size.width))
-      x2 = buffer.size.width;
+    if (x2 > clip.right)
+      x2 = clip.right;
 
     if (x1 >= x2)
       return;
@@ -300,14 +348,14 @@ public:
   template<AnyWritePixelOperation PixelOperations>
   void DrawVLine(int x, int y1, int y2, color_type c,
                  PixelOperations operations) noexcept {
-    if (x < 0 || unsigned(x) >= buffer.size.width)
+    if (x < clip.left || x >= clip.right)
       return;
 
-    if (y1 < 0)
-      y1 = 0;
+    if (y1 < clip.top)
+      y1 = clip.top;
 
-    if (y2 > int(buffer.size.height))
-      y2 = buffer.size.height;
+    if (y2 > clip.bottom)
+      y2 = clip.bottom;
 
     if (y1 >= y2)
       return;
@@ -345,6 +393,12 @@ public:
     dx = sx * dx + 1;
     dy = sy * dy + 1;
 
+    if (!ClipContains(x1, y1, x2, y2)) {
+      DrawLineClipped(x1, y1, x2, y2, sx, sy, dx, dy, c,
+                      line_mask, line_mask_position);
+      return;
+    }
+
     pointer p = At(x1, y1);
 
     std::ptrdiff_t pixx = PixelTraits::CalcIncrement(sx) * sizeof(*p);
@@ -371,6 +425,91 @@ public:
     line_mask_position = lmp;
   }
 
+private:
+  /**
+   * Determine the range of Bresenham steps [begin, end) which keep a
+   * coordinate inside [lo, hi).  After i steps, the coordinate has
+   * moved by floor(i * d_minor / d_major) pixels in the direction
+   * #step (for the major axis, d_minor equals d_major).
+   */
+  static constexpr std::pair<int, int>
+  StepRange(int start, int step, int lo, int hi,
+            int d_minor, int d_major) noexcept {
+    /* the range of the number of pixels moved */
+    int k_begin, k_end;
+    if (step > 0) {
+      k_begin = lo - start;
+      k_end = hi - start;
+    } else {
+      k_begin = start - hi + 1;
+      k_end = start - lo + 1;
+    }
+
+    /* the first step after which at least k pixels were moved is
+       ceil(k * d_major / d_minor) */
+    const auto k_to_i = [d_minor, d_major](int k) -> int {
+      return k <= 0
+        ? 0
+        : int((int64_t(k) * d_major + d_minor - 1) / d_minor);
+    };
+
+    return {k_to_i(k_begin), k_to_i(k_end)};
+  }
+
+  /**
+   * The slow path of DrawLineDirect() for lines which are not
+   * completely inside the clip rectangle: skips the steps outside of
+   * it, and draws the same pixels as DrawLineDirect() inside of it.
+   */
+  void DrawLineClipped(int x1, int y1, int x2, int y2,
+                       int sx, int sy, int dx, int dy,
+                       color_type c, unsigned line_mask,
+                       unsigned &line_mask_position) noexcept {
+    const bool x_major = dx >= dy;
+    const int d_major = x_major ? dx : dy, d_minor = x_major ? dy : dx;
+    const int s_major = x_major ? sx : sy, s_minor = x_major ? sy : sx;
+
+    const unsigned lmp_begin = line_mask_position;
+    /* keep the line mask position in sync even if nothing is drawn */
+    line_mask_position += d_major;
+
+    if (!ClipOverlaps(x1, y1, x2, y2))
+      return;
+
+    const auto [major_begin, major_end] = x_major
+      ? StepRange(x1, sx, clip.left, clip.right, d_major, d_major)
+      : StepRange(y1, sy, clip.top, clip.bottom, d_major, d_major);
+    const auto [minor_begin, minor_end] = x_major
+      ? StepRange(y1, sy, clip.top, clip.bottom, d_minor, d_major)
+      : StepRange(x1, sx, clip.left, clip.right, d_minor, d_major);
+
+    const int begin = std::max(major_begin, minor_begin);
+    const int end = std::min({major_end, minor_end, d_major});
+    if (begin >= end)
+      return;
+
+    /* fast-forward the Bresenham state to the first visible step */
+    const int64_t acc = int64_t(begin) * d_minor;
+    int major = (x_major ? x1 : y1) + s_major * begin;
+    int minor = (x_major ? y1 : x1) + s_minor * int(acc / d_major);
+    int e = acc % d_major;
+    unsigned lmp = lmp_begin + begin;
+
+    for (int i = begin; i < end; ++i, major += s_major) {
+      const int x = x_major ? major : minor;
+      const int y = x_major ? minor : major;
+      if ((lmp++ | line_mask) == unsigned(-1) && Check(x, y))
+        PixelTraits::WritePixel(At(x, y), c);
+
+      e += d_minor;
+      if (e >= d_major) {
+        e -= d_major;
+        minor += s_minor;
+      }
+    }
+  }
+
+public:
   void DrawLine(int x1, int y1, int x2, int y2, color_type c,
                 unsigned line_mask=-1) noexcept {
     /* optimised Bresenham algorithm */
@@ -396,6 +535,15 @@ public:
       return;
     }
 
+    /* skip segments which are far away from the clip rectangle, but
+       advance the line mask position like MurphyIterator does */
+    const int margin = thickness + 1;
+    if (!ClipOverlaps(std::min(x1, x2) - margin, std::min(y1, y2) - margin,
+                      std::max(x1, x2) + margin, std::max(y1, y2) + margin)) {
+      line_mask_position += std::max(std::abs(x2 - x1), std::abs(y2 - y1));
+      return;
+    }
+
     MurphyIterator murphy(*this, c, line_mask,
                           line_mask_position);
     murphy.Wideline({x1, y1}, {x2, y2}, thickness, 0);
@@ -494,6 +642,12 @@ public:
     if (n_edges < 2)
       return;
 
+    /* skip rows outside the clip rectangle; AdvanceTo() moves each
+       edge to the same position as stepping row by row would, and
+       the spans of a row only depend on these positions */
+    miny = std::max(miny, clip.top);
+    maxy = std::min(maxy, clip.bottom - 1);
+
     auto edge_start = edge_buffer.begin();
     auto edge_end = edge_start+n_edges;
 
@@ -577,8 +731,9 @@ public:
         maxy = points[i].y;
     }
 
-    // Draw, scanning y
-    for (int y = miny; y <= maxy; y++) {
+    // Draw, scanning y (only the rows inside the clip rectangle)
+    const int y_end = std::min(maxy, clip.bottom - 1);
+    for (int y = std::max(miny, clip.top); y <= y_end; y++) {
       unsigned n_ints = 0;
       for (unsigned i = 0; i < n; i++) {
         unsigned ind1, ind2;
@@ -641,20 +796,8 @@ public:
 
     /* Get circle and clipping boundary and test if bounding box of
        circle is visible */
-    const int x2 = x + rad;
-    if (x2 < 0)
-      return;
-
-    const int x1 = x - rad;
-    if (x1 >= int(buffer.size.width))
-      return;
-
-    const int y2 = y + rad;
-    if (y2 < 0)
-      return;
-
-    const int y1 = y - rad;
-    if (y1 >= int(buffer.size.height))
+    if (x + int(rad) < clip.left || x - int(rad) >= clip.right ||
+        y + int(rad) < clip.top || y - int(rad) >= clip.bottom)
       return;
 
     // draw
@@ -723,20 +866,8 @@ public:
 
     /* Get circle and clipping boundary and test if bounding box of
        circle is visible */
-    const int x2 = x + rad;
-    if (x2 < 0)
-      return;
-
-    const int x1 = x - rad;
-    if (x1 >= int(buffer.size.width))
-      return;
-
-    const int y2 = y + rad;
-    if (y2 < 0)
-      return;
-
-    const int y1 = y - rad;
-    if (y1 >= int(buffer.size.height))
+    if (x + int(rad) < clip.left || x - int(rad) >= clip.right ||
+        y + int(rad) < clip.top || y - int(rad) >= clip.bottom)
       return;
 
     // draw
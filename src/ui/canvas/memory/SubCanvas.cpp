@@ -15,6 +15,9 @@ ClipMax(unsigned limit, int offset, unsigned size) noexcept
 SubCanvas::SubCanvas(Canvas &canvas,
                      PixelPoint _offset, PixelSize _size) noexcept
 {
+  /* the parent's deferred operations must not be drawn after ours */
+  canvas.FlushDeferred();
+
   buffer = canvas.buffer;
   buffer.data = buffer.At(_offset.x, _offset.y);
   buffer.size.width = ClipMax(buffer.size.width, _offset.x, _size.width);
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TiledRenderer.hpp"
+#include "RasterCanvas.hpp"
+#include "Optimised.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using TileCanvas = RasterCanvas<ActivePixelTraits>;
+
+TiledRenderer::Operation &
+TiledRenderer::Add(Type type, const BulkPixelPoint *p, unsigned n,
+                   color_type color, int margin) noexcept
+{
+  assert(n > 0);
+
+  int left = p[0].x, top = p[0].y, right = p[0].x, bottom = p[0].y;
+  for (unsigned i = 1; i < n; ++i) {
+    left = std::min(left, p[i].x);
+    top = std::min(top, p[i].y);
+    right = std::max(right, p[i].x);
+    bottom = std::max(bottom, p[i].y);
+  }
+
+  auto &op = operations.emplace_back();
+  op.bounds = PixelRect{left - margin, top - margin,
+                        right + 1 + margin, bottom + 1 + margin};
+  op.first_point = points.size();
+  op.n_points = n;
+  op.color = color;
+  op.width = op.radius = 0;
+  op.mask = unsigned(-1);
+  op.type = type;
+  op.alpha = 0xff;
+  op.loop = false;
+
+  points.insert(points.end(), p, p + n);
+
+  ++statistics.operations;
+  return op;
+}
+
+void
+TiledRenderer::FillRectangle(PixelRect r, color_type color) noexcept
+{
+  const BulkPixelPoint p[2] = { r.GetTopLeft(), r.GetBottomRight() };
+  Add(Type::FILL_RECTANGLE, p, 2, color, 0);
+}
+
+void
+TiledRenderer::OutlineRectangle(PixelRect r, color_type color) noexcept
+{
+  const BulkPixelPoint p[2] = { r.GetTopLeft(), r.GetBottomRight() };
+  Add(Type::OUTLINE_RECTANGLE, p, 2, color, 0);
+}
+
+void
+TiledRenderer::DrawHLine(int x1, int x2, int y, color_type color) noexcept
+{
+  const BulkPixelPoint p[2] = { {x1, y}, {x2, y} };
+  Add(Type::HLINE, p, 2, color, 0);
+}
+
+void
+TiledRenderer::DrawLine(PixelPoint a, PixelPoint b, color_type color,
+                        unsigned width, unsigned mask) noexcept
+{
+  const BulkPixelPoint p[2] = { a, b };
+  auto &op = Add(Type::LINE, p, 2, color, width + 1);
+  op.width = width;
+  op.mask = mask;
+}
+
+void
+TiledRenderer::DrawPolyline(const BulkPixelPoint *p, unsigned n, bool loop,
+                            color_type color,
+                            unsigned width, unsigned mask) noexcept
+{
+  if (n == 0)
+    return;
+
+  auto &op = Add(Type::POLYLINE, p, n, color, width + 1);
+  op.width = width;
+  op.mask = mask;
+  op.loop = loop;
+}
+
+void
+TiledRenderer::FillPolygon(const BulkPixelPoint *p, unsigned n,
+                           color_type color, uint8_t alpha) noexcept
+{
+  if (n < 3)
+    return;
+
+  auto &op = Add(Type::POLYGON, p, n, color, 1);
+  op.alpha = alpha;
+}
+
+void
+TiledRenderer::FillCircle(PixelPoint center, unsigned radius,
+                          color_type color, uint8_t alpha) noexcept
+{
+  const BulkPixelPoint p = center;
+  auto &op = Add(Type::FILL_CIRCLE, &p, 1, color, radius + 1);
+  op.radius = radius;
+  op.alpha = alpha;
+}
+
+void
+TiledRenderer::DrawCircle(PixelPoint center, unsigned radius,
+                          color_type color, unsigned width) noexcept
+{
+  const BulkPixelPoint p = center;
+  auto &op = Add(Type::CIRCLE, &p, 1, color, radius + width + 1);
+  op.radius = radius;
+  op.width = width;
+}
+
+/**
+ * Replay one operation exactly like the immediate code path in
+ * Canvas.cpp does.
+ */
+void
+TiledRenderer::Replay(auto &canvas, const Operation &op) const noexcept
+{
+  const BulkPixelPoint *p = points.data() + op.first_point;
+
+  switch (op.type) {
+  case Type::FILL_RECTANGLE:
+    canvas.FillRectangle(p[0].x, p[0].y, p[1].x, p[1].y, op.color);
+    break;
+
+  case Type::OUTLINE_RECTANGLE:
+    canvas.DrawRectangle(p[0].x, p[0].y, p[1].x, p[1].y, op.color);
+    break;
+
+  case Type::HLINE:
+    canvas.DrawHLine(p[0].x, p[1].x, p[0].y, op.color);
+    break;
+
+  case Type::LINE:
+    if (op.width > 1) {
+      unsigned mask_position = 0;
+      canvas.DrawThickLine(p[0].x, p[0].y, p[1].x, p[1].y, op.width,
+                           op.color, op.mask, mask_position);
+    } else
+      canvas.DrawLine(p[0].x, p[0].y, p[1].x, p[1].y, op.color, op.mask);
+    break;
+
+  case Type::POLYLINE:
+    canvas.DrawPolyline(p, op.n_points, op.loop, op.color,
+                        op.width, op.mask);
+    break;
+
+  case Type::POLYGON:
+    if (op.alpha == 0xff)
+      canvas.FillPolygon(p, op.n_points, op.color);
+    else
+      canvas.FillPolygon(p, op.n_points, op.color,
+                         AlphaPixelOperations<ActivePixelTraits>(op.alpha));
+    break;
+
+  case Type::FILL_CIRCLE:
+    if (op.alpha == 0xff)
+      canvas.FillCircle(p->x, p->y, op.radius, op.color);
+    else
+      canvas.FillCircle(p->x, p->y, op.radius, op.color,
+                        AlphaPixelOperations<ActivePixelTraits>(op.alpha));
+    break;
+
+  case Type::CIRCLE:
+    if (op.width < 2) {
+      canvas.DrawCircle(p->x, p->y, op.radius, op.color);
+      break;
+    }
+
+    for (int i = op.width / 2; i >= -(int)(op.width - 1) / 2; --i)
+      canvas.DrawCircle(p->x, p->y, op.radius + i, op.color);
+    break;
+  }
+}
+
+inline void
+TiledRenderer::Bin(unsigned height) noexcept
+{
+  const unsigned n_tiles = pool->GetConcurrency() * TILES_PER_THREAD;
+  tile_height = std::max((height + n_tiles - 1) / n_tiles, MIN_TILE_HEIGHT);
+
+  tiles.resize((height + tile_height - 1) / tile_height);
+  for (auto &i : tiles)
+    i.clear();
+
+  for (std::size_t i = 0; i < operations.size(); ++i) {
+    const PixelRect &b = operations[i].bounds;
+    const int top = std::max(b.top, 0);
+    const int bottom = std::min(b.bottom, int(height));
+    if (top >= bottom || b.left >= b.right)
+      continue;
+
+    const unsigned first = top / tile_height;
+    const unsigned end = (bottom - 1) / tile_height + 1;
+    for (unsigned j = first; j < end; ++j)
+      tiles[j].push_back(i);
+
+    statistics.binned += end - first;
+  }
+}
+
+void
+TiledRenderer::Flush(WritableImageBuffer<ActivePixelTraits> buffer) noexcept
+{
+  if (operations.empty())
+    return;
+
+  ++statistics.flushes;
+
+  if (pool == nullptr || pool->GetConcurrency() < 2 ||
+      operations.size() < MIN_PARALLEL) {
+    TileCanvas canvas(buffer);
+    for (const auto &op : operations)
+      Replay(canvas, op);
+  } else {
+    ++statistics.parallel_flushes;
+
+    Bin(buffer.size.height);
+
+    pool->ParallelFor(tiles.size(), [&](std::size_t i){
+      const auto &tile = tiles[i];
+      if (tile.empty())
+        return;
+
+      const int top = i * tile_height;
+      const int bottom = std::min(top + int(tile_height),
+                                  int(buffer.size.height));
+
+      TileCanvas canvas(buffer);
+      canvas.SetClip({0, top, int(buffer.size.width), bottom});
+
+      for (const auto j : tile)
+        Replay(canvas, operations[j]);
+    });
+  }
+
+  operations.clear();
+  points.clear();
+}
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ActivePixelTraits.hpp"
+#include "Buffer.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "ui/dim/Rect.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Records vector drawing operations of a memory #Canvas and
+ * rasterises them later in parallel.
+ *
+ * Flush() splits the buffer into tiles, assigns each recorded
+ * operation to all tiles overlapped by its (conservative) bounding
+ * box, and lets a #ThreadPool process the tiles.  Each tile replays
+ * its operations in the original order with a clip rectangle (see
+ * RasterCanvas::SetClip()), therefore the result is identical to
+ * drawing the operations directly.
+ *
+ * The tiles span the whole buffer width.  Splitting horizontal spans
+ * would change which pixels the SIMD pixel operations (e.g. MMX/NEON
+ * alpha blending) handle and which ones are left to the portable
+ * code, and these do not round identically.
+ *
+ * Only the primitives which can be clipped this way are recorded;
+ * #Canvas flushes before all other operations which access the
+ * buffer (text, bitmaps, copies).
+ */
+class TiledRenderer {
+public:
+  using color_type = ActivePixelTraits::color_type;
+
+  /**
+   * Each thread gets this many tiles per Flush() (if the buffer is
+   * large enough).  More tiles balance the load better, but
+   * operations spanning several tiles are replayed in each of them.
+   */
+  static constexpr unsigned TILES_PER_THREAD = 2;
+
+  static constexpr unsigned MIN_TILE_HEIGHT = 16;
+
+  /**
+   * Batches with fewer operations than this are drawn by the calling
+   * thread without binning; the overhead would outweigh the gain.
+   */
+  static constexpr std::size_t MIN_PARALLEL = 16;
+
+  struct Statistics {
+    /**
+     * The number of non-empty Flush() calls, and how many of them
+     * were rasterised in parallel.
+     */
+    unsigned flushes = 0, parallel_flushes = 0;
+
+    /**
+     * The number of operations recorded.
+     */
+    unsigned operations = 0;
+
+    /**
+     * The number of (tile, operation) pairs replayed by parallel
+     * flushes.  Divided by the number of operations, this is the
+     * average number of tiles each operation touches.
+     */
+    unsigned binned = 0;
+  };
+
+private:
+  enum class Type : uint8_t {
+    FILL_RECTANGLE,
+    OUTLINE_RECTANGLE,
+    HLINE,
+    LINE,
+    POLYLINE,
+    POLYGON,
+    FILL_CIRCLE,
+    CIRCLE,
+  };
+
+  struct Operation {
+    /**
+     * Conservative bounds of all pixels this operation may modify.
+     */
+    PixelRect bounds;
+
+    /**
+     * The range in #points.  Rectangles and lines have two points
+     * (FILL_RECTANGLE and OUTLINE_RECTANGLE: top left and bottom
+     * right), circles have one (the center).
+     */
+    uint32_t first_point, n_points;
+
+    color_type color;
+
+    /**
+     * The pen width (LINE, POLYLINE, CIRCLE) or the circle radius.
+     */
+    unsigned width, radius;
+
+    /**
+     * The line mask (LINE, POLYLINE).
+     */
+    unsigned mask;
+
+    Type type;
+
+    /**
+     * The fill opacity (POLYGON, FILL_CIRCLE); 0xff means opaque.
+     */
+    uint8_t alpha;
+
+    /**
+     * Close the polyline?
+     */
+    bool loop;
+  };
+
+  ThreadPool *pool;
+
+  std::vector<Operation> operations;
+  std::vector<BulkPixelPoint> points;
+
+  /**
+   * For each tile, the indexes of the operations to be replayed
+   * there.  Kept across Flush() calls to reuse the allocations.
+   */
+  std::vector<std::vector<uint32_t>> tiles;
+
+  unsigned tile_height;
+
+  Statistics statistics;
+
+public:
+  /**
+   * @param _pool the pool which rasterises the tiles; nullptr
+   * means everything is drawn by the thread which calls Flush()
+   */
+  explicit TiledRenderer(ThreadPool *_pool) noexcept
+    :pool(_pool) {}
+
+  TiledRenderer(const TiledRenderer &) = delete;
+  TiledRenderer &operator=(const TiledRenderer &) = delete;
+
+  bool IsEmpty() const noexcept {
+    return operations.empty();
+  }
+
+  const Statistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
+  void FillRectangle(PixelRect r, color_type color) noexcept;
+  void OutlineRectangle(PixelRect r, color_type color) noexcept;
+  void DrawHLine(int x1, int x2, int y, color_type color) noexcept;
+
+  void DrawLine(PixelPoint a, PixelPoint b, color_type color,
+                unsigned width, unsigned mask) noexcept;
+
+  void DrawPolyline(const BulkPixelPoint *p, unsigned n, bool loop,
+                    color_type color,
+                    unsigned width, unsigned mask) noexcept;
+
+  void FillPolygon(const BulkPixelPoint *p, unsigned n,
+                   color_type color, uint8_t alpha) noexcept;
+
+  void FillCircle(PixelPoint center, unsigned radius,
+                  color_type color, uint8_t alpha) noexcept;
+
+  void DrawCircle(PixelPoint center, unsigned radius,
+                  color_type color, unsigned width) noexcept;
+
+  /**
+   * Rasterise all recorded operations into the given buffer and
+   * clear the list.
+   */
+  void Flush(WritableImageBuffer<ActivePixelTraits> buffer) noexcept;
+
+private:
+  Operation &Add(Type type, const BulkPixelPoint *p, unsigned n,
+                 color_type color, int margin) noexcept;
+
+  /**
+   * Draw one operation on a RasterCanvas.
+   */
+  void Replay(auto &canvas, const Operation &op) const noexcept;
+
+  void Bin(unsigned height) noexcept;
+};
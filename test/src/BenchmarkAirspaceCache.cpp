@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the start-up cost of parsing airspace files (like
+ * ReadAirspace() does without a cache) with loading the binary
+ * airspace cache.
+ */
+
+#include "Airspace/AirspaceCache.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/MemoryReader.hxx"
+#include "io/StringOutputStream.hxx"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/SpanCast.hxx"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+using Clock = steady_clock;
+
+static constexpr unsigned N_ITERATIONS = 20;
+
+static void
+Parse(std::span<const AllocatedPath> paths, Airspaces &airspaces)
+{
+  for (const auto &path : paths) {
+    FileReader file_reader{path};
+    BufferedReader buffered_reader{file_reader};
+    ParseAirspaceFile(airspaces, buffered_reader);
+  }
+
+  airspaces.Optimise();
+}
+
+static void
+Load(const std::string &data, std::span<const Path> sources,
+     Airspaces &airspaces)
+{
+  MemoryReader reader{AsBytes(data)};
+  BufferedReader br{reader};
+  if (!LoadAirspaceCache(br, sources, airspaces))
+    exit(EXIT_FAILURE);
+
+  airspaces.Optimise();
+}
+
+static double
+Milliseconds(Clock::duration d) noexcept
+{
+  return duration_cast<duration<double, std::milli>>(d).count()
+    / N_ITERATIONS;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE...");
+
+  std::vector<AllocatedPath> paths;
+  do {
+    paths.emplace_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  const std::vector<Path> sources(paths.begin(), paths.end());
+
+  std::string data;
+  unsigned n_airspaces;
+
+  {
+    Airspaces airspaces;
+    Parse(paths, airspaces);
+    n_airspaces = airspaces.GetSize();
+
+    StringOutputStream sos;
+    BufferedOutputStream bos(sos);
+    SaveAirspaceCache(bos, sources, airspaces);
+    bos.Flush();
+    data = std::move(sos).GetValue();
+  }
+
+  auto start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    Airspaces airspaces;
+    Parse(paths, airspaces);
+  }
+  const auto parse_duration = Clock::now() - start;
+
+  start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    Airspaces airspaces;
+    Load(data, sources, airspaces);
+  }
+  const auto cache_duration = Clock::now() - start;
+
+  printf("%u airspaces, cache size %zu bytes\n"
+         "parse %8.2f ms\n"
+         "cache %8.2f ms\n",
+         n_airspaces, data.size(),
+         Milliseconds(parse_duration),
+         Milliseconds(cache_duration));
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
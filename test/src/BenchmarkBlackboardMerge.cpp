@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Simulate 50 Hz sensor input from a vario and a FLARM and measure
+ * the cost of the blackboard copies done by DeviceBlackboard::Merge(),
+ * MergeThread::Tick() and CalculationThread::Tick() while holding the
+ * blackboard mutex.  The traffic is copied either in every tick or
+ * only when its version has changed.
+ */
+
+#include "FLARMEmulator.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/MoreData.hpp"
+#include "FLARM/List.hpp"
+#include "NMEA/Checksum.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/Mutex.hxx"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned RATE = 50;
+
+/**
+ * A #Port which collects everything written to it.
+ */
+class CapturePort final : public NullPort {
+public:
+  std::string data;
+
+  std::size_t Write(std::span<const std::byte> src) override {
+    data.append((const char *)src.data(), src.size());
+    return src.size();
+  }
+};
+
+static void
+ParseLines(NMEAParser &parser, std::string_view rest, NMEAInfo &info)
+{
+  while (!rest.empty()) {
+    const auto eol = rest.find('\n');
+    std::string line{rest.substr(0, eol)};
+    rest = eol == rest.npos ? std::string_view{} : rest.substr(eol + 1);
+
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    parser.ParseLine(line.c_str(), info);
+  }
+}
+
+struct Simulation {
+  NullOperationEnvironment env;
+
+  CapturePort flarm_port;
+  FLARMEmulator flarm;
+
+  std::array<NMEAParser, 2> parsers;
+  std::array<NMEAInfo, 2> devices;
+  std::array<TrafficList, 2> traffic;
+
+  unsigned n_targets;
+
+  explicit Simulation(unsigned _n_targets) noexcept
+    :n_targets(_n_targets) {
+    flarm.port = &flarm_port;
+    flarm.env = &env;
+
+    for (auto &i : devices)
+      i.Reset();
+
+    for (unsigned i = 0; i < parsers.size(); ++i) {
+      traffic[i].Clear();
+      parsers[i].SetTraffic(&traffic[i]);
+    }
+  }
+
+  void Feed(NMEAInfo &info, NMEAParser &parser, const char *format,
+            auto... args) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer) - 4, format, args...);
+    AppendNMEAChecksum(buffer);
+    parser.ParseLine(buffer, info);
+  }
+
+  /**
+   * Feed one 20 ms step of input: barometric altitude at 50 Hz and
+   * GPS at 10 Hz from the vario, and GPS plus traffic at 1 Hz from
+   * the FLARM.
+   */
+  void Step(unsigned tick) {
+    const auto clock = TimeStamp{std::chrono::milliseconds{tick * 1000 / RATE}};
+    const unsigned seconds = tick / RATE;
+    const unsigned hhmmss = (10 + seconds / 3600) * 10000 +
+      seconds / 60 % 60 * 100 + seconds % 60;
+
+    for (auto &i : devices) {
+      i.clock = clock;
+      i.alive.Update(clock);
+    }
+
+    auto &vario = devices[0];
+    Feed(vario, parsers[0], "$PGRMZ,%d,m,3",
+         1000 + (int)(50 * std::sin(tick * 0.01)));
+
+    if (tick % (RATE / 10) == 0)
+      Feed(vario, parsers[0],
+           "$GPRMC,%06u.%02u,A,5130.%03u,N,00720.000,E,50.0,90.0,010124,,,A",
+           hhmmss, tick % RATE * 2, tick % 1000);
+
+    if (tick % RATE == 0) {
+      auto &device = devices[1];
+      Feed(device, parsers[1],
+           "$GPRMC,%06u.00,A,5130.%03u,N,00720.000,E,50.0,90.0,010124,,,A",
+           hhmmss, tick % 1000);
+
+      Feed(device, parsers[1], "$PFLAU,%u,1,2,1,0,,0,,", n_targets);
+
+      flarm_port.data.clear();
+      flarm.SendTraffic(0xdd0000, n_targets, seconds);
+      ParseLines(parsers[1], flarm_port.data, device);
+    }
+  }
+};
+
+struct Result {
+  Clock::duration merge{}, hold{}, max_hold{};
+
+  /**
+   * The number of ticks in which the traffic was copied to the
+   * readers.
+   */
+  unsigned published = 0;
+};
+
+/**
+ * Emulate the effect of FlarmComputer::Process(), which modifies the
+ * traffic objects in the merged data after each merge.
+ */
+static void
+ProcessTraffic(TrafficList &traffic_list) noexcept
+{
+  for (auto &traffic : traffic_list)
+    traffic.distance = std::hypot(traffic.relative_north,
+                                  traffic.relative_east);
+}
+
+/**
+ * The blackboards which copy the traffic from the DeviceBlackboard:
+ * InterfaceBlackboard, GlideComputerBlackboard and
+ * MapWindowBlackboard.
+ */
+static constexpr unsigned N_READERS = 3;
+
+/**
+ * @param versioned copy the traffic only if it has changed, like
+ * DeviceBlackboard::PublishTraffic() and BaseBlackboard::CopyTraffic()
+ * do; otherwise copy it in every tick
+ */
+static Result
+Run(unsigned n_targets, unsigned n_ticks, bool versioned)
+{
+  Simulation simulation{n_targets};
+
+  Mutex mutex;
+
+  auto real_data = std::make_unique<NMEAInfo>();
+  auto basic = std::make_unique<MoreData>();
+  auto last_any = std::make_unique<MoreData>();
+  auto calculation = std::make_unique<MoreData>();
+
+  real_data->Reset();
+  basic->Reset();
+  last_any->Reset();
+  calculation->Reset();
+
+  auto merged_traffic = std::make_unique<TrafficList>();
+  auto traffic = std::make_unique<TrafficList>();
+  auto readers = std::make_unique<std::array<TrafficList, N_READERS>>();
+
+  merged_traffic->Clear();
+  traffic->Clear();
+  for (auto &i : *readers)
+    i.Clear();
+
+  unsigned traffic_version = 0;
+  std::array<unsigned, N_READERS> reader_versions{};
+
+  Result result;
+
+  for (unsigned tick = 1; tick <= n_ticks; ++tick) {
+    simulation.Step(tick);
+
+    const std::lock_guard lock{mutex};
+    const auto t0 = Clock::now();
+
+    /* DeviceBlackboard::Merge() */
+    real_data->Reset();
+    merged_traffic->Clear();
+    for (unsigned i = 0; i < simulation.devices.size(); ++i) {
+      NMEAInfo &device = simulation.devices[i];
+      device.Expire();
+      real_data->Complement(device);
+
+      simulation.traffic[i].Expire(device.clock);
+      merged_traffic->Complement(simulation.traffic[i]);
+    }
+
+    static_cast<NMEAInfo &>(*basic) = *real_data;
+
+    const auto t1 = Clock::now();
+
+    ProcessTraffic(*merged_traffic);
+
+    /* DeviceBlackboard::PublishTraffic() */
+    if (!versioned || !traffic->IsSame(*merged_traffic)) {
+      traffic->CopyFrom(*merged_traffic);
+      ++traffic_version;
+      ++result.published;
+    }
+
+    /* MergeThread::Tick() and CalculationThread::Tick() */
+    *last_any = *basic;
+    *calculation = *basic;
+
+    for (unsigned i = 0; i < N_READERS; ++i) {
+      if (reader_versions[i] != traffic_version) {
+        (*readers)[i].CopyFrom(*traffic);
+        reader_versions[i] = traffic_version;
+      }
+    }
+
+    const auto t2 = Clock::now();
+
+    result.merge += t1 - t0;
+    result.hold += t2 - t0;
+    result.max_hold = std::max(result.max_hold, t2 - t0);
+  }
+
+  for (const auto &i : *readers) {
+    if (i.GetActiveTrafficCount() != n_targets) {
+      fprintf(stderr, "Expected %u targets, got %u\n", n_targets,
+              i.GetActiveTrafficCount());
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  return result;
+}
+
+static void
+Print(const char *name, const Result &result, unsigned n_ticks)
+{
+  using us = std::chrono::duration<double, std::micro>;
+
+  printf("  %-9s merge %7.2f us, mutex held %7.2f us (maximum %7.2f us), "
+         "traffic copied in %u of %u ticks\n",
+         name,
+         us(result.merge).count() / n_ticks,
+         us(result.hold).count() / n_ticks,
+         us(result.max_hold).count(),
+         result.published, n_ticks);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--seconds=N] [TARGETS ...]");
+
+  unsigned n_seconds = 60;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--seconds=")) != nullptr) {
+      n_seconds = strtoul(value, nullptr, 10);
+      if (n_seconds == 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  std::vector<unsigned> targets;
+  while (!args.IsEmpty()) {
+    targets.push_back(strtoul(args.ExpectNext(), nullptr, 10));
+    if (targets.back() > TrafficList::MAX_COUNT)
+      args.UsageError();
+  }
+
+  if (targets.empty())
+    targets = {0, 10, unsigned(TrafficList::MAX_COUNT)};
+
+  const unsigned n_ticks = n_seconds * RATE;
+
+  for (const unsigned n : targets) {
+    printf("%u FLARM targets, %u s at %u Hz:\n", n, n_seconds, RATE);
+    Print("always", Run(n, n_ticks, false), n_ticks);
+    Print("versioned", Run(n, n_ticks, true), n_ticks);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Feed traffic from several simulated FLARM devices through the NMEA
+ * parser and merge the per-device data the way
+ * DeviceBlackboard::Merge() does, measuring the merge time.
+ */
+
+#include "FLARMEmulator.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "FLARM/List.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * A #Port which collects everything written to it.
+ */
+class CapturePort final : public NullPort {
+public:
+  std::string data;
+
+  std::size_t Write(std::span<const std::byte> src) override {
+    data.append((const char *)src.data(), src.size());
+    return src.size();
+  }
+};
+
+struct SimulatedDevice {
+  CapturePort port;
+  FLARMEmulator emulator;
+  NMEAParser parser;
+  NMEAInfo basic;
+  TrafficList traffic;
+
+  unsigned first_id;
+
+  SimulatedDevice(OperationEnvironment &env, unsigned _first_id) noexcept
+    :first_id(_first_id) {
+    emulator.port = &port;
+    emulator.env = &env;
+    basic.Reset();
+    traffic.Clear();
+    parser.SetTraffic(&traffic);
+  }
+
+  void Receive(unsigned n_targets, unsigned tick) {
+    port.data.clear();
+    emulator.SendTraffic(first_id, n_targets, tick);
+
+    basic.clock = TimeStamp{std::chrono::seconds{tick}};
+    basic.alive.Update(basic.clock);
+
+    std::string_view rest = port.data;
+    while (!rest.empty()) {
+      const auto eol = rest.find('\n');
+      std::string line{rest.substr(0, eol)};
+      rest = eol == rest.npos ? std::string_view{} : rest.substr(eol + 1);
+
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      parser.ParseLine(line.c_str(), basic);
+    }
+  }
+};
+
+static unsigned
+ParseUnsigned(Args &args, const char *value)
+{
+  char *endptr;
+  const unsigned long n = strtoul(value, &endptr, 10);
+  if (endptr == value || *endptr != 0 || n == 0)
+    args.UsageError();
+  return n;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--targets=N] [--devices=N] [--overlap=N] [--ticks=N]");
+
+  unsigned n_targets = 100, n_devices = 2, overlap = 80, n_ticks = 600;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--targets=")) != nullptr)
+      n_targets = ParseUnsigned(args, value);
+    else if ((value = StringAfterPrefix(arg, "--devices=")) != nullptr)
+      n_devices = ParseUnsigned(args, value);
+    else if ((value = StringAfterPrefix(arg, "--overlap=")) != nullptr)
+      overlap = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--ticks=")) != nullptr)
+      n_ticks = ParseUnsigned(args, value);
+    else
+      args.UsageError();
+  }
+
+  args.ExpectEnd();
+
+  if (overlap > n_targets)
+    args.UsageError();
+
+  NullOperationEnvironment env;
+
+  /* each device sees n_targets; consecutive devices share "overlap"
+     of them */
+  constexpr unsigned FIRST_ID = 0xdd0000;
+  const unsigned stride = n_targets - overlap;
+  const unsigned n_unique = n_targets + (n_devices - 1) * stride;
+
+  std::vector<std::unique_ptr<SimulatedDevice>> devices;
+  for (unsigned i = 0; i < n_devices; ++i)
+    devices.emplace_back(std::make_unique<SimulatedDevice>(env,
+                                                           FIRST_ID + i * stride));
+
+  NMEAInfo real_data, basic;
+  real_data.Reset();
+  basic.Reset();
+
+  TrafficList real_traffic, traffic;
+  real_traffic.Clear();
+  traffic.Clear();
+
+  Clock::duration total{}, maximum{};
+  unsigned min_count = TrafficList::MAX_COUNT, max_count = 0;
+
+  for (unsigned tick = 1; tick <= n_ticks; ++tick) {
+    /* during a short period, the last 20 targets of each device
+       disappear and must expire */
+    const bool dropout = tick % 100 >= 50 && tick % 100 < 55;
+    const unsigned n = dropout && n_targets > 20 ? n_targets - 20 : n_targets;
+
+    for (auto &device : devices)
+      device->Receive(n, tick);
+
+    const auto t0 = Clock::now();
+
+    real_data.Reset();
+    real_traffic.Clear();
+    for (auto &device : devices) {
+      device->basic.Expire();
+      real_data.Complement(device->basic);
+
+      device->traffic.Expire(device->basic.clock);
+      real_traffic.Complement(device->traffic);
+    }
+
+    basic = real_data;
+    traffic.CopyFrom(real_traffic);
+
+    const auto duration = Clock::now() - t0;
+    total += duration;
+    maximum = std::max(maximum, duration);
+    const unsigned count = traffic.GetActiveTrafficCount();
+    min_count = std::min(min_count, count);
+    max_count = std::max(max_count, count);
+  }
+
+  /* after the last tick, every target must be present exactly once
+     (up to the capacity of the list) and must be found by id */
+  const unsigned expected = std::min<unsigned>(n_unique, TrafficList::MAX_COUNT);
+
+  std::vector<FlarmId> ids;
+  for (unsigned i = 0; i < n_unique; ++i) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%06X", FIRST_ID + i);
+    ids.push_back(FlarmId::Parse(buffer, nullptr));
+  }
+
+  unsigned found = 0;
+  const auto t0 = Clock::now();
+  for (const auto id : ids)
+    if (traffic.FindTraffic(id) != nullptr)
+      ++found;
+  const auto lookup_duration = Clock::now() - t0;
+
+  const auto total_us = std::chrono::duration<double, std::micro>(total).count();
+  const auto max_us = std::chrono::duration<double, std::micro>(maximum).count();
+
+  printf("%u devices, %u targets each, %u unique, %u ticks\n",
+         n_devices, n_targets, n_unique, n_ticks);
+  printf("merged traffic: %u (minimum %u, maximum %u, capacity %zu)\n",
+         traffic.GetActiveTrafficCount(), min_count, max_count,
+         TrafficList::MAX_COUNT);
+  printf("merge:  %8.2f us average, %8.2f us maximum\n",
+         total_us / n_ticks, max_us);
+  printf("lookup: %8.1f ns (%u of %u found)\n",
+         std::chrono::duration<double, std::nano>(lookup_duration).count() / n_unique,
+         found, n_unique);
+
+  if (traffic.GetActiveTrafficCount() != expected || found != expected) {
+    fprintf(stderr, "Expected %u targets\n", expected);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
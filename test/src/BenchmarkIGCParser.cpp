@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the line-based IGC parser (FileLineReaderA + IGCParseFix(),
+ * as used by DebugReplayIGC) with IGCBulkParseFile().
+ */
+
+#include "IGC/IGCBulkParser.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using Clock = std::chrono::steady_clock;
+
+static void
+LineParse(Path path, IGCBulkResult &result)
+{
+  FileLineReaderA reader(path);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  const char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] == 'B') {
+      IGCFix fix;
+      if (IGCParseFix(line, extensions, fix))
+        result.fixes.push_back(fix);
+    } else if (line[0] == 'H') {
+      BrokenDate date;
+      if (!result.date.IsPlausible() && memcmp(line, "HFDTE", 5) == 0 &&
+          IGCParseDateRecord(line, date))
+        result.date = date;
+    } else if (line[0] == 'I') {
+      IGCParseExtensions(line, extensions);
+    }
+  }
+}
+
+static bool
+SameFix(const IGCFix &a, const IGCFix &b)
+{
+  return a.time == b.time && a.location == b.location &&
+    a.gps_valid == b.gps_valid && a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm && a.hdm == b.hdm && a.hdt == b.hdt &&
+    a.trm == b.trm && a.trt == b.trt && a.gsp == b.gsp && a.ias == b.ias &&
+    a.tas == b.tas && a.siu == b.siu;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--repeat=N] FILE.igc ...");
+
+  unsigned repeat = 10;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--repeat=")) != nullptr) {
+      repeat = strtoul(value, nullptr, 10);
+      if (repeat == 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  std::list<decltype(args.ExpectNextPath())> paths;
+  do {
+    paths.emplace_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  Clock::duration line_duration{}, bulk_duration{};
+  std::size_t n_fixes = 0;
+  bool mismatch = false;
+
+  for (const auto &path : paths) {
+    for (unsigned i = 0; i < repeat; ++i) {
+      IGCBulkResult line_result;
+      const auto t0 = Clock::now();
+      LineParse(path, line_result);
+      const auto t1 = Clock::now();
+      const auto bulk_result = IGCBulkParseFile(path);
+      const auto t2 = Clock::now();
+
+      line_duration += t1 - t0;
+      bulk_duration += t2 - t1;
+
+      if (i > 0)
+        continue;
+
+      n_fixes += bulk_result.fixes.size();
+
+      if (!(line_result.date == bulk_result.date) ||
+          line_result.fixes.size() != bulk_result.fixes.size() ||
+          !std::equal(line_result.fixes.begin(), line_result.fixes.end(),
+                      bulk_result.fixes.begin(), SameFix)) {
+        fprintf(stderr, "Mismatch in %s\n", path.c_str());
+        mismatch = true;
+      }
+    }
+  }
+
+  const auto line_ms = std::chrono::duration<double, std::milli>(line_duration).count();
+  const auto bulk_ms = std::chrono::duration<double, std::milli>(bulk_duration).count();
+
+  printf("%zu files, %zu fixes, %u repetitions\n",
+         paths.size(), n_fixes, repeat);
+  printf("line-based: %9.3f ms (%.1f ns/fix)\n", line_ms,
+         line_ms * 1e6 / (double(n_fixes) * repeat));
+  printf("bulk:       %9.3f ms (%.1f ns/fix)\n", bulk_ms,
+         bulk_ms * 1e6 / (double(n_fixes) * repeat));
+  printf("speedup:    %9.2fx\n", line_ms / bulk_ms);
+
+  return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
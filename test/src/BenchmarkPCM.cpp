@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Measure the throughput of the PCM synthesisers (like PlayTone and
+ * PlayVario, but without a PCMPlayer) and of the mixer, and compare
+ * them with the portable scalar code.
+ */
+
+#include "Audio/AudioAlgorithms.hpp"
+#include "Audio/ToneSynthesiser.hpp"
+#include "Audio/VarioSynthesiser.hpp"
+#include "Math/FastTrig.hpp"
+#include "system/Args.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned sample_rate = 44100;
+
+/**
+ * The size of one audio buffer, a typical value for ALSA.
+ */
+static constexpr size_t BUFFER_SIZE = 1024;
+
+static int16_t buffer[BUFFER_SIZE], buffer2[BUFFER_SIZE];
+
+/**
+ * Prevent the compiler from optimising the work away.
+ */
+static volatile int16_t sink;
+
+template<typename F>
+static void
+Measure(const char *name, unsigned seconds, F &&f)
+{
+  const unsigned n_buffers = seconds * sample_rate / BUFFER_SIZE;
+
+  const auto start = Clock::now();
+  for (unsigned i = 0; i < n_buffers; ++i)
+    f(i);
+  const auto duration = Clock::now() - start;
+
+  sink = buffer[0];
+
+  const double n_samples = double(n_buffers) * BUFFER_SIZE;
+  const double s = std::chrono::duration<double>(duration).count();
+  printf("%-16s %12.0f samples/s (%.0fx real time)\n",
+         name, n_samples / s, n_samples / sample_rate / s);
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[SECONDS]");
+  const char *seconds_s = args.PeekNext();
+  const unsigned seconds = seconds_s != nullptr
+    ? strtoul(args.ExpectNext(), nullptr, 10)
+    : 3600;
+  args.ExpectEnd();
+
+  if (seconds == 0) {
+    fprintf(stderr, "Invalid duration\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("synthesising %u seconds of audio per test\n", seconds);
+
+  ToneSynthesiser tone(sample_rate);
+  tone.SetTone(880);
+  tone.SetVolume(80);
+
+  Measure("tone", seconds, [&tone](unsigned) {
+    tone.Synthesise(buffer, BUFFER_SIZE);
+  });
+
+  const unsigned increment = ISINETABLE.size() * 880 / sample_rate;
+  unsigned angle = 0;
+  Measure("tone (scalar)", seconds, [increment, &angle](unsigned) {
+    for (auto &i : buffer) {
+      i = ISINETABLE[angle] * (32767 / 1024) * 80 / 100;
+      angle = (angle + increment) & (ISINETABLE.size() - 1);
+    }
+  });
+
+  VarioSynthesiser vario(sample_rate);
+  vario.SetVolume(80);
+
+  /* sweep from -5 m/s to +5 m/s and back, changing the value ten
+     times per second */
+  Measure("vario", seconds, [&vario](unsigned i) {
+    if (i % 4 == 0) {
+      const int step = (i / 4) % 200;
+      vario.SetVario((step < 100 ? step : 200 - step) * 0.1 - 5);
+    }
+
+    vario.Synthesise(buffer, BUFFER_SIZE);
+  });
+
+  tone.Synthesise(buffer2, BUFFER_SIZE);
+
+  Measure("mix", seconds, [](unsigned) {
+    MixPCM(buffer, buffer2, BUFFER_SIZE, 70);
+  });
+
+  Measure("mix (scalar)", seconds, [](unsigned) {
+    MixPCM(buffer, BUFFER_SIZE, 70,
+           [](size_t i) { return buffer2[i]; });
+  });
+
+  Measure("mix byte-swapped", seconds, [](unsigned) {
+    ByteSwapAndMixPCM(buffer, buffer2, BUFFER_SIZE, 70);
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -1,11 +1,29 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright The XCSoar Project
 
+/*
+ * Compare the throughput of the scalar Projection::GeoToScreen() with
+ * the batch version, on a polyline of the size of a typical airspace
+ * outline or snail trail.
+ */
+
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
+#include "ui/dim/BulkPoint.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace std::chrono;
+using Clock = steady_clock;
 
 unsigned Layout::scale_1024 = 1024;
 
+static constexpr unsigned N_POINTS = 1024;
+static constexpr unsigned N_ITERATIONS = 64 * 1024;
+
 class TestProjection : public Projection {
 public:
   TestProjection() {
@@ -13,23 +31,52 @@ public:
     SetScale(640. / (100 * 2));
     SetGeoLocation(GeoPoint(Angle::Degrees(7.7061111111111114),
                             Angle::Degrees(51.051944444444445)));
+    SetScreenAngle(Angle::Degrees(30));
   }
 };
 
+static double
+NanosecondsPerPoint(Clock::duration d) noexcept
+{
+  return duration_cast<duration<double, std::nano>>(d).count()
+    / (double(N_ITERATIONS) * N_POINTS);
+}
+
 int main()
 {
   TestProjection projection;
 
-  GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
-                         Angle::Degrees(51.051944444444445));
+  std::vector<GeoPoint> points;
+  points.reserve(N_POINTS);
+  for (unsigned i = 0; i < N_POINTS; ++i)
+    points.emplace_back(Angle::Degrees(7.7061111111111114 + 0.0001 * (i % 97)),
+                        Angle::Degrees(51.051944444444445 + 0.0001 * (i % 89)));
+
+  std::vector<BulkPixelPoint> screen(N_POINTS);
+
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
-    auto rp = projection.GeoToScreen(gp);
+
+  auto start = Clock::now();
+  for (unsigned i = N_ITERATIONS; i-- > 0;) {
+    for (unsigned j = 0; j < N_POINTS; ++j)
+      screen[j] = projection.GeoToScreen(points[j]);
 
     /* prevent gcc from optimizing this loop away */
-    x += rp.x;
-    y += rp.y;
+    x += screen[i % N_POINTS].x;
   }
+  const auto scalar_duration = Clock::now() - start;
+
+  start = Clock::now();
+  for (unsigned i = N_ITERATIONS; i-- > 0;) {
+    projection.GeoToScreen(points, screen.data());
+    y += screen[i % N_POINTS].y;
+  }
+  const auto batch_duration = Clock::now() - start;
+
+  printf("scalar %5.2f ns/point\n"
+         "batch  %5.2f ns/point\n",
+         NanosecondsPerPoint(scalar_duration),
+         NanosecondsPerPoint(batch_duration));
 
-  return x + y;
+  return (x + y) == 42;
 }
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Push IGC files through the full GlideComputer as quickly as
+ * possible.  The GPS time drives all rate limiters, so the results do
+ * not depend on the processing speed, and they are printed for
+ * regression testing together with the throughput.
+ */
+
+#include "DebugReplayIGC.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <list>
+#include <memory>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+void
+ConditionMonitors::Update([[maybe_unused]] const NMEAInfo &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated,
+                          [[maybe_unused]] const ComputerSettings &settings) noexcept
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogPoint([[maybe_unused]] const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  std::size_t n_fixes = 0;
+  Clock::duration duration{};
+};
+
+static Result
+Run(Path path, GlideComputer &glide_computer)
+{
+  std::unique_ptr<DebugReplay> replay{DebugReplayIGC::Create(path)};
+
+  glide_computer.ResetFlight();
+
+  Result result;
+  const auto start = Clock::now();
+
+  while (replay->Next()) {
+    glide_computer.ReadBlackboard(replay->Basic());
+    glide_computer.Expire();
+
+    if (glide_computer.ProcessGPS())
+      glide_computer.ProcessIdle();
+
+    ++result.n_fixes;
+  }
+
+  glide_computer.ProcessExhaustive();
+
+  result.duration = Clock::now() - start;
+  return result;
+}
+
+static void
+PrintResult(Path path, const GlideComputer &glide_computer,
+            const Result &result)
+{
+  const DerivedInfo &calculated = glide_computer.Calculated();
+  const double seconds =
+    std::chrono::duration<double>(result.duration).count();
+
+  printf("%s: %zu fixes, flight %.0f s, circling %.0f s, "
+         "wind %.1f m/s %.0f deg, contest %.2f / %.0f m, "
+         "%.0f fixes/s\n",
+         path.c_str(), result.n_fixes,
+         calculated.flight.flight_time.count(),
+         calculated.time_circling.count(),
+         calculated.wind.norm, calculated.wind.bearing.Degrees(),
+         calculated.contest_stats.GetResult(0).score,
+         calculated.contest_stats.GetResult(0).distance,
+         result.n_fixes / seconds);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc ...");
+
+  std::list<decltype(args.ExpectNextPath())> paths;
+  do {
+    paths.emplace_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  const Waypoints way_points;
+  Airspaces airspace_database;
+
+  TaskManager task_manager(settings.task, way_points);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  GlideComputer glide_computer(settings, way_points, airspace_database,
+                               protected_task_manager, task_events);
+  glide_computer.SetDeterministic(true);
+  glide_computer.Initialise();
+
+  Result total;
+
+  for (const auto &path : paths) {
+    const auto result = Run(path, glide_computer);
+    PrintResult(path, glide_computer, result);
+
+    total.n_fixes += result.n_fixes;
+    total.duration += result.duration;
+  }
+
+  printf("total: %zu files, %zu fixes, %.3f s, %.0f fixes/s\n",
+         paths.size(), total.n_fixes,
+         std::chrono::duration<double>(total.duration).count(),
+         total.n_fixes / std::chrono::duration<double>(total.duration).count());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Measure #TaskDijkstraMin and #TaskDijkstraMax on a synthetic
+ * task: a chain of cylinder observation zones, each represented by
+ * the points on its boundary, like OrderedTask does.
+ */
+
+#include "Engine/Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Engine/Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/Math.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+using Clock = steady_clock;
+
+static constexpr unsigned N_ITERATIONS = 500;
+
+/**
+ * Generate the boundaries of a zig-zag task with the given number of
+ * turn points.
+ */
+static std::vector<SearchPointVector>
+GenerateTask(unsigned n_turnpoints, unsigned n_boundary_points)
+{
+  const GeoPoint origin(Angle::Degrees(7.7), Angle::Degrees(51.0));
+
+  std::vector<GeoPoint> centers;
+  for (unsigned i = 0; i < n_turnpoints; ++i)
+    centers.emplace_back(origin.longitude + Angle::Degrees(0.8 * i),
+                         origin.latitude + Angle::Degrees(i % 2 ? 0.5 : 0.));
+
+  TaskProjection projection;
+  projection.Reset(centers.front());
+  for (const auto &i : centers)
+    projection.Scan(i);
+  projection.Update();
+
+  std::vector<SearchPointVector> result(n_turnpoints);
+  for (unsigned i = 0; i < n_turnpoints; ++i) {
+    /* the start and the finish are lines, represented by a single
+       point like OrderedTask does for achieved task points */
+    const unsigned n = i == 0 || i + 1 == n_turnpoints
+      ? 1 : n_boundary_points;
+    const double radius = 1000 + 500 * (i % 5);
+
+    for (unsigned j = 0; j < n; ++j) {
+      const Angle bearing = Angle::FullCircle() * j / n;
+      result[i].emplace_back(FindLatitudeLongitude(centers[i], bearing, radius),
+                             projection);
+    }
+  }
+
+  return result;
+}
+
+template<typename T>
+static void
+Setup(T &dijkstra, const std::vector<SearchPointVector> &task) noexcept
+{
+  dijkstra.SetTaskSize(task.size());
+  for (unsigned i = 0; i < task.size(); ++i)
+    dijkstra.SetBoundary(i, task[i]);
+}
+
+template<typename T>
+static double
+GetDistance(const T &dijkstra, unsigned n_stages) noexcept
+{
+  double distance = 0;
+  for (unsigned i = 1; i < n_stages; ++i)
+    distance += dijkstra.GetSolution(i - 1).GetLocation()
+      .Distance(dijkstra.GetSolution(i).GetLocation());
+  return distance;
+}
+
+static void
+Run(unsigned n_turnpoints, unsigned n_boundary_points)
+{
+  const auto task = GenerateTask(n_turnpoints, n_boundary_points);
+  const SearchPoint location = task[1].front();
+
+  TaskDijkstraMin min;
+  Setup(min, task);
+
+  auto start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i)
+    if (!min.DistanceMin(location))
+      exit(EXIT_FAILURE);
+  const auto min_duration = Clock::now() - start;
+
+  TaskDijkstraMax max;
+  Setup(max, task);
+
+  start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i)
+    if (!max.DistanceMax())
+      exit(EXIT_FAILURE);
+  const auto max_duration = Clock::now() - start;
+
+  printf("%2u points x %3u: min %8.1f us (%7.3f km), "
+         "max %8.1f us (%7.3f km)\n",
+         n_turnpoints, n_boundary_points,
+         duration_cast<duration<double, std::micro>>(min_duration).count()
+         / N_ITERATIONS,
+         GetDistance(min, n_turnpoints) / 1000,
+         duration_cast<duration<double, std::micro>>(max_duration).count()
+         / N_ITERATIONS,
+         GetDistance(max, n_turnpoints) / 1000);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "");
+  args.ExpectEnd();
+
+  for (const unsigned n_boundary_points : {16, 64, 128})
+    for (const unsigned n_turnpoints : {4, 7, 12})
+      Run(n_turnpoints, n_boundary_points);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
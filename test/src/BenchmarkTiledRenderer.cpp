@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Draw a synthetic map-like scene (translucent airspace polygons,
+ * topography polylines, a thick trail, range rings and markers) into
+ * an offscreen memory canvas, once directly and once through a
+ * #TiledRenderer with various numbers of threads.  Verifies that all
+ * variants produce the same pixels and prints the frame times.
+ */
+
+#include "ui/canvas/Canvas.hpp"
+#include "ui/canvas/memory/TiledRenderer.hpp"
+#include "ui/window/Init.hpp"
+#include "thread/ThreadPool.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Shape {
+  enum class Type {
+    AIRSPACE,
+    TOPOGRAPHY,
+    TRAIL,
+    RING,
+    MARKER,
+    LINE,
+    INVERT,
+  } type;
+
+  std::vector<BulkPixelPoint> points;
+  unsigned radius;
+  Color color;
+  Pen::Style style;
+  unsigned width;
+};
+
+static std::vector<Shape>
+GenerateScene(PixelSize size)
+{
+  std::mt19937 rng(42);
+
+  const auto random_point = [&rng, size](int margin){
+    return BulkPixelPoint(std::uniform_int_distribution(-margin, int(size.width) + margin)(rng),
+                          std::uniform_int_distribution(-margin, int(size.height) + margin)(rng));
+  };
+
+  const auto random_int = [&rng](int min, int max){
+    return std::uniform_int_distribution(min, max)(rng);
+  };
+
+  const auto random_color = [&random_int](uint8_t alpha){
+    return Color(random_int(0, 255), random_int(0, 255), random_int(0, 255),
+                 alpha);
+  };
+
+  std::vector<Shape> scene;
+
+  /* airspace: large translucent polygons with a thick outline */
+  for (unsigned i = 0; i < 30; ++i) {
+    Shape s{Shape::Type::AIRSPACE, {}, 0, random_color(96),
+            Pen::SOLID, 2};
+    const auto center = random_point(100);
+    const int radius = random_int(40, 300);
+    const unsigned n = random_int(8, 60);
+    for (unsigned j = 0; j < n; ++j) {
+      const double angle = 2 * std::numbers::pi * j / n;
+      const int r = radius + random_int(-radius / 4, radius / 4);
+      s.points.emplace_back(center.x + int(r * std::cos(angle)),
+                            center.y + int(r * std::sin(angle)));
+    }
+    scene.push_back(std::move(s));
+  }
+
+  /* topography: many thin polylines, some of them dashed */
+  for (unsigned i = 0; i < 300; ++i) {
+    Shape s{Shape::Type::TOPOGRAPHY, {}, 0, random_color(255),
+            i % 4 == 0 ? Pen::DASH1 : Pen::SOLID, 1};
+    auto p = random_point(50);
+    const unsigned n = random_int(5, 50);
+    for (unsigned j = 0; j < n; ++j) {
+      s.points.push_back(p);
+      p.x += random_int(-20, 20);
+      p.y += random_int(-20, 20);
+    }
+    scene.push_back(std::move(s));
+  }
+
+  /* a mid-scene pixel operation which forces a flush */
+  scene.push_back({Shape::Type::INVERT, {random_point(0)},
+                   unsigned(random_int(50, 200)), {}, Pen::SOLID, 0});
+
+  /* trail: thick segments */
+  for (unsigned i = 0; i < 20; ++i) {
+    Shape s{Shape::Type::TRAIL, {}, 0, random_color(255),
+            Pen::SOLID, unsigned(random_int(2, 6))};
+    auto p = random_point(0);
+    for (unsigned j = 0; j < 30; ++j) {
+      s.points.push_back(p);
+      p.x += random_int(-15, 15);
+      p.y += random_int(-15, 15);
+    }
+    scene.push_back(std::move(s));
+  }
+
+  /* range rings */
+  for (unsigned i = 1; i <= 6; ++i)
+    scene.push_back({Shape::Type::RING,
+                     {BulkPixelPoint(size.width / 2, size.height / 2)},
+                     i * 80, Color(0, 0, 0, 255), Pen::DASH2, i % 3 + 1});
+
+  /* waypoint and traffic markers */
+  for (unsigned i = 0; i < 200; ++i)
+    scene.push_back({Shape::Type::MARKER, {random_point(10)},
+                     unsigned(random_int(2, 12)),
+                     random_color(i % 2 ? 255 : 160), Pen::SOLID, 1});
+
+  /* task legs and bearing lines */
+  for (unsigned i = 0; i < 20; ++i)
+    scene.push_back({Shape::Type::LINE, {random_point(200), random_point(200)},
+                     0, random_color(255),
+                     i % 2 ? Pen::SOLID : Pen::DASH3,
+                     unsigned(random_int(1, 4))});
+
+  return scene;
+}
+
+static void
+DrawScene(Canvas &canvas, const std::vector<Shape> &scene)
+{
+  canvas.Clear(Color(0xf0, 0xf0, 0xe0));
+
+  for (const auto &s : scene) {
+    const PixelPoint &a = s.points.front(), &b = s.points.back();
+
+    switch (s.type) {
+    case Shape::Type::AIRSPACE:
+      canvas.Select(Brush(s.color));
+      canvas.Select(Pen(s.style, s.width, s.color.WithAlpha(255)));
+      canvas.DrawPolygon(s.points.data(), s.points.size());
+      break;
+
+    case Shape::Type::TOPOGRAPHY:
+    case Shape::Type::TRAIL:
+      canvas.Select(Pen(s.style, s.width, s.color));
+      canvas.DrawPolyline(s.points.data(), s.points.size());
+      break;
+
+    case Shape::Type::RING:
+      canvas.SelectHollowBrush();
+      canvas.Select(Pen(s.style, s.width, s.color));
+      canvas.DrawCircle(a, s.radius);
+      break;
+
+    case Shape::Type::MARKER:
+      canvas.Select(Brush(s.color));
+      canvas.SelectBlackPen();
+      canvas.DrawCircle(a, s.radius);
+      canvas.DrawFilledRectangle(PixelRect::Centered(a, {s.radius, s.radius}),
+                                 s.color.WithAlpha(255));
+      break;
+
+    case Shape::Type::LINE:
+      canvas.Select(Pen(s.style, s.width, s.color));
+      canvas.DrawLine(a, b);
+      canvas.DrawHLine(a.x, b.x, a.y, s.color);
+      break;
+
+    case Shape::Type::INVERT:
+      canvas.InvertRectangle(PixelRect::Centered(a, {s.radius, s.radius}));
+      break;
+    }
+  }
+
+  canvas.DrawOutlineRectangle(canvas.GetRect(), COLOR_BLACK);
+  canvas.FlushDeferred();
+}
+
+static Clock::duration
+Run(Canvas &canvas, const std::vector<Shape> &scene, unsigned n_frames)
+{
+  const auto start = Clock::now();
+  for (unsigned i = 0; i < n_frames; ++i)
+    DrawScene(canvas, scene);
+  return Clock::now() - start;
+}
+
+static bool
+Equals(const WritableImageBuffer<ActivePixelTraits> &a,
+       const WritableImageBuffer<ActivePixelTraits> &b) noexcept
+{
+  return memcmp(a.data, b.data, a.pitch * a.size.height) == 0;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--frames=N] [--width=N] [--height=N] [THREADS ...]");
+
+  unsigned n_frames = 50;
+  PixelSize size{800, 480};
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--frames=")) != nullptr) {
+      n_frames = strtoul(value, nullptr, 10);
+      if (n_frames == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--width=")) != nullptr) {
+      size.width = strtoul(value, nullptr, 10);
+      if (size.width == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--height=")) != nullptr) {
+      size.height = strtoul(value, nullptr, 10);
+      if (size.height == 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  std::vector<unsigned> threads;
+  while (!args.IsEmpty()) {
+    threads.push_back(strtoul(args.ExpectNext(), nullptr, 10));
+    if (threads.back() == 0)
+      args.UsageError();
+  }
+
+  if (threads.empty())
+    threads = {1, 2, 4};
+
+  ScreenGlobalInit screen;
+
+  const auto scene = GenerateScene(size);
+
+  WritableImageBuffer<ActivePixelTraits> reference, buffer;
+  reference.Allocate(size);
+  buffer.Allocate(size);
+
+  using ms = std::chrono::duration<double, std::milli>;
+
+  printf("%ux%u pixels, %u shapes, %u frames, %u processors\n",
+         size.width, size.height, unsigned(scene.size()), n_frames,
+         ThreadPool::GetDefaultConcurrency());
+
+  Canvas immediate{reference};
+  const double immediate_ms = ms(Run(immediate, scene, n_frames)).count() / n_frames;
+  printf("  immediate     %7.2f ms/frame\n", immediate_ms);
+
+  int result = EXIT_SUCCESS;
+
+  for (const unsigned n : threads) {
+    memset(buffer.data, 0, buffer.pitch * size.height);
+
+    ThreadPool pool{n};
+    TiledRenderer renderer{&pool};
+
+    Canvas canvas{buffer};
+    canvas.SetTiledRenderer(&renderer);
+    const double tiled_ms = ms(Run(canvas, scene, n_frames)).count() / n_frames;
+    canvas.SetTiledRenderer(nullptr);
+
+    const auto &statistics = renderer.GetStatistics();
+    const bool equal = Equals(reference, buffer);
+
+    printf("  tiled %2u      %7.2f ms/frame (%.2fx), %.1f tiles/operation, %u/%u parallel flushes%s\n",
+           n, tiled_ms, immediate_ms / tiled_ms,
+           statistics.operations > 0
+           ? double(statistics.binned) / statistics.operations : 0.,
+           statistics.parallel_flushes, statistics.flushes,
+           equal ? "" : "  MISMATCH");
+
+    if (!equal)
+      result = EXIT_FAILURE;
+  }
+
+  buffer.Free();
+  reference.Free();
+
+  return result;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
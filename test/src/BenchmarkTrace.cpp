@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare #Trace and #FlatTrace: the cost of appending a fix (with
+ * and without thinning) and of iterating over all points, with the
+ * capacities used by #TraceComputer.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/FlatTrace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "TraceGenerator.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+using Clock = steady_clock;
+
+static constexpr unsigned N_ITERATIONS = 1000;
+
+struct Result {
+  Clock::duration append{}, thin{}, iterate{}, copy{};
+  unsigned n_appended = 0, n_thinned = 0, n_iterated = 0;
+};
+
+template<typename T>
+static Result
+Run(const std::vector<TracePoint> &flight,
+    TracePoint::Time no_thin_time, TracePoint::Time max_time,
+    unsigned max_size)
+{
+  Result result;
+  T trace(no_thin_time, max_time, max_size);
+
+  for (const auto &point : flight) {
+    const auto serial = trace.GetModifySerial();
+
+    const auto start = Clock::now();
+    trace.push_back(point);
+    const auto duration = Clock::now() - start;
+
+    if (trace.GetModifySerial() != serial) {
+      result.thin += duration;
+      ++result.n_thinned;
+    } else {
+      result.append += duration;
+      ++result.n_appended;
+    }
+  }
+
+  /* iterate like the contest solvers do */
+  double sum = 0;
+  auto start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i)
+    for (const auto &point : trace)
+      sum += point.GetFlatLocation().x + point.GetIntegerAltitude();
+  result.iterate = Clock::now() - start;
+  result.n_iterated = N_ITERATIONS * trace.size();
+
+  /* copy like TraceComputer::LockedCopyTo() does */
+  TracePointVector v;
+  start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i)
+    trace.GetPoints(v);
+  result.copy = Clock::now() - start;
+
+  if (sum == 0)
+    /* prevent the compiler from optimising the loop away */
+    printf(" ");
+
+  return result;
+}
+
+static double
+NanosecondsPer(Clock::duration d, unsigned n) noexcept
+{
+  return n > 0
+    ? duration_cast<duration<double, std::nano>>(d).count() / n
+    : 0.;
+}
+
+static void
+Print(const char *name, const Result &r, std::size_t bytes_per_point)
+{
+  printf("  %-10s append %7.0f ns, thin %9.0f ns (%5u), "
+         "iterate %5.2f ns/point, copy %5.2f ns/point, %3zu bytes/point\n",
+         name,
+         NanosecondsPer(r.append, r.n_appended),
+         NanosecondsPer(r.thin, r.n_thinned), r.n_thinned,
+         NanosecondsPer(r.iterate, r.n_iterated),
+         NanosecondsPer(r.copy, r.n_iterated),
+         bytes_per_point);
+}
+
+static void
+Compare(const char *name, const std::vector<TracePoint> &flight,
+        TracePoint::Time no_thin_time, TracePoint::Time max_time,
+        unsigned max_size)
+{
+  printf("%s (%u points)\n", name, max_size);
+  Print("Trace", Run<Trace>(flight, no_thin_time, max_time, max_size),
+        Trace::BYTES_PER_POINT + TracePointStore::BYTES_PER_POINT);
+  Print("FlatTrace", Run<FlatTrace>(flight, no_thin_time, max_time, max_size),
+        FlatTrace::BYTES_PER_POINT);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--hours=N]");
+
+  unsigned hours = 10;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--hours=")) != nullptr) {
+      hours = strtoul(value, nullptr, 10);
+      if (hours == 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  args.ExpectEnd();
+
+  /* one fix every 2 seconds on average */
+  const auto flight = GenerateFlight(1, hours * 1800);
+
+  printf("%u hours, %zu fixes\n", hours, flight.size());
+
+  /* the configurations used by TraceComputer */
+  Compare("full", flight, minutes{2}, Trace::null_time, 1024);
+  Compare("contest", flight, {}, Trace::null_time, 256);
+  Compare("sprint", flight, {}, minutes{150}, 128);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
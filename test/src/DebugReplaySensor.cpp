@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "DebugReplaySensor.hpp"
+#include "system/Path.hpp"
+
+DebugReplaySensor::DebugReplaySensor(Path input_file)
+  :mapping(input_file), reader(mapping)
+{
+}
+
+DebugReplaySensor *
+DebugReplaySensor::Create(Path input_file)
+{
+  return new DebugReplaySensor(input_file);
+}
+
+void
+DebugReplaySensor::Seek(FloatDuration offset)
+{
+  const auto start = reader.GetStartClock();
+  if (!start.IsDefined())
+    return;
+
+  reader.Seek(start + offset, raw_basic);
+  last_basic.Reset();
+  computed_basic.Reset();
+}
+
+bool
+DebugReplaySensor::Next()
+{
+  last_basic = computed_basic;
+
+  while (reader.Read(raw_basic)) {
+    if (raw_basic.location_available != last_basic.location_available) {
+      Compute();
+      return true;
+    }
+  }
+
+  if (computed_basic.time_available)
+    flying_computer.Finish(calculated.flight, computed_basic.time);
+
+  return false;
+}
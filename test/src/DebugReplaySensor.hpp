@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "DebugReplay.hpp"
+#include "Replay/SensorRecord.hpp"
+#include "io/FileMapping.hpp"
+#include "time/FloatDuration.hxx"
+
+class DebugReplaySensor : public DebugReplay {
+  FileMapping mapping;
+
+  SensorRecordReader reader;
+
+private:
+  explicit DebugReplaySensor(Path input_file);
+
+public:
+  virtual bool Next();
+
+  /**
+   * Continue at the specified offset from the beginning of the
+   * recording.
+   */
+  void Seek(FloatDuration offset);
+
+  static DebugReplaySensor *Create(Path input_file);
+};
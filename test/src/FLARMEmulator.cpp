@@ -10,6 +10,8 @@
 #include "util/SpanCast.hxx"
 #include "util/StaticString.hxx"
 
+#include <cmath>
+
 #include <stdio.h>
 #include <string.h>
 
@@ -219,3 +221,27 @@ FLARMEmulator::LineReceived(const char *_line) noexcept
 
   return true;
 }
+
+void
+FLARMEmulator::SendTraffic(unsigned first_id, unsigned n,
+                           unsigned tick) noexcept
+{
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned id = first_id + i;
+
+    /* each target flies its own circle at 25 m/s */
+    const double radius = 500 + 50 * (id % 64);
+    const double angle = (25. / radius) * tick + id;
+    const int north = (int)(radius * std::cos(angle));
+    const int east = (int)(radius * std::sin(angle));
+    const int vertical = (int)(id % 21) * 20 - 200;
+    const unsigned track =
+      ((int)(angle * 180 / M_PI) + 90) % 360;
+
+    char buffer[128];
+    snprintf(buffer, ARRAY_SIZE(buffer),
+             "PFLAA,0,%d,%d,%d,2,%06X,%u,0,25,1.0,1",
+             north, east, vertical, id & 0xffffff, track);
+    PortWriteNMEA(*port, buffer, *env);
+  }
+}
@@ -24,6 +24,15 @@ public:
     handler = this;
   }
 
+  /**
+   * Send one "PFLAA" sentence for each of the specified number of
+   * simulated targets.  The targets circle around the own aircraft;
+   * their ids are consecutive, starting at @a first_id.
+   *
+   * @param tick the current time [s]
+   */
+  void SendTraffic(unsigned first_id, unsigned n, unsigned tick) noexcept;
+
 private:
   void PFLAC_S(NMEAInputLine &line) noexcept;
   void PFLAC_R(NMEAInputLine &line) noexcept;
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Convert a NMEA log file to a sensor recording (see
+ * #SensorRecorder), which can be replayed much faster by the
+ * DebugReplay programs and by XCSoar.
+ */
+
+#include "Replay/SensorRecord.hpp"
+#include "Device/Driver.hpp"
+#include "Device/Register.hpp"
+#include "Device/Parser.hpp"
+#include "Device/Config.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "NMEA/Info.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "time/ReplayClock.hpp"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "util/PrintException.hxx"
+
+#include <memory>
+
+#include <stdio.h>
+
+int
+main(int argc, char **argv) noexcept
+try {
+  Args args(argc, argv, "DRIVER INFILE.nmea OUTFILE.xsr");
+  const auto driver_name = args.ExpectNextT();
+  const auto input_path = args.ExpectNextPath();
+  const auto output_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  const struct DeviceRegister *driver = FindDriverByName(driver_name.c_str());
+  if (driver == nullptr) {
+    _ftprintf(stderr, _T("No such driver: %s\n"), driver_name.c_str());
+    return EXIT_FAILURE;
+  }
+
+  DeviceConfig config;
+  config.Clear();
+  NullPort port;
+  std::unique_ptr<Device> device(driver->CreateOnPort != nullptr
+                                 ? driver->CreateOnPort(config, port)
+                                 : nullptr);
+
+  NMEAParser parser;
+  parser.SetReal(false);
+
+  ReplayClock clock;
+  clock.Reset();
+
+  FileLineReaderA reader(input_path);
+
+  FileOutputStream file(output_path);
+  SensorRecordWriter writer(file);
+
+  NMEAInfo basic;
+  basic.Reset();
+
+  unsigned n_lines = 0;
+
+  const char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    basic.clock = clock.NextClock(basic.time_available
+                                  ? basic.time
+                                  : TimeStamp::Undefined());
+
+    if ((device != nullptr && device->ParseNMEA(line, basic)) ||
+        parser.ParseLine(line, basic)) {
+      basic.alive.Update(basic.clock);
+
+      /* like DeviceBlackboard::Merge() */
+      basic.Expire();
+
+      writer.Write(basic);
+      ++n_lines;
+    }
+  }
+
+  writer.Finish();
+  file.Commit();
+
+  printf("%u sentences, %zu keyframes, %llu -> %llu bytes\n",
+         n_lines, writer.GetIndex().size(),
+         (unsigned long long)File::GetSize(input_path),
+         (unsigned long long)File::GetSize(output_path));
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -91,7 +91,7 @@ LoadFiles(Airspaces &airspace_database)
   terrain = RasterTerrain::OpenTerrain(nullptr, operation).release();
 
   const AtmosphericPressure pressure = AtmosphericPressure::Standard();
-  ReadAirspace(airspace_database, pressure, operation);
+  ReadAirspace(airspace_database, pressure, nullptr, operation);
 
   if (terrain != nullptr)
     SetAirspaceGroundLevels(airspace_database, *terrain);
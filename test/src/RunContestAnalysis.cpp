@@ -6,11 +6,17 @@
 #include "Printing.hpp"
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
+#include "util/StringCompare.hxx"
 
 #include <cassert>
+#include <chrono>
+#include <vector>
+
 #include <stdio.h>
+#include <stdlib.h>
 
 using namespace std::chrono;
+using Clock = steady_clock;
 
 // Uncomment the following line to use the same trace size as LK8000.
 //#define BENCHMARK_LK8000
@@ -48,10 +54,57 @@ static ContestManager weglide_free(Contest::WEGLIDE_FREE,
 static ContestManager charron(Contest::CHARRON,
                               full_trace, triangle_trace, sprint_trace);
 
+/**
+ * Measures the time spent in ContestManager::UpdateIdle() during the
+ * flight.
+ */
+struct IdleTimer {
+  Clock::duration total{}, max{};
+  unsigned n_calls = 0;
+
+  void Run(ContestManager &manager) noexcept {
+    const auto start = Clock::now();
+    manager.UpdateIdle();
+    const auto duration = Clock::now() - start;
+
+    total += duration;
+    if (duration > max)
+      max = duration;
+    ++n_calls;
+  }
+
+  void Print(const char *name) const noexcept {
+    printf("  %-8s %8.1f us/call, max %8.1f ms\n", name,
+           n_calls > 0
+           ? duration_cast<duration<double, std::micro>>(total).count() / n_calls
+           : 0.,
+           duration_cast<duration<double, std::milli>>(max).count());
+  }
+};
+
+static IdleTimer classic_timer, sprint_timer, league_timer;
+static IdleTimer plus_timer, weglide_timer;
+
+static void
+Push(const TracePoint &point) noexcept
+{
+  triangle_trace.push_back(point);
+  full_trace.push_back(point);
+  sprint_trace.push_back(point);
+
+  classic_timer.Run(olc_classic);
+  sprint_timer.Run(olc_sprint);
+  league_timer.Run(olc_league);
+  plus_timer.Run(olc_plus);
+  weglide_timer.Run(weglide_free);
+}
+
 static int
-TestContest(DebugReplay &replay)
+TestContest(DebugReplay &replay, unsigned repeat)
 {
-  bool released = false;
+  std::vector<TracePoint> flight;
+  std::size_t release_index = 0;
+  TimeStamp release_time = TimeStamp::Undefined();
 
   for (int i = 1; replay.Next(); i++) {
     if (i % 500 == 0) {
@@ -64,23 +117,40 @@ TestContest(DebugReplay &replay)
         !basic.NavAltitudeAvailable())
       continue;
 
-    if (!released && replay.Calculated().flight.release_time.IsDefined()) {
-      released = true;
-
-      triangle_trace.EraseEarlierThan(replay.Calculated().flight.release_time);
-      full_trace.EraseEarlierThan(replay.Calculated().flight.release_time);
-      sprint_trace.EraseEarlierThan(replay.Calculated().flight.release_time);
+    if (!release_time.IsDefined() &&
+        replay.Calculated().flight.release_time.IsDefined()) {
+      release_time = replay.Calculated().flight.release_time;
+      release_index = flight.size();
     }
 
-    const TracePoint point(basic);
-    triangle_trace.push_back(point);
-    full_trace.push_back(point);
-    sprint_trace.push_back(point);
+    flight.emplace_back(basic);
+  }
 
-    olc_sprint.UpdateIdle();
-    olc_league.UpdateIdle();
+  if (flight.empty()) {
+    fputs("No fixes\n", stderr);
+    return EXIT_FAILURE;
   }
 
+  for (std::size_t i = 0; i < flight.size(); ++i) {
+    if (i == release_index && release_time.IsDefined()) {
+      triangle_trace.EraseEarlierThan(release_time);
+      full_trace.EraseEarlierThan(release_time);
+      sprint_trace.EraseEarlierThan(release_time);
+    }
+
+    Push(flight[i]);
+  }
+
+  /* append copies of the flight (without the part before the
+     release), one minute apart, to simulate a long flight */
+  const TracePoint::Time period = flight.back().GetTime()
+    - flight[release_index].GetTime() + minutes{1};
+  for (unsigned r = 1; r < repeat; ++r)
+    for (std::size_t i = release_index; i < flight.size(); ++i)
+      Push(TracePoint(flight[i].GetLocation(),
+                      flight[i].GetTime() + r * period,
+                      flight[i].GetAltitude(), flight[i].GetVario(), 0));
+
   olc_classic.SolveExhaustive();
   olc_fai.SolveExhaustive();
   olc_league.SolveExhaustive();
@@ -94,6 +164,13 @@ TestContest(DebugReplay &replay)
 
   putchar('\n');
 
+  printf("idle (%u calls)\n", sprint_timer.n_calls);
+  classic_timer.Print("classic");
+  sprint_timer.Print("sprint");
+  league_timer.Print("league");
+  plus_timer.Print("plus");
+  weglide_timer.Print("weglide");
+
   std::cout << "classic\n";
   PrintHelper::print(olc_classic.GetStats().GetResult());
   std::cout << "league\n";
@@ -160,14 +237,42 @@ TestContest(DebugReplay &replay)
 
 int main(int argc, char **argv)
 {
-  Args args(argc, argv, "DRIVER FILE");
+  unsigned repeat = 1;
+
+  Args args(argc, argv,
+            "[options] DRIVER FILE\n"
+            "Options:\n"
+            "  --incremental            Solve incrementally, like XCSoar does\n"
+            "                           in flight\n"
+            "  --repeat=N               Append the flight to itself N times,\n"
+            "                           to simulate a long flight");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if (StringIsEqual(arg, "--incremental")) {
+      for (auto *i : {&olc_classic, &olc_fai, &olc_sprint, &olc_league,
+                      &olc_plus, &dmst, &xcontest, &sis_at, &olc_netcoupe,
+                      &weglide_free, &charron})
+        i->SetIncremental(true);
+    } else if ((value = StringAfterPrefix(arg, "--repeat=")) != nullptr) {
+      repeat = strtoul(value, nullptr, 10);
+      if (repeat == 0)
+        args.UsageError();
+    } else {
+      args.UsageError();
+    }
+  }
+
   DebugReplay *replay = CreateDebugReplay(args);
   if (replay == NULL)
     return EXIT_FAILURE;
 
   args.ExpectEnd();
 
-  int result = TestContest(*replay);
+  int result = TestContest(*replay, repeat);
   delete replay;
   return result;
 }
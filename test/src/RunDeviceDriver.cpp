@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "NMEA/Info.hpp"
+#include "FLARM/List.hpp"
 #include "Device/Port/NullPort.hpp"
 #include "Device/Driver.hpp"
 #include "Device/Register.hpp"
@@ -51,7 +52,7 @@ Dump(const ExternalSettings &settings)
 }
 
 static void
-Dump(const NMEAInfo &basic)
+Dump(const NMEAInfo &basic, const TrafficList &traffic)
 {
   if (basic.date_time_utc.IsDatePlausible())
     printf("Date=%02u.%02u.%04u\n",
@@ -143,7 +144,7 @@ Dump(const NMEAInfo &basic)
     printf("FLARM rx=%u tx=%u\n", flarm.status.rx, flarm.status.tx);
     printf("FLARM gps=%u\n", (unsigned)flarm.status.gps);
     printf("FLARM alarm=%u\n", (unsigned)flarm.status.alarm_level);
-    printf("FLARM traffic=%zu\n", flarm.traffic.list.size());
+    printf("FLARM traffic=%u\n", traffic.GetActiveTrafficCount());
   }
 
   if (basic.engine_noise_level_available)
@@ -189,7 +190,11 @@ int main(int argc, char **argv)
     ? driver->CreateOnPort(config, port)
     : nullptr;
 
+  TrafficList traffic;
+  traffic.Clear();
+
   NMEAParser parser;
+  parser.SetTraffic(&traffic);
 
   NMEAInfo data;
   data.Reset();
@@ -202,7 +207,7 @@ int main(int argc, char **argv)
       parser.ParseLine(buffer, data);
   }
 
-  Dump(data);
+  Dump(data, traffic);
 
   return EXIT_SUCCESS;
 }
@@ -1,27 +1,189 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // Copyright The XCSoar Project
 
+/*
+ * Feed a flight into the three traces kept by #TraceComputer (full,
+ * contest and sprint), once with a private #TracePointStore for each
+ * and once with one shared store.  Prints the time per fix and the
+ * memory used by the trace points, and verifies that both variants
+ * end up with the same points.
+ */
+
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
 #include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "util/StringCompare.hxx"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+using Clock = steady_clock;
+
+/* see TraceComputer.cpp */
+static constexpr unsigned full_trace_size = 1024;
+static constexpr unsigned contest_trace_size = 256;
+static constexpr unsigned sprint_trace_size = 128;
+static constexpr auto full_trace_no_thin_time = minutes{2};
+
+struct TraceSet {
+  TracePointStore store;
+  std::array<Trace, 3> traces;
+
+  /**
+   * @param shared use #store for all traces?  Otherwise, each one
+   * uses its own store
+   */
+  explicit TraceSet(bool shared) noexcept
+    :traces(shared
+            ? std::array<Trace, 3>{
+                Trace{store, full_trace_no_thin_time, Trace::null_time, full_trace_size},
+                Trace{store, {}, Trace::null_time, contest_trace_size},
+                Trace{store, {}, minutes{150}, sprint_trace_size},
+              }
+            : std::array<Trace, 3>{
+                Trace{full_trace_no_thin_time, Trace::null_time, full_trace_size},
+                Trace{{}, Trace::null_time, contest_trace_size},
+                Trace{{}, minutes{150}, sprint_trace_size},
+              }) {}
+
+  void push_back(const TracePoint &point) noexcept {
+    for (auto &i : traces)
+      i.push_back(point);
+  }
+
+  /**
+   * The number of bytes used by the trace points, not counting
+   * allocator overhead.
+   */
+  std::size_t GetMemory() const noexcept {
+    std::size_t result = 0;
+    for (const auto &i : traces) {
+      result += i.size() * Trace::BYTES_PER_POINT;
+      if (&i.GetStore() != &store)
+        result += i.GetStore().size() * TracePointStore::BYTES_PER_POINT;
+    }
+
+    result += store.size() * TracePointStore::BYTES_PER_POINT;
+    return result;
+  }
+};
+
+static void
+Run(const char *name, bool shared, const std::vector<TracePoint> &points,
+    std::array<TracePointVector, 3> &result)
+{
+  TraceSet set(shared);
+
+  std::size_t peak_memory = 0;
+  Clock::duration elapsed{};
+
+  for (const auto &point : points) {
+    const auto start = Clock::now();
+    set.push_back(point);
+    elapsed += Clock::now() - start;
+
+    peak_memory = std::max(peak_memory, set.GetMemory());
+  }
+
+  for (unsigned i = 0; i < set.traces.size(); ++i)
+    set.traces[i].GetPoints(result[i]);
+
+  printf("  %-10s %6.2f us/fix, peak %6zu kB, final %6zu kB\n",
+         name,
+         duration_cast<duration<double, std::micro>>(elapsed).count()
+         / points.size(),
+         peak_memory / 1024, set.GetMemory() / 1024);
+}
+
+static bool
+Equals(const TracePointVector &a, const TracePointVector &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const TracePoint &x, const TracePoint &y){
+                      return x.GetTime() == y.GetTime() &&
+                        x.GetLocation() == y.GetLocation() &&
+                        x.GetFlatLocation() == y.GetFlatLocation();
+                    });
+}
 
 int main(int argc, char **argv)
 {
-  Args args(argc, argv, "DRIVER FILE");
+  unsigned repeat = 1;
+
+  Args args(argc, argv,
+            "[options] DRIVER FILE\n"
+            "Options:\n"
+            "  --repeat=N               Append the flight to itself N times,\n"
+            "                           to simulate a long flight");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--repeat=")) != nullptr) {
+      repeat = strtoul(value, nullptr, 10);
+      if (repeat == 0)
+        args.UsageError();
+    } else {
+      args.UsageError();
+    }
+  }
+
   DebugReplay *replay = CreateDebugReplay(args);
   if (replay == NULL)
     return EXIT_FAILURE;
 
   args.ExpectEnd();
 
-  Trace trace;
+  std::vector<TracePoint> flight;
 
   while (replay->Next()) {
     const MoreData &basic = replay->Basic();
     if (basic.time_available && basic.location_available &&
         basic.NavAltitudeAvailable())
-      trace.push_back(TracePoint(basic));
+      flight.emplace_back(basic);
   }
 
   delete replay;
+
+  if (flight.empty()) {
+    fputs("No fixes\n", stderr);
+    return EXIT_FAILURE;
+  }
+
+  /* concatenate copies of the flight, one minute apart */
+  const TracePoint::Time period = flight.back().GetTime()
+    - flight.front().GetTime() + minutes{1};
+
+  std::vector<TracePoint> points;
+  points.reserve(flight.size() * repeat);
+  for (unsigned i = 0; i < repeat; ++i)
+    for (const auto &p : flight)
+      points.emplace_back(p.GetLocation(), p.GetTime() + i * period,
+                          p.GetAltitude(), p.GetVario(), 0);
+
+  printf("%zu fixes, %u hours\n", points.size(),
+         unsigned(duration_cast<hours>(points.back().GetTime()
+                                       - points.front().GetTime()).count()));
+
+  std::array<TracePointVector, 3> separate_result, shared_result;
+  Run("separate", false, points, separate_result);
+  Run("shared", true, points, shared_result);
+
+  for (unsigned i = 0; i < separate_result.size(); ++i) {
+    if (!Equals(separate_result[i], shared_result[i])) {
+      fprintf(stderr, "Trace %u differs\n", i);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
 }
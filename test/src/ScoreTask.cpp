@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Evaluate many IGC files against one task (e.g. all flights of a
+ * competition day) and print the results as CSV.
+ */
+
+#include "TaskScoring.hpp"
+#include "system/Args.hpp"
+#include "Task/TaskFile.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "thread/ThreadPool.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
+
+#include <chrono>
+#include <list>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void
+PrintTime(TimeStamp t)
+{
+  if (t.IsDefined())
+    printf("%u", unsigned(t.Cast<std::chrono::seconds>().count()));
+}
+
+static void
+Print(const FlightScore &score)
+{
+  printf("%s,%d", score.path.ToUTF8().c_str(), score.valid);
+
+  if (!score.valid) {
+    printf(",,,,,,,,\n");
+    return;
+  }
+
+  printf(",%d,%d,", score.started, score.finished);
+  PrintTime(score.start_time);
+  putchar(',');
+  PrintTime(score.finish_time);
+  printf(",%.0f,%.3f,%.3f,%.2f\n",
+         score.elapsed.count(),
+         score.travelled_distance / 1000,
+         score.scored_distance / 1000,
+         score.scored_speed * 3.6);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] TASKFILE FILE.igc ...\n"
+            "Options:\n"
+            "  --threads=N              Number of threads (default = number of CPUs)");
+
+  unsigned n_threads = ThreadPool::GetDefaultConcurrency();
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr) {
+      n_threads = strtoul(value, nullptr, 10);
+      if (n_threads == 0) {
+        fputs("The threads parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+    } else {
+      args.UsageError();
+    }
+  }
+
+  const auto task_path = args.ExpectNextPath();
+
+  /* keep the converted strings alive (only relevant for
+     _UNICODE builds) */
+  std::list<decltype(args.ExpectNextPath())> flight_storage;
+  std::vector<Path> flights;
+  do {
+    flights.emplace_back(flight_storage.emplace_back(args.ExpectNextPath()));
+  } while (!args.IsEmpty());
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  auto task = TaskFile::GetTask(task_path, task_behaviour, nullptr, 0);
+  if (task == nullptr) {
+    fprintf(stderr, "Failed to load task\n");
+    return EXIT_FAILURE;
+  }
+
+  task->UpdateGeometry();
+
+  const GlidePolar glide_polar(1);
+
+  ThreadPool pool(n_threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto scores = ScoreFlights(*task, task_behaviour, glide_polar,
+                                   flights, pool);
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+
+  printf("file,valid,started,finished,start_time,finish_time,"
+         "elapsed_s,travelled_km,scored_km,scored_speed_kph\n");
+  for (const auto &score : scores)
+    Print(score);
+
+  fprintf(stderr, "scored %zu flights on %u threads in %.3f s\n",
+          scores.size(), pool.GetConcurrency(), duration.count());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TaskScoring.hpp"
+#include "DebugReplayIGC.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <memory>
+
+static void
+Run(DebugReplay &replay, OrderedTask &task, const GlidePolar &glide_polar)
+{
+  Validity last_location_available;
+  last_location_available.Clear();
+
+  AircraftState last_as;
+
+  while (replay.Next()) {
+    const MoreData &basic = replay.Basic();
+
+    if (!basic.location_available) {
+      last_location_available.Clear();
+      continue;
+    }
+
+    const AircraftState current_as =
+      ToAircraftState(basic, replay.Calculated());
+
+    if (!last_location_available) {
+      last_as = current_as;
+      last_location_available = basic.location_available;
+      continue;
+    }
+
+    if (!basic.location_available.Modified(last_location_available))
+      continue;
+
+    task.Update(current_as, last_as, glide_polar);
+    task.UpdateIdle(current_as, glide_polar);
+    task.SetTaskAdvance().SetArmed(true);
+
+    last_as = current_as;
+    last_location_available = basic.location_available;
+  }
+}
+
+FlightScore
+ScoreFlight(const OrderedTask &_task, const TaskBehaviour &task_behaviour,
+            const GlidePolar &glide_polar, Path path)
+{
+  FlightScore score;
+  score.path = path;
+
+  std::unique_ptr<DebugReplay> replay;
+  try {
+    replay.reset(DebugReplayIGC::Create(path));
+  } catch (...) {
+    return score;
+  }
+
+  const auto task = _task.Clone(task_behaviour);
+  task->Reset();
+
+  Run(*replay, *task, glide_polar);
+
+  const TaskStats &stats = task->GetStats();
+
+  score.valid = true;
+  score.started = stats.start.HasStarted();
+  score.finished = stats.task_finished;
+  score.elapsed = stats.total.time_elapsed;
+  score.travelled_distance = stats.total.travelled.GetDistance();
+  score.scored_distance = stats.distance_scored;
+
+  if (score.started) {
+    score.start_time = stats.start.GetStartedTime();
+    if (score.finished)
+      score.finish_time = score.start_time + score.elapsed;
+  }
+
+  if (score.elapsed.count() > 0)
+    score.scored_speed = score.scored_distance / score.elapsed.count();
+
+  return score;
+}
+
+std::vector<FlightScore>
+ScoreFlights(const OrderedTask &task, const TaskBehaviour &task_behaviour,
+             const GlidePolar &glide_polar,
+             std::span<const Path> paths, ThreadPool &pool)
+{
+  std::vector<FlightScore> scores(paths.size());
+
+  pool.ParallelFor(paths.size(), [&](std::size_t i){
+    scores[i] = ScoreFlight(task, task_behaviour, glide_polar, paths[i]);
+  });
+
+  return scores;
+}
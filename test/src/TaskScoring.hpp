@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "system/Path.hpp"
+#include "time/Stamp.hpp"
+
+#include <span>
+#include <vector>
+
+class OrderedTask;
+class GlidePolar;
+class ThreadPool;
+struct TaskBehaviour;
+
+/**
+ * The result of evaluating one flight against a task.
+ */
+struct FlightScore {
+  AllocatedPath path;
+
+  /**
+   * False if the flight could not be loaded; all other attributes
+   * are undefined then.
+   */
+  bool valid = false;
+
+  bool started = false, finished = false;
+
+  /**
+   * Start and finish time [UTC seconds of day].  Only defined if
+   * #started / #finished is set.
+   */
+  TimeStamp start_time = TimeStamp::Undefined();
+  TimeStamp finish_time = TimeStamp::Undefined();
+
+  /**
+   * Elapsed task time [s].
+   */
+  FloatDuration elapsed{};
+
+  /**
+   * Travelled and scored (achieved) distance [m].
+   */
+  double travelled_distance = 0, scored_distance = 0;
+
+  /**
+   * Scored speed [m/s]; zero if no time has elapsed.
+   */
+  double scored_speed = 0;
+};
+
+/**
+ * Evaluate one flight (IGC file) against a private copy of the given
+ * task.  The task itself is not modified, so several threads may
+ * call this function concurrently with the same task.
+ *
+ * A file which cannot be opened yields a score which is not
+ * #FlightScore::valid.  Throws on other errors.
+ */
+FlightScore
+ScoreFlight(const OrderedTask &task, const TaskBehaviour &task_behaviour,
+            const GlidePolar &glide_polar, Path path);
+
+/**
+ * Evaluate many flights against the same task on the given
+ * #ThreadPool.  The task geometry and its waypoints are shared by
+ * all flights; each flight gets a lightweight clone holding only its
+ * own progress.
+ *
+ * Throws the exception of the first ScoreFlight() call which failed.
+ *
+ * @return one #FlightScore for each path, in the same order
+ */
+std::vector<FlightScore>
+ScoreFlights(const OrderedTask &task, const TaskBehaviour &task_behaviour,
+             const GlidePolar &glide_polar,
+             std::span<const Path> paths, ThreadPool &pool);
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Airspace/AirspaceCache.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/MemoryReader.hxx"
+#include "io/StringOutputStream.hxx"
+#include "system/Path.hpp"
+#include "util/SpanCast.hxx"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <tchar.h>
+
+static const std::array<Path, 2> sources{
+  Path(_T("test/data/airspace/openair.txt")),
+  Path(_T("test/data/AirspaceAus-DAA.txt")),
+};
+
+static void
+ParseFile(Path path, Airspaces &airspaces)
+{
+  FileReader file_reader{path};
+  BufferedReader buffered_reader{file_reader};
+  ParseAirspaceFile(airspaces, buffered_reader);
+}
+
+static std::string
+Save(const Airspaces &airspaces, std::span<const Path> _sources)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  SaveAirspaceCache(bos, _sources, airspaces);
+  bos.Flush();
+  return std::move(sos).GetValue();
+}
+
+static bool
+Load(const std::string &data, std::span<const Path> _sources,
+     Airspaces &airspaces)
+{
+  MemoryReader reader{AsBytes(data)};
+  BufferedReader br{reader};
+  return LoadAirspaceCache(br, _sources, airspaces);
+}
+
+using AirspaceKey = std::tuple<tstring, tstring, unsigned, RadioFrequency,
+                               double, double, double, double,
+                               unsigned, double, double, double>;
+
+/**
+ * Describe an airspace in a comparable way; the #Airspaces tree
+ * order is not specified, so the descriptions are sorted.
+ */
+static std::vector<AirspaceKey>
+Describe(const Airspaces &airspaces)
+{
+  std::vector<AirspaceKey> result;
+
+  for (const auto &i : airspaces.QueryAll()) {
+    const AbstractAirspace &as = i.GetAirspace();
+    const auto &points = as.GetPoints();
+    const GeoPoint first = points.front().GetLocation();
+    const GeoPoint last = points[points.size() / 2].GetLocation();
+    const double radius = as.GetShape() == AbstractAirspace::Shape::CIRCLE
+      ? ((const AirspaceCircle &)as).GetRadius()
+      : 0;
+
+    result.emplace_back(as.GetName(), as.GetType(),
+                        unsigned(as.GetClass()),
+                        as.GetRadioFrequency(),
+                        as.GetBase().altitude, as.GetBase().flight_level,
+                        as.GetTop().altitude, as.GetTop().flight_level,
+                        unsigned(points.size()),
+                        first.latitude.Degrees() + first.longitude.Degrees(),
+                        last.latitude.Degrees() + last.longitude.Degrees(),
+                        radius);
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+int main()
+try {
+  plan_tests(10);
+
+  Airspaces parsed;
+  for (const Path path : sources)
+    ParseFile(path, parsed);
+  parsed.Optimise();
+
+  const auto data = Save(parsed, sources);
+  ok1(!data.empty());
+
+  /* round trip */
+  Airspaces loaded;
+  ok1(Load(data, sources, loaded));
+  loaded.Optimise();
+  ok1(loaded.GetSize() == parsed.GetSize());
+  ok1(Describe(loaded) == Describe(parsed));
+
+  /* the bounding boxes must be the same after loading */
+  const GeoPoint location(Angle::Degrees(146), Angle::Degrees(-36.5));
+  ok1(std::distance(loaded.QueryWithinRange(location, 100000).begin(),
+                    loaded.QueryWithinRange(location, 100000).end()) ==
+      std::distance(parsed.QueryWithinRange(location, 100000).begin(),
+                    parsed.QueryWithinRange(location, 100000).end()));
+
+  /* a different set of source files makes the cache stale */
+  {
+    Airspaces airspaces;
+    ok1(!Load(data, std::span{sources}.first(1), airspaces));
+    ok1(airspaces.IsEmpty());
+
+    const std::array<Path, 2> other{sources[1], sources[0]};
+    ok1(!Load(data, other, airspaces));
+  }
+
+  /* a truncated file is an error */
+  {
+    Airspaces airspaces;
+    try {
+      Load(data.substr(0, data.size() / 2), sources, airspaces);
+      ok1(false);
+    } catch (...) {
+      ok1(true);
+    }
+  }
+
+  /* empty airspace set */
+  {
+    Airspaces empty;
+    Airspaces airspaces;
+    ok1(Load(Save(empty, sources), sources, airspaces) &&
+        airspaces.IsEmpty());
+  }
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Test #AsyncOutputStream with a fake #OutputStream which blocks
+ * until the test opens it, like a stalled storage device: producers
+ * must not be blocked by it, no line may be torn or lost (unless the
+ * ring buffer overflows in DISCARD mode), and Flush() must wait for
+ * the data.  The tests only check counters and the written data, not
+ * the timing.
+ */
+
+#include "Logger/AsyncOutputStream.hpp"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "util/SpanCast.hxx"
+#include "util/StringSplit.hxx"
+#include "TestUtil.hpp"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace std::chrono;
+
+/**
+ * An #OutputStream whose Write() blocks while the gate is closed.
+ */
+class GatedOutputStream final : public OutputStream {
+  Mutex mutex;
+  Cond cond;
+
+  bool open;
+
+  /**
+   * The number of Write() calls which have been entered.
+   */
+  unsigned n_entered = 0;
+
+  /**
+   * Throw an exception after this number of Write() calls.
+   */
+  const unsigned fail_after;
+
+public:
+  std::string data;
+  unsigned n_writes = 0;
+
+  explicit GatedOutputStream(bool _open, unsigned _fail_after=~0u) noexcept
+    :open(_open), fail_after(_fail_after) {}
+
+  void Open() noexcept {
+    const std::lock_guard lock{mutex};
+    open = true;
+    cond.notify_all();
+  }
+
+  /**
+   * Wait until the writer thread has entered Write().
+   */
+  void WaitEntered() noexcept {
+    std::unique_lock lock{mutex};
+    cond.wait(lock, [this]{ return n_entered > 0; });
+  }
+
+  /* virtual methods from class OutputStream */
+  void Write(std::span<const std::byte> src) override {
+    std::unique_lock lock{mutex};
+    ++n_entered;
+    cond.notify_all();
+    cond.wait(lock, [this]{ return open; });
+
+    if (n_writes++ >= fail_after)
+      throw std::runtime_error("Simulated I/O error");
+
+    data.append(ToStringView(src));
+  }
+};
+
+static std::string
+MakeLine(unsigned producer, unsigned i)
+{
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%u:%u\n", producer, i);
+  return buffer;
+}
+
+/**
+ * Parse the output and check that each producer's lines are intact
+ * and in order.
+ *
+ * @return the number of lines, or -1 if a line is malformed
+ */
+static int
+CheckLines(std::string_view data, unsigned n_producers)
+{
+  if (!data.empty() && data.back() != '\n')
+    return -1;
+
+  std::vector<int> last_index(n_producers, -1);
+  int n = 0;
+
+  while (!data.empty()) {
+    auto [line, rest] = Split(data, '\n');
+    data = rest;
+
+    unsigned producer, i;
+    char dummy;
+    if (sscanf(std::string{line}.c_str(), "%u:%u%c",
+               &producer, &i, &dummy) != 2 ||
+        producer >= n_producers || (int)i <= last_index[producer])
+      return -1;
+
+    last_index[producer] = i;
+    ++n;
+  }
+
+  return n;
+}
+
+class Producer final : public Thread {
+  AsyncOutputStream &os;
+  const unsigned id, n_lines;
+
+public:
+  Producer(AsyncOutputStream &_os, unsigned _id, unsigned _n_lines) noexcept
+    :Thread("producer"), os(_os), id(_id), n_lines(_n_lines) {}
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    for (unsigned i = 0; i < n_lines; ++i)
+      os.Write(AsBytes(MakeLine(id, i)));
+  }
+};
+
+/**
+ * Several producers write concurrently while the underlying stream
+ * is blocked.
+ */
+static void
+TestConcurrent()
+{
+  static constexpr unsigned N_PRODUCERS = 4, N_LINES = 500;
+
+  GatedOutputStream gated{false};
+
+  AsyncOutputStream os{"writer", gated,
+                       AsyncOutputStream::Overflow::DISCARD, 4096,
+                       seconds(60)};
+
+  std::unique_ptr<Producer> producers[N_PRODUCERS];
+  for (unsigned i = 0; i < N_PRODUCERS; ++i)
+    producers[i] = std::make_unique<Producer>(os, i, N_LINES);
+
+  for (auto &i : producers)
+    i->Start();
+
+  /* the producers finish even though the underlying stream is
+     blocked */
+  for (auto &i : producers)
+    i->Join();
+
+  gated.Open();
+  os.Flush();
+
+  ok1(CheckLines(gated.data, N_PRODUCERS) == N_PRODUCERS * N_LINES);
+
+  const auto stats = os.GetStatistics();
+  printf("# %u batches\n", (unsigned)stats.batches);
+
+  ok1(stats.discarded == 0);
+  ok1(stats.stalls == 0);
+  ok1(stats.written_bytes == gated.data.size());
+  ok1(stats.batches == gated.n_writes);
+
+  /* the lines were written in batches, not one by one */
+  ok1(stats.batches < N_PRODUCERS * N_LINES / 10);
+}
+
+/**
+ * Fill the ring buffer of a small #AsyncOutputStream while the writer
+ * thread is blocked in the underlying stream: write two lines (which
+ * wakes up the writer thread at half fill), and wait until it is
+ * blocked; after that, the ring buffer is empty.
+ */
+static void
+BlockWriter(AsyncOutputStream &os, GatedOutputStream &gated)
+{
+  os.Write(AsBytes(MakeLine(0, 0)));
+  os.Write(AsBytes(MakeLine(0, 1)));
+  gated.WaitEntered();
+}
+
+/**
+ * A small ring buffer in DISCARD mode drops whole writes, but never
+ * tears them.
+ */
+static void
+TestDiscard()
+{
+  GatedOutputStream gated{false};
+  AsyncOutputStream os{"writer", gated,
+                       AsyncOutputStream::Overflow::DISCARD, 4,
+                       seconds(60)};
+
+  BlockWriter(os, gated);
+
+  /* occupy three of the four slots */
+  for (unsigned i = 2; i < 5; ++i)
+    os.Write(AsBytes(MakeLine(0, i)));
+
+  /* a write which needs two slots doesn't fit and is dropped
+     completely */
+  const std::string big(AsyncOutputStream::SLOT_SIZE * 3 / 2, 'x');
+  os.Write(AsBytes(big));
+
+  /* this one fits into the last slot */
+  os.Write(AsBytes(MakeLine(0, 5)));
+
+  /* full */
+  os.Write(AsBytes(MakeLine(0, 6)));
+
+  /* larger than the whole ring buffer */
+  const std::string huge(AsyncOutputStream::SLOT_SIZE * 5, 'y');
+  os.Write(AsBytes(huge));
+
+  gated.Open();
+  os.Flush();
+
+  const auto stats = os.GetStatistics();
+  ok1(stats.discarded == 3);
+  ok1(stats.stalls == 0);
+  ok1(CheckLines(gated.data, 1) == 6);
+}
+
+class BigWriter final : public Thread {
+  AsyncOutputStream &os;
+  const std::string &big;
+
+public:
+  BigWriter(AsyncOutputStream &_os, const std::string &_big) noexcept
+    :Thread("big"), os(_os), big(_big) {}
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    os.Write(AsBytes(big));
+    os.Write(AsBytes(MakeLine(0, 6)));
+  }
+};
+
+/**
+ * A small ring buffer in WAIT mode never loses data.
+ */
+static void
+TestWait()
+{
+  GatedOutputStream gated{false};
+  AsyncOutputStream os{"writer", gated,
+                       AsyncOutputStream::Overflow::WAIT, 4,
+                       seconds(60)};
+
+  BlockWriter(os, gated);
+
+  /* fill all four slots */
+  for (unsigned i = 2; i < 6; ++i)
+    os.Write(AsBytes(MakeLine(0, i)));
+
+  /* a write larger than one slot, which must wait for room */
+  const std::string big(AsyncOutputStream::SLOT_SIZE * 3 / 2, 'x');
+  BigWriter writer{os, big};
+  writer.Start();
+
+  while (os.GetStatistics().stalls == 0)
+    std::this_thread::sleep_for(milliseconds(1));
+
+  gated.Open();
+  writer.Join();
+  os.Flush();
+
+  const auto stats = os.GetStatistics();
+  ok1(stats.discarded == 0);
+  ok1(stats.stalls == 1);
+
+  std::string expected;
+  for (unsigned i = 0; i < 6; ++i)
+    expected += MakeLine(0, i);
+  expected += big;
+  expected += MakeLine(0, 6);
+  ok1(gated.data == expected);
+}
+
+/**
+ * The destructor writes all pending data.
+ */
+static void
+TestDestructor()
+{
+  GatedOutputStream gated{true};
+
+  {
+    AsyncOutputStream os{"writer", gated,
+                         AsyncOutputStream::Overflow::WAIT, 64,
+                         seconds(60)};
+    for (unsigned i = 0; i < 10; ++i)
+      os.Write(AsBytes(MakeLine(0, i)));
+  }
+
+  ok1(CheckLines(gated.data, 1) == 10);
+}
+
+/**
+ * Errors of the underlying stream are reported by Flush().
+ */
+static void
+TestError()
+{
+  GatedOutputStream gated{true, 0};
+  AsyncOutputStream os{"writer", gated, AsyncOutputStream::Overflow::WAIT};
+
+  os.Write(AsBytes(MakeLine(0, 0)));
+
+  try {
+    os.Flush();
+    ok1(false);
+  } catch (const std::runtime_error &) {
+    ok1(true);
+  }
+
+  /* writing after an error doesn't block */
+  os.Write(AsBytes(MakeLine(0, 1)));
+  ok1(gated.data.empty());
+}
+
+int main()
+{
+  plan_tests(15);
+
+  TestConcurrent();
+  TestDiscard();
+  TestWait();
+  TestDestructor();
+  TestError();
+
+  return exit_status();
+}
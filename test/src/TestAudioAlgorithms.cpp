@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Verify that the optimised PCM algorithms produce exactly the same
+ * results as the portable scalar code.
+ */
+
+#include "Audio/AudioAlgorithms.hpp"
+#include "Audio/ToneSynthesiser.hpp"
+#include "Math/FastTrig.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * All 16 bit sample values, plus an odd remainder for the scalar
+ * code.
+ */
+static constexpr size_t N_SAMPLES = 65536 + 5;
+
+static std::vector<int16_t>
+MakeSource()
+{
+  std::vector<int16_t> v(N_SAMPLES);
+  for (size_t i = 0; i < N_SAMPLES; ++i)
+    v[i] = static_cast<int16_t>(i * 40503);
+  return v;
+}
+
+static std::vector<int16_t>
+MakeDestination()
+{
+  std::vector<int16_t> v(N_SAMPLES);
+  for (size_t i = 0; i < N_SAMPLES; ++i)
+    v[i] = static_cast<int16_t>(i * 7919 + 12345);
+  return v;
+}
+
+static constexpr unsigned volumes[] = {
+  1, 3, 7, 33, 50, 99, 100, 101, 150, 255, 1000, 32767,
+};
+
+static void
+TestMixPCM()
+{
+  const auto src = MakeSource();
+  const auto initial = MakeDestination();
+
+  for (const unsigned volume : volumes) {
+    auto expected = initial;
+    MixPCM(expected.data(), N_SAMPLES, volume,
+           [&src](size_t i) { return src[i]; });
+
+    auto actual = initial;
+    MixPCM(actual.data(), src.data(), N_SAMPLES, volume);
+
+    ok1(actual == expected);
+  }
+}
+
+static void
+TestByteSwapAndMixPCM()
+{
+  const auto src = MakeSource();
+  const auto initial = MakeDestination();
+
+  for (const unsigned volume : volumes) {
+    auto expected = initial;
+    MixPCM(expected.data(), N_SAMPLES, volume,
+           [&src](size_t i) {
+             return static_cast<int32_t>(GenericByteSwap16(src[i]));
+           });
+
+    auto actual = initial;
+    ByteSwapAndMixPCM(actual.data(), src.data(), N_SAMPLES, volume);
+
+    ok1(actual == expected);
+  }
+}
+
+/**
+ * Check ToneSynthesiser against the scalar formula, with buffer
+ * sizes which are not a multiple of the vector size.
+ */
+static void
+TestTone(unsigned tone_hz, unsigned volume)
+{
+  static constexpr unsigned sample_rate = 44100;
+
+  ToneSynthesiser tone(sample_rate);
+  tone.SetTone(tone_hz);
+  tone.SetVolume(volume);
+
+  const unsigned increment = ISINETABLE.size() * tone_hz / sample_rate;
+  unsigned angle = 0;
+
+  bool equal = true;
+  int16_t buffer[333];
+  for (unsigned n = 1; n <= std::size(buffer); n += 37) {
+    tone.Synthesise(buffer, n);
+
+    for (unsigned i = 0; i < n; ++i) {
+      const int16_t expected = ISINETABLE[angle] * (32767 / 1024)
+        * (int)volume / 100;
+      if (buffer[i] != expected)
+        equal = false;
+
+      angle = (angle + increment) & (ISINETABLE.size() - 1);
+    }
+  }
+
+  ok1(equal);
+}
+
+int main()
+{
+  plan_tests(2 * std::size(volumes) + 6);
+
+  TestMixPCM();
+  TestByteSwapAndMixPCM();
+
+  TestTone(500, 100);
+  TestTone(200, 1);
+  TestTone(1500, 37);
+  TestTone(880, 0);
+  TestTone(440, 120);
+  TestTone(20000, 99);
+
+  return exit_status();
+}
@@ -41,6 +41,7 @@
 #include "Logger/Settings.hpp"
 #include "Plane/Plane.hpp"
 #include "NMEA/Info.hpp"
+#include "FLARM/List.hpp"
 #include "Protection.hpp"
 #include "Input/InputEvents.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
@@ -145,7 +146,11 @@ TestTasman()
 static void
 TestFLARM()
 {
+  TrafficList traffic_list;
+  traffic_list.Clear();
+
   NMEAParser parser;
+  parser.SetTraffic(&traffic_list);
 
   NMEAInfo nmea_info;
   nmea_info.Reset();
@@ -157,17 +162,17 @@ TestFLARM()
   ok1(nmea_info.flarm.status.tx);
   ok1(nmea_info.flarm.status.gps == FlarmStatus::GPSStatus::GPS_2D);
   ok1(nmea_info.flarm.status.alarm_level == FlarmTraffic::AlarmType::NONE);
-  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 0);
-  ok1(!nmea_info.flarm.traffic.new_traffic);
+  ok1(traffic_list.GetActiveTrafficCount() == 0);
+  ok1(!traffic_list.new_traffic);
 
   ok1(parser.ParseLine("$PFLAA,0,100,-150,10,2,DDA85C,123,13,24,1.4,2*7f",
                                       nmea_info));
-  ok1(nmea_info.flarm.traffic.new_traffic);
-  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 1);
+  ok1(traffic_list.new_traffic);
+  ok1(traffic_list.GetActiveTrafficCount() == 1);
 
   FlarmId id = FlarmId::Parse("DDA85C", NULL);
 
-  FlarmTraffic *traffic = nmea_info.flarm.traffic.FindTraffic(id);
+  FlarmTraffic *traffic = traffic_list.FindTraffic(id);
   if (ok1(traffic != NULL)) {
     ok1(traffic->valid);
     ok1(traffic->alarm_level == FlarmTraffic::AlarmType::NONE);
@@ -190,10 +195,10 @@ TestFLARM()
 
   ok1(parser.ParseLine("$PFLAA,2,20,10,24,2,DEADFF,,,,,1*46",
                                       nmea_info));
-  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 2);
+  ok1(traffic_list.GetActiveTrafficCount() == 2);
 
   id = FlarmId::Parse("DEADFF", NULL);
-  traffic = nmea_info.flarm.traffic.FindTraffic(id);
+  traffic = traffic_list.FindTraffic(id);
   if (ok1(traffic != NULL)) {
     ok1(traffic->valid);
     ok1(traffic->alarm_level == FlarmTraffic::AlarmType::IMPORTANT);
@@ -212,10 +217,10 @@ TestFLARM()
 
   ok1(parser.ParseLine("$PFLAA,0,1206,574,21,2,DDAED5,196,,32,1.0,C*62",
                        nmea_info));
-  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 3);
+  ok1(traffic_list.GetActiveTrafficCount() == 3);
 
   id = FlarmId::Parse("DDAED5", NULL);
-  traffic = nmea_info.flarm.traffic.FindTraffic(id);
+  traffic = traffic_list.FindTraffic(id);
   if (ok1(traffic != NULL)) {
     ok1(traffic->valid);
     ok1(traffic->alarm_level == FlarmTraffic::AlarmType::NONE);
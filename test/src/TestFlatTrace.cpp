@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Feed the same synthetic flights into #Trace and #FlatTrace and
+ * verify that both keep exactly the same points after each fix.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/FlatTrace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "TraceGenerator.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static bool
+Equals(const TracePoint &a, const TracePoint &b) noexcept
+{
+  return a.GetTime() == b.GetTime() &&
+    a.GetLocation() == b.GetLocation() &&
+    a.GetFlatLocation() == b.GetFlatLocation();
+}
+
+static bool
+Equals(const Trace &a, const FlatTrace &b) noexcept
+{
+  if (a.size() != b.size() ||
+      a.GetAverageDeltaDistance() != b.GetAverageDeltaDistance() ||
+      a.GetAverageDeltaTime() != b.GetAverageDeltaTime())
+    return false;
+
+  auto j = b.begin();
+  for (const auto &i : a) {
+    if (!Equals(i, *j))
+      return false;
+    ++j;
+  }
+
+  return j == b.end();
+}
+
+static void
+TestCompare(const char *name, TracePoint::Time no_thin_time,
+            TracePoint::Time max_time, unsigned max_size,
+            bool time_warps)
+{
+  for (unsigned seed = 1; seed <= 3; ++seed) {
+    const auto flight = GenerateFlight(seed, 20000, time_warps);
+
+    Trace trace(no_thin_time, max_time, max_size);
+    FlatTrace flat(no_thin_time, max_time, max_size);
+
+    bool equal = true;
+    unsigned n_modified = 0;
+    for (const auto &point : flight) {
+      const auto serial = trace.GetModifySerial();
+      const auto flat_serial = flat.GetModifySerial();
+
+      trace.push_back(point);
+      flat.push_back(point);
+
+      if (trace.GetModifySerial() != serial) {
+        ++n_modified;
+        if (flat.GetModifySerial() == flat_serial)
+          equal = false;
+      }
+
+      if (!Equals(trace, flat)) {
+        equal = false;
+        break;
+      }
+    }
+
+    ok(equal && n_modified > 0, "%s seed %u", name, seed);
+  }
+}
+
+static void
+TestGetPoints()
+{
+  const auto flight = GenerateFlight(42, 3000);
+
+  Trace trace({}, Trace::null_time, 256);
+  FlatTrace flat({}, FlatTrace::null_time, 256);
+
+  for (const auto &point : flight) {
+    trace.push_back(point);
+    flat.push_back(point);
+  }
+
+  TracePointVector a, b;
+  trace.GetPoints(a);
+  flat.GetPoints(b);
+  ok1(a.size() == b.size() &&
+      std::equal(a.begin(), a.end(), b.begin(),
+                 [](const TracePoint &x, const TracePoint &y){
+                   return Equals(x, y);
+                 }));
+
+  const GeoPoint &location = flight.back().GetLocation();
+  const auto min_time = flight[flight.size() / 2].GetTime();
+  a.clear();
+  b.clear();
+  trace.GetPoints(a, min_time, location, 500);
+  flat.GetPoints(b, min_time, location, 500);
+  ok1(!a.empty() && a.size() == b.size() &&
+      std::equal(a.begin(), a.end(), b.begin(),
+                 [](const TracePoint &x, const TracePoint &y){
+                   return Equals(x, y);
+                 }));
+
+  /* appending keeps pointers valid, SyncPoints() adds the new ones */
+  TracePointerVector v;
+  flat.GetPoints(v);
+  const unsigned old_size = v.size();
+  const auto modify_serial = flat.GetModifySerial();
+  flat.push_back(TracePoint(location, flight.back().GetTime() + seconds{10},
+                            1000, 0, 0));
+  ok1(flat.GetModifySerial() == modify_serial);
+  ok1(flat.SyncPoints(v));
+  ok1(v.size() == old_size + 1);
+  ok1(v.front() == &flat.front() && v.back() == &flat.back());
+  ok1(!flat.SyncPoints(v));
+}
+
+int main()
+{
+  plan_tests(3 * 5 + 7);
+
+  /* the configurations used by TraceComputer (scaled down) */
+  TestCompare("full", minutes{2}, Trace::null_time, 128, false);
+  TestCompare("contest", {}, Trace::null_time, 32, false);
+  TestCompare("sprint", {}, minutes{15}, 16, false);
+
+  TestCompare("full with time warps", minutes{2}, Trace::null_time, 128, true);
+  TestCompare("sprint with time warps", {}, minutes{15}, 16, true);
+
+  TestGetPoints();
+
+  return exit_status();
+}
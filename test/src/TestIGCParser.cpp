@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "IGC/IGCParser.hpp"
+#include "IGC/IGCBulkParser.hpp"
 #include "IGC/IGCExtensions.hpp"
 #include "IGC/IGCFix.hpp"
 #include "IGC/IGCHeader.hpp"
@@ -10,6 +11,8 @@
 #include "time/BrokenTime.hpp"
 #include "TestUtil.hpp"
 
+#include <string>
+
 #include <string.h>
 
 static void
@@ -249,9 +252,80 @@ TestDeclarationTurnpoint()
   ok1(tp.name.empty());
 }
 
+static bool
+SameFix(const IGCFix &a, const IGCFix &b)
+{
+  return a.time == b.time && a.location == b.location &&
+    a.gps_valid == b.gps_valid && a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm && a.hdm == b.hdm && a.hdt == b.hdt &&
+    a.trm == b.trm && a.trt == b.trt && a.gsp == b.gsp && a.ias == b.ias &&
+    a.tas == b.tas && a.siu == b.siu;
+}
+
+static void
+TestBulk()
+{
+  static constexpr const char *b_records[] = {
+    "B1122385103117N00742367EA004900048712304507",
+    "B1122395103117S00742367WV-001000487999",
+    "B1122405103117N00742367EA0049000487",
+  };
+
+  /* CRLF, an invalid record and no newline after the last line */
+  const std::string igc = std::string("AXCSfoo\r\n"
+                                      "HFDTE040910\r\n"
+                                      "I033638ENL3941GSP4243SIU\r\n") +
+    b_records[0] + "\r\n"
+    "B1122385103117X00742367EA0049000487123\r\n" +
+    b_records[1] + "\n" +
+    b_records[2];
+
+  IGCBulkResult result;
+  IGCBulkParse(igc, result);
+
+  ok1(result.date == BrokenDate(2010, 9, 4));
+  ok1(result.fixes.size() == 3);
+  if (result.fixes.size() != 3)
+    return;
+
+  const IGCFix &a = result.fixes[0];
+  ok1(a.time == BrokenTime(11, 22, 38));
+  ok1(equals(a.location, 51.05195, 7.70611667));
+  ok1(a.gps_valid);
+  ok1(a.pressure_altitude == 490);
+  ok1(a.gps_altitude == 487);
+  ok1(a.enl == 123);
+  ok1(a.gsp == 45);
+  ok1(a.siu == 7);
+  ok1(a.rpm == -1);
+
+  const IGCFix &b = result.fixes[1];
+  ok1(equals(b.location, -51.05195, -7.70611667));
+  ok1(!b.gps_valid);
+  ok1(b.pressure_altitude == -10);
+  ok1(b.enl == 999);
+  ok1(b.gsp == -1);
+  ok1(b.siu == -1);
+
+  const IGCFix &c = result.fixes[2];
+  ok1(c.time == BrokenTime(11, 22, 40));
+  ok1(c.enl == -1);
+
+  /* the line-based parser must agree */
+  IGCExtensions extensions;
+  IGCParseExtensions("I033638ENL3941GSP4243SIU", extensions);
+
+  for (unsigned i = 0; i < 3; ++i) {
+    IGCFix fix;
+    ok1(IGCParseFix(b_records[i], extensions, fix) &&
+        SameFix(fix, result.fixes[i]));
+  }
+}
+
 int main()
 {
-  plan_tests(148);
+  plan_tests(170);
 
   TestHeader();
   TestDate();
@@ -261,6 +335,7 @@ int main()
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
+  TestBulk();
 
   return exit_status();
 }
@@ -2,8 +2,12 @@
 // Copyright The XCSoar Project
 
 #include "Projection/Projection.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "ui/dim/Rect.hpp"
 #include "TestUtil.hpp"
 
+#include <vector>
+
 static void
 TestGeoScreenCouple(const Projection prj, const GeoPoint geo,
                     int x, int y)
@@ -27,11 +31,88 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+/**
+ * An object with an embedded #GeoPoint, like #SearchPoint.
+ */
+struct Located {
+  GeoPoint location;
+  unsigned padding;
+
+  const GeoPoint &GetLocation() const noexcept {
+    return location;
+  }
+};
+
+static bool
+Equals(const Projection &prj, const std::vector<Located> &src,
+       const BulkPixelPoint *dest)
+{
+  for (const auto &i : src) {
+    const PixelPoint expected = prj.GeoToScreen(i.location);
+    if (dest->x != expected.x || dest->y != expected.y)
+      return false;
+
+    ++dest;
+  }
+
+  return true;
+}
+
+static void
+test_batch()
+{
+  Projection prj;
+  prj.SetScreenOrigin(320, 240);
+  prj.SetScale(0.01);
+  prj.SetGeoLocation(GeoPoint(Angle::Degrees(179.9), Angle::Degrees(51)));
+
+  /* an odd number of points around the location, across the date
+     line */
+  std::vector<Located> src;
+  for (int i = -20; i <= 20; ++i)
+    for (int j = -10; j <= 10; ++j)
+      src.push_back({GeoPoint(Angle::Degrees(179.9 + i * 0.013).AsDelta(),
+                              Angle::Degrees(51 + j * 0.007)), 0});
+  ok1(src.size() % 2 == 1);
+
+  std::vector<BulkPixelPoint> dest(src.size());
+
+  for (const Angle angle : {Angle::Zero(), Angle::Degrees(37),
+                            Angle::Degrees(-123)}) {
+    prj.SetScreenAngle(angle);
+    prj.GeoToScreen(src, dest.data());
+    ok1(Equals(prj, src, dest.data()));
+  }
+
+  /* the plain GeoPoint overload */
+  std::vector<GeoPoint> geo;
+  for (const auto &i : src)
+    geo.push_back(i.location);
+
+  prj.GeoToScreen(geo, dest.data());
+  ok1(Equals(prj, src, dest.data()));
+
+  /* clipping flags */
+  const PixelRect screen(0, 0, 640, 480);
+  ok1(prj.GeoToScreen(geo, dest.data()) == 0);
+  ok1(prj.GeoToScreen(geo, dest.data(), &screen) == 0);
+
+  const PixelRect left(-10000, 0, -9000, 480);
+  ok1(prj.GeoToScreen(geo, dest.data(), &left) == Projection::CLIP_RIGHT);
+
+  const PixelRect below(0, -20000, 640, -19000);
+  ok1(prj.GeoToScreen(std::span{geo}.first(3), dest.data(), &below) ==
+      Projection::CLIP_BOTTOM);
+
+  ok1(prj.GeoToScreen(std::span{geo}.first(0), dest.data(), &below) == 0);
+}
+
 int main()
 {
-  plan_tests(4);
+  plan_tests(4 + 10);
 
   test_simple();
+  test_batch();
 
   return exit_status();
 }
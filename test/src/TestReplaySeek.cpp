@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replay an IGC file straight through, then seek back to a checkpoint
+ * and forward again, like Replay::Seek() does, and verify that the
+ * results are the same.  The duration of the backward seek is
+ * printed.
+ */
+
+#include "Replay/IgcReplay.hpp"
+#include "Replay/SeekFeeder.hpp"
+#include "Replay/Checkpoints.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskProgress.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/IntermediatePoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/Factory/AbstractTaskFactory.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <chrono>
+#include <memory>
+
+#include <stdio.h>
+
+/* fake symbols: */
+
+void
+ConditionMonitors::Update([[maybe_unused]] const NMEAInfo &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated,
+                          [[maybe_unused]] const ComputerSettings &settings) noexcept
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogPoint([[maybe_unused]] const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr Path igc_path{_T("test/data/01lz1hq1.igc")};
+
+/**
+ * The results which must not be affected by seeking.
+ */
+struct Results {
+  TaskStats task;
+  TracePointVector trace;
+  SpeedVector wind;
+  FloatDuration flight_time, time_circling;
+  ContestResult contest;
+
+  explicit Results(const GlideComputer &glide_computer) {
+    const DerivedInfo &calculated = glide_computer.Calculated();
+    task = calculated.ordered_task_stats;
+    glide_computer.GetTraceComputer().LockedCopyTo(trace);
+    wind = calculated.wind;
+    flight_time = calculated.flight.flight_time;
+    time_circling = calculated.time_circling;
+    contest = calculated.contest_stats.GetResult(0);
+  }
+
+  bool IsSameTask(const Results &other) const noexcept {
+    return task.active_index == other.task.active_index &&
+      task.task_finished == other.task.task_finished &&
+      task.inside_oz == other.task.inside_oz &&
+      task.start.time == other.task.start.time &&
+      task.distance_scored == other.task.distance_scored &&
+      task.total.travelled.GetDistance() == other.task.total.travelled.GetDistance() &&
+      task.total.remaining.GetDistance() == other.task.total.remaining.GetDistance();
+  }
+
+  bool IsSameTrace(const Results &other) const noexcept {
+    return std::equal(trace.begin(), trace.end(),
+                      other.trace.begin(), other.trace.end(),
+                      [](const TracePoint &a, const TracePoint &b){
+                        return a.GetTime() == b.GetTime() &&
+                          a.GetLocation() == b.GetLocation() &&
+                          a.GetAltitude() == b.GetAltitude();
+                      });
+  }
+
+  bool IsSameWind(const Results &other) const noexcept {
+    return wind.norm == other.wind.norm &&
+      wind.bearing == other.wind.bearing;
+  }
+
+  bool IsSameTimes(const Results &other) const noexcept {
+    return flight_time == other.flight_time &&
+      time_circling == other.time_circling;
+  }
+
+  bool IsSameContest(const Results &other) const noexcept {
+    return contest.score == other.contest.score &&
+      contest.distance == other.contest.distance &&
+      contest.time == other.contest.time;
+  }
+};
+
+static void
+Compare(const char *name, const Results &expected, const Results &actual)
+{
+  ok(actual.IsSameTask(expected), "%s: task stats", name);
+  ok(actual.IsSameTrace(expected), "%s: trace", name);
+  ok(actual.IsSameWind(expected), "%s: wind", name);
+  ok(actual.IsSameTimes(expected), "%s: flight/circling time", name);
+  ok(actual.IsSameContest(expected), "%s: contest", name);
+}
+
+static IgcReplay
+OpenReplay()
+{
+  return IgcReplay{std::make_unique<FileLineReaderA>(igc_path)};
+}
+
+/**
+ * Feed the whole file, or until the specified time, from the
+ * beginning of the flight.
+ */
+static void
+ReplayStraight(GlideComputer &glide_computer, ReplayCheckpoints &checkpoints,
+               TimeStamp until=TimeStamp::Undefined())
+{
+  glide_computer.ResetFlight();
+
+  WrapClock clock;
+  clock.Reset();
+
+  SeekFeeder feeder{glide_computer, checkpoints, clock};
+
+  auto replay = OpenReplay();
+  NMEAInfo data;
+  data.Reset();
+  while (replay.Update(data)) {
+    if (until.IsDefined() && data.time_available && data.time > until)
+      break;
+
+    feeder.Feed(data);
+  }
+}
+
+/**
+ * Build a racing task from the declaration in the IGC file.
+ */
+static void
+CreateTask(TaskManager &task_manager)
+{
+  static constexpr struct {
+    double latitude, longitude;
+  } turnpoints[] = {
+    { -35.99360, 146.35333 }, /* Corowa */
+    { -35.22750, 146.71972 }, /* Lockhart */
+    { -34.35693, 146.90083 }, /* Ardlethan */
+    { -33.93917, 147.19360 }, /* West Wyalong */
+    { -33.28333, 146.38333 }, /* Lake Cargelligo */
+    { -34.42222, 147.51110 }, /* Temora */
+    { -35.99360, 146.35333 }, /* Corowa */
+  };
+
+  task_manager.SetFactory(TaskFactoryType::RACING);
+  AbstractTaskFactory &factory = task_manager.GetFactory();
+
+  for (std::size_t i = 0; i < std::size(turnpoints); ++i) {
+    const GeoPoint location(Angle::Degrees(turnpoints[i].longitude),
+                            Angle::Degrees(turnpoints[i].latitude));
+    auto wp = std::make_shared<Waypoint>(location);
+
+    std::unique_ptr<OrderedTaskPoint> tp;
+    if (i == 0)
+      tp = factory.CreateStart(std::move(wp));
+    else if (i + 1 == std::size(turnpoints))
+      tp = factory.CreateFinish(std::move(wp));
+    else
+      tp = factory.CreateIntermediate(std::move(wp));
+
+    factory.Append(*tp, false);
+  }
+
+  factory.UpdateGeometry();
+  task_manager.SetActiveTaskPoint(0);
+  task_manager.Resume();
+}
+
+/**
+ * Find the latest time (but not after #end) before the first
+ * checkpoint after the specified time, i.e. the seek target which
+ * requires replaying the most input after restoring a checkpoint.
+ */
+static TimeStamp
+FindWorstTarget(const ReplayCheckpoints &checkpoints,
+                TimeStamp time, TimeStamp end)
+{
+  const auto *checkpoint = checkpoints.FindBefore(time);
+  while (time < end &&
+         checkpoints.FindBefore(time + std::chrono::seconds{1}) == checkpoint)
+    time += std::chrono::seconds{1};
+  return time;
+}
+
+/**
+ * Do what Replay::Seek() does when seeking backwards.
+ *
+ * @param data receives the first input after the target
+ */
+static WrapClock
+SeekBack(GlideComputer &glide_computer, ReplayCheckpoints &checkpoints,
+         IgcReplay &replay, NMEAInfo &data, TimeStamp target)
+{
+  const auto *checkpoint = checkpoints.FindBefore(target);
+  ok1(checkpoint != nullptr);
+  if (checkpoint == nullptr)
+    return {};
+
+  glide_computer.RestoreCheckpoint(checkpoint->computer);
+
+  data.Reset();
+  while (replay.Update(data))
+    if (data.time_available && data.time > checkpoint->time)
+      break;
+
+  SeekFeeder feeder{glide_computer, checkpoints, checkpoint->clock};
+  do {
+    if (data.time_available && data.time > target)
+      break;
+
+    feeder.Feed(data);
+  } while (replay.Update(data));
+
+  return feeder.GetClock();
+}
+
+static void
+TestSeek(GlideComputer &glide_computer)
+{
+  /* replay straight through */
+
+  ReplayCheckpoints checkpoints;
+  auto start = Clock::now();
+  ReplayStraight(glide_computer, checkpoints);
+  const auto straight_duration = Clock::now() - start;
+
+  const Results expected_end(glide_computer);
+  ok1(expected_end.task.start.HasStarted());
+  ok1(expected_end.contest.IsDefined());
+
+  const TimeStamp end = glide_computer.Basic().time;
+  const TimeStamp target =
+    FindWorstTarget(checkpoints, TimeStamp{end.ToDuration() * 2 / 3}, end);
+
+  ReplayCheckpoints unused_checkpoints;
+  ReplayStraight(glide_computer, unused_checkpoints, target);
+  const Results expected_target(glide_computer);
+
+  /* seek back to the target */
+
+  auto replay = OpenReplay();
+  NMEAInfo data;
+
+  start = Clock::now();
+  const WrapClock clock = SeekBack(glide_computer, checkpoints,
+                                   replay, data, target);
+  const auto seek_duration = Clock::now() - start;
+
+  Compare("seek back", expected_target, Results(glide_computer));
+
+  /* seek forward to the end */
+
+  SeekFeeder feeder{glide_computer, checkpoints, clock};
+  do {
+    feeder.Feed(data);
+  } while (replay.Update(data));
+
+  Compare("seek forward", expected_end, Results(glide_computer));
+
+  printf("# replay %.3f s, seek back %.3f s\n",
+         std::chrono::duration<double>(straight_duration).count(),
+         std::chrono::duration<double>(seek_duration).count());
+}
+
+/**
+ * The progress must not be restored if an observation zone has been
+ * edited since, even if the task point was not moved.
+ */
+static void
+TestEditedTask(const TaskManager &task_manager, const TaskBehaviour &tb)
+{
+  TaskProgress progress;
+  task_manager.SaveProgress(progress);
+
+  auto task = task_manager.Clone(tb);
+  ok1(task->RestoreProgress(progress));
+
+  const OrderedTaskPoint &old_tp = task->GetTaskPoint(1);
+
+  /* change the radius */
+
+  auto tp = task->GetFactory().CreateIntermediate(TaskPointFactoryType::AST_CYLINDER,
+                                                  old_tp.GetWaypointPtr());
+  auto &cylinder = (CylinderZone &)tp->GetObservationZone();
+  cylinder.SetRadius(cylinder.GetRadius() + 1000);
+  ok1(task->Replace(*tp, 1));
+  ok1(!task->RestoreProgress(progress));
+
+  /* change the type, but not the observation zone */
+
+  task = task_manager.Clone(tb);
+  task->SetFactory(TaskFactoryType::MIXED);
+  tp = task->GetFactory().CreateIntermediate(TaskPointFactoryType::AAT_CYLINDER,
+                                             old_tp.GetWaypointPtr());
+  ((CylinderZone &)tp->GetObservationZone())
+    .SetRadius(((const CylinderZone &)old_tp.GetObservationZone()).GetRadius());
+  ok1(tp->GetObservationZone().Equals(old_tp.GetObservationZone()));
+  ok1(task->Replace(*tp, 1));
+  ok1(!task->RestoreProgress(progress));
+}
+
+int
+main()
+{
+  plan_tests(19);
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  const Waypoints way_points;
+  Airspaces airspace_database;
+
+  TaskManager task_manager(settings.task, way_points);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  CreateTask(task_manager);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  GlideComputer glide_computer(settings, way_points, airspace_database,
+                               protected_task_manager, task_events);
+  glide_computer.SetDeterministic(true);
+  glide_computer.Initialise();
+
+  TestSeek(glide_computer);
+  TestEditedTask(task_manager, settings.task);
+
+  return exit_status();
+}
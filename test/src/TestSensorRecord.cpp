@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Replay/SensorRecord.hpp"
+#include "NMEA/Info.hpp"
+#include "io/StringOutputStream.hxx"
+#include "util/SpanCast.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+/* 10 minutes of data with 10 records per second */
+static constexpr unsigned N_RECORDS = 6000;
+static constexpr double START_CLOCK = 1000;
+
+/**
+ * Generate a synthetic record: a GPS fix every second, a vario
+ * value in every record, and a baro altitude which drops out for
+ * a while.
+ */
+static void
+Generate(NMEAInfo &info, unsigned i) noexcept
+{
+  info.clock = TimeStamp{FloatDuration{START_CLOCK + i * 0.1}};
+  info.alive.Update(info.clock);
+
+  if (i % 10 == 0) {
+    const unsigned second = i / 10;
+    info.ProvideTime(TimeStamp{FloatDuration{43200 + second}});
+    info.ProvideDate(BrokenDate(2024, 7, 14));
+    info.location = GeoPoint(Angle::Degrees(7 + second * 0.0001),
+                             Angle::Degrees(51 + second * 0.00005));
+    info.location_available.Update(info.clock);
+    info.gps_altitude = 1000 + second;
+    info.gps_altitude_available.Update(info.clock);
+    info.gps.fix_quality = FixQuality::GPS;
+    info.gps.fix_quality_available.Update(info.clock);
+  }
+
+  info.ProvideTotalEnergyVario((int(i % 50) - 25) * 0.1);
+
+  if (i >= 2000 && i < 2500)
+    info.baro_altitude_available.Clear();
+  else
+    info.ProvideBaroAltitudeTrue(900 + i * 0.5);
+}
+
+struct Recording {
+  std::string data;
+
+  /**
+   * The state after each record.
+   */
+  std::vector<NMEAInfo> states;
+};
+
+static Recording
+Record(bool finish=true)
+{
+  Recording r;
+
+  StringOutputStream sos;
+  SensorRecordWriter writer{sos};
+
+  NMEAInfo info;
+  info.Reset();
+  for (unsigned i = 0; i < N_RECORDS; ++i) {
+    Generate(info, i);
+    writer.Write(info);
+    r.states.push_back(info);
+  }
+
+  if (finish)
+    writer.Finish();
+
+  r.data = std::move(sos).GetValue();
+  return r;
+}
+
+/**
+ * Compare the recorded attributes of two #NMEAInfo objects.
+ */
+static bool
+Equals(const NMEAInfo &a, const NMEAInfo &b) noexcept
+{
+  if (std::abs(a.clock.ToDuration().count() -
+               b.clock.ToDuration().count()) > 0.001)
+    return false;
+
+  if ((bool)a.time_available != (bool)b.time_available ||
+      (a.time_available && a.time != b.time))
+    return false;
+
+  if (a.date_time_utc != b.date_time_utc)
+    return false;
+
+  if ((bool)a.location_available != (bool)b.location_available ||
+      (a.location_available && a.location != b.location))
+    return false;
+
+  if ((bool)a.gps_altitude_available != (bool)b.gps_altitude_available ||
+      (a.gps_altitude_available && a.gps_altitude != b.gps_altitude))
+    return false;
+
+  if ((bool)a.total_energy_vario_available != (bool)b.total_energy_vario_available ||
+      (a.total_energy_vario_available &&
+       a.total_energy_vario != b.total_energy_vario))
+    return false;
+
+  if ((bool)a.baro_altitude_available != (bool)b.baro_altitude_available ||
+      (a.baro_altitude_available &&
+       (a.baro_altitude != b.baro_altitude ||
+        a.baro_altitude_weak != b.baro_altitude_weak)))
+    return false;
+
+  if ((bool)a.gps.fix_quality_available != (bool)b.gps.fix_quality_available ||
+      (a.gps.fix_quality_available && a.gps.fix_quality != b.gps.fix_quality))
+    return false;
+
+  return true;
+}
+
+static void
+TestSequential(const Recording &r)
+{
+  SensorRecordReader reader{AsBytes(r.data)};
+
+  NMEAInfo info;
+  info.Reset();
+
+  unsigned n = 0;
+  bool equal = true;
+  while (reader.Read(info)) {
+    if (n < r.states.size() && !Equals(info, r.states[n]))
+      equal = false;
+    ++n;
+  }
+
+  ok1(n == N_RECORDS);
+  ok1(equal);
+
+  /* one keyframe every 10 seconds */
+  ok1(reader.GetIndex().size() == N_RECORDS / 100);
+
+  ok1(std::abs(reader.GetStartClock().ToDuration().count() - START_CLOCK) < 0.001);
+  ok1(std::abs(reader.GetEndClock().ToDuration().count() -
+               r.states.back().clock.ToDuration().count()) < 0.001);
+
+  /* much smaller than the NMEAInfo objects */
+  ok1(r.data.size() < N_RECORDS * 40);
+}
+
+static void
+TestSeek(const Recording &r)
+{
+  SensorRecordReader reader{AsBytes(r.data)};
+
+  NMEAInfo info;
+  info.Reset();
+
+  /* forward, backward, into the baro gap, before the start and
+     after the end */
+  static constexpr int targets[] = {
+    3456, 17, 5999, 2100, 2499, 2500, 0, 100, 99, 4000,
+  };
+
+  for (const int i : targets) {
+    reader.Seek(r.states[i].clock, info);
+    ok1(Equals(info, r.states[i]));
+
+    /* continue reading sequentially after the seek */
+    if (i + 1 < (int)N_RECORDS) {
+      ok1(reader.Read(info));
+      ok1(Equals(info, r.states[i + 1]));
+    }
+  }
+
+  reader.Seek(TimeStamp{FloatDuration{START_CLOCK - 100}}, info);
+  ok1(Equals(info, r.states.front()));
+
+  reader.Seek(TimeStamp{FloatDuration{START_CLOCK + 10000}}, info);
+  ok1(Equals(info, r.states.back()));
+  ok1(!reader.Read(info));
+}
+
+/**
+ * A recording which was not finished (e.g. after a crash) has no
+ * index; the reader rebuilds it, and ignores a truncated record at
+ * the end.
+ */
+static void
+TestUnfinished(const Recording &finished)
+{
+  const Recording r = Record(false);
+  ok1(r.data.size() < finished.data.size());
+
+  SensorRecordReader reader{AsBytes(r.data)};
+  const SensorRecordReader finished_reader{AsBytes(finished.data)};
+  ok1(std::equal(reader.GetIndex().begin(), reader.GetIndex().end(),
+                 finished_reader.GetIndex().begin(),
+                 finished_reader.GetIndex().end(),
+                 [](const auto &a, const auto &b){
+                   return a.clock == b.clock && a.offset == b.offset;
+                 }));
+
+  const std::string truncated = r.data.substr(0, r.data.size() - 3);
+  SensorRecordReader truncated_reader{AsBytes(truncated)};
+
+  NMEAInfo info;
+  info.Reset();
+  unsigned n = 0;
+  while (truncated_reader.Read(info))
+    ++n;
+
+  ok1(n == N_RECORDS - 1);
+  ok1(Equals(info, r.states[N_RECORDS - 2]));
+}
+
+static void
+TestMalformed()
+{
+  try {
+    const std::string data = "NMEA$GPRMC";
+    SensorRecordReader reader{AsBytes(data)};
+    ok1(false);
+  } catch (const std::runtime_error &) {
+    ok1(true);
+  }
+}
+
+int main()
+{
+  plan_tests(6 + 10 * 3 - 2 + 3 + 4 + 1);
+
+  const Recording r = Record();
+  TestSequential(r);
+  TestSeek(r);
+  TestUnfinished(r);
+  TestMalformed();
+
+  return exit_status();
+}
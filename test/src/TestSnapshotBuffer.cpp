@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Stress test for #SnapshotBuffer: one writer publishes a large
+ * object at full speed while several readers copy it, verifying that
+ * no reader ever sees a torn value and that sequence numbers never go
+ * backwards.
+ */
+
+#include "thread/SnapshotBuffer.hpp"
+#include "thread/Thread.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <stdio.h>
+
+/**
+ * Large enough that a copy takes a while, which gives the writer a
+ * chance to overtake the readers.
+ */
+struct Payload {
+  uint32_t sequence;
+  uint32_t data[2048];
+};
+
+static constexpr unsigned N_SLOTS = 5;
+static constexpr unsigned N_READERS = N_SLOTS - 2;
+static constexpr uint32_t N_PUBLICATIONS = 20000;
+
+using Buffer = SnapshotBuffer<Payload, N_SLOTS>;
+
+static bool
+IsConsistent(const Payload &p, uint32_t sequence) noexcept
+{
+  return p.sequence == sequence &&
+    std::all_of(std::begin(p.data), std::end(p.data),
+                [sequence](uint32_t i){ return i == sequence; });
+}
+
+class Writer final : public Thread {
+  Buffer &buffer;
+
+public:
+  unsigned n_failed = 0;
+
+  explicit Writer(Buffer &_buffer) noexcept
+    :Thread("writer"), buffer(_buffer) {}
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    auto p = std::make_unique<Payload>();
+
+    for (uint32_t sequence = 1; sequence <= N_PUBLICATIONS; ++sequence) {
+      p->sequence = sequence;
+      std::fill(std::begin(p->data), std::end(p->data), sequence);
+      if (!buffer.Publish(*p))
+        ++n_failed;
+    }
+  }
+};
+
+class Reader final : public Thread {
+  const Buffer &buffer;
+  const std::atomic_bool &done;
+
+public:
+  unsigned n_reads = 0, n_torn = 0, n_backwards = 0;
+  uint32_t last_sequence = 0;
+
+  Reader(const Buffer &_buffer, const std::atomic_bool &_done) noexcept
+    :Thread("reader"), buffer(_buffer), done(_done) {}
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    auto p = std::make_unique<Payload>();
+
+    while (true) {
+      /* check the flag before reading, so the final value is always
+         seen */
+      const bool finished = done.load();
+
+      const uint32_t sequence = buffer.Read(*p);
+      ++n_reads;
+
+      if (!IsConsistent(*p, sequence))
+        ++n_torn;
+
+      if (sequence < last_sequence)
+        ++n_backwards;
+
+      last_sequence = sequence;
+
+      if (finished)
+        break;
+    }
+  }
+};
+
+static void
+TestInitial()
+{
+  auto buffer = std::make_unique<SnapshotBuffer<Payload, 3>>();
+  auto p = std::make_unique<Payload>();
+
+  ok1(buffer->GetSequence() == 0);
+  ok1(buffer->Read(*p) == 0);
+  ok1(IsConsistent(*p, 0));
+
+  p->sequence = 1;
+  std::fill(std::begin(p->data), std::end(p->data), 1);
+  ok1(buffer->Publish(*p));
+  ok1(buffer->GetSequence() == 1);
+
+  *p = {};
+  ok1(buffer->Read(*p) == 1);
+  ok1(IsConsistent(*p, 1));
+}
+
+static void
+TestStress()
+{
+  auto buffer = std::make_unique<Buffer>();
+  std::atomic_bool done{false};
+
+  Writer writer{*buffer};
+  std::unique_ptr<Reader> readers[N_READERS];
+  for (auto &i : readers)
+    i = std::make_unique<Reader>(*buffer, done);
+
+  for (auto &i : readers)
+    i->Start();
+
+  writer.Start();
+  writer.Join();
+
+  done.store(true);
+
+  unsigned n_reads = 0, n_torn = 0, n_backwards = 0;
+  bool all_final = true;
+  for (auto &i : readers) {
+    i->Join();
+    n_reads += i->n_reads;
+    n_torn += i->n_torn;
+    n_backwards += i->n_backwards;
+    all_final = all_final && i->last_sequence == N_PUBLICATIONS;
+  }
+
+  const auto statistics = buffer->GetStatistics();
+  printf("# %u publications, %u skipped, %u reads, %u read retries\n",
+         (unsigned)statistics.publications, (unsigned)statistics.skipped,
+         (unsigned)statistics.reads, (unsigned)statistics.read_retries);
+
+  /* with at most N-2 readers, the writer always finds a free slot */
+  ok1(writer.n_failed == 0);
+  ok1(statistics.skipped == 0);
+  ok1(statistics.publications == N_PUBLICATIONS);
+  ok1(statistics.reads == n_reads);
+
+  ok1(n_torn == 0);
+  ok1(n_backwards == 0);
+  ok1(all_final);
+}
+
+int main()
+{
+  plan_tests(14);
+
+  TestInitial();
+  TestStress();
+
+  return exit_status();
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static void
+TestEmpty(ThreadPool &pool)
+{
+  unsigned calls = 0;
+  pool.ParallelFor(0, [&calls](std::size_t){ ++calls; });
+  ok1(calls == 0);
+}
+
+/**
+ * Each index must be processed exactly once.
+ */
+static void
+TestDistribution(ThreadPool &pool, std::size_t n)
+{
+  const auto counters = std::make_unique<std::atomic<unsigned>[]>(n);
+  for (std::size_t i = 0; i < n; ++i)
+    counters[i] = 0;
+
+  pool.ParallelFor(n, [&counters](std::size_t i){
+    ++counters[i];
+  });
+
+  bool once = true;
+  for (std::size_t i = 0; i < n; ++i)
+    if (counters[i] != 1)
+      once = false;
+
+  ok1(once);
+}
+
+/**
+ * Many small batches, to exercise the hand-over between batches.
+ */
+static void
+TestManyBatches(ThreadPool &pool)
+{
+  std::atomic<unsigned> sum{0};
+
+  for (unsigned batch = 0; batch < 1000; ++batch)
+    pool.ParallelFor(batch % 7, [&sum](std::size_t i){
+      sum += i + 1;
+    });
+
+  /* the sum of 1..k for k = batch % 7 */
+  unsigned expected = 0;
+  for (unsigned batch = 0; batch < 1000; ++batch) {
+    const unsigned k = batch % 7;
+    expected += k * (k + 1) / 2;
+  }
+
+  ok1(sum == expected);
+}
+
+static void
+TestException(ThreadPool &pool)
+{
+  std::atomic<unsigned> calls{0};
+
+  try {
+    pool.ParallelFor(1000, [&calls](std::size_t i){
+      ++calls;
+      if (i == 37)
+        throw std::runtime_error("job 37");
+    });
+
+    ok1(false);
+  } catch (const std::runtime_error &e) {
+    ok1(std::string(e.what()) == "job 37");
+  }
+
+  /* the job which threw has been invoked at least */
+  ok1(calls >= 1 && calls <= 1000);
+
+  /* the pool is still usable after an exception */
+  TestDistribution(pool, 100);
+}
+
+static void
+TestPool(unsigned concurrency)
+{
+  ThreadPool pool(concurrency);
+  ok1(pool.GetConcurrency() == concurrency);
+
+  TestEmpty(pool);
+  TestDistribution(pool, 1);
+  TestDistribution(pool, 10000);
+  TestManyBatches(pool);
+  TestException(pool);
+}
+
+int main()
+{
+  static constexpr unsigned concurrencies[] = {1, 2, 4, 8};
+
+  plan_tests(std::size(concurrencies) * 8);
+
+  for (const unsigned concurrency : concurrencies)
+    TestPool(concurrency);
+
+  return exit_status();
+}
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Verify that #Trace instances sharing a #TracePointStore keep the
+ * same points as with private stores, and that the shared store frees
+ * its points when the last #Trace drops them.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Store.hpp"
+#include "TraceGenerator.hpp"
+#include "TestUtil.hpp"
+
+#include <set>
+
+using namespace std::chrono;
+
+static bool
+Equals(const Trace &a, const Trace &b) noexcept
+{
+  if (a.size() != b.size())
+    return false;
+
+  auto j = b.begin();
+  for (const auto &i : a) {
+    if (i.GetTime() != j->GetTime() ||
+        i.GetLocation() != j->GetLocation() ||
+        i.GetFlatLocation() != j->GetFlatLocation())
+      return false;
+    ++j;
+  }
+
+  return true;
+}
+
+/**
+ * The number of distinct points in all the given traces.
+ */
+static unsigned
+CountDistinct(std::initializer_list<const Trace *> traces) noexcept
+{
+  std::set<const TracePoint *> points;
+  for (const Trace *trace : traces)
+    for (const auto &i : *trace)
+      points.insert(&i);
+  return points.size();
+}
+
+/**
+ * The configuration of TraceComputer (scaled down).
+ */
+struct Traces {
+  Trace full, contest, sprint;
+
+  Traces(TracePointStore &store) noexcept
+    :full(store, minutes{2}, Trace::null_time, 128),
+     contest(store, {}, Trace::null_time, 32),
+     sprint(store, {}, minutes{15}, 16) {}
+
+  Traces() noexcept
+    :full(minutes{2}, Trace::null_time, 128),
+     contest({}, Trace::null_time, 32),
+     sprint({}, minutes{15}, 16) {}
+
+  void push_back(const TracePoint &point) noexcept {
+    full.push_back(point);
+    contest.push_back(point);
+    sprint.push_back(point);
+  }
+};
+
+static void
+TestSharing(bool time_warps)
+{
+  const auto flight = GenerateFlight(7, 20000, time_warps);
+
+  TracePointStore store;
+  Traces shared(store), separate;
+
+  bool equal = true, distinct = true;
+  for (const auto &point : flight) {
+    shared.push_back(point);
+    separate.push_back(point);
+
+    if (!Equals(shared.full, separate.full) ||
+        !Equals(shared.contest, separate.contest) ||
+        !Equals(shared.sprint, separate.sprint))
+      equal = false;
+
+    /* each point is stored only once */
+    if (store.size() !=
+        CountDistinct({&shared.full, &shared.contest, &shared.sprint}))
+      distinct = false;
+  }
+
+  ok(equal, "same points as separate stores, time warps=%d", time_warps);
+  ok(distinct, "points stored once, time warps=%d", time_warps);
+  ok1(store.size() <
+      shared.full.size() + shared.contest.size() + shared.sprint.size());
+}
+
+static void
+TestRelease()
+{
+  const auto flight = GenerateFlight(3, 5000);
+
+  TracePointStore store;
+
+  {
+    Trace full(store, minutes{2}, Trace::null_time, 128);
+
+    {
+      Trace contest(store, {}, Trace::null_time, 32);
+      for (const auto &point : flight) {
+        full.push_back(point);
+        contest.push_back(point);
+      }
+
+      ok1(store.size() == CountDistinct({&full, &contest}));
+      ok1(store.size() > full.size());
+    }
+
+    /* the contest trace has dropped its references */
+    ok1(store.size() == full.size());
+  }
+
+  ok1(store.empty());
+}
+
+static void
+TestClear()
+{
+  const auto flight = GenerateFlight(5, 3000);
+
+  TracePointStore store;
+  Traces traces(store);
+  for (const auto &point : flight)
+    traces.push_back(point);
+
+  /* the other traces still hold points, so the projection is kept */
+  const GeoPoint old_center = store.GetProjection().GetCenter();
+  traces.full.clear();
+  ok1(traces.full.empty());
+  ok1(!store.empty());
+  ok1(store.size() == CountDistinct({&traces.contest, &traces.sprint}));
+
+  traces.full.push_back(flight.back());
+  ok1(store.GetProjection().GetCenter() == old_center);
+
+  /* after clearing all of them, the next point is the new origin */
+  traces.full.clear();
+  traces.contest.clear();
+  traces.sprint.clear();
+  ok1(store.empty());
+
+  const TracePoint far(GeoPoint(Angle::Degrees(-120), Angle::Degrees(-30)),
+                       flight.back().GetTime() + minutes{1}, 500, 0, 0);
+  traces.push_back(far);
+  ok1(store.size() == 1);
+  ok1(store.GetProjection().GetCenter() == far.GetLocation());
+  ok1(traces.full.front().GetFlatLocation() ==
+      traces.sprint.front().GetFlatLocation());
+}
+
+int main()
+{
+  plan_tests(2 * 3 + 4 + 8);
+
+  TestSharing(false);
+  TestSharing(true);
+  TestRelease();
+  TestClear();
+
+  return exit_status();
+}
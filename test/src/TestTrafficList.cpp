@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static constexpr unsigned N = 120;
+
+static FlarmId
+MakeId(unsigned i) noexcept
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", 0xdd0000 + i * 7);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static FlarmTraffic *
+Add(TrafficList &list, FlarmId id, TimeStamp clock) noexcept
+{
+  FlarmTraffic *traffic = list.AllocateTraffic(id);
+  if (traffic != nullptr)
+    traffic->valid.Update(clock);
+  return traffic;
+}
+
+static void
+TestLookup()
+{
+  const TimeStamp clock{std::chrono::seconds{10}};
+
+  TrafficList list;
+  list.Clear();
+  ok1(list.IsEmpty());
+  ok1(list.FindTraffic(MakeId(0)) == nullptr);
+
+  FlarmTraffic *slots[N];
+  bool allocated = true;
+  for (unsigned i = 0; i < N; ++i) {
+    slots[i] = Add(list, MakeId(i), clock);
+    allocated &= slots[i] != nullptr;
+  }
+
+  ok1(allocated);
+  ok1(list.GetActiveTrafficCount() == N);
+
+  /* every target is found in the slot it was allocated in */
+  bool found = true;
+  for (unsigned i = 0; i < N; ++i)
+    found &= list.FindTraffic(MakeId(i)) == slots[i];
+  ok1(found);
+
+  ok1(list.FindTraffic(MakeId(N)) == nullptr);
+
+  unsigned n = 0;
+  for ([[maybe_unused]] const auto &traffic : list)
+    ++n;
+  ok1(n == N);
+
+  /* fill the list up to its capacity */
+  for (unsigned i = N; i < TrafficList::MAX_COUNT; ++i)
+    Add(list, MakeId(i), clock);
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+}
+
+static void
+TestExpire()
+{
+  TrafficList list;
+  list.Clear();
+
+  FlarmTraffic *slots[N];
+  for (unsigned i = 0; i < N; ++i)
+    slots[i] = Add(list, MakeId(i), TimeStamp{std::chrono::seconds{10}});
+
+  /* refresh the even targets only; the odd ones expire */
+  for (unsigned i = 0; i < N; i += 2)
+    slots[i]->valid.Update(TimeStamp{std::chrono::seconds{11}});
+
+  list.Expire(TimeStamp{std::chrono::milliseconds{12500}});
+  ok1(list.GetActiveTrafficCount() == N / 2);
+
+  /* the remaining targets keep their slots */
+  bool stable = true;
+  for (unsigned i = 0; i < N; ++i)
+    stable &= list.FindTraffic(MakeId(i)) == (i % 2 == 0 ? slots[i] : nullptr);
+  ok1(stable);
+
+  /* a new target reuses the first free slot */
+  const FlarmId id = MakeId(1000);
+  ok1(Add(list, id, TimeStamp{std::chrono::seconds{12}}) == slots[1]);
+  ok1(list.FindTraffic(id) == slots[1]);
+  ok1(list.GetActiveTrafficCount() == N / 2 + 1);
+
+  list.Expire(TimeStamp{std::chrono::seconds{20}});
+  ok1(list.IsEmpty());
+  ok1(list.begin() == list.end());
+}
+
+static void
+TestComplement()
+{
+  const TimeStamp clock{std::chrono::seconds{10}};
+
+  /* two lists sharing half of their targets */
+  TrafficList a, b;
+  a.Clear();
+  b.Clear();
+
+  for (unsigned i = 0; i < N; ++i)
+    Add(a, MakeId(i), clock);
+  for (unsigned i = N / 2; i < N + N / 2; ++i)
+    Add(b, MakeId(i), clock)->name = _T("B");
+
+  TrafficList merged;
+  merged.Clear();
+  merged.Complement(a);
+  ok1(merged.GetActiveTrafficCount() == N);
+
+  merged.Complement(b);
+  ok1(merged.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+
+  /* the targets of the first list take precedence */
+  bool found = true;
+  for (unsigned i = 0; i < N; ++i) {
+    const FlarmTraffic *traffic = merged.FindTraffic(MakeId(i));
+    found &= traffic != nullptr && !traffic->HasName();
+  }
+  ok1(found);
+
+  unsigned from_b = 0;
+  for (unsigned i = N; i < N + N / 2; ++i)
+    if (merged.FindTraffic(MakeId(i)) != nullptr)
+      ++from_b;
+  ok1(from_b == TrafficList::MAX_COUNT - N);
+
+  TrafficList copy;
+  copy.CopyFrom(merged);
+  ok1(copy.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(copy.FindTraffic(MakeId(N - 1)) ==
+      &copy.slots[merged.TrafficIndex(merged.FindTraffic(MakeId(N - 1)))]);
+}
+
+static void
+TestIsSame()
+{
+  TrafficList a, b;
+  a.Clear();
+  b.Clear();
+  ok1(a.IsSame(b));
+
+  for (unsigned i = 0; i < N; ++i)
+    Add(a, MakeId(i), TimeStamp{std::chrono::seconds{10}});
+  ok1(!a.IsSame(b));
+
+  b.CopyFrom(a);
+  ok1(b.IsSame(a));
+
+  /* nothing expires, so nothing changes */
+  b.Expire(TimeStamp{std::chrono::seconds{11}});
+  ok1(b.IsSame(a));
+
+  b.slots[N / 2].relative_north = 42;
+  ok1(!b.IsSame(a));
+}
+
+int main()
+{
+  plan_tests(9 + 7 + 6 + 5);
+
+  TestLookup();
+  TestExpire();
+  TestComplement();
+  TestIsSame();
+
+  return exit_status();
+}
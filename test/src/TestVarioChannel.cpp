@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Audio/VarioChannel.hpp"
+#include "Audio/VarioSynthesiser.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+using namespace std::chrono;
+
+static constexpr auto start = VarioChannel::Clock::time_point{hours{100}};
+
+static bool
+Near(VarioChannel::Clock::time_point a,
+     VarioChannel::Clock::time_point b) noexcept
+{
+  return std::abs(duration_cast<microseconds>(a - b).count()) <= 1;
+}
+
+static void
+TestReadWrite()
+{
+  VarioChannel channel;
+  VarioChannel::Sample sample;
+
+  /* nothing submitted yet */
+  ok1(!channel.Read(sample));
+
+  channel.Push(VarioChannel::MERGED, 1.234, start);
+  ok1(channel.Read(sample));
+  ok1(!sample.silence);
+  ok1(sample.ivario == 123);
+  ok1(Near(sample.time, start));
+
+  /* a value is read only once */
+  ok1(!channel.Read(sample));
+
+  channel.Push(VarioChannel::MERGED, -2.5, start + milliseconds{50});
+  channel.Push(VarioChannel::MERGED, -3.5, start + milliseconds{100});
+  ok1(channel.Read(sample));
+  ok1(sample.ivario == -350);
+  ok1(Near(sample.time, start + milliseconds{100}));
+
+  channel.PushSilence(VarioChannel::MERGED, start + milliseconds{150});
+  ok1(channel.Read(sample));
+  ok1(sample.silence);
+}
+
+static void
+TestPriority()
+{
+  VarioChannel channel;
+  VarioChannel::Sample sample;
+
+  channel.Push(1, 1, start);
+  ok1(channel.Read(sample));
+  ok1(sample.ivario == 100);
+
+  /* device 0 wins over device 1 */
+  channel.Push(0, 2, start + milliseconds{100});
+  channel.Push(1, 3, start + milliseconds{200});
+  ok1(channel.Read(sample));
+  ok1(sample.ivario == 200);
+
+  /* the merged value is ignored while devices submit values, even
+     if it is older */
+  channel.Push(VarioChannel::MERGED, 4, start + milliseconds{50});
+  channel.PushSilence(VarioChannel::MERGED, start + milliseconds{300});
+  ok1(!channel.Read(sample));
+
+  /* device 0 has gone silent; the others take over */
+  channel.Push(1, 5, start + milliseconds{100} + VarioChannel::HOLD_TIME);
+  ok1(channel.Read(sample));
+  ok1(sample.ivario == 500);
+
+  channel.PushSilence(VarioChannel::MERGED,
+                      start + milliseconds{200} + 2 * VarioChannel::HOLD_TIME);
+  ok1(channel.Read(sample));
+  ok1(sample.silence);
+}
+
+class CountingListener final : public VarioSynthesiser::Listener {
+public:
+  unsigned n = 0;
+  bool ordered = true;
+
+  void OnVarioSynthesised(VarioChannel::Clock::time_point received,
+                          VarioChannel::Clock::time_point begin,
+                          VarioChannel::Clock::time_point end) noexcept override {
+    ++n;
+    /* the channel stores the time with microsecond resolution */
+    if (received > begin + microseconds{1} || begin > end)
+      ordered = false;
+  }
+};
+
+static void
+TestSynthesiser()
+{
+  VarioSynthesiser synthesiser(44100);
+  CountingListener listener;
+  synthesiser.SetListener(&listener);
+
+  int16_t buffer[1024];
+
+  /* silence until a value arrives */
+  synthesiser.Synthesise(buffer, std::size(buffer));
+  ok1(std::all_of(std::begin(buffer), std::end(buffer),
+                  [](int16_t i){ return i == 0; }));
+  ok1(listener.n == 0);
+
+  /* sinking: continuous tone */
+  synthesiser.SetVario(-1);
+  synthesiser.Synthesise(buffer, std::size(buffer));
+  ok1(std::any_of(std::begin(buffer), std::end(buffer),
+                  [](int16_t i){ return i != 0; }));
+  ok1(listener.n == 1);
+
+  /* no new value: the hook is not invoked */
+  synthesiser.Synthesise(buffer, std::size(buffer));
+  ok1(listener.n == 1);
+
+  /* a device value arrives */
+  synthesiser.GetChannel().Push(0, -2, VarioChannel::Clock::now());
+  synthesiser.Synthesise(buffer, std::size(buffer));
+  ok1(listener.n == 2);
+  ok1(listener.ordered);
+
+  synthesiser.SetSilence();
+  synthesiser.Synthesise(buffer, std::size(buffer));
+  /* the merged value is ignored while the device is active */
+  ok1(listener.n == 2);
+}
+
+int main()
+{
+  plan_tests(11 + 9 + 8);
+
+  TestReadWrite();
+  TestPriority();
+  TestSynthesiser();
+
+  return exit_status();
+}
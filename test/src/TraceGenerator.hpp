@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Trace/Point.hpp"
+#include "Geo/Math.hpp"
+
+#include <random>
+#include <vector>
+
+/**
+ * Generate a synthetic flight for #Trace tests and benchmarks: a
+ * random walk with circling phases, fixes every 1..3 seconds, and
+ * optionally some time warps (small ones which #Trace repairs, and
+ * large ones which clear it).
+ */
+static std::vector<TracePoint>
+GenerateFlight(unsigned seed, unsigned n_fixes, bool time_warps=false)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<unsigned> step(1, 3);
+  std::uniform_real_distribution<double> turn(-0.2, 0.2);
+  std::uniform_int_distribution<unsigned> event(0, 2000);
+
+  std::vector<TracePoint> result;
+  result.reserve(n_fixes);
+
+  GeoPoint location(Angle::Degrees(7.7), Angle::Degrees(51.4));
+  Angle heading = Angle::Zero();
+  double altitude = 1000;
+  unsigned time = 36000;
+  unsigned circling = 0;
+
+  for (unsigned i = 0; i < n_fixes; ++i) {
+    const unsigned e = event(rng);
+    if (time_warps && e == 0) {
+      /* small time warp, will be repaired */
+      time -= 20;
+    } else if (time_warps && e == 1) {
+      /* large time warp, clears the trace */
+      time -= 600;
+    } else if (e < 20) {
+      /* gap */
+      time += 300;
+    }
+
+    if (circling == 0 && e > 1980)
+      circling = 60;
+
+    const unsigned dt = step(rng);
+    time += dt;
+
+    if (circling > 0) {
+      --circling;
+      heading += Angle::Degrees(12 * dt);
+      altitude += 1.5 * dt;
+    } else {
+      heading += Angle::Radians(turn(rng));
+      altitude -= 0.8 * dt;
+    }
+
+    location = FindLatitudeLongitude(location, heading, 30. * dt);
+    result.emplace_back(location, TracePoint::Time{time},
+                        altitude, 0, 0);
+  }
+
+  return result;
+}
@@ -21,6 +21,7 @@
 
 #include <zzip/zzip.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include <string.h>
@@ -31,6 +32,16 @@ extern "C" {
 
 static constexpr unsigned NUM_SOL = 15;
 
+static bool
+operator==(const Route &a, const Route &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const AGeoPoint &x, const AGeoPoint &y){
+                      return (const GeoPoint &)x == (const GeoPoint &)y &&
+                        x.altitude == y.altitude;
+                    });
+}
+
 static bool
 test_route(const unsigned n_airspaces, const RasterMap& map)
 {
@@ -136,6 +147,12 @@ test_route(const unsigned n_airspaces, const RasterMap& map)
     route.UpdatePolar(settings, config, polar, polar, wind);
     route.SetTerrain(&map);
 
+    /* a second planner which doesn't reuse clearance test results,
+       to verify the cache */
+    AirspaceRoute reference;
+    reference.UpdatePolar(settings, config, polar, polar, wind);
+    reference.SetTerrain(&map);
+
     auto predicate = AirspacePredicateTrue;
 
     bool sol = false;
@@ -157,15 +174,34 @@ test_route(const unsigned n_airspaces, const RasterMap& map)
       char buffer[80];
       sprintf(buffer, "route %d solution", i);
       ok(sol, buffer, 0);
+
+      reference.Synchronise(airspaces, predicate, loc_start, loc_end);
+      reference.ClearClearanceCache();
+      reference.Solve(loc_start, loc_end, config);
+      sprintf(buffer, "route %d same as without cache", i);
+      ok(route.GetSolution() == reference.GetSolution(), buffer, 0);
     }
+
+    const auto &terrain_cache = route.GetTerrainClearanceCache();
+    const auto &airspace_cache = route.GetAirspaceClearanceCache();
+    printf("# terrain clearance cache: %u hits, %u misses\n"
+           "# airspace clearance cache: %u hits, %u misses\n",
+           terrain_cache.GetHits(), terrain_cache.GetMisses(),
+           airspace_cache.GetHits(), airspace_cache.GetMisses());
   }
 
   return true;
 }
 
-int main()
+int main(int argc, char **argv)
 try {
-  static const char map_path[] = "tmp/map.xcm";
+  static const char hc_path[] = "tmp/map.xcm";
+  const char *map_path;
+  if ((argc<2) || !strlen(argv[1])) {
+    map_path = hc_path;
+  } else {
+    map_path = argv[1];
+  }
 
   ZZIP_DIR *dir = zzip_dir_open(map_path, nullptr);
   if (dir == nullptr) {
@@ -190,7 +226,7 @@ try {
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(4 + NUM_SOL);
+  plan_tests(4 + 2 * NUM_SOL);
   ok(test_route(28, map), "route 28", 0);
   return exit_status();
 } catch (const std::runtime_error &e) {
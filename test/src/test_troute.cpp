@@ -20,8 +20,21 @@
 
 #include <zzip/zzip.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include <string.h>
 
+static bool
+operator==(const Route &a, const Route &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const AGeoPoint &x, const AGeoPoint &y){
+                      return (const GeoPoint &)x == (const GeoPoint &)y &&
+                        x.altitude == y.altitude;
+                    });
+}
+
 static void
 test_troute(const RasterMap &map, double mwind, double mc, int ceiling)
 {
@@ -36,6 +49,12 @@ test_troute(const RasterMap &map, double mwind, double mc, int ceiling)
   route.UpdatePolar(settings, config, polar, polar, wind);
   route.SetTerrain(&map);
 
+  /* a second planner which doesn't reuse clearance test results, to
+     verify the cache */
+  TerrainRoute reference;
+  reference.UpdatePolar(settings, config, polar, polar, wind);
+  reference.SetTerrain(&map);
+
   GeoPoint origin(map.GetMapCenter());
 
   auto pd = map.PixelDistance(origin, 1);
@@ -68,33 +87,101 @@ test_troute(const RasterMap &map, double mwind, double mc, int ceiling)
 
     int hdest = map.GetHeight(dest).GetValueOr0() + 100;
 
-    retval = route.Solve(AGeoPoint(origin,
-                                   map.GetHeight(origin).GetValueOr0() + 100),
-                         AGeoPoint(dest,
-                                   mc > 0
-                                   ? hdest
-                                   : std::max(hdest, 3200)),
-                         config, ceiling);
+    const AGeoPoint a_origin(origin,
+                             map.GetHeight(origin).GetValueOr0() + 100);
+    const AGeoPoint a_dest(dest, mc > 0 ? hdest : std::max(hdest, 3200));
+
+    retval = route.Solve(a_origin, a_dest, config, ceiling);
     char buffer[128];
     sprintf(buffer,"terrain route solve, dir=%g, wind=%g, mc=%g ceiling=%d",
             (double)ang, (double)mwind, (double)mc, (int)ceiling);
     ok(retval, buffer, 0);
     PrintHelper::print_route(route);
+
+    reference.ClearClearanceCache();
+    reference.Solve(a_origin, a_dest, config, ceiling);
+    ok1(route.GetSolution() == reference.GetSolution());
   }
 
+  const auto &cache = route.GetTerrainClearanceCache();
+  printf("# terrain clearance cache: %u hits, %u misses\n",
+         cache.GetHits(), cache.GetMisses());
+
   // polar.SetMC(0);
   // route.UpdatePolar(polar, wind);
 }
 
+/**
+ * Solve repeatedly while the aircraft approaches the target, like
+ * RouteComputer does, and compare with a planner which does not
+ * reuse clearance test results.
+ */
+static void
+test_troute_approach(const RasterMap &map, Angle bearing)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::TERRAIN;
+
+  GlidePolar polar(1);
+  SpeedVector wind(Angle::Degrees(0), 0);
+
+  TerrainRoute route, reference;
+  route.UpdatePolar(settings, config, polar, polar, wind);
+  route.SetTerrain(&map);
+  reference.UpdatePolar(settings, config, polar, polar, wind);
+  reference.SetTerrain(&map);
+
+  const GeoPoint target(map.GetMapCenter());
+  const AGeoPoint a_target(target, map.GetHeight(target).GetValueOr0() + 100);
+
+  using Clock = std::chrono::steady_clock;
+  Clock::duration route_duration{}, reference_duration{};
+
+  bool same = true;
+  for (unsigned i = 0; i < 20; ++i) {
+    const GeoPoint location =
+      GeoVector(20000 - 500 * i, bearing).EndPoint(target);
+    /* a few metres of altitude jitter between two solves, like the
+       vario noise of a real flight */
+    const AGeoPoint a_location(location,
+                               map.GetHeight(location).GetValueOr0() + 100
+                               + 3 * (i % 4));
+
+    auto start = Clock::now();
+    route.Solve(a_target, a_location, config);
+    route_duration += Clock::now() - start;
+
+    start = Clock::now();
+    reference.ClearClearanceCache();
+    reference.Solve(a_target, a_location, config);
+    reference_duration += Clock::now() - start;
+
+    if (!(route.GetSolution() == reference.GetSolution()))
+      same = false;
+  }
+
+  ok(same, "approach same as without cache", 0);
+
+  const auto &cache = route.GetTerrainClearanceCache();
+  printf("# approach from %g deg: %u hits, %u misses, "
+         "%.1f ms vs %.1f ms without cache\n",
+         (double)bearing.Degrees(), cache.GetHits(), cache.GetMisses(),
+         std::chrono::duration<double, std::milli>(route_duration).count(),
+         std::chrono::duration<double, std::milli>(reference_duration).count());
+}
+
 int
 main(int argc, char **argv)
 try {
   static const char hc_path[] = "tmp/map.xcm";
   const char *map_path;
-  if ((argc<2) || !strlen(argv[0])) {
+  if ((argc<2) || !strlen(argv[1])) {
     map_path = hc_path;
   } else {
-    map_path = argv[0];
+    map_path = argv[1];
   }
 
   ZZIP_DIR *dir = zzip_dir_open(map_path, nullptr);
@@ -120,11 +207,14 @@ try {
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(16*3);
+  plan_tests(17 * 3 * 2 + 8);
   test_troute(map, 0, 0.1, 10000);
   test_troute(map, 0, 0, 10000);
   test_troute(map, 5.0, 1, 10000);
 
+  for (unsigned i = 0; i < 8; ++i)
+    test_troute_approach(map, Angle::Degrees(45 * i));
+
   return exit_status();
 } catch (const std::runtime_error &e) {
   PrintException(e);